@@ -5,8 +5,24 @@ SUBDIRS += \
     src/MyLib/RTL_SDR_RadarLib \
     src/MyApp/RadarApp \
     src/MyApp/RaspberryApp \
+    src/MyApp/RaspberryDaemon \
     #tests/TestServer
     #tests/PoolObjectsTest \
-    #src/MyApp/ImitObjectsTest
+    #tests/AircraftDbTest \
+    #tests/TrackModelTest \
+    #tests/ArchiveCodecTest \
+    #tests/IngestTest \
+    #tests/SbsFormatterTest \
+    #tests/HttpServerTest \
+    #tests/PipelineTest \
+    #tests/DspTest \
+    #tests/DeltaCodecTest \
+    #tests/TimeModelBenchmark \
+    #tests/PoolScanBenchmark \
+    #tests/MulticastLoopbackTest \
+    #tests/FrameParserFuzzTest \
+    #tests/FeederLoadGenerator \
+    #src/MyApp/ImitObjectsTest \
+    #src/MyApp/AircraftDbBuilder
 
 CONFIG += ordered
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+if [ $# -eq 0 ] 
+then
+       	printf "[$NOW] Error usage.\n Usage: \n startRaspberryDaemon.sh <config file> \n Example: ./startRaspberryDaemon.sh ../import/raspberry_daemon.ini\n"
+	exit 0
+fi
+
+CONFIG=$(readlink -f $1)
+
+cd ../
+CURRENT_DIR=$(pwd)/lib.linux/
+LD_LIBRARY_PATH=${LD_LIBRARY_PATH}:${CURRENT_DIR}
+export LD_LIBRARY_PATH
+
+echo $LD_LIBRARY_PATH
+
+cd bin/release/RaspberryDaemon
+nohup ./RaspberryDaemon -c $CONFIG > /dev/null 2>&1& 
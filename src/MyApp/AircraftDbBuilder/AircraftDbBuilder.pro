@@ -0,0 +1,23 @@
+QT       += core
+QT       -= gui
+
+TARGET = AircraftDbBuilder
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11
+
+include( ../../../common.pri )
+include( ../../../app.pri )
+
+SOURCES += \
+        main.cpp \
+    AircraftDbWriter.cpp
+
+HEADERS += \
+    ../../include/database/AircraftDbFormat.h \
+    AircraftDbWriter.h
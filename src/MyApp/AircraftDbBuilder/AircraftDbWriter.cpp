@@ -0,0 +1,183 @@
+#include "AircraftDbWriter.h"
+
+#include <algorithm>
+#include <string.h>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+
+AircraftDbWriter::AircraftDbWriter()
+{
+}
+
+QList<QByteArray> AircraftDbWriter::splitLine(const QByteArray &line)
+{
+    QList<QByteArray> fields;
+    QByteArray current;
+    bool quoted = false;
+
+    for(int i = 0; i < line.size(); ++i)
+    {
+        char c = line.at(i);
+
+        if(quoted)
+        {
+            if(c == '"')
+            {
+                //двойная кавычка внутри поля
+                if(i + 1 < line.size() && line.at(i + 1) == '"')
+                {
+                    current.append('"');
+                    ++i;
+                }
+                else
+                    quoted = false;
+            }
+            else
+                current.append(c);
+        }
+        else
+        {
+            if(c == '"')
+                quoted = true;
+            else if(c == ',')
+            {
+                fields.append(current.trimmed());
+                current.clear();
+            }
+            else if(c != '\r' && c != '\n')
+                current.append(c);
+        }
+    }
+    fields.append(current.trimmed());
+
+    return fields;
+}
+
+bool AircraftDbWriter::findColumns(const QList<QByteArray> &header)
+{
+    _icaoColumn = _registrationColumn = _typeColumn = _ownerColumn = -1;
+
+    for(int i = 0; i < header.size(); ++i)
+    {
+        QByteArray name = header.at(i).toLower();
+
+        if(name == "icao24" || name == "icao")
+            _icaoColumn = i;
+        else if(name == "registration")
+            _registrationColumn = i;
+        else if(name == "typecode" || name == "type")
+            _typeColumn = i;
+        else if(name == "operator" || name == "owner")
+            _ownerColumn = i;
+    }
+
+    return _icaoColumn >= 0;
+}
+
+QByteArray AircraftDbWriter::field(const QList<QByteArray> &fields, int column)
+{
+    if(column < 0 || column >= fields.size())
+        return QByteArray();
+
+    return fields.at(column);
+}
+
+uint32_t AircraftDbWriter::addString(const QByteArray &str)
+{
+    if(str.isEmpty())
+        return AIRCRAFT_DB_NO_STRING;
+
+    auto it = _offsets.constFind(str);
+    if(it != _offsets.constEnd())
+        return it.value();
+
+    uint32_t offset = uint32_t(_strings.size());
+    _strings.append(str);
+    _strings.append('\0');
+    _offsets.insert(str, offset);
+
+    return offset;
+}
+
+int AircraftDbWriter::readCsv(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qDebug()<<"can't open file"<<fileName;
+        return -1;
+    }
+
+    if(!findColumns(splitLine(file.readLine())))
+    {
+        qDebug()<<"icao24 column not found in"<<fileName;
+        return -1;
+    }
+
+    int counter = 0;
+    while(!file.atEnd())
+    {
+        QList<QByteArray> fields = splitLine(file.readLine());
+
+        bool ok = false;
+        uint32_t icao = field(fields, _icaoColumn).toUInt(&ok, 16);
+        if(!ok || icao == 0 || icao > 0xffffff)
+            continue;
+
+        AircraftDbRecord record;
+        record.icao = icao;
+        record.registration = addString(field(fields, _registrationColumn));
+        record.type = addString(field(fields, _typeColumn));
+        record.owner = addString(field(fields, _ownerColumn));
+
+        _records.append(record);
+        ++counter;
+    }
+
+    return counter;
+}
+
+bool AircraftDbWriter::write(const QString &fileName)
+{
+    //устойчивая сортировка сохраняет порядок чтения повторяющихся адресов
+    std::stable_sort(_records.begin(), _records.end(),
+                     [](const AircraftDbRecord& a, const AircraftDbRecord& b)
+    {
+        return a.icao < b.icao;
+    });
+
+    QVector<AircraftDbRecord> records;
+    records.reserve(_records.size());
+    for(const AircraftDbRecord& record : _records)
+    {
+        if(!records.isEmpty() && records.last().icao == record.icao)
+            records.last() = record;
+        else
+            records.append(record);
+    }
+    _records = records;
+
+    AircraftDbHeader header;
+    memcpy(header.magic, AIRCRAFT_DB_MAGIC, sizeof(header.magic));
+    header.version = AIRCRAFT_DB_VERSION;
+    header.count = uint32_t(_records.size());
+    header.recordsOffset = sizeof(AircraftDbHeader);
+    header.stringsOffset = header.recordsOffset +
+            header.count * uint32_t(sizeof(AircraftDbRecord));
+    header.stringsSize = uint32_t(_strings.size());
+
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        qDebug()<<"can't create file"<<fileName;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(_records.constData()),
+               qint64(_records.size()) * qint64(sizeof(AircraftDbRecord)));
+    file.write(_strings);
+
+    return file.commit();
+}
@@ -0,0 +1,71 @@
+#ifndef AIRCRAFTDBWRITER_H
+#define AIRCRAFTDBWRITER_H
+
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+#include <QStringList>
+
+#include "database/AircraftDbFormat.h"
+
+/*!
+ * \brief The AircraftDbWriter class
+ * Формирование файла справочника самолётов из CSV-файла.
+ * Первая строка CSV-файла - заголовок, столбцы определяются по имени
+ * (icao24/icao, registration, typecode/type, operator/owner),
+ * поэтому поддерживаются выгрузки открытых баз данных самолётов.
+ * \author Данильченко Артем
+ */
+class AircraftDbWriter
+{
+    ///< записи справочника
+    QVector<AircraftDbRecord> _records;
+    ///< пул строк
+    QByteArray _strings;
+    ///< смещения строк в пуле
+    QHash<QByteArray, uint32_t> _offsets;
+
+    ///< номера столбцов CSV-файла
+    int _icaoColumn = -1;
+    int _registrationColumn = -1;
+    int _typeColumn = -1;
+    int _ownerColumn = -1;
+
+    /*!
+     * \brief splitLine разбор строки CSV с учётом кавычек
+     */
+    static QList<QByteArray> splitLine(const QByteArray& line);
+    /*!
+     * \brief findColumns поиск столбцов по заголовку
+     * \return true - найден столбец адреса ICAO
+     */
+    bool findColumns(const QList<QByteArray>& header);
+    /*!
+     * \brief addString добавление строки в пул
+     * \return смещение строки в пуле
+     */
+    uint32_t addString(const QByteArray& str);
+    static QByteArray field(const QList<QByteArray>& fields, int column);
+
+public:
+    AircraftDbWriter();
+
+    /*!
+     * \brief readCsv чтение записей из CSV-файла
+     * \param fileName - имя файла
+     * \return количество прочитанных записей или -1 при ошибке
+     */
+    int readCsv(const QString& fileName);
+    /*!
+     * \brief write запись файла справочника.
+     * Записи сортируются по адресу ICAO, из повторяющихся адресов
+     * остаётся последняя запись
+     * \param fileName - имя файла
+     * \return результат записи
+     */
+    bool write(const QString& fileName);
+
+    int count() const { return _records.size(); }
+};
+
+#endif // AIRCRAFTDBWRITER_H
@@ -0,0 +1,41 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include "AircraftDbWriter.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setApplicationName("AircraftDbBuilder");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QCoreApplication::translate("main",
+                                                                 "Build aircraft database from CSV file"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("csv",
+                                 QCoreApplication::translate("main",
+                                                             "CSV file with icao24, registration, typecode, operator columns"));
+    parser.addPositionalArgument("db",
+                                 QCoreApplication::translate("main",
+                                                             "output database file"));
+    parser.process(a);
+
+    const QStringList args = parser.positionalArguments();
+    if(args.size() < 2)
+        parser.showHelp(1);
+
+    AircraftDbWriter writer;
+    if(writer.readCsv(args.at(0)) < 0)
+        return 1;
+
+    if(!writer.write(args.at(1)))
+        return 1;
+
+    qDebug()<<"records written"<<writer.count();
+
+    return 0;
+}
@@ -1,19 +1,55 @@
 #include "Core.h"
 #include <QApplication>
+#include <QJsonArray>
+#include <QJsonObject>
 
 #include "../MyLib/RTL_SDR_RadarLib/PoolObject/PoolObject.h"
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/database/AircraftDatabase.h"
 #include "../MyLib/RTL_SDR_RadarLib/Logger/Logger.h"
 #include "../MyLib/RTL_SDR_RadarLib/Carrier/Carrier.h"
 #include "../MyLib/RTL_SDR_RadarLib/Carrier/ServiceLocator.h"
 #include "../MyLib/RTL_SDR_RadarLib/DataController/DataController.h"
 #include "../MyLib/RTL_SDR_RadarLib/RTL_SDR_Reciver/RTL_SDR_Reciver.h"
 #include "../MyLib/RTL_SDR_RadarLib/Demodulator/Demodulator.h"
+#include "../MyLib/RTL_SDR_RadarLib/TrackArchive/TrackArchive.h"
+#include "../MyLib/RTL_SDR_RadarLib/DSP/SpectrumEngine.h"
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/IngestServer.h"
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/SbsServer.h"
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/HttpJsonServer.h"
 #include "../MyLib/RTL_SDR_RadarLib/GraphicsWidget/GraphicsWidget.h"
 #include "../MyLib/RTL_SDR_RadarLib/ModelTable/ModelTable.h"
 #include "../include/coord/Conversions.h"
 
 #include "publisher/Subject.h"
 
+namespace
+{
+///< список ядер для вывода: "0,1,2"
+QString cpuList(const QVector<int>& cpus)
+{
+    QStringList list;
+    for(int cpu : cpus)
+        list.append(QString::number(cpu));
+    return list.join(',');
+}
+
+QString schedName(const PlacementReport& report)
+{
+    if(report.scheduling == SCHED_CLASS::FIFO)
+        return QString("fifo:%1").arg(report.priority);
+    return QString("normal");
+}
+
+QJsonObject latencyJson(const LatencyStats& stats)
+{
+    QJsonObject latency;
+    latency.insert("average", stats.average);
+    latency.insert("p50", double(stats.p50));
+    latency.insert("p99", double(stats.p99));
+    latency.insert("max", double(stats.max));
+    return latency;
+}
+}
 
 Core::Core(QObject *parent) : QObject(parent)
 {
@@ -31,13 +67,27 @@ Core::Core(QObject *parent) : QObject(parent)
 
 Core::~Core()
 {
+    if(!_httpServer.isNull())
+        _httpServer->stop();
+    _httpServer.clear();
+
+    if(!_sbsServer.isNull())
+        _sbsServer->stop();
+    _sbsServer.clear();
+
+    if(!_ingestServer.isNull())
+        _ingestServer->stop();
+    _ingestServer.clear();
+
     _dataController->stop();
     _dataController.clear();
+    _dsp.clear();
 
     _device->closeDevice();
     _device.clear();
 
     _demodulator.clear();
+    _trackArchive.clear();
 
     _subject->Deatach(_graphicsWidget);
     delete _graphicsWidget;
@@ -52,7 +102,8 @@ Core::~Core()
     delete _mainWindow;
 }
 
-void Core::init()
+void Core::init(uint16_t serverPort, uint16_t sbsPort, uint16_t httpPort, bool spectrum,
+                const QString &threadPolicy)
 {  
     //носитель приемника стационарный объект
     ServiceLocator::provide(QSharedPointer<ICarrierClass>( new NullCarrier()) );
@@ -64,15 +115,68 @@ void Core::init()
     _device->openDevice();
     //пулл объектов для хранения объектов типа самолет
     _poolObjects = QSharedPointer<IPoolObject>(new PoolObject(OBJECT_TYPE::air));
+    //справочник самолетов по адресу ICAO
+    QSharedPointer<AircraftDatabase> database(new AircraftDatabase());
+    if(database->open(QApplication::applicationDirPath()+"/../../../import/aircraft.db"))
+        _poolObjects->setAircraftDatabase(database);
+    else
+        qDebug()<<"aircraft database not loaded";
 
     //демодулятор входного сигнала
     _demodulator = QSharedPointer<IDemodulator>(new Demodulator(_poolObjects));
     _demodulator->setLogger(_logger);
+    //архив траекторий
+    _trackArchive = QSharedPointer<ITrackArchive>(
+                new TrackArchive(QApplication::applicationDirPath()+"/archive"));
+    _demodulator->setTrackArchive(_trackArchive);
+    //восстановление состояния после перезапуска
+    const QString stateFile = QApplication::applicationDirPath()+"/radar_state.bin";
+    _demodulator->loadState(stateFile);
 
     //контроллер данных
     _dataController = QSharedPointer<IDataController>(new DataController(_device,
                                                                          _demodulator));
+    _dataController->setStateFile(stateFile, STATE_SAVE_PERIOD);
+    //спектр рассчитывается собственным потоком и не задерживает демодуляцию
+    if(spectrum)
+    {
+        _dsp = QSharedPointer<IDSP>(new SpectrumEngine());
+        _dataController->setDSP(_dsp);
+    }
+    //размещение потоков: стадия чтения (и приемник) отдельно от GUI и сети
+    ThreadPolicy policy;
+    const bool placed = !threadPolicy.isEmpty() && ThreadPolicy::load(threadPolicy, policy);
+    if(placed)
+        _dataController->setThreadPolicy(policy);
     _dataController->run();
+    //основной поток размещается после запуска потока обработки:
+    //потоки, созданные позже, наследуют размещение основного потока
+    _guiPlacement = placed ? ThreadPlacer::apply("gui", policy.gui)
+                           : ThreadPlacer::current("gui");
+
+    //прием данных от удаленных приемных пунктов в общий пул
+    if(serverPort != 0)
+    {
+        _ingestServer = QSharedPointer<IIngestServer>(new IngestServer(_poolObjects));
+        if(!_ingestServer->start(serverPort))
+            qDebug()<<"ingest server not started on port"<<serverPort;
+    }
+
+    //выдача данных сторонним программам в формате SBS-1
+    if(sbsPort != 0)
+    {
+        _sbsServer = QSharedPointer<ISbsServer>(new SbsServer(_poolObjects));
+        if(!_sbsServer->start(sbsPort))
+            qDebug()<<"SBS server not started on port"<<sbsPort;
+    }
+
+    //выдача списка самолётов браузерам и скриптам
+    if(httpPort != 0)
+    {
+        _httpServer = QSharedPointer<IHttpServer>(new HttpJsonServer(_poolObjects));
+        if(!_httpServer->start(httpPort))
+            qDebug()<<"HTTP server not started on port"<<httpPort;
+    }
 
     //паттерн наблюдатель наблюдатель
     _subject = QSharedPointer<ISubject>(new Subject());
@@ -104,6 +208,12 @@ void Core::init()
     _timerUpdateWidgets.start(TIMEOUT_UPDATE);
 }
 
+void Core::setArchiveRetention(int hours)
+{
+    if(!_trackArchive.isNull())
+        _trackArchive->setRetention(hours);
+}
+
 void Core::slotUpdateWidgets()
 {
     if(_poolObjects.isNull())
@@ -119,6 +229,202 @@ void Core::slotUpdateWidgets()
 
         _poolObjects->unlockPool();
     }
+
+    if(!_httpServer.isNull())
+        updateReceiverStats();
+
+    if(++_statsCounter >= STATS_PERIOD)
+    {
+        _statsCounter = 0;
+        if(!_dataController.isNull())
+        {
+            for(const StageStats& stats : _dataController->stageStats())
+                qDebug()<<"stage"<<stats.name
+                       <<"threads"<<stats.threads
+                       <<"queued"<<stats.queued
+                       <<"processed"<<stats.processed
+                       <<"dropped"<<stats.dropped
+                       <<"waits"<<stats.waits
+                       <<"latency us avg"<<stats.latency.average
+                       <<"p50"<<stats.latency.p50
+                       <<"p99"<<stats.latency.p99
+                       <<"max"<<stats.latency.max
+                       <<"wakeup us p50"<<stats.wakeup.p50
+                       <<"p99"<<stats.wakeup.p99
+                       <<"max"<<stats.wakeup.max;
+
+            QVector<PlacementReport> threads = _dataController->threadPlacement();
+            threads.append(_guiPlacement);
+            for(const PlacementReport& report : threads)
+                qDebug()<<"thread"<<report.name
+                       <<"tid"<<report.tid
+                       <<"cpus"<<cpuList(report.cpus)
+                       <<"sched"<<schedName(report)
+                       <<"nice"<<report.nice
+                       <<(report.fallback ? "fallback: " + report.errors.join("; ")
+                                          : QString());
+
+            const OverloadStats overload = _dataController->overloadStats();
+            qDebug()<<"overload level"<<OverloadGovernor::levelName(overload.level)
+                   <<"lag us"<<overload.lagUs
+                   <<"backlog us"<<overload.backlogUs
+                   <<"max"<<overload.maxBacklogUs
+                   <<"drop ratio"<<overload.dropRatio
+                   <<"degradations"<<overload.degradations
+                   <<"recoveries"<<overload.recoveries;
+        }
+
+        if(!_ingestServer.isNull())
+        {
+            for(const FeederStats& stats : _ingestServer->feederStats())
+                qDebug()<<"feeder"<<stats.address
+                       <<"records/s"<<stats.recordsPerSec
+                       <<"bytes/s"<<stats.bytesPerSec
+                       <<"lag"<<stats.lag<<"max lag"<<stats.maxLag
+                       <<"latency"<<stats.latency
+                       <<"clock offset"<<(stats.clockSynced ? QString::number(stats.clockOffset)
+                                                            : QString("unknown"))
+                       <<"rtt"<<stats.rtt
+                       <<"errors"<<stats.errors;
+
+            const MergeStats merge = _ingestServer->mergeStats();
+            qDebug()<<"merge aircraft"<<merge.aircraft
+                   <<"applied"<<merge.applied<<"of"<<merge.records
+                   <<"stale"<<merge.stale<<"held"<<merge.held
+                   <<"source switches"<<merge.sourceSwitches;
+        }
+
+        if(!_sbsServer.isNull())
+        {
+            const SbsServerStats stats = _sbsServer->stats();
+            qDebug()<<"SBS clients"<<stats.clients
+                   <<"messages"<<stats.messages
+                   <<"bytes"<<stats.bytes
+                   <<"skipped"<<stats.skipped
+                   <<"slow disconnects"<<stats.slowDisconnects;
+        }
+    }
+}
+
+void Core::updateReceiverStats()
+{
+    QJsonObject receiver;
+    if(!_device.isNull())
+        receiver.insert("device_open", _device->isOpenDevice());
+
+    if(!_dataController.isNull())
+    {
+        QJsonArray stages;
+        for(const StageStats& stats : _dataController->stageStats())
+        {
+            QJsonObject stage;
+            stage.insert("name", stats.name);
+            stage.insert("threads", stats.threads);
+            stage.insert("queued", stats.queued);
+            stage.insert("processed", double(stats.processed));
+            stage.insert("dropped", double(stats.dropped));
+            stage.insert("waits", double(stats.waits));
+            if(stats.latency.count > 0)
+                stage.insert("latency_us", latencyJson(stats.latency));
+            if(stats.wakeup.count > 0)
+                stage.insert("wakeup_us", latencyJson(stats.wakeup));
+            stages.append(stage);
+        }
+        receiver.insert("pipeline", stages);
+
+        QVector<PlacementReport> reports = _dataController->threadPlacement();
+        reports.append(_guiPlacement);
+        QJsonArray threads;
+        for(const PlacementReport& report : reports)
+        {
+            QJsonObject thread;
+            thread.insert("name", report.name);
+            thread.insert("tid", double(report.tid));
+            QJsonArray cpus;
+            for(int cpu : report.cpus)
+                cpus.append(cpu);
+            thread.insert("cpus", cpus);
+            thread.insert("sched", schedName(report));
+            thread.insert("nice", report.nice);
+            thread.insert("fallback", report.fallback);
+            if(!report.errors.isEmpty())
+                thread.insert("errors", QJsonArray::fromStringList(report.errors));
+            threads.append(thread);
+        }
+        receiver.insert("threads", threads);
+
+        const OverloadStats stats = _dataController->overloadStats();
+        QJsonObject overload;
+        overload.insert("level", QString(OverloadGovernor::levelName(stats.level)));
+        overload.insert("lag_us", double(stats.lagUs));
+        overload.insert("backlog_us", double(stats.backlogUs));
+        overload.insert("max_backlog_us", double(stats.maxBacklogUs));
+        overload.insert("drop_ratio", stats.dropRatio);
+        overload.insert("degradations", double(stats.degradations));
+        overload.insert("recoveries", double(stats.recoveries));
+        overload.insert("overloaded_periods", double(stats.overloadedPeriods));
+        receiver.insert("overload", overload);
+    }
+
+    if(!_ingestServer.isNull())
+    {
+        QJsonArray feeders;
+        for(const FeederStats& stats : _ingestServer->feederStats())
+        {
+            QJsonObject feeder;
+            feeder.insert("address", stats.address);
+            feeder.insert("records", double(stats.records));
+            feeder.insert("errors", double(stats.errors));
+            feeder.insert("records_per_sec", stats.recordsPerSec);
+            feeder.insert("bytes_per_sec", stats.bytesPerSec);
+            feeder.insert("lag", double(stats.lag));
+            feeder.insert("latency", stats.latency);
+            if(stats.clockSynced)
+            {
+                feeder.insert("clock_offset", double(stats.clockOffset));
+                feeder.insert("rtt", double(stats.rtt));
+            }
+            feeders.append(feeder);
+        }
+        receiver.insert("feeders", feeders);
+
+        const MergeStats stats = _ingestServer->mergeStats();
+        QJsonObject merge;
+        merge.insert("aircraft", stats.aircraft);
+        merge.insert("records", double(stats.records));
+        merge.insert("applied", double(stats.applied));
+        merge.insert("stale", double(stats.stale));
+        merge.insert("held", double(stats.held));
+        merge.insert("source_switches", double(stats.sourceSwitches));
+        receiver.insert("merge", merge);
+    }
+
+    if(!_dsp.isNull())
+    {
+        const SpectrumFrame frame = _dsp->spectrumFrame();
+        QJsonArray bins;
+        for(float value : frame.spectrum)
+            bins.append(qRound(value * 10.0f) / 10.0);
+
+        QJsonObject spectrum;
+        spectrum.insert("sample_rate", frame.sampleRate);
+        spectrum.insert("rows", double(frame.rows));
+        spectrum.insert("skipped", double(frame.skipped));
+        spectrum.insert("db", bins);
+        receiver.insert("spectrum", spectrum);
+    }
+
+    if(!_sbsServer.isNull())
+    {
+        const SbsServerStats stats = _sbsServer->stats();
+        QJsonObject sbs;
+        sbs.insert("clients", stats.clients);
+        sbs.insert("messages", double(stats.messages));
+        sbs.insert("skipped", double(stats.skipped));
+        receiver.insert("sbs", sbs);
+    }
+
+    _httpServer->setReceiverStats(receiver);
 }
 
 void Core::updateGeoPositionInfo()
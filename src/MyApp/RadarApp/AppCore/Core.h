@@ -10,15 +10,21 @@
 
 #include "gui/MainWindow.h"
 #include "gui/TableForm.h"
+#include "pipeline/ThreadPlacement.h"
 
 class IPoolObject;
 class IDataController;
 class IReciverDevice;
 class IDemodulator;
+class ITrackArchive;
 class GraphicsWidget;
 class ISubject;
 class ModelTable;
 class ILogger;
+class IIngestServer;
+class ISbsServer;
+class IHttpServer;
+class IDSP;
 
 class Core : public QObject
 {
@@ -28,6 +34,11 @@ class Core : public QObject
 
     uint32_t SIZE_WIDGET = 600;
     int sizeLog = 1000;
+    ///< период сохранения состояния демодулятора, мс
+    const int64_t STATE_SAVE_PERIOD = 30000;
+    ///< период вывода счетчиков приемных пунктов, периодов обновления
+    const int32_t STATS_PERIOD = 10;
+    int32_t _statsCounter = 0;
     ///< таймер обновления
     QTimer _timerUpdateWidgets;
     ///< основная форма
@@ -46,10 +57,21 @@ class Core : public QObject
     QSharedPointer<IReciverDevice> _device = nullptr;
     ///< демодулятор
     QSharedPointer<IDemodulator> _demodulator = nullptr;
+    QSharedPointer<ITrackArchive> _trackArchive = nullptr;
+    ///< сервер сбора данных от приемных пунктов
+    QSharedPointer<IIngestServer> _ingestServer = nullptr;
+    ///< сервер выдачи данных в формате SBS-1
+    QSharedPointer<ISbsServer> _sbsServer = nullptr;
+    ///< HTTP сервер выдачи данных в формате JSON
+    QSharedPointer<IHttpServer> _httpServer = nullptr;
+    ///< модуль ЦОС: спектр и водопад
+    QSharedPointer<IDSP> _dsp = nullptr;
     ///< поставщик из паттерна наблюдатель
     QSharedPointer<ISubject> _subject = nullptr;
     ///< логгер
     QSharedPointer<ILogger> _logger = nullptr;
+    ///< фактическое размещение основного потока
+    PlacementReport _guiPlacement;
 
     /*!
      * \brief updateGeoPositionInfo
@@ -57,14 +79,38 @@ class Core : public QObject
      * объектов
      */
     void updateGeoPositionInfo();
+    /*!
+     * \brief updateReceiverStats передача счетчиков приемника
+     * и серверов в HTTP сервер
+     */
+    void updateReceiverStats();
 
 public:
     explicit Core(QObject *parent = nullptr);
     ~Core();
     /*!
      * \brief init  -иинициализация приложения
+     * \param serverPort - порт сервера приема данных от приемных пунктов,
+     * 0 - сервер не запускается
+     * \param sbsPort - порт выдачи данных в формате SBS-1,
+     * 0 - выдача не запускается
+     * \param httpPort - порт HTTP сервера выдачи JSON,
+     * 0 - сервер не запускается
+     * \param spectrum - расчет спектра и водопада
+     * \param threadPolicy - INI файл размещения потоков (ThreadPolicy),
+     * пустая строка - потоки не размещаются
+     */
+    void init(uint16_t serverPort = 0,
+              uint16_t sbsPort = 0,
+              uint16_t httpPort = 0,
+              bool spectrum = false,
+              const QString& threadPolicy = QString());
+    /*!
+     * \brief setArchiveRetention срок хранения архива траекторий,
+     * вызывается после init
+     * \param hours - срок хранения, ч; 0 - без ограничения
      */
-    void init();
+    void setArchiveRetention(int hours);
 signals:
 
 public slots:
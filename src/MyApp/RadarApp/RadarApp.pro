@@ -57,9 +57,12 @@ DISTFILES += \
 
 LIBS += -lLogger \
         -lPoolObject \
+        -lTrackArchive \
+        -lDSP \
         -lGraphicsWidget \
         -lCarrier \
         -lDataController \
         -lRTL_SDR_Reciver \
         -lDemodulator \
+        -lNetServer \
         -lModelTable
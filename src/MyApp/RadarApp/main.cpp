@@ -1,4 +1,5 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDir>
 #include <QProcessEnvironment>
 #include "AppCore/Core.h"
@@ -6,7 +7,69 @@
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    // парсер аргументов командной строки
+    QApplication::setApplicationName("RadarApp");
+    QApplication::setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QCoreApplication::translate("main",
+                                                                 "RadarApp"));
+    parser.addHelpOption();
+
+    QCommandLineOption serverOption(QStringList() << "s" << "server",
+                                    QCoreApplication::translate("main",
+                                                                "accept data from remote receivers on <port>"),
+                                    QCoreApplication::translate("main", "port"));
+    parser.addOption(serverOption);
+
+    QCommandLineOption sbsOption(QStringList() << "b" << "sbs",
+                                 QCoreApplication::translate("main",
+                                                             "serve SBS-1 (BaseStation) messages on <port>, usually 30003"),
+                                 QCoreApplication::translate("main", "port"));
+    parser.addOption(sbsOption);
+
+    QCommandLineOption httpOption(QStringList() << "j" << "http",
+                                  QCoreApplication::translate("main",
+                                                              "serve /data/aircraft.json and /data/stats.json on <port>"),
+                                  QCoreApplication::translate("main", "port"));
+    parser.addOption(httpOption);
+
+    QCommandLineOption spectrumOption(QStringList() << "S" << "spectrum",
+                                      QCoreApplication::translate("main",
+                                                                  "compute spectrum and waterfall of the receiver band"));
+    parser.addOption(spectrumOption);
+
+    QCommandLineOption threadsOption(QStringList() << "t" << "threads",
+                                     QCoreApplication::translate("main",
+                                                                 "place receiver, pipeline and GUI threads by INI <file>"),
+                                     QCoreApplication::translate("main", "file"));
+    parser.addOption(threadsOption);
+
+    QCommandLineOption retentionOption(QStringList() << "H" << "archive-hours",
+                                       QCoreApplication::translate("main",
+                                                                   "keep the track archive for <hours>, 0 - forever (default 72)"),
+                                       QCoreApplication::translate("main", "hours"));
+    parser.addOption(retentionOption);
+
+    parser.process(a);
+
+    uint16_t serverPort = 0;
+    if(parser.isSet(serverOption))
+        serverPort = parser.value(serverOption).toUShort();
+
+    uint16_t sbsPort = 0;
+    if(parser.isSet(sbsOption))
+        sbsPort = parser.value(sbsOption).toUShort();
+
+    uint16_t httpPort = 0;
+    if(parser.isSet(httpOption))
+        httpPort = parser.value(httpOption).toUShort();
+
     Core core;
-    core.init();
+    core.init(serverPort, sbsPort, httpPort, parser.isSet(spectrumOption),
+              parser.value(threadsOption));
+    if(parser.isSet(retentionOption))
+        core.setArchiveRetention(parser.value(retentionOption).toInt());
     return a.exec();
 }
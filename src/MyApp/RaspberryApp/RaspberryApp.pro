@@ -35,6 +35,7 @@ DISTFILES += \
 
 LIBS += -lLogger \
         -lPoolObject \
+        -lTrackArchive \
         -lCarrier \
         -lDataController \
         -lRTL_SDR_Reciver \
@@ -48,6 +49,7 @@ SOURCES += \
 
 HEADERS += \
     ../../include/interface/INetworkWorker.h \
+    ../../include/protocol/MulticastProtocol.h \
     ../../include/widget/led/led.h \
     ui/Mainwindow.h \
     core/Core.h
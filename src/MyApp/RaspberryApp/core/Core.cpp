@@ -10,6 +10,7 @@
 #include "../MyLib/RTL_SDR_RadarLib/DataController/DataController.h"
 #include "../MyLib/RTL_SDR_RadarLib/RTL_SDR_Reciver/RTL_SDR_Reciver.h"
 #include "../MyLib/RTL_SDR_RadarLib/Demodulator/Demodulator.h"
+#include "../MyLib/RTL_SDR_RadarLib/TrackArchive/TrackArchive.h"
 
 Core::Core(QObject *parent) : QObject(parent)
 {
@@ -37,6 +38,12 @@ Core::Core(QObject *parent) : QObject(parent)
     _demodulator = QSharedPointer<IDemodulator>(new Demodulator(_poolObjects));
 
     _demodulator->setLogger(_logger);
+    //архив траекторий
+    _trackArchive = QSharedPointer<ITrackArchive>(
+                new TrackArchive(QApplication::applicationDirPath()+"/archive"));
+    _demodulator->setTrackArchive(_trackArchive);
+    //восстановление состояния после перезапуска
+    _demodulator->loadState(QApplication::applicationDirPath()+"/radar_state.bin");
 
     _mainWindow.setLogger(_logger);
     _mainWindow.show();
@@ -54,18 +61,22 @@ Core::~Core()
     _poolObjects.clear();
     _dataController.clear();
     _demodulator.clear();
+    _trackArchive.clear();
     _device->closeDevice();
     _device.clear();
     _logger.clear();
 }
 
-void Core::init(const QString &ip, uint16_t port)
+void Core::init(const QString &ip, uint16_t port, NET_PROTOCOL protocol)
 {
 
     _dataController = QSharedPointer<IDataController>(new DataController(_device,
                                                                          _demodulator,
                                                                          ip,
                                                                          port));
+    _dataController->setStateFile(QApplication::applicationDirPath()+"/radar_state.bin",
+                                  STATE_SAVE_PERIOD);
+    _dataController->setNetProtocol(protocol);
 }
 
 
@@ -73,6 +84,76 @@ void Core::init()
 {
     _dataController = QSharedPointer<IDataController>(new DataController(_device,
                                                                          _demodulator));
+    _dataController->setStateFile(QApplication::applicationDirPath()+"/radar_state.bin",
+                                  STATE_SAVE_PERIOD);
+}
+
+void Core::setMulticast(const QString &group, uint16_t port)
+{
+    if(!_dataController.isNull())
+        _dataController->setMulticast(group, port);
+}
+
+void Core::setThreadPolicy(const QString &fileName)
+{
+    _hasThreadPolicy = ThreadPolicy::load(fileName, _threadPolicy);
+    if(_hasThreadPolicy && !_dataController.isNull())
+        _dataController->setThreadPolicy(_threadPolicy);
+}
+
+void Core::printStats()
+{
+    if(_dataController.isNull())
+        return;
+
+    for(const StageStats& stats : _dataController->stageStats())
+        qDebug()<<"stage"<<stats.name
+               <<"processed"<<stats.processed
+               <<"dropped"<<stats.dropped
+               <<"latency us p99"<<stats.latency.p99
+               <<"wakeup us p50"<<stats.wakeup.p50
+               <<"p99"<<stats.wakeup.p99
+               <<"max"<<stats.wakeup.max;
+
+    QVector<PlacementReport> threads = _dataController->threadPlacement();
+    threads.append(_guiPlacement);
+    for(const PlacementReport& report : threads)
+    {
+        QStringList cpus;
+        for(int cpu : report.cpus)
+            cpus.append(QString::number(cpu));
+
+        qDebug()<<"thread"<<report.name
+               <<"tid"<<report.tid
+               <<"cpus"<<cpus.join(',')
+               <<"sched"<<(report.scheduling == SCHED_CLASS::FIFO
+                           ? QString("fifo:%1").arg(report.priority)
+                           : QString("normal"))
+               <<"nice"<<report.nice
+               <<(report.fallback ? "fallback: " + report.errors.join("; ")
+                                  : QString());
+    }
+
+    const OverloadStats overload = _dataController->overloadStats();
+    qDebug()<<"overload level"<<OverloadGovernor::levelName(overload.level)
+           <<"lag us"<<overload.lagUs
+           <<"backlog us"<<overload.backlogUs
+           <<"max"<<overload.maxBacklogUs
+           <<"drop ratio"<<overload.dropRatio
+           <<"degradations"<<overload.degradations
+           <<"recoveries"<<overload.recoveries;
+}
+
+void Core::setAggressive(bool state)
+{
+    if(!_demodulator.isNull())
+        _demodulator->setAggressive(state);
+}
+
+void Core::setArchiveRetention(int hours)
+{
+    if(!_trackArchive.isNull())
+        _trackArchive->setRetention(hours);
 }
 
 void Core::slotTimeout()
@@ -80,10 +161,23 @@ void Core::slotTimeout()
     if(_device && !_device->isOpenDevice())
     {
         if(_device->openDevice())
+        {
             _dataController->run();
+            //основной поток размещается один раз, после создания
+            //потока обработки: новые потоки наследуют размещение
+            if(_guiPlacement.name.isEmpty())
+                _guiPlacement = _hasThreadPolicy ? ThreadPlacer::apply("gui", _threadPolicy.gui)
+                                                 : ThreadPlacer::current("gui");
+        }
 
     }
     _mainWindow.setOpenDevState((_device != nullptr) ? _device->isOpenDevice() : false);
+
+    if(++_statsCounter >= STATS_PERIOD)
+    {
+        _statsCounter = 0;
+        printStats();
+    }
 }
 
 
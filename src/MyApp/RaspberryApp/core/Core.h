@@ -5,11 +5,14 @@
 #include <QTimer>
 
 #include "ui/Mainwindow.h"
+#include "interface/INetworkWorker.h"
+#include "pipeline/ThreadPolicy.h"
 
 class IDataController;
 class IPoolObject;
 class IReciverDevice;
 class IDemodulator;
+class ITrackArchive;
 class ILogger;
 class INetworkWorker;
 
@@ -20,6 +23,11 @@ class Core : public QObject
     int sizeLog = 1000;
 
     const uint32_t TIMEOUT = 1000;
+    ///< период сохранения состояния демодулятора, мс
+    const int64_t STATE_SAVE_PERIOD = 30000;
+    ///< период вывода счетчиков конвейера и размещения потоков, периодов таймера
+    const int32_t STATS_PERIOD = 60;
+    int32_t _statsCounter = 0;
     QTimer _timer;
     MainWindow _mainWindow;
 
@@ -27,14 +35,49 @@ class Core : public QObject
     QSharedPointer<IDataController> _dataController = nullptr;
     QSharedPointer<IReciverDevice> _device = nullptr;
     QSharedPointer<IDemodulator> _demodulator = nullptr;
+    QSharedPointer<ITrackArchive> _trackArchive = nullptr;
     QSharedPointer<ILogger> _logger = nullptr;
 
+    ///< размещение потоков
+    ThreadPolicy _threadPolicy;
+    bool _hasThreadPolicy = false;
+    ///< фактическое размещение основного потока
+    PlacementReport _guiPlacement;
+
+    /*!
+     * \brief printStats вывод счетчиков стадий, размещения потоков
+     * и контроля перегрузки
+     */
+    void printStats();
+
 public:
     explicit Core(QObject *parent = nullptr);
     ~Core();
 
     void init();
-    void init(const QString& ip , uint16_t port);
+    void init(const QString& ip , uint16_t port,
+              NET_PROTOCOL protocol = NET_PROTOCOL::RAW_DUMP);
+    /*!
+     * \brief setMulticast рассылка данных в группу UDP multicast
+     * для локальных получателей, вызывается после init
+     */
+    void setMulticast(const QString& group, uint16_t port);
+    /*!
+     * \brief setThreadPolicy размещение потоков по INI файлу (ThreadPolicy),
+     * вызывается после init. Основной поток размещается после запуска
+     * потока обработки, чтобы тот не унаследовал размещение GUI
+     */
+    void setThreadPolicy(const QString& fileName);
+    /*!
+     * \brief setAggressive агрессивный режим обнаружения сообщений.
+     * При перегрузке его дорогие алгоритмы отключаются первыми
+     */
+    void setAggressive(bool state);
+    /*!
+     * \brief setArchiveRetention срок хранения архива траекторий
+     * \param hours - срок хранения, ч; 0 - без ограничения
+     */
+    void setArchiveRetention(int hours);
 signals:
 
 public slots:
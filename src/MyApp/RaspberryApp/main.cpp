@@ -4,6 +4,7 @@
 #include <signal.h>
 #include "core/Core.h"
 #include "ui/Mainwindow.h"
+#include "protocol/MulticastProtocol.h"
 
 int main(int argc, char *argv[])
 {
@@ -26,6 +27,39 @@ int main(int argc, char *argv[])
                                  QCoreApplication::translate("main",
                                                              "port to connect to the server"));
 
+    QCommandLineOption deltaOption(QStringList() << "d" << "delta",
+                                   QCoreApplication::translate("main",
+                                                               "send only changes since the previous message"));
+    parser.addOption(deltaOption);
+
+    QCommandLineOption framedOption(QStringList() << "f" << "framed",
+                                    QCoreApplication::translate("main",
+                                                                "send framed batches with sync word and CRC"));
+    parser.addOption(framedOption);
+
+    QCommandLineOption multicastOption(QStringList() << "m" << "multicast",
+                                       QCoreApplication::translate("main",
+                                                                   "also publish updates to UDP multicast <group[:port]>"),
+                                       QCoreApplication::translate("main", "group[:port]"));
+    parser.addOption(multicastOption);
+
+    QCommandLineOption threadsOption(QStringList() << "t" << "threads",
+                                     QCoreApplication::translate("main",
+                                                                 "place receiver, pipeline and GUI threads by INI <file>"),
+                                     QCoreApplication::translate("main", "file"));
+    parser.addOption(threadsOption);
+
+    QCommandLineOption aggressiveOption(QStringList() << "a" << "aggressive",
+                                        QCoreApplication::translate("main",
+                                                                    "aggressive detection: accept two demodulation errors, fix two-bit errors"));
+    parser.addOption(aggressiveOption);
+
+    QCommandLineOption retentionOption(QStringList() << "H" << "archive-hours",
+                                       QCoreApplication::translate("main",
+                                                                   "keep the track archive for <hours>, 0 - forever (default 72)"),
+                                       QCoreApplication::translate("main", "hours"));
+    parser.addOption(retentionOption);
+
     parser.process(a);
 
     //TODO: добавить проверку на наличие всех параметров командной строки
@@ -35,15 +69,37 @@ int main(int argc, char *argv[])
     uint16_t port = 0;
 
     Core core;
+    core.setAggressive(parser.isSet(aggressiveOption));
+    if(parser.isSet(retentionOption))
+        core.setArchiveRetention(parser.value(retentionOption).toInt());
     if(!args.isEmpty() && args.size() >= 2)
     {
         strIp = args.at(0);
         port = args.at(1).toUShort();
         qDebug()<<strIp<<port;
-        core.init(strIp,port);
+        NET_PROTOCOL protocol = NET_PROTOCOL::RAW_DUMP;
+        if(parser.isSet(deltaOption))
+            protocol = NET_PROTOCOL::DELTA;
+        else if(parser.isSet(framedOption))
+            protocol = NET_PROTOCOL::FRAMED;
+        core.init(strIp, port, protocol);
+
+        if(parser.isSet(multicastOption))
+        {
+            QStringList group = parser.value(multicastOption).split(':');
+            uint16_t groupPort = MCAST_DEFAULT_PORT;
+            if(group.size() > 1)
+                groupPort = group.at(1).toUShort();
+            core.setMulticast(group.at(0).isEmpty() ? QString(MCAST_DEFAULT_GROUP)
+                                                    : group.at(0),
+                              groupPort);
+        }
     }
     else
         core.init();
 
+    if(parser.isSet(threadsOption))
+        core.setThreadPolicy(parser.value(threadsOption));
+
     return a.exec();
 }
@@ -0,0 +1,49 @@
+#-------------------------------------------------
+#
+# Приемный пункт без графического интерфейса
+#
+#-------------------------------------------------
+
+# QtGui нужен только ради QVector2D/QVector3D в coord/Position.h,
+# QtWidgets и графическая платформа не используются
+QT       += core gui network
+
+TARGET = RaspberryDaemon
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+CONFIG += c++11
+
+include( ../../../common.pri )
+include( ../../../app.pri )
+
+DISTFILES += \
+    ../../../import/raspberry_daemon.ini \
+    ../../../import/threads_rpi4.ini
+
+LIBS += -lLogger \
+        -lPoolObject \
+        -lTrackArchive \
+        -lCarrier \
+        -lDataController \
+        -lRTL_SDR_Reciver \
+        -lDemodulator
+
+SOURCES += \
+        main.cpp \
+    core/Core.cpp \
+    core/DaemonConfig.cpp \
+    core/DaemonLog.cpp \
+    core/SignalHandler.cpp
+
+HEADERS += \
+    ../../include/interface/INetworkWorker.h \
+    ../../include/protocol/MulticastProtocol.h \
+    core/Core.h \
+    core/DaemonConfig.h \
+    core/DaemonLog.h \
+    core/SignalHandler.h
@@ -0,0 +1,235 @@
+#include <QDebug>
+#include <QFile>
+#include <QStringList>
+#include "Core.h"
+#include "DaemonLog.h"
+
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/PoolObject.h"
+#include "../MyLib/RTL_SDR_RadarLib/Logger/Logger.h"
+#include "../MyLib/RTL_SDR_RadarLib/Carrier/Carrier.h"
+#include "../MyLib/RTL_SDR_RadarLib/Carrier/ServiceLocator.h"
+#include "../MyLib/RTL_SDR_RadarLib/DataController/DataController.h"
+#include "../MyLib/RTL_SDR_RadarLib/RTL_SDR_Reciver/RTL_SDR_Reciver.h"
+#include "../MyLib/RTL_SDR_RadarLib/Demodulator/Demodulator.h"
+#include "../MyLib/RTL_SDR_RadarLib/TrackArchive/TrackArchive.h"
+
+Core::Core(const DaemonConfig &config, QObject *parent) : QObject(parent),
+    _config(config)
+{
+    _logger = QSharedPointer<ILogger>(new Logger(sizeLog));
+
+    ServiceLocator::provide(QSharedPointer<ICarrierClass>( new NullCarrier()) );
+
+    _device = QSharedPointer<IReciverDevice>(new RTL_SDR_Reciver());
+    _device->setLogger(_logger);
+
+    //пулл объектов для хранения объектов типа самолет
+    _poolObjects = QSharedPointer<IPoolObject>(new PoolObject(OBJECT_TYPE::air));
+
+    //демодулятор входного сигнала
+    _demodulator = QSharedPointer<IDemodulator>(new Demodulator(_poolObjects));
+    _demodulator->setLogger(_logger);
+    _demodulator->setAggressive(_config.aggressive);
+
+    //архив траекторий
+    _trackArchive = QSharedPointer<ITrackArchive>(new TrackArchive(_config.archiveDir));
+    _trackArchive->setRetention(_config.archiveRetention);
+    _demodulator->setTrackArchive(_trackArchive);
+    //восстановление состояния после перезапуска
+    _demodulator->loadState(_config.stateFile);
+
+    QObject::connect(&_timer,SIGNAL(timeout()),this,SLOT(slotTimeout()));
+}
+
+Core::~Core()
+{
+    _timer.stop();
+    //остановка конвейера сохраняет состояние демодулятора
+    if(!_dataController.isNull())
+        _dataController->stop();
+    drainLog();
+
+    _poolObjects.clear();
+    _dataController.clear();
+    _demodulator.clear();
+    _trackArchive.clear();
+    _device->closeDevice();
+    _device.clear();
+    _logger.clear();
+}
+
+void Core::init()
+{
+    if(_config.ip.isEmpty())
+        _dataController = QSharedPointer<IDataController>(new DataController(_device,
+                                                                             _demodulator));
+    else
+    {
+        _dataController = QSharedPointer<IDataController>(new DataController(_device,
+                                                                             _demodulator,
+                                                                             _config.ip,
+                                                                             _config.port));
+        _dataController->setNetProtocol(_config.protocol);
+    }
+    _dataController->setStateFile(_config.stateFile, STATE_SAVE_PERIOD);
+
+    if(!_config.multicastGroup.isEmpty())
+        _dataController->setMulticast(_config.multicastGroup, _config.multicastPort);
+
+    if(!_config.threadPolicy.isEmpty())
+    {
+        _hasThreadPolicy = ThreadPolicy::load(_config.threadPolicy, _threadPolicy);
+        if(_hasThreadPolicy)
+            _dataController->setThreadPolicy(_threadPolicy);
+        else
+            qWarning()<<"thread policy is not applied"<<_config.threadPolicy;
+    }
+
+    _timer.start(TIMEOUT);
+}
+
+int64_t Core::residentMemory(int64_t *peak)
+{
+    int64_t rss = -1;
+    if(peak)
+        *peak = -1;
+
+    QFile file("/proc/self/status");
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return rss;
+
+    //строки вида "VmRSS:     12345 kB"
+    for(const QByteArray& line : file.readAll().split('\n'))
+    {
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        if(fields.size() < 2)
+            continue;
+
+        if(fields.at(0) == "VmRSS:")
+            rss = fields.at(1).toLongLong();
+        else if(peak && fields.at(0) == "VmHWM:")
+            *peak = fields.at(1).toLongLong();
+    }
+    return rss;
+}
+
+void Core::drainLog()
+{
+    if(_logger.isNull() || _logger->isEmpty())
+        return;
+
+    //Logger - стек, сообщения извлекаются от последнего к первому
+    QStringList messages;
+    while(!_logger->isEmpty())
+        messages.prepend(_logger->pop());
+
+    for(const QString& message : messages)
+        qInfo().noquote()<<message;
+}
+
+void Core::printPlacement()
+{
+    if(_dataController.isNull())
+        return;
+
+    QVector<PlacementReport> threads = _dataController->threadPlacement();
+    if(!_mainPlacement.name.isEmpty())
+        threads.append(_mainPlacement);
+
+    for(const PlacementReport& report : threads)
+    {
+        QStringList cpus;
+        for(int cpu : report.cpus)
+            cpus.append(QString::number(cpu));
+
+        QString line = QString("thread %1 tid %2 cpus %3 sched %4 nice %5")
+                .arg(report.name)
+                .arg(report.tid)
+                .arg(cpus.join(','))
+                .arg(report.scheduling == SCHED_CLASS::FIFO
+                     ? QString("fifo:%1").arg(report.priority)
+                     : QString("normal"))
+                .arg(report.nice);
+        if(report.fallback)
+            line += " fallback: " + report.errors.join("; ");
+
+        DaemonLog::status(line);
+    }
+}
+
+void Core::printStatus()
+{
+    int64_t peak = 0;
+    const int64_t rss = residentMemory(&peak);
+
+    DaemonLog::status(QString("device %1 aircraft %2 rss %3 kB peak %4 kB")
+                      .arg(_device->isOpenDevice() ? "open" : "closed")
+                      .arg(_poolObjects->getObjectsCount())
+                      .arg(rss)
+                      .arg(peak));
+
+    if(_dataController.isNull())
+        return;
+
+    for(const StageStats& stats : _dataController->stageStats())
+        DaemonLog::status(QString("stage %1 processed %2 dropped %3 latency us p99 %4"
+                                  " wakeup us p50 %5 p99 %6 max %7")
+                          .arg(stats.name)
+                          .arg(stats.processed)
+                          .arg(stats.dropped)
+                          .arg(stats.latency.p99)
+                          .arg(stats.wakeup.p50)
+                          .arg(stats.wakeup.p99)
+                          .arg(stats.wakeup.max));
+
+    const OverloadStats overload = _dataController->overloadStats();
+    DaemonLog::status(QString("overload level %1 lag us %2 backlog us %3 max %4"
+                              " drop ratio %5 degradations %6 recoveries %7")
+                      .arg(OverloadGovernor::levelName(overload.level))
+                      .arg(overload.lagUs)
+                      .arg(overload.backlogUs)
+                      .arg(overload.maxBacklogUs)
+                      .arg(overload.dropRatio)
+                      .arg(overload.degradations)
+                      .arg(overload.recoveries));
+}
+
+void Core::slotTimeout()
+{
+    if(_device && !_device->isOpenDevice())
+    {
+        if(_device->openDevice())
+        {
+            _dataController->run();
+            //основной поток размещается один раз, после создания
+            //потока обработки: новые потоки наследуют размещение
+            if(_mainPlacement.name.isEmpty())
+                _mainPlacement = _hasThreadPolicy ? ThreadPlacer::apply("main", _threadPolicy.gui)
+                                                  : ThreadPlacer::current("main");
+        }
+    }
+
+    drainLog();
+
+    if(++_statusCounter >= _config.statusPeriod)
+    {
+        _statusCounter = 0;
+        //размещение потоков известно после первого периода работы
+        if(!_placementPrinted && !_mainPlacement.name.isEmpty())
+        {
+            _placementPrinted = true;
+            printPlacement();
+        }
+        printStatus();
+    }
+}
+
+void Core::slotHangup()
+{
+    if(!_config.logFile.isEmpty() && !DaemonLog::reopen())
+        qWarning()<<"log file is not reopened";
+    qInfo()<<"SIGHUP";
+
+    printPlacement();
+    printStatus();
+}
@@ -0,0 +1,97 @@
+#ifndef CORE_H
+#define CORE_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include "DaemonConfig.h"
+#include "pipeline/ThreadPolicy.h"
+
+class IDataController;
+class IPoolObject;
+class IReciverDevice;
+class IDemodulator;
+class ITrackArchive;
+class ILogger;
+
+/*!
+ * \brief The Core class
+ * Ядро приемного пункта без графического интерфейса: приемник,
+ * демодулятор и конвейер обработки те же, что у RaspberryApp,
+ * журнал Logger выводится в DaemonLog, состояние - периодически
+ * в стандартный вывод
+ * \author Данильченко Артем
+ */
+class Core : public QObject
+{
+    Q_OBJECT
+    int sizeLog = 1000;
+
+    const uint32_t TIMEOUT = 1000;
+    ///< период сохранения состояния демодулятора, мс
+    const int64_t STATE_SAVE_PERIOD = 30000;
+    int32_t _statusCounter = 0;
+    bool _placementPrinted = false;
+    QTimer _timer;
+    DaemonConfig _config;
+
+    QSharedPointer<IPoolObject> _poolObjects = nullptr;
+    QSharedPointer<IDataController> _dataController = nullptr;
+    QSharedPointer<IReciverDevice> _device = nullptr;
+    QSharedPointer<IDemodulator> _demodulator = nullptr;
+    QSharedPointer<ITrackArchive> _trackArchive = nullptr;
+    QSharedPointer<ILogger> _logger = nullptr;
+
+    ///< размещение потоков
+    ThreadPolicy _threadPolicy;
+    bool _hasThreadPolicy = false;
+    ///< фактическое размещение основного потока
+    PlacementReport _mainPlacement;
+
+    /*!
+     * \brief drainLog перенос сообщений Logger в журнал в порядке поступления
+     */
+    void drainLog();
+    /*!
+     * \brief printPlacement вывод размещения потоков
+     */
+    void printPlacement();
+
+public:
+    /*!
+     * \brief Core
+     * \param config - параметры, пути файлов состояния и архива
+     * должны быть заданы
+     */
+    explicit Core(const DaemonConfig& config, QObject *parent = nullptr);
+    ~Core();
+
+    /*!
+     * \brief init создание конвейера обработки и запуск таймера
+     * открытия приемника
+     */
+    void init();
+
+    /*!
+     * \brief printStatus вывод состояния: приемник, число объектов,
+     * счетчики стадий, уровень перегрузки и занимаемая память
+     */
+    void printStatus();
+
+    /*!
+     * \brief residentMemory занимаемая процессом память из /proc/self/status
+     * \param peak - максимальное значение за время работы, кБ
+     * \return текущее значение, кБ; -1 - недоступно
+     */
+    static int64_t residentMemory(int64_t* peak = nullptr);
+
+public slots:
+    void slotTimeout();
+    /*!
+     * \brief slotHangup SIGHUP: повторное открытие журнала и вывод состояния
+     */
+    void slotHangup();
+};
+
+#endif // CORE_H
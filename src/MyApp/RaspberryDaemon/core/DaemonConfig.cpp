@@ -0,0 +1,92 @@
+#include "DaemonConfig.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+
+namespace
+{
+///< путь относительно каталога файла параметров
+QString resolvePath(const QDir& dir, const QString& path)
+{
+    if(path.isEmpty())
+        return path;
+    return QDir::cleanPath(dir.absoluteFilePath(path));
+}
+}
+
+NET_PROTOCOL DaemonConfig::parseProtocol(const QString &name, bool *ok)
+{
+    *ok = true;
+    const QString value = name.trimmed().toLower();
+    if(value == "raw")
+        return NET_PROTOCOL::RAW_DUMP;
+    if(value == "delta")
+        return NET_PROTOCOL::DELTA;
+    if(value == "framed")
+        return NET_PROTOCOL::FRAMED;
+
+    *ok = false;
+    return NET_PROTOCOL::RAW_DUMP;
+}
+
+bool DaemonConfig::load(const QString &fileName, DaemonConfig &config)
+{
+    if(!QFile::exists(fileName))
+    {
+        qDebug()<<"config file not found"<<fileName;
+        return false;
+    }
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    if(settings.status() != QSettings::NoError)
+    {
+        qDebug()<<"config file format error"<<fileName;
+        return false;
+    }
+
+    const QDir dir = QFileInfo(fileName).absoluteDir();
+    bool result = true;
+
+    config.ip = settings.value("server/ip", config.ip).toString().trimmed();
+    config.port = uint16_t(settings.value("server/port", config.port).toUInt());
+    if(settings.contains("server/protocol"))
+    {
+        bool ok = false;
+        config.protocol = parseProtocol(settings.value("server/protocol").toString(), &ok);
+        if(!ok)
+        {
+            qDebug()<<"unknown protocol"<<settings.value("server/protocol").toString();
+            result = false;
+        }
+    }
+    if(!config.ip.isEmpty() && config.port == 0)
+    {
+        qDebug()<<"server port is not set";
+        result = false;
+    }
+
+    config.multicastGroup = settings.value("multicast/group", config.multicastGroup)
+            .toString().trimmed();
+    config.multicastPort = uint16_t(settings.value("multicast/port", config.multicastPort)
+                                    .toUInt());
+
+    config.aggressive = settings.value("receiver/aggressive", config.aggressive).toBool();
+
+    config.threadPolicy = resolvePath(dir, settings.value("daemon/thread_policy",
+                                                          config.threadPolicy).toString());
+    config.stateFile = resolvePath(dir, settings.value("daemon/state_file",
+                                                       config.stateFile).toString());
+    config.archiveDir = resolvePath(dir, settings.value("daemon/archive_dir",
+                                                        config.archiveDir).toString());
+    config.archiveRetention = qMax(0, settings.value("daemon/archive_retention",
+                                                     config.archiveRetention).toInt());
+    config.logFile = resolvePath(dir, settings.value("daemon/log_file",
+                                                     config.logFile).toString());
+    config.statusPeriod = qMax(1, settings.value("daemon/status_period",
+                                                 config.statusPeriod).toInt());
+
+    return result;
+}
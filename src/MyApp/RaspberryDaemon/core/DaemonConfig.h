@@ -0,0 +1,74 @@
+#ifndef DAEMONCONFIG_H
+#define DAEMONCONFIG_H
+
+#include <QString>
+
+#include "interface/INetworkWorker.h"
+#include "interface/ITrackArchive.h"
+#include "protocol/MulticastProtocol.h"
+
+/*!
+ * \brief The DaemonConfig class
+ * Параметры приемного пункта без графического интерфейса.
+ * Файл параметров - INI:
+ * \code
+ * [server]
+ * ip=192.168.1.10
+ * port=62000
+ * protocol=framed
+ * [multicast]
+ * group=239.255.77.1
+ * port=30100
+ * [receiver]
+ * aggressive=false
+ * [daemon]
+ * state_file=radar_state.bin
+ * archive_dir=archive
+ * archive_retention=72
+ * log_file=raspberry_daemon.log
+ * status_period=60
+ * thread_policy=threads_rpi4.ini
+ * \endcode
+ * protocol - raw, delta или framed. Пустой ip - данные на сервер
+ * не передаются. archive_retention - срок хранения архива, ч,
+ * 0 - без ограничения. Относительные пути отсчитываются от каталога
+ * файла параметров
+ * \author Данильченко Артем
+ */
+class DaemonConfig
+{
+    static NET_PROTOCOL parseProtocol(const QString& name, bool* ok);
+
+public:
+    ///< сервер сбора данных
+    QString ip;
+    uint16_t port = 0;
+    NET_PROTOCOL protocol = NET_PROTOCOL::RAW_DUMP;
+    ///< рассылка в группу UDP multicast, пустая группа - рассылка выключена
+    QString multicastGroup;
+    uint16_t multicastPort = MCAST_DEFAULT_PORT;
+    ///< агрессивный режим обнаружения
+    bool aggressive = false;
+    ///< файл размещения потоков (ThreadPolicy), пустая строка - не размещаются
+    QString threadPolicy;
+    ///< файл состояния демодулятора и каталог архива траекторий
+    QString stateFile;
+    QString archiveDir;
+    ///< срок хранения архива траекторий, ч; 0 - без ограничения
+    int archiveRetention = ARCHIVE_DEFAULT_RETENTION;
+    ///< журнал, пустая строка - только стандартный вывод
+    QString logFile;
+    ///< период вывода состояния, с
+    int statusPeriod = 60;
+
+    /*!
+     * \brief load чтение параметров из файла. Отсутствующие
+     * параметры сохраняют текущие значения
+     * \param fileName - имя INI файла
+     * \param config - результат
+     * \return false - файл не найден или содержит ошибки
+     */
+    static bool load(const QString& fileName, DaemonConfig& config);
+};
+
+#endif // DAEMONCONFIG_H
@@ -0,0 +1,111 @@
+#include "DaemonLog.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QMutex>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace
+{
+QMutex logMutex;
+QFile logFile;
+QString logFileName;
+
+QString timestamp()
+{
+    return QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd'T'HH:mm:ss.zzz'Z'");
+}
+
+///< запись строки в файл журнала, вызывается под logMutex
+bool writeFile(const QString& line)
+{
+    if(!logFile.isOpen())
+        return false;
+
+    logFile.write(line.toUtf8());
+    logFile.write("\n");
+    logFile.flush();
+    return true;
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext&, const QString& message)
+{
+    const char* level = "debug";
+    switch(type)
+    {
+    case QtDebugMsg:
+        level = "debug";
+        break;
+    case QtInfoMsg:
+        level = "info";
+        break;
+    case QtWarningMsg:
+        level = "warning";
+        break;
+    case QtCriticalMsg:
+        level = "critical";
+        break;
+    case QtFatalMsg:
+        level = "fatal";
+        break;
+    }
+
+    const QString line = QString("%1 [%2] %3").arg(timestamp()).arg(level).arg(message);
+
+    QMutexLocker lock(&logMutex);
+    if(!writeFile(line))
+    {
+        fprintf(stderr, "%s\n", line.toLocal8Bit().constData());
+        fflush(stderr);
+    }
+
+    if(type == QtFatalMsg)
+        abort();
+}
+}
+
+bool DaemonLog::open(const QString &fileName)
+{
+    QMutexLocker lock(&logMutex);
+    if(logFile.isOpen())
+        logFile.close();
+
+    logFileName = fileName;
+    if(logFileName.isEmpty())
+        return false;
+
+    logFile.setFileName(logFileName);
+    return logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+}
+
+bool DaemonLog::reopen()
+{
+    QString fileName;
+    {
+        QMutexLocker lock(&logMutex);
+        fileName = logFileName;
+    }
+    return open(fileName);
+}
+
+void DaemonLog::close()
+{
+    QMutexLocker lock(&logMutex);
+    logFile.close();
+}
+
+void DaemonLog::status(const QString &text)
+{
+    const QString line = QString("%1 [status] %2").arg(timestamp()).arg(text);
+
+    QMutexLocker lock(&logMutex);
+    fprintf(stdout, "%s\n", line.toLocal8Bit().constData());
+    fflush(stdout);
+    writeFile(line);
+}
+
+void DaemonLog::installMessageHandler()
+{
+    qInstallMessageHandler(messageHandler);
+}
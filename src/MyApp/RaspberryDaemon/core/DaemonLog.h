@@ -0,0 +1,42 @@
+#ifndef DAEMONLOG_H
+#define DAEMONLOG_H
+
+#include <QString>
+
+/*!
+ * \brief The DaemonLog class
+ * Журнал приемного пункта без графического интерфейса.
+ * Строки состояния выводятся в стандартный вывод и в файл журнала,
+ * сообщения qDebug/qWarning - в файл журнала, а без него - в stderr.
+ * Запись допускается из любого потока. reopen по SIGHUP позволяет
+ * logrotate переименовать файл без остановки программы
+ * \author Данильченко Артем
+ */
+class DaemonLog
+{
+public:
+    /*!
+     * \brief open открытие файла журнала на дозапись
+     * \param fileName - имя файла, пустая строка - журнал не ведется
+     * \return false - файл не открыт
+     */
+    static bool open(const QString& fileName);
+    /*!
+     * \brief reopen повторное открытие файла журнала
+     */
+    static bool reopen();
+    /*!
+     * \brief close закрытие файла журнала
+     */
+    static void close();
+    /*!
+     * \brief status строка состояния: стандартный вывод и файл журнала
+     */
+    static void status(const QString& text);
+    /*!
+     * \brief installMessageHandler перенаправление qDebug в журнал
+     */
+    static void installMessageHandler();
+};
+
+#endif // DAEMONLOG_H
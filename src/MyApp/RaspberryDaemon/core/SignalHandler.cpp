@@ -0,0 +1,83 @@
+#include "SignalHandler.h"
+
+#include <QDebug>
+#include <QSocketNotifier>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+int SignalHandler::_fds[2] = { -1, -1 };
+
+SignalHandler::SignalHandler(QObject *parent) : QObject(parent)
+{
+    if(::socketpair(AF_UNIX, SOCK_STREAM, 0, _fds) != 0)
+    {
+        qDebug()<<"signal handler: socketpair failed"<<strerror(errno);
+        return;
+    }
+    //обработчик сигнала не должен блокироваться на заполненном сокете
+    ::fcntl(_fds[0], F_SETFL, ::fcntl(_fds[0], F_GETFL) | O_NONBLOCK);
+
+    _notifier = new QSocketNotifier(_fds[1], QSocketNotifier::Read, this);
+    connect(_notifier, &QSocketNotifier::activated,
+            this, &SignalHandler::slotActivated);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = SignalHandler::handle;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+    ::sigaction(SIGHUP, &action, nullptr);
+
+    ::signal(SIGPIPE, SIG_IGN);
+}
+
+SignalHandler::~SignalHandler()
+{
+    ::signal(SIGINT, SIG_DFL);
+    ::signal(SIGTERM, SIG_DFL);
+    ::signal(SIGHUP, SIG_DFL);
+
+    delete _notifier;
+    _notifier = nullptr;
+
+    for(int& fd : _fds)
+    {
+        if(fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+}
+
+void SignalHandler::handle(int signal)
+{
+    //в обработчике сигнала допустимы только async-signal-safe вызовы
+    const int saved = errno;
+    const char number = char(signal);
+    ssize_t result = ::write(_fds[0], &number, sizeof(number));
+    Q_UNUSED(result);
+    errno = saved;
+}
+
+void SignalHandler::slotActivated()
+{
+    _notifier->setEnabled(false);
+
+    char number = 0;
+    const ssize_t size = ::read(_fds[1], &number, sizeof(number));
+    if(size == sizeof(number))
+    {
+        if(number == SIGHUP)
+            emit hangup();
+        else
+            emit terminate();
+    }
+
+    _notifier->setEnabled(true);
+}
@@ -0,0 +1,51 @@
+#ifndef SIGNALHANDLER_H
+#define SIGNALHANDLER_H
+
+#include <QObject>
+
+class QSocketNotifier;
+
+/*!
+ * \brief The SignalHandler class
+ * Обработка сигналов Unix в цикле событий Qt. Обработчик сигнала
+ * только записывает номер сигнала в пару сокетов, чтение выполняется
+ * QSocketNotifier в основном потоке - в нем допустимы любые вызовы Qt.
+ * SIGINT и SIGTERM - завершение работы, SIGHUP - повторное открытие
+ * журнала и вывод состояния. SIGPIPE игнорируется.
+ * Создается один экземпляр на процесс
+ * \author Данильченко Артем
+ */
+class SignalHandler : public QObject
+{
+    Q_OBJECT
+
+    ///< пара сокетов: [0] - запись в обработчике сигнала, [1] - чтение
+    static int _fds[2];
+    QSocketNotifier* _notifier = nullptr;
+
+    static void handle(int signal);
+
+public:
+    explicit SignalHandler(QObject* parent = nullptr);
+    ~SignalHandler() override;
+
+    /*!
+     * \brief isValid обработчики установлены
+     */
+    bool isValid() const { return _notifier != nullptr; }
+
+signals:
+    /*!
+     * \brief terminate получен SIGINT или SIGTERM
+     */
+    void terminate();
+    /*!
+     * \brief hangup получен SIGHUP
+     */
+    void hangup();
+
+private slots:
+    void slotActivated();
+};
+
+#endif // SIGNALHANDLER_H
@@ -0,0 +1,87 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include "core/Core.h"
+#include "core/DaemonConfig.h"
+#include "core/DaemonLog.h"
+#include "core/SignalHandler.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    // парсер аргументов командной строки
+    QCoreApplication::setApplicationName("RaspberryDaemon");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QCoreApplication::translate("main",
+                                                                 "RaspberryDaemon"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    parser.addPositionalArgument("ip",
+                                 QCoreApplication::translate("main",
+                                                             "IP-address to connect to the server, overrides the config file"));
+    parser.addPositionalArgument("port",
+                                 QCoreApplication::translate("main",
+                                                             "port to connect to the server, overrides the config file"));
+
+    QCommandLineOption configOption(QStringList() << "c" << "config",
+                                    QCoreApplication::translate("main",
+                                                                "read settings from INI <file>"),
+                                    QCoreApplication::translate("main", "file"));
+    parser.addOption(configOption);
+
+    parser.process(a);
+
+    DaemonLog::installMessageHandler();
+
+    //пути по умолчанию совпадают с RaspberryApp
+    DaemonConfig config;
+    config.stateFile = QCoreApplication::applicationDirPath() + "/radar_state.bin";
+    config.archiveDir = QCoreApplication::applicationDirPath() + "/archive";
+
+    if(parser.isSet(configOption) && !DaemonConfig::load(parser.value(configOption), config))
+    {
+        qCritical()<<"config file is not loaded"<<parser.value(configOption);
+        return 1;
+    }
+
+    const QStringList args = parser.positionalArguments();
+    if(args.size() >= 2)
+    {
+        config.ip = args.at(0);
+        config.port = args.at(1).toUShort();
+    }
+
+    if(!config.logFile.isEmpty() && !DaemonLog::open(config.logFile))
+        qWarning()<<"log file is not opened"<<config.logFile;
+
+    SignalHandler signalHandler;
+    if(!signalHandler.isValid())
+        return 1;
+
+    Core core(config);
+    QObject::connect(&signalHandler, &SignalHandler::terminate,
+                     &a, &QCoreApplication::quit);
+    QObject::connect(&signalHandler, &SignalHandler::hangup,
+                     &core, &Core::slotHangup);
+
+    int64_t peak = 0;
+    const int64_t rss = Core::residentMemory(&peak);
+    DaemonLog::status(QString("started pid %1 server %2 rss %3 kB peak %4 kB")
+                      .arg(QCoreApplication::applicationPid())
+                      .arg(config.ip.isEmpty() ? QString("none")
+                                               : QString("%1:%2").arg(config.ip).arg(config.port))
+                      .arg(rss)
+                      .arg(peak));
+
+    core.init();
+
+    const int result = a.exec();
+
+    DaemonLog::status("stopped");
+    return result;
+}
@@ -0,0 +1,33 @@
+#-------------------------------------------------
+#
+# Цифровая обработка сигнала: спектр и водопад
+#
+#-------------------------------------------------
+
+QT       += core
+
+TARGET = DSP
+TEMPLATE = lib
+
+DEFINES += DSP_LIBRARY
+
+SOURCES += SpectrumEngine.cpp
+
+HEADERS += SpectrumEngine.h \
+        dsp_global.h \
+    ../../../include/dsp/IDSP.h \
+    ../../../include/dsp/SrcDataAdc.h \
+    ../../../include/dsp/SpectrumFrame.h \
+    ../../../include/pipeline/PipelineStage.h \
+    ../../../include/pipeline/MpmcQueue.h
+
+LIBS += -lfftw3f
+
+unix {
+    target.path = /usr/lib
+    INSTALLS += target
+}
+
+
+include( ../../../../common.pri )
+include( ../../../../lib.pri )
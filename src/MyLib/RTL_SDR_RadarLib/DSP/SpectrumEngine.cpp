@@ -0,0 +1,268 @@
+#include "SpectrumEngine.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+namespace
+{
+///< нулевой уровень 8-битного АЦП rtl-sdr
+constexpr float ADC_OFFSET = 127.5f;
+///< ограничение снизу мощности перед логарифмированием
+constexpr float POWER_FLOOR = 1e-20f;
+///< буферов блоков для потока ЦОС: два в очереди и один в расчете
+constexpr int SPECTRUM_BLOCKS = 3;
+///< makeAll вызывается потоками выдачи конвейера приема, которых может
+///< быть несколько: производителей больше одного, очередь - MpmcQueue
+constexpr int SPECTRUM_PRODUCERS = 2;
+
+/*!
+ * \brief plannerMutex планировщик FFTW не допускает параллельных вызовов,
+ * выполнение готового плана - допускает
+ */
+QMutex& plannerMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+SpectrumConfig checkedConfig(SpectrumConfig config)
+{
+    config.fftSize = qMax(16, config.fftSize);
+    config.decimation = qMax(1, config.decimation);
+    config.averages = qMax(1, config.averages);
+    config.blockStride = qMax(1, config.blockStride);
+    config.waterfallRows = qMax(1, config.waterfallRows);
+    return config;
+}
+}
+
+SpectrumEngine::SpectrumEngine(const SpectrumConfig &config) :
+    _config(checkedConfig(config)),
+    _freeBlocks(SPECTRUM_BLOCKS),
+    _blockCounter(0)
+{
+    const int n = _config.fftSize;
+    _rowBytes = n * _config.decimation * _config.averages * 2;
+
+    //окно Хэннинга; тон полной шкалы после нормировки дает 0 дБ
+    _window.resize(n);
+    double sum = 0.0;
+    for(int i = 0; i < n; i++)
+    {
+        _window[i] = float(0.5 - 0.5 * cos(2.0 * M_PI * i / (n - 1)));
+        sum += double(_window[i]);
+    }
+    _powerScale = float(1.0 / (sum * sum * _config.averages));
+
+    _power.resize(n);
+    _row.resize(n);
+
+    const float floorDb = 10.0f * log10f(POWER_FLOOR);
+    _spectrum.fill(floorDb, n);
+    _waterfall.fill(floorDb, n * _config.waterfallRows);
+
+    {
+        QMutexLocker lock(&plannerMutex());
+        _in = fftwf_alloc_complex(size_t(n));
+        _out = fftwf_alloc_complex(size_t(n));
+        _plan = fftwf_plan_dft_1d(n, _in, _out, FFTW_FORWARD, FFTW_ESTIMATE);
+
+        _syncIn = fftwf_alloc_complex(size_t(n));
+        _syncOut = fftwf_alloc_complex(size_t(n));
+        _syncPlan = fftwf_plan_dft_1d(n, _syncIn, _syncOut, FFTW_FORWARD, FFTW_ESTIMATE);
+    }
+
+    for(int i = 0; i < SPECTRUM_BLOCKS; i++)
+    {
+        std::unique_ptr<SpectrumBlock> block(new SpectrumBlock());
+        block->samples.resize(_rowBytes);
+
+        SpectrumBlock* ptr = block.get();
+        _freeBlocks.tryPush(ptr);
+        _blocks.push_back(std::move(block));
+    }
+
+    //единственный поток ЦОС, при занятом потоке блоки отбрасываются
+    _stage.reset(new PipelineStage<SpectrumBlock*>(
+                     "spectrum",
+                     StageConfig(1, SPECTRUM_BLOCKS - 1, OVERFLOW_POLICY::DROP),
+                     SPECTRUM_PRODUCERS,
+                     [this](SpectrumBlock*& block)
+    {
+        process(block);
+        return true;
+    }));
+    _stage->setRelease([this](SpectrumBlock*& block) { release(block); });
+    _stage->start();
+}
+
+SpectrumEngine::~SpectrumEngine()
+{
+    _stage->stop();
+
+    QMutexLocker lock(&plannerMutex());
+    fftwf_destroy_plan(_plan);
+    fftwf_destroy_plan(_syncPlan);
+    fftwf_free(_in);
+    fftwf_free(_out);
+    fftwf_free(_syncIn);
+    fftwf_free(_syncOut);
+}
+
+void SpectrumEngine::release(SpectrumBlock *&block)
+{
+    _freeBlocks.tryPush(block);
+}
+
+void SpectrumEngine::process(const SpectrumBlock *block)
+{
+    const int n = _config.fftSize;
+    const int decimation = _config.decimation;
+    const float scale = 1.0f / (ADC_OFFSET * float(decimation));
+    const uint8_t* p = block->samples.constData();
+
+    std::fill(_power.begin(), _power.end(), 0.0f);
+
+    for(int a = 0; a < _config.averages; a++)
+    {
+        for(int k = 0; k < n; k++)
+        {
+            //децимация усреднением соседних отсчетов - простейший ФНЧ
+            float re = 0.0f;
+            float im = 0.0f;
+            for(int j = 0; j < decimation; j++)
+            {
+                re += float(p[0]) - ADC_OFFSET;
+                im += float(p[1]) - ADC_OFFSET;
+                p += 2;
+            }
+
+            const float w = _window[k] * scale;
+            _in[k][0] = re * w;
+            _in[k][1] = im * w;
+        }
+
+        fftwf_execute(_plan);
+
+        float* power = _power.data();
+        for(int k = 0; k < n; k++)
+            power[k] += _out[k][0] * _out[k][0] + _out[k][1] * _out[k][1];
+    }
+
+    //перестановка: нулевая частота в центре строки
+    const int shift = (n + 1) / 2;
+    float* row = _row.data();
+    for(int i = 0; i < n; i++)
+    {
+        const float power = _power[(i + shift) % n] * _powerScale;
+        row[i] = 10.0f * log10f(std::max(power, POWER_FLOOR));
+    }
+
+    QMutexLocker lock(&_resultMutex);
+    const size_t bytes = size_t(n) * sizeof(float);
+    memcpy(_spectrum.data(), row, bytes);
+    memcpy(_waterfall.data() + int(_rows % uint64_t(_config.waterfallRows)) * n, row, bytes);
+    _rows++;
+}
+
+SrcDataAdc SpectrumEngine::makeAll(const QVector<uint8_t> &vector)
+{
+    //прореживание блоков ограничивает нагрузку на поток ЦОС
+    if(_blockCounter.fetch_add(1, std::memory_order_relaxed) %
+            uint64_t(_config.blockStride) != 0)
+        return SrcDataAdc();
+
+    if(vector.size() < _rowBytes)
+        return SrcDataAdc();
+
+    SpectrumBlock* block = nullptr;
+    if(!_freeBlocks.tryPop(block))
+    {
+        _stage->countDropped();
+        return SrcDataAdc();
+    }
+
+    //окончание блока - новые данные, начало повторяет предыдущий блок
+    memcpy(block->samples.data(),
+           vector.constData() + (vector.size() - _rowBytes),
+           size_t(_rowBytes));
+
+    if(!_stage->push(block))
+        release(block);
+
+    return SrcDataAdc();
+}
+
+SrcDataAdc SpectrumEngine::makeFFT(const QVector<uint8_t> &vector)
+{
+    SrcDataAdc result;
+    const int n = _config.fftSize;
+    if(vector.size() < 2 * n)
+        return result;
+
+    result.fftVector.resize(n);
+    const uint8_t* p = vector.constData();
+    const float scale = 1.0f / ADC_OFFSET;
+
+    QMutexLocker lock(&_syncMutex);
+    for(int k = 0; k < n; k++)
+    {
+        const float w = _window[k] * scale;
+        _syncIn[k][0] = (float(p[2 * k]) - ADC_OFFSET) * w;
+        _syncIn[k][1] = (float(p[2 * k + 1]) - ADC_OFFSET) * w;
+    }
+
+    fftwf_execute(_syncPlan);
+
+    for(int k = 0; k < n; k++)
+        result.fftVector[k] = std::complex<float>(_syncOut[k][0], _syncOut[k][1]);
+
+    return result;
+}
+
+SrcDataAdc SpectrumEngine::makeMagnitude(const QVector<uint8_t> &vector)
+{
+    SrcDataAdc result;
+    const int count = vector.size() / 2;
+    result.magnitudeVector.resize(count);
+
+    const uint8_t* p = vector.constData();
+    for(int k = 0; k < count; k++)
+    {
+        const float i = (float(p[2 * k]) - ADC_OFFSET) / ADC_OFFSET;
+        const float q = (float(p[2 * k + 1]) - ADC_OFFSET) / ADC_OFFSET;
+        result.magnitudeVector[k] = std::complex<float>(sqrtf(i * i + q * q), 0.0f);
+    }
+
+    return result;
+}
+
+SpectrumFrame SpectrumEngine::spectrumFrame()
+{
+    const int n = _config.fftSize;
+    const int rows = _config.waterfallRows;
+
+    SpectrumFrame frame;
+    frame.bins = n;
+    frame.sampleRate = _config.sampleRate / _config.decimation;
+    frame.waterfallRows = rows;
+    frame.skipped = _stage->stats().dropped;
+    frame.spectrum.resize(n);
+    frame.waterfall.resize(n * rows);
+
+    QMutexLocker lock(&_resultMutex);
+    frame.rows = _rows;
+    memcpy(frame.spectrum.data(), _spectrum.constData(), size_t(n) * sizeof(float));
+
+    //строка, которая будет записана следующей, - самая старая
+    const int oldest = int(_rows % uint64_t(rows));
+    memcpy(frame.waterfall.data(),
+           _waterfall.constData() + oldest * n,
+           size_t((rows - oldest) * n) * sizeof(float));
+    memcpy(frame.waterfall.data() + (rows - oldest) * n,
+           _waterfall.constData(),
+           size_t(oldest * n) * sizeof(float));
+
+    return frame;
+}
@@ -0,0 +1,130 @@
+#ifndef SPECTRUMENGINE_H
+#define SPECTRUMENGINE_H
+
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <fftw3.h>
+
+#include "dsp_global.h"
+#include "dsp/IDSP.h"
+#include "pipeline/PipelineStage.h"
+#include "sdr_dev/include/constant.h"
+
+/*!
+ * @brief  Параметры расчета спектра
+ */
+struct SpectrumConfig
+{
+    ///< размер БПФ, отсчетов
+    int fftSize = 1024;
+    ///< коэффициент децимации: усреднение соседних отсчетов
+    int decimation = 8;
+    ///< количество усредняемых БПФ на строку
+    int averages = 4;
+    ///< обрабатывается каждый blockStride-й блок приемника
+    int blockStride = 2;
+    ///< строк в водопаде
+    int waterfallRows = 256;
+    ///< частота дискретизации приемника, Гц
+    double sampleRate = double(MODES_DEFAULT_RATE);
+};
+
+/*!
+ * \brief The SpectrumEngine class
+ * Реализация IDSP: спектр и водопад по потоку отсчетов I/Q.
+ * makeAll вызывается конвейером приема для каждого блока и только
+ * копирует часть прореженного потока в свободный буфер - расчет
+ * выполняется собственным потоком ЦОС. Если поток занят, блок
+ * пропускается: декодирование Mode S не ожидает расчет спектра.
+ * План БПФ, окно и буферы создаются один раз в конструкторе
+ * \author Данильченко Артём
+ */
+class DSPSHARED_EXPORT SpectrumEngine : public IDSP
+{
+    /*!
+     * @brief  Копия отсчетов для потока ЦОС
+     */
+    struct SpectrumBlock
+    {
+        QVector<uint8_t> samples;
+    };
+
+    const SpectrumConfig _config;
+    ///< байт отсчетов I/Q на одну строку водопада
+    int _rowBytes = 0;
+    ///< окно Хэннинга с нормировкой масштаба АЦП и децимации
+    QVector<float> _window;
+    ///< поправка мощности на когерентное усиление окна
+    float _powerScale = 1.0f;
+
+    ///< план и буферы потока ЦОС
+    fftwf_complex* _in = nullptr;
+    fftwf_complex* _out = nullptr;
+    fftwf_plan _plan = nullptr;
+    ///< накопленная мощность, используется только потоком ЦОС
+    QVector<float> _power;
+    ///< строка спектра, используется только потоком ЦОС
+    QVector<float> _row;
+
+    ///< план и буферы синхронного makeFFT
+    fftwf_complex* _syncIn = nullptr;
+    fftwf_complex* _syncOut = nullptr;
+    fftwf_plan _syncPlan = nullptr;
+    QMutex _syncMutex;
+
+    ///< результат расчета
+    QMutex _resultMutex;
+    QVector<float> _spectrum;
+    QVector<float> _waterfall;
+    uint64_t _rows = 0;
+
+    ///< буферы блоков и поток ЦОС
+    std::vector<std::unique_ptr<SpectrumBlock>> _blocks;
+    MpmcQueue<SpectrumBlock*> _freeBlocks;
+    std::unique_ptr<PipelineStage<SpectrumBlock*>> _stage;
+    std::atomic<uint64_t> _blockCounter;
+
+    /*!
+     * \brief process расчет строки спектра, выполняется потоком ЦОС
+     */
+    void process(const SpectrumBlock* block);
+    /*!
+     * \brief release возврат блока в список свободных
+     */
+    void release(SpectrumBlock*& block);
+
+public:
+    explicit SpectrumEngine(const SpectrumConfig& config = SpectrumConfig());
+    ~SpectrumEngine() override;
+
+    /*!
+     * \brief makeFFT синхронный расчет БПФ первых fftSize отсчетов
+     * с окном, без децимации
+     * \param vector отсчёты 8 - битного АЦП rtl-sdr
+     * \return fftVector - комплексный спектр в порядке БПФ
+     */
+    SrcDataAdc makeFFT(const QVector<uint8_t>& vector) override;
+    /*!
+     * \brief makeMagnitude синхронный расчет огибающей
+     * \param vector - отсчёты 8-битного АЦП rtl-sdr
+     * \return magnitudeVector - модуль отсчетов в действительной части
+     */
+    SrcDataAdc makeMagnitude(const QVector<uint8_t>& vector) override;
+    /*!
+     * \brief makeAll передача блока потоку ЦОС без ожидания расчета,
+     * допускает одновременный вызов из нескольких потоков
+     * \param vector - отсчёты 8-битного АЦП rtl-sdr
+     * \return пустой блок, результат выдается spectrumFrame
+     */
+    SrcDataAdc makeAll(const QVector<uint8_t>& vector) override;
+    /*!
+     * \brief spectrumFrame последний спектр и водопад
+     */
+    SpectrumFrame spectrumFrame() override;
+};
+
+#endif // SPECTRUMENGINE_H
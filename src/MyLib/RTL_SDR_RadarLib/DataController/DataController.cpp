@@ -1,6 +1,6 @@
 #include "DataController.h"
 
-#include "DataWorkerNetSender.h"
+#include "DataPipeline.h"
 
 DataController::DataController(QSharedPointer<IReciverDevice> dev,
                                QSharedPointer<IDemodulator> dem)
@@ -9,7 +9,7 @@ DataController::DataController(QSharedPointer<IReciverDevice> dev,
 
     _dataThread = new QThread();
 
-    _worker = std::unique_ptr<IWorker>(new DataWorker(dev,dem));
+    _worker = std::unique_ptr<IWorker>(new DataPipeline(dev,dem));
 
     if(_worker)
     {
@@ -35,7 +35,7 @@ DataController::DataController(QSharedPointer<IReciverDevice> dev,
     qDebug()<<"create DataController";
     _dataThread = new QThread();
 
-    _worker = std::unique_ptr<IWorker>(new DataWorkerNetSender(dev, dem, ip, port));
+    _worker = std::unique_ptr<IWorker>(new DataPipeline(dev, dem, ip, port));
 
     if(_worker)
     {
@@ -108,3 +108,60 @@ void DataController::setDSP(QSharedPointer<IDSP> dsp)
     if(_worker != nullptr)
         _worker->setDSP(dsp);
 }
+
+void DataController::setStateFile(const QString &fileName, int64_t period)
+{
+    if(_worker != nullptr)
+        _worker->setStateFile(fileName, period);
+}
+
+void DataController::setNetProtocol(NET_PROTOCOL protocol)
+{
+    if(_worker != nullptr)
+        _worker->setNetProtocol(protocol);
+}
+
+void DataController::setMulticast(const QString &group, uint16_t port)
+{
+    if(_worker != nullptr)
+        _worker->setMulticast(group, port);
+}
+
+void DataController::setStageConfig(PIPELINE_STAGE stage, const StageConfig &config)
+{
+    if(_worker != nullptr)
+        _worker->setStageConfig(stage, config);
+}
+
+QVector<StageStats> DataController::stageStats()
+{
+    if(_worker != nullptr)
+        return _worker->stageStats();
+    return QVector<StageStats>();
+}
+
+void DataController::setThreadPolicy(const ThreadPolicy &policy)
+{
+    if(_worker != nullptr)
+        _worker->setThreadPolicy(policy);
+}
+
+QVector<PlacementReport> DataController::threadPlacement()
+{
+    if(_worker != nullptr)
+        return _worker->threadPlacement();
+    return QVector<PlacementReport>();
+}
+
+void DataController::setOverloadConfig(const OverloadConfig &config)
+{
+    if(_worker != nullptr)
+        _worker->setOverloadConfig(config);
+}
+
+OverloadStats DataController::overloadStats()
+{
+    if(_worker != nullptr)
+        return _worker->overloadStats();
+    return OverloadStats();
+}
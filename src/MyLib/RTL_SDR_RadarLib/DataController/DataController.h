@@ -11,7 +11,8 @@
 
 /*!
  * \brief The DataController class
- * реализация интерфейса контроллера обработки данных
+ * реализация интерфейса контроллера обработки данных.
+ * Обработка выполняется конвейером стадий DataPipeline
  * \author Данильченко Артём
  */
 
@@ -75,6 +76,44 @@ public:
      * алгоритмов ЦОС
      */
     void setDSP(QSharedPointer<IDSP> dsp) override;
+    /*!
+     * \brief setStateFile периодическое сохранение состояния демодулятора
+     * \param fileName - имя файла, пустая строка - сохранение отключено
+     * \param period - период сохранения в мс
+     */
+    void setStateFile(const QString& fileName, int64_t period) override;
+    /*!
+     * \brief setNetProtocol выбор формата передачи данных на сервер
+     */
+    void setNetProtocol(NET_PROTOCOL protocol) override;
+    /*!
+     * \brief setMulticast рассылка данных в группу UDP multicast
+     */
+    void setMulticast(const QString& group, uint16_t port) override;
+    /*!
+     * \brief setStageConfig параметры стадии конвейера обработки
+     */
+    void setStageConfig(PIPELINE_STAGE stage, const StageConfig& config) override;
+    /*!
+     * \brief stageStats счетчики стадий конвейера обработки
+     */
+    QVector<StageStats> stageStats() override;
+    /*!
+     * \brief setThreadPolicy размещение потоков приема и обработки
+     */
+    void setThreadPolicy(const ThreadPolicy& policy) override;
+    /*!
+     * \brief threadPlacement фактическое размещение потоков
+     */
+    QVector<PlacementReport> threadPlacement() override;
+    /*!
+     * \brief setOverloadConfig пороги упрощения обработки при перегрузке
+     */
+    void setOverloadConfig(const OverloadConfig& config) override;
+    /*!
+     * \brief overloadStats отставание обработки и ступень упрощения
+     */
+    OverloadStats overloadStats() override;
 };
 
 #endif // DATACONTROLLER_H
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += gui network widgets
+QT       += gui network
 
 TARGET = DataController
 TEMPLATE = lib
@@ -24,22 +24,48 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 SOURCES += \
         DataController.cpp \
-    DataWorker.cpp \
-    DataWorkerNetSender.cpp \
-    NetworkWorker.cpp
+    DataPipeline.cpp \
+    NetworkWorker.cpp \
+    NetSender.cpp \
+    MulticastPublisher.cpp \
+    MulticastReceiver.cpp \
+    ../../../include/protocol/MulticastCodec.cpp \
+    ../../../include/protocol/FrameCodec.cpp \
+    ../../../include/protocol/Crc32.cpp \
+    ../../../include/protocol/DeltaEncoder.cpp \
+    ../../../include/pipeline/ThreadPolicy.cpp
 
 HEADERS += \
         ../../../include/interface/INetworkWorker.h \
         DataController.h \
-        DataWorkerNetSender.h \
+        DataPipeline.h \
         NetworkWorker.h \
+        NetSender.h \
+        MulticastPublisher.h \
+        MulticastReceiver.h \
         datacontroller_global.h \ 
     ../../../include/interface/IDataController.h \
     ../../../include/interface/IWorker.h \
     ../../../include/interface/IDemodulator.h \
-    DataWorker.h \
     ../../../include/dsp/SrcDataAdc.h \
-    ../../../include/dsp/IDSP.h
+    ../../../include/dsp/IDSP.h \
+    ../../../include/protocol/DeltaProtocol.h \
+    ../../../include/protocol/DeltaEncoder.h \
+    ../../../include/protocol/MulticastProtocol.h \
+    ../../../include/protocol/MulticastCodec.h \
+    ../../../include/protocol/FrameProtocol.h \
+    ../../../include/protocol/FrameCodec.h \
+    ../../../include/protocol/Crc32.h \
+    ../../../include/pipeline/BoundedQueue.h \
+    ../../../include/pipeline/SpscQueue.h \
+    ../../../include/pipeline/MpmcQueue.h \
+    ../../../include/pipeline/StageConfig.h \
+    ../../../include/pipeline/EventCount.h \
+    ../../../include/pipeline/LatencyHistogram.h \
+    ../../../include/pipeline/PipelineStage.h \
+    ../../../include/pipeline/ThreadPlacement.h \
+    ../../../include/pipeline/ThreadPolicy.h \
+    ../../../include/pipeline/OverloadGovernor.h
 
 unix {
     target.path = /usr/lib
@@ -0,0 +1,484 @@
+#include "DataPipeline.h"
+
+#include <string.h>
+
+#include "NetSender.h"
+#include "time/Clock.h"
+
+namespace
+{
+///< монотонное время в мс для измерения интервалов
+int64_t monotonicMSec()
+{
+    return Clock::toMSec(Clock::monotonicNSec());
+}
+
+///< отсчетов I/Q в блоке приемника
+constexpr uint64_t BLOCK_SAMPLES = MODES_DATA_LEN / 2;
+
+///< длительность отсчетов по часам дискретизации, нс.
+///< Целая и дробная части секунды считаются отдельно, чтобы
+///< произведение не переполнялось за время работы
+int64_t samplesToNSec(uint64_t samples)
+{
+    const uint64_t rate = MODES_DEFAULT_RATE;
+    return int64_t((samples / rate) * uint64_t(Clock::NSEC_PER_SEC) +
+                   (samples % rate) * uint64_t(Clock::NSEC_PER_SEC) / rate);
+}
+}
+
+DataPipeline::DataPipeline(QSharedPointer<IReciverDevice> dev,
+                           QSharedPointer<IDemodulator> dem) :
+    _abort(false),
+    _device(dev),
+    _demod(dem)
+{
+    //чтение с приемника не ожидает обработку: при перегрузке блоки
+    //отбрасываются перед расчетом огибающей, демодуляция не теряет
+    //рассчитанные блоки, выходы не задерживают демодуляцию
+    _config[int(PIPELINE_STAGE::ACQUISITION)] = StageConfig(1, 1, OVERFLOW_POLICY::DROP);
+    _config[int(PIPELINE_STAGE::MAGNITUDE)] = StageConfig(1, 4, OVERFLOW_POLICY::DROP);
+    _config[int(PIPELINE_STAGE::DEMODULATION)] = StageConfig(1, 4, OVERFLOW_POLICY::BLOCK);
+    _config[int(PIPELINE_STAGE::OUTPUTS)] = StageConfig(1, 2, OVERFLOW_POLICY::DROP);
+
+    qDebug()<<"create DataPipeline";
+}
+
+DataPipeline::DataPipeline(QSharedPointer<IReciverDevice> dev,
+                           QSharedPointer<IDemodulator> dem,
+                           const QString &ip,
+                           uint16_t port) :
+    DataPipeline(dev, dem)
+{
+    QString address = DEFAULT_IP;
+    uint16_t netPort = DEFAULT_PORT;
+    if(!ip.isEmpty())
+    {
+        address = ip;
+        netPort = port;
+    }
+
+    _netThread = new QThread();
+    _net = new NetSender(address, netPort);
+    _net->moveToThread(_netThread);
+    _netThread->start();
+    QMetaObject::invokeMethod(_net, "start", Qt::QueuedConnection);
+}
+
+DataPipeline::~DataPipeline()
+{
+    if(_net != nullptr)
+    {
+        QMetaObject::invokeMethod(_net, "stop", Qt::BlockingQueuedConnection);
+        _netThread->quit();
+        _netThread->wait();
+
+        delete _net;
+        delete _netThread;
+    }
+
+    _device.clear();
+    _demod.clear();
+    qDebug()<<"delete DataPipeline";
+}
+
+void DataPipeline::setReciverDevice(QSharedPointer<IReciverDevice> dev)
+{
+    QMutexLocker lock(&_mutex);
+    _device = dev;
+}
+
+void DataPipeline::setDemodulator(QSharedPointer<IDemodulator> dem)
+{
+    QMutexLocker lock(&_mutex);
+    _demod = dem;
+}
+
+void DataPipeline::setDSP(QSharedPointer<IDSP> dsp)
+{
+    QMutexLocker lock(&_mutex);
+    _dsp = dsp;
+}
+
+void DataPipeline::setStateFile(const QString &fileName, int64_t period)
+{
+    QMutexLocker lock(&_mutex);
+    _stateFile = fileName;
+    if(period > 0)
+        _statePeriod = period;
+    _stateTime = monotonicMSec();
+}
+
+void DataPipeline::setNetProtocol(NET_PROTOCOL protocol)
+{
+    if(_net != nullptr)
+        _net->setNetProtocol(protocol);
+}
+
+void DataPipeline::setMulticast(const QString &group, uint16_t port)
+{
+    if(_net == nullptr)
+        return;
+
+    QMetaObject::invokeMethod(_net, "setMulticast", Qt::QueuedConnection,
+                              Q_ARG(QString, group),
+                              Q_ARG(quint16, port));
+}
+
+void DataPipeline::setStageConfig(PIPELINE_STAGE stage, const StageConfig &config)
+{
+    StageConfig value = config;
+    value.threads = qMax(1, value.threads);
+    value.capacity = qMax(1, value.capacity);
+    //несколько потоков расчета огибающей передавали бы блоки
+    //демодуляции не в порядке чтения
+    if(stage == PIPELINE_STAGE::ACQUISITION || stage == PIPELINE_STAGE::MAGNITUDE ||
+            stage == PIPELINE_STAGE::DEMODULATION)
+        value.threads = 1;
+
+    QMutexLocker lock(&_mutex);
+    _config[int(stage)] = value;
+}
+
+QVector<StageStats> DataPipeline::stageStats()
+{
+    QMutexLocker lock(&_stagesMutex);
+
+    QVector<StageStats> stats;
+    if(_acquisition)
+    {
+        stats.append(_acquisition->stats());
+        stats.append(_magnitude->stats());
+        stats.append(_demodulation->stats());
+        stats.append(_outputs->stats());
+    }
+    return stats;
+}
+
+void DataPipeline::setThreadPolicy(const ThreadPolicy &policy)
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _placement[int(PIPELINE_STAGE::ACQUISITION)] = policy.acquisition;
+        _placement[int(PIPELINE_STAGE::MAGNITUDE)] = policy.magnitude;
+        _placement[int(PIPELINE_STAGE::DEMODULATION)] = policy.demodulation;
+        _placement[int(PIPELINE_STAGE::OUTPUTS)] = policy.outputs;
+    }
+
+    if(_net != nullptr)
+        _net->setPlacement(policy.network);
+}
+
+QVector<PlacementReport> DataPipeline::threadPlacement()
+{
+    QVector<PlacementReport> reports;
+    {
+        QMutexLocker lock(&_stagesMutex);
+        if(_acquisition)
+        {
+            reports += _acquisition->placement();
+            reports += _magnitude->placement();
+            reports += _demodulation->placement();
+            reports += _outputs->placement();
+        }
+    }
+
+    if(_net != nullptr)
+    {
+        const PlacementReport report = _net->placement();
+        if(!report.name.isEmpty())
+            reports.append(report);
+    }
+    return reports;
+}
+
+void DataPipeline::setOverloadConfig(const OverloadConfig &config)
+{
+    QMutexLocker lock(&_mutex);
+    _overloadConfig = config;
+}
+
+void DataPipeline::assemble()
+{
+    QSharedPointer<IReciverDevice> device;
+    QSharedPointer<IDemodulator> demod;
+    QSharedPointer<IDSP> dsp;
+    StageConfig config[STAGE_COUNT];
+    OverloadConfig overload;
+    {
+        QMutexLocker lock(&_mutex);
+        device = _device;
+        demod = _demod;
+        dsp = _dsp;
+        overload = _overloadConfig;
+        overload.skipTwoBitsFix = !demod.isNull() && !demod->isAggressive();
+        for(int i = 0; i < STAGE_COUNT; i++)
+        {
+            config[i] = _config[i];
+            config[i].placement = _placement[i];
+        }
+    }
+
+    const StageConfig& magnitudeConfig = config[int(PIPELINE_STAGE::MAGNITUDE)];
+    const bool sendSnapshots = (_net != nullptr);
+
+    QMutexLocker lock(&_stagesMutex);
+
+    _acquisition.reset(new PipelineSource<SampleBlock*>(
+                           "acquisition",
+                           config[int(PIPELINE_STAGE::ACQUISITION)],
+                           [this, device](SampleBlock*& block)
+    {
+        return acquire(block, device);
+    }));
+
+    _magnitude.reset(new PipelineStage<SampleBlock*>(
+                         "magnitude",
+                         magnitudeConfig,
+                         1,
+                         [demod](SampleBlock*& block)
+    {
+        if(demod.isNull())
+            return false;
+
+        demod->computeMagnitude(block->samples, block->magnitude);
+        return true;
+    }));
+
+    //демодуляция и сопровождение выполняются вместе: сообщения
+    //декодируются и сразу применяются к пулу под его блокировкой
+    _demodulation.reset(new PipelineStage<SampleBlock*>(
+                            "demodulation",
+                            config[int(PIPELINE_STAGE::DEMODULATION)],
+                            1,
+                            [this, demod, sendSnapshots](SampleBlock*& block)
+    {
+        demod->demodulate(block->magnitude);
+        checkOverload(block, demod);
+
+        const int64_t now = monotonicMSec();
+        if(sendSnapshots && now - _sendTime > SEND_INTERVAL)
+        {
+            //снимок формируется между блоками, пока пул не изменяется
+            block->snapshot = demod->getRawDumpOfObjectsInfo();
+            _sendTime = now;
+        }
+
+        saveState(demod);
+        return true;
+    }));
+
+    _outputs.reset(new PipelineStage<SampleBlock*>(
+                       "outputs",
+                       config[int(PIPELINE_STAGE::OUTPUTS)],
+                       1,
+                       [this, dsp](SampleBlock*& block)
+    {
+        //спектр - первое, что отключается при перегрузке
+        if(!dsp.isNull() && _governor.level() < DEGRADATION_LEVEL::NO_DSP)
+            dsp->makeAll(block->samples);
+
+        //снимок передается в поток отправки без ожидания сети
+        if(_net != nullptr && !block->snapshot.isEmpty())
+            _net->push(block->snapshot, block->time);
+
+        return true;
+    }));
+
+    _acquisition->setNext(_magnitude.get());
+    _magnitude->setNext(_demodulation.get());
+    _demodulation->setNext(_outputs.get());
+
+    //задержка от чтения блока до декодирования сообщений и до выдачи
+    auto acquired = [](SampleBlock* const& block) { return block->acquired; };
+    _demodulation->setLatencyProbe(acquired);
+    _outputs->setLatencyProbe(acquired);
+
+    auto releaseBlock = [this](SampleBlock*& block) { release(block); };
+    _acquisition->setRelease(releaseBlock);
+    _magnitude->setRelease(releaseBlock);
+    _demodulation->setRelease(releaseBlock);
+    _outputs->setRelease(releaseBlock);
+
+    //блок находится либо в очереди, либо в обработке одним из потоков,
+    //либо в списке свободных - этого количества достаточно без выделений
+    const int count = 1 +
+            _magnitude->capacity() + magnitudeConfig.threads +
+            _demodulation->capacity() + 1 +
+            _outputs->capacity() + config[int(PIPELINE_STAGE::OUTPUTS)].threads;
+
+    _freeBlocks.reset(new MpmcQueue<SampleBlock*>(count));
+    _blocks.clear();
+    for(int i = 0; i < count; i++)
+    {
+        std::unique_ptr<SampleBlock> block(new SampleBlock());
+        block->samples.resize(int(MODES_DATA_LEN + MODES_FULL_LEN_OFFS));
+        block->magnitude.resize(block->samples.size() / 2);
+
+        SampleBlock* ptr = block.get();
+        _freeBlocks->tryPush(ptr);
+        _blocks.push_back(std::move(block));
+    }
+
+    _tail.fill(0, int(MODES_FULL_LEN_OFFS));
+    _seq = 0;
+    _samples = 0;
+    _clockStart = 0;
+    _sendTime = monotonicMSec();
+
+    _governor.reset(overload, Clock::monotonicNSec());
+    applyDegradation(DEGRADATION_LEVEL::FULL, demod);
+}
+
+bool DataPipeline::acquire(SampleBlock *&block,
+                           const QSharedPointer<IReciverDevice> &device)
+{
+    if(device.isNull())
+    {
+        QThread::sleep(1);
+        return false;
+    }
+
+    if(!device->isOpenDevice())
+    {
+        //после повторного открытия часы дискретизации отсчитываются заново
+        _samples = 0;
+        _clockStart = 0;
+        QThread::sleep(1);
+        device->openDevice();
+        return false;
+    }
+
+    const uint8_t* ptrData = device->getDataBlockPtr(size_t(MODES_DATA_LEN));
+    if(ptrData == nullptr)
+        return false;
+
+    //часы дискретизации идут и для потерянных блоков
+    const int64_t now = Clock::monotonicNSec();
+    _samples += BLOCK_SAMPLES;
+    if(_clockStart == 0)
+        _clockStart = now - samplesToNSec(_samples);
+
+    if(!_freeBlocks->tryPop(block))
+    {
+        //все блоки в обработке - данные теряются,
+        //окончание сохраняется для следующего блока
+        memcpy(_tail.data(), ptrData + MODES_DATA_LEN - MODES_FULL_LEN_OFFS,
+               MODES_FULL_LEN_OFFS);
+        _acquisition->countDropped();
+        return false;
+    }
+
+    /* Move the last part of the previous buffer, that was not processed,
+     * on the start of the new buffer. */
+    uint8_t* samples = block->samples.data();
+    memcpy(samples, _tail.constData(), MODES_FULL_LEN_OFFS);
+    /* Read the new data. */
+    memcpy(samples + MODES_FULL_LEN_OFFS, ptrData, size_t(MODES_DATA_LEN));
+    memcpy(_tail.data(), samples + MODES_DATA_LEN, MODES_FULL_LEN_OFFS);
+
+    block->seq = _seq++;
+    block->time = Clock::nowMSec();
+    block->acquired = now;
+    block->sampleClock = _clockStart + samplesToNSec(_samples);
+    return true;
+}
+
+void DataPipeline::release(SampleBlock *&block)
+{
+    block->snapshot.clear();
+    _freeBlocks->tryPush(block);
+}
+
+void DataPipeline::checkOverload(const SampleBlock *block,
+                                 const QSharedPointer<IDemodulator> &demod)
+{
+    const int64_t now = Clock::monotonicNSec();
+    //блоки, потерянные до демодуляции: нет свободного блока при чтении
+    //или переполнена очередь расчета огибающей
+    const uint64_t dropped = _acquisition->dropped() + _magnitude->dropped();
+    const uint64_t blocks = _acquisition->processed() + _acquisition->dropped();
+
+    const DEGRADATION_LEVEL previous = _governor.level();
+    if(!_governor.update(now - block->sampleClock, blocks, dropped, now))
+        return;
+
+    const DEGRADATION_LEVEL level = _governor.level();
+    applyDegradation(level, demod);
+
+    const OverloadStats stats = _governor.stats();
+    const QString text = QString("overload: %1 -> %2, backlog %3 us, dropped %4%")
+            .arg(OverloadGovernor::levelName(previous))
+            .arg(OverloadGovernor::levelName(level))
+            .arg(stats.backlogUs)
+            .arg(stats.dropRatio * 100.0, 0, 'f', 1);
+    qDebug()<<text;
+    if(_log != nullptr)
+        _log->push(text, (level > previous) ? TypeLog::Warning : TypeLog::Success);
+}
+
+void DataPipeline::applyDegradation(DEGRADATION_LEVEL level,
+                                    const QSharedPointer<IDemodulator> &demod)
+{
+    if(demod.isNull())
+        return;
+
+    demod->setTwoBitsFix(level < DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+    demod->setPhaseCorrection(level < DEGRADATION_LEVEL::NO_PHASE_CORRECTION);
+}
+
+void DataPipeline::saveState(const QSharedPointer<IDemodulator> &demod, bool force)
+{
+    QString fileName;
+    {
+        QMutexLocker lock(&_mutex);
+        if(_stateFile.isEmpty() || demod.isNull())
+            return;
+
+        const int64_t now = monotonicMSec();
+        if(!force && now - _stateTime < _statePeriod)
+            return;
+
+        _stateTime = now;
+        fileName = _stateFile;
+    }
+
+    if(!demod->saveState(fileName))
+        qDebug()<<"error save state to"<<fileName;
+}
+
+void DataPipeline::exec()
+{
+    _abort = false;
+
+    assemble();
+
+    //запуск от выхода к источнику: каждая стадия готова принять данные
+    _outputs->start();
+    _demodulation->start();
+    _magnitude->start();
+    _acquisition->start();
+
+    while(!_abort)
+        QThread::msleep(CONTROL_PERIOD);
+
+    //остановка от источника к выходу: в остановленную стадию
+    //не поступают новые блоки
+    _acquisition->stop();
+    _magnitude->stop();
+    _demodulation->stop();
+    _outputs->stop();
+
+    QSharedPointer<IDemodulator> demod;
+    {
+        QMutexLocker lock(&_mutex);
+        demod = _demod;
+    }
+    //демодуляция остановлена - состояние можно сохранить,
+    //следующий запуск начинается с полной обработки
+    saveState(demod, true);
+    applyDegradation(DEGRADATION_LEVEL::FULL, demod);
+
+    qDebug()<<"terminate thread id" << QThread::currentThreadId();
+    emit finished();
+}
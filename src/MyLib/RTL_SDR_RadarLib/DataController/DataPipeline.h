@@ -0,0 +1,258 @@
+#ifndef DATAPIPELINE_H
+#define DATAPIPELINE_H
+
+#include <QDebug>
+#include <QThread>
+#include <QMutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "interface/IWorker.h"
+#include "dsp/IDSP.h"
+#include "pipeline/PipelineStage.h"
+#include "sdr_dev/include/constant.h"
+
+class NetSender;
+
+/*!
+ * @brief  Блок отсчетов, передаваемый между стадиями конвейера
+ */
+struct SampleBlock
+{
+    ///< номер блока
+    uint64_t seq = 0;
+    ///< время чтения блока, мс с начала эпохи
+    int64_t time = 0;
+    ///< время чтения блока по монотонным часам, нс
+    int64_t acquired = 0;
+    ///< время окончания блока по часам дискретизации,
+    ///< приведенное к монотонным часам, нс
+    int64_t sampleClock = 0;
+    ///< отсчеты I/Q: окончание предыдущего блока и новые данные
+    QVector<uint8_t> samples;
+    ///< огибающая
+    QVector<uint16_t> magnitude;
+    ///< снимок пула для отправки на сервер, пустой - отправка не нужна
+    QByteArray snapshot;
+};
+
+/*!
+ * \brief The DataPipeline class
+ * Реализация интерфейса получения и обработки данных от приемника
+ * в виде конвейера стадий, связанных очередями без блокировок:
+ * чтение с приемника -> огибающая -> демодуляция и сопровождение -> выходы.
+ * Блоки отсчетов выделяются один раз и возвращаются в список свободных
+ * после обработки. Потоки стадий создаются при запуске и ожидают блоки
+ * на futex; задержка от чтения блока до декодирования сообщений
+ * измеряется стадией демодуляции. При заданном адресе сервера снимки
+ * пула передаются модулем NetSender в отдельном потоке.
+ * Потоки стадий и поток отправки размещаются по ThreadPolicy;
+ * приемник читается потоком стадии чтения и размещается вместе с ней.
+ * Стадия демодуляции сравнивает часы дискретизации с монотонными часами
+ * и при перегрузке упрощает обработку по ступеням OverloadGovernor
+ * \author Данильченко Артём
+ */
+class DataPipeline : public IWorker
+{
+    Q_OBJECT
+
+    ///< количество стадий
+    static constexpr int STAGE_COUNT = 4;
+    ///< период проверки флага остановки, мс
+    static constexpr unsigned long CONTROL_PERIOD = 100;
+    ///< ip для подключения по умолчанию
+    const QString DEFAULT_IP = QString("127.0.0.1");
+    ///< порт для подключения по умолчания
+    const uint16_t DEFAULT_PORT = 62000;
+    ///< интервал отправки сообщений
+    const int64_t SEND_INTERVAL = 500;
+
+    std::atomic<bool> _abort;
+    ///< защита зависимостей и параметров, изменяемых из других потоков
+    QMutex _mutex;
+
+    ///< указатель на rtl_sdr устройство
+    QSharedPointer<IReciverDevice> _device;
+    ///< указатель на демодулятор устройства
+    QSharedPointer<IDemodulator> _demod;
+    ///< указатель на модуль ЦОС
+    QSharedPointer<IDSP> _dsp;
+
+    ILogger* _log = nullptr;
+
+    ///< модуль отправки данных, живет в потоке _netThread
+    NetSender* _net = nullptr;
+    ///< поток отправки данных
+    QThread* _netThread = nullptr;
+
+    ///< параметры стадий
+    StageConfig _config[STAGE_COUNT];
+    ///< размещение потоков стадий, добавляется к параметрам при запуске
+    ThreadPlacement _placement[STAGE_COUNT];
+    ///< стадии текущего запуска, защищены _stagesMutex
+    std::unique_ptr<PipelineSource<SampleBlock*>> _acquisition;
+    std::unique_ptr<PipelineStage<SampleBlock*>> _magnitude;
+    std::unique_ptr<PipelineStage<SampleBlock*>> _demodulation;
+    std::unique_ptr<PipelineStage<SampleBlock*>> _outputs;
+    QMutex _stagesMutex;
+
+    ///< блоки отсчетов и список свободных блоков
+    std::vector<std::unique_ptr<SampleBlock>> _blocks;
+    std::unique_ptr<MpmcQueue<SampleBlock*>> _freeBlocks;
+    ///< окончание предыдущего блока, используется только стадией чтения
+    QVector<uint8_t> _tail;
+    uint64_t _seq = 0;
+    ///< отсчетов прочитано с приемника, включая потерянные блоки,
+    ///< и начало отсчета часов дискретизации, используются стадией чтения
+    uint64_t _samples = 0;
+    int64_t _clockStart = 0;
+
+    ///< контроль перегрузки, обновляется стадией демодуляции
+    OverloadConfig _overloadConfig;
+    OverloadGovernor _governor;
+
+    ///< время последней отправки снимка, используется стадией демодуляции
+    int64_t _sendTime = 0;
+
+    ///< файл состояния демодулятора
+    QString _stateFile;
+    ///< период сохранения состояния, мс
+    int64_t _statePeriod = 30000;
+    ///< время последнего сохранения состояния, используется стадией демодуляции
+    int64_t _stateTime = 0;
+
+    /*!
+     * \brief assemble создание стадий и блоков отсчетов по текущим параметрам
+     */
+    void assemble();
+    /*!
+     * \brief acquire стадия чтения: блок данных с приемника
+     * дополняется окончанием предыдущего блока
+     * \return false - блок не сформирован
+     */
+    bool acquire(SampleBlock*& block,
+                 const QSharedPointer<IReciverDevice>& device);
+    /*!
+     * \brief release возврат блока в список свободных
+     */
+    void release(SampleBlock*& block);
+    /*!
+     * \brief saveState сохранение состояния демодулятора в файл.
+     * Вызывается только потоком демодуляции или после остановки конвейера
+     * \param force - сохранение без учета периода
+     */
+    void saveState(const QSharedPointer<IDemodulator>& demod, bool force = false);
+    /*!
+     * \brief checkOverload учет отставания обработанного блока и переход
+     * между ступенями упрощения. Вызывается только потоком демодуляции
+     */
+    void checkOverload(const SampleBlock* block, const QSharedPointer<IDemodulator>& demod);
+    /*!
+     * \brief applyDegradation включение и отключение алгоритмов демодуляции
+     * по ступени упрощения. Вызывается потоком демодуляции или при
+     * остановленной стадии демодуляции
+     */
+    static void applyDegradation(DEGRADATION_LEVEL level,
+                                 const QSharedPointer<IDemodulator>& demod);
+
+public:
+    /*!
+     * \brief DataPipeline конструктор без отправки данных на сервер
+     * \param dev - модуль работы с приемником
+     * \param dem - модуль демодуляции
+     */
+    DataPipeline(QSharedPointer<IReciverDevice> dev,
+                 QSharedPointer<IDemodulator> dem);
+    /*!
+     * \brief DataPipeline конструктор с отправкой данных на сервер
+     * \param dev - модуль работы с приемником
+     * \param dem - модуль демодуляции
+     * \param ip - ip сервера
+     * \param port  порт сервера
+     */
+    DataPipeline(QSharedPointer<IReciverDevice> dev,
+                 QSharedPointer<IDemodulator> dem,
+                 const QString& ip,
+                 uint16_t port);
+
+    ~DataPipeline() override;
+    /*!
+     * \brief setLogger - внедрение зависимости модуля логгирования
+     */
+    void setLogger(ILogger* log) override { _log = log; }
+    /*!
+     * \brief setReciverDevice внедрение зависимости модуля работы с приемником
+     */
+    void setReciverDevice(QSharedPointer<IReciverDevice> dev) override;
+    /*!
+     * \brief setDemodulator - внедрение зависимости модуля
+     * демодуляции входного сигнала
+     */
+    void setDemodulator(QSharedPointer<IDemodulator> dem) override;
+    /*!
+     * \brief setDSP внедрение зависимости модуля
+     * алгоритмов ЦОС
+     */
+    void setDSP(QSharedPointer<IDSP> dsp) override;
+    /*!
+     * \brief abortExec - прекращение выполения цикла обработки данных
+     */
+    void abortExec() override { _abort = true; }
+    /*!
+     * \brief setTimeout задание периода съема и обработки данных с приёмника
+     * \param msleep - время в мс
+     */
+    void setTimeout(uint64_t) override {}
+    /*!
+     * \brief setStateFile периодическое сохранение состояния демодулятора
+     * \param fileName - имя файла, пустая строка - сохранение отключено
+     * \param period - период сохранения в мс
+     */
+    void setStateFile(const QString& fileName, int64_t period) override;
+    /*!
+     * \brief setNetProtocol выбор формата передачи данных на сервер
+     */
+    void setNetProtocol(NET_PROTOCOL protocol) override;
+    /*!
+     * \brief setMulticast рассылка снимков в группу UDP multicast
+     */
+    void setMulticast(const QString& group, uint16_t port) override;
+    /*!
+     * \brief setStageConfig параметры стадии конвейера. Стадии чтения,
+     * расчета огибающей и демодуляции всегда выполняются одним потоком:
+     * приемник читается последовательно, демодулятор хранит состояние
+     * между блоками и должен получать их в порядке чтения
+     */
+    void setStageConfig(PIPELINE_STAGE stage, const StageConfig& config) override;
+    /*!
+     * \brief stageStats счетчики стадий текущего запуска
+     */
+    QVector<StageStats> stageStats() override;
+    /*!
+     * \brief setThreadPolicy размещение потоков стадий (при следующем
+     * запуске exec) и потока отправки данных (сразу)
+     */
+    void setThreadPolicy(const ThreadPolicy& policy) override;
+    /*!
+     * \brief threadPlacement фактическое размещение потоков стадий
+     * текущего запуска и потока отправки данных
+     */
+    QVector<PlacementReport> threadPlacement() override;
+    /*!
+     * \brief setOverloadConfig пороги упрощения обработки при перегрузке
+     */
+    void setOverloadConfig(const OverloadConfig& config) override;
+    /*!
+     * \brief overloadStats отставание обработки и ступень упрощения
+     */
+    OverloadStats overloadStats() override { return _governor.stats(); }
+
+public slots:
+    /*!
+    * \brief exec запуск стадий конвейера и ожидание остановки
+    */
+    void exec() override;
+};
+
+#endif // DATAPIPELINE_H
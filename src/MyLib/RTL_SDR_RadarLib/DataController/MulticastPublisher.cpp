@@ -0,0 +1,82 @@
+#include <QDebug>
+
+#include "MulticastPublisher.h"
+
+MulticastPublisher::~MulticastPublisher()
+{
+    close();
+}
+
+bool MulticastPublisher::open(const QString &group,
+                              uint16_t port,
+                              int ttl,
+                              const QNetworkInterface &iface)
+{
+    close();
+
+    QHostAddress address(group);
+    if(!address.isMulticast())
+    {
+        qDebug()<<"[Multicast] : not a multicast group"<<group;
+        return false;
+    }
+
+    _socket = std::unique_ptr<QUdpSocket>(new QUdpSocket());
+    //сокет привязывается к семейству адресов группы
+    if(!_socket->bind(address.protocol() == QAbstractSocket::IPv6Protocol ? QHostAddress::AnyIPv6
+                                                                        : QHostAddress::AnyIPv4, 0))
+    {
+        qDebug()<<"[Multicast] : bind error"<<_socket->errorString();
+        _socket.reset(nullptr);
+        return false;
+    }
+
+    _socket->setSocketOption(QAbstractSocket::MulticastTtlOption, ttl);
+    //получатели на этом же узле (TestServer, логгер) принимают рассылку
+    _socket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+    if(iface.isValid())
+        _socket->setMulticastInterface(iface);
+
+    _group = address;
+    _port = port;
+
+    qDebug()<<"[Multicast] : publish to"<<group<<port<<"ttl"<<ttl;
+    return true;
+}
+
+void MulticastPublisher::close()
+{
+    if(_socket)
+        _socket->close();
+    _socket.reset(nullptr);
+}
+
+int MulticastPublisher::publish(const QByteArray &dump, int64_t time)
+{
+    if(!_socket)
+        return 0;
+
+    QVector<QByteArray> datagrams = _packer.pack(dump, time);
+
+    int sent = 0;
+    for(const QByteArray& datagram : datagrams)
+    {
+        //UDP не блокируется: при переполнении буфера датаграмма теряется,
+        //получатели увидят разрыв нумерации
+        qint64 ret = _socket->writeDatagram(datagram, _group, _port);
+        if(ret != datagram.size())
+        {
+            _stats.errors++;
+            continue;
+        }
+
+        sent++;
+        _stats.datagrams++;
+        _stats.bytes += uint64_t(ret);
+    }
+
+    if(!datagrams.isEmpty())
+        _stats.snapshots++;
+
+    return sent;
+}
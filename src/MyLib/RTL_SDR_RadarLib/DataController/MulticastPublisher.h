@@ -0,0 +1,80 @@
+#ifndef MULTICASTPUBLISHER_H
+#define MULTICASTPUBLISHER_H
+
+#include <QUdpSocket>
+#include <QNetworkInterface>
+#include <memory>
+
+#include "datacontroller_global.h"
+#include "protocol/MulticastCodec.h"
+
+/*!
+ * @brief  Счетчики рассылки
+ */
+struct MulticastTxStats
+{
+    ///< отправлено снимков
+    uint64_t snapshots = 0;
+    ///< отправлено датаграмм
+    uint64_t datagrams = 0;
+    ///< отправлено байт
+    uint64_t bytes = 0;
+    ///< ошибки отправки датаграмм
+    uint64_t errors = 0;
+};
+
+/*!
+ * \brief The MulticastPublisher class
+ * Рассылка снимков состояния самолётов в группу UDP multicast.
+ * Стоимость отправки не зависит от количества получателей:
+ * снимок сериализуется и отправляется один раз.
+ * Используется в потоке, в котором создан.
+ * \author Данильченко Артём
+ */
+class DATACONTROLLERSHARED_EXPORT MulticastPublisher
+{
+    std::unique_ptr<QUdpSocket> _socket;
+    QHostAddress _group;
+    uint16_t _port = MCAST_DEFAULT_PORT;
+    MulticastPacker _packer;
+    MulticastTxStats _stats;
+
+public:
+    MulticastPublisher() = default;
+    ~MulticastPublisher();
+
+    /*!
+     * \brief open подготовка сокета рассылки
+     * \param group - адрес группы
+     * \param port - порт получателей
+     * \param ttl - время жизни датаграмм, 0 - только текущий узел,
+     * 1 - локальная сеть
+     * \param iface - интерфейс рассылки, по умолчанию выбирается системой
+     * \return результат операции
+     */
+    bool open(const QString& group,
+              uint16_t port,
+              int ttl = 1,
+              const QNetworkInterface& iface = QNetworkInterface());
+    /*!
+     * \brief close закрытие сокета
+     */
+    void close();
+    /*!
+     * \brief isOpen сокет рассылки готов
+     */
+    bool isOpen() const { return _socket != nullptr; }
+    /*!
+     * \brief publish отправка снимка
+     * \param dump - список самолётов (IDemodulator::getRawDumpOfObjectsInfo)
+     * \param time - время формирования снимка, мс
+     * \return количество отправленных датаграмм
+     */
+    int publish(const QByteArray& dump, int64_t time);
+    /*!
+     * \brief stats счетчики рассылки
+     */
+    const MulticastTxStats& stats() const { return _stats; }
+};
+
+#endif // MULTICASTPUBLISHER_H
@@ -0,0 +1,113 @@
+#include <QDebug>
+#include <QNetworkDatagram>
+
+#include "MulticastReceiver.h"
+
+MulticastReceiver::MulticastReceiver(QObject *parent) : QObject(parent)
+{
+    connect(&_socket, &QUdpSocket::readyRead,
+            this, &MulticastReceiver::slotReadyRead);
+}
+
+MulticastReceiver::~MulticastReceiver()
+{
+    close();
+}
+
+bool MulticastReceiver::open(const QString &group,
+                             uint16_t port,
+                             const QNetworkInterface &iface)
+{
+    close();
+
+    QHostAddress address(group);
+    if(!address.isMulticast())
+    {
+        qDebug()<<"[Multicast] : not a multicast group"<<group;
+        return false;
+    }
+
+    //несколько получателей на одном узле используют один порт
+    if(!_socket.bind(address.protocol() == QAbstractSocket::IPv6Protocol ? QHostAddress::AnyIPv6
+                                                                       : QHostAddress::AnyIPv4,
+                     port,
+                     QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
+    {
+        qDebug()<<"[Multicast] : bind error"<<_socket.errorString();
+        return false;
+    }
+
+    bool joined = iface.isValid() ? _socket.joinMulticastGroup(address, iface)
+                                  : _socket.joinMulticastGroup(address);
+    if(!joined)
+    {
+        qDebug()<<"[Multicast] : join error"<<group<<_socket.errorString();
+        _socket.close();
+        return false;
+    }
+
+    _group = address;
+    _iface = iface;
+    return true;
+}
+
+void MulticastReceiver::close()
+{
+    if(_socket.state() == QAbstractSocket::BoundState)
+    {
+        if(_iface.isValid())
+            _socket.leaveMulticastGroup(_group, _iface);
+        else
+            _socket.leaveMulticastGroup(_group);
+    }
+    _socket.close();
+}
+
+void MulticastReceiver::slotReadyRead()
+{
+    while(_socket.hasPendingDatagrams())
+    {
+        QNetworkDatagram datagram = _socket.receiveDatagram();
+        processDatagram(datagram.data());
+    }
+}
+
+void MulticastReceiver::processDatagram(const QByteArray &datagram)
+{
+    MulticastHeader header;
+    QVector<StructAircraft> records;
+    if(!_tracker.accept(datagram, header, records))
+        return;
+
+    if(header.snapshot != _snapshot || _parts == 0)
+    {
+        _snapshot = header.snapshot;
+        _parts = 0;
+        _snapshotIcao.clear();
+    }
+
+    for(const StructAircraft& a : records)
+    {
+        const uint32_t icao = a.icao & 0xffffff;
+        _snapshotIcao.insert(icao);
+
+        auto it = _objects.find(icao);
+        if(it == _objects.end() || it->seen <= a.seen)
+            _objects.insert(icao, a);
+    }
+
+    //датаграммы снимка идут подряд: снимок полон, если приняты все части
+    if(++_parts < int(header.parts))
+        return;
+
+    for(auto it = _objects.begin(); it != _objects.end();)
+    {
+        if(_snapshotIcao.contains(it.key()))
+            ++it;
+        else
+            it = _objects.erase(it);
+    }
+
+    _parts = 0;
+    emit snapshotReceived(header.snapshot, header.time);
+}
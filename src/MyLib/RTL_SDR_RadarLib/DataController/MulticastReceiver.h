@@ -0,0 +1,83 @@
+#ifndef MULTICASTRECEIVER_H
+#define MULTICASTRECEIVER_H
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QNetworkInterface>
+#include <QHash>
+#include <QSet>
+
+#include "datacontroller_global.h"
+#include "protocol/MulticastCodec.h"
+
+/*!
+ * \brief The MulticastReceiver class
+ * Прием рассылки снимков состояния самолётов.
+ * Записи каждой датаграммы применяются сразу, самолёты, отсутствующие
+ * в полностью принятом снимке, удаляются.
+ * Потери и перестановки датаграмм учитываются в счетчиках.
+ * \author Данильченко Артём
+ */
+class DATACONTROLLERSHARED_EXPORT MulticastReceiver : public QObject
+{
+    Q_OBJECT
+
+    QUdpSocket _socket;
+    QHostAddress _group;
+    QNetworkInterface _iface;
+    MulticastTracker _tracker;
+
+    ///< текущее состояние самолётов
+    QHash<uint32_t, StructAircraft> _objects;
+    ///< номер принимаемого снимка
+    uint32_t _snapshot = 0;
+    ///< принято датаграмм текущего снимка
+    int _parts = 0;
+    ///< самолёты текущего снимка
+    QSet<uint32_t> _snapshotIcao;
+
+    /*!
+     * \brief processDatagram применение датаграммы
+     */
+    void processDatagram(const QByteArray& datagram);
+
+public:
+    explicit MulticastReceiver(QObject* parent = nullptr);
+    ~MulticastReceiver() override;
+
+    /*!
+     * \brief open подключение к группе рассылки
+     * \param group - адрес группы
+     * \param port - порт
+     * \param iface - интерфейс, по умолчанию выбирается системой
+     * \return результат операции
+     */
+    bool open(const QString& group,
+              uint16_t port,
+              const QNetworkInterface& iface = QNetworkInterface());
+    /*!
+     * \brief close отключение от группы
+     */
+    void close();
+    /*!
+     * \brief objects текущее состояние самолётов
+     */
+    const QHash<uint32_t, StructAircraft>& objects() const { return _objects; }
+    /*!
+     * \brief stats счетчики приема
+     */
+    const MulticastRxStats& stats() const { return _tracker.stats(); }
+
+signals:
+    /*!
+     * \brief snapshotReceived все датаграммы снимка приняты
+     * \param snapshot - номер снимка
+     * \param time - время формирования снимка, мс
+     */
+    void snapshotReceived(quint32 snapshot, qint64 time);
+
+private slots:
+    void slotReadyRead();
+};
+
+#endif // MULTICASTRECEIVER_H
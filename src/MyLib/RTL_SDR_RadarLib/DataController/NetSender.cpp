@@ -0,0 +1,324 @@
+#include <QDebug>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "NetSender.h"
+#include "time/Clock.h"
+
+NetSender::NetSender(const QString &ip, uint16_t port):
+    _ip(ip),
+    _port(port),
+    _protocol(NET_PROTOCOL::RAW_DUMP),
+    _sendScheduled(false)
+{
+    qDebug()<<"create NetSender";
+}
+
+NetSender::~NetSender()
+{
+    qDebug()<<"delete NetSender";
+}
+
+void NetSender::start()
+{
+    if(_socket == nullptr)
+    {
+        _socket = new QTcpSocket(this);
+        connect(_socket, &QTcpSocket::connected,
+                this, &NetSender::slotConnected);
+        connect(_socket, &QTcpSocket::disconnected,
+                this, &NetSender::slotDisconnected);
+        connect(_socket, &QTcpSocket::readyRead,
+                this, &NetSender::slotReadyRead);
+        connect(_socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
+                this, &NetSender::slotError);
+
+        _reconnectTimer = new QTimer(this);
+        _reconnectTimer->setSingleShot(true);
+        connect(_reconnectTimer, &QTimer::timeout,
+                this, &NetSender::slotConnect);
+
+        _connectTimer = new QTimer(this);
+        _connectTimer->setSingleShot(true);
+        connect(_connectTimer, &QTimer::timeout,
+                this, &NetSender::slotConnectTimeout);
+
+        _statsTimer = new QTimer(this);
+        connect(_statsTimer, &QTimer::timeout,
+                this, &NetSender::slotPrintStats);
+    }
+
+    //размещение по умолчанию только фиксирует текущее состояние потока
+    slotApplyPlacement();
+
+    _stopped = false;
+    _reconnectInterval = RECONNECT_MIN;
+    _statsTimer->start(STATS_PERIOD);
+    slotConnect();
+}
+
+void NetSender::stop()
+{
+    _stopped = true;
+
+    if(_reconnectTimer != nullptr)
+        _reconnectTimer->stop();
+    if(_connectTimer != nullptr)
+        _connectTimer->stop();
+    if(_statsTimer != nullptr)
+        _statsTimer->stop();
+
+    if(_socket != nullptr)
+        _socket->abort();
+
+    _multicast.close();
+}
+
+void NetSender::setMulticast(const QString &group, quint16 port)
+{
+    if(group.isEmpty())
+        _multicast.close();
+    else
+        _multicast.open(group, port);
+}
+
+void NetSender::push(const QByteArray &dump, int64_t time)
+{
+    {
+        QMutexLocker lock(&_mutex);
+        if(_hasPending)
+            ++_stats.coalesced;
+
+        _pending = dump;
+        _pendingTime = time;
+        _hasPending = true;
+    }
+
+    //в очереди событий не более одного вызова отправки
+    if(!_sendScheduled.exchange(true))
+        QMetaObject::invokeMethod(this, "slotSend", Qt::QueuedConnection);
+}
+
+NetSenderStats NetSender::stats()
+{
+    QMutexLocker lock(&_mutex);
+    return _stats;
+}
+
+void NetSender::setPlacement(const ThreadPlacement &placement)
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _placement = placement;
+    }
+    QMetaObject::invokeMethod(this, "slotApplyPlacement", Qt::QueuedConnection);
+}
+
+PlacementReport NetSender::placement()
+{
+    QMutexLocker lock(&_mutex);
+    return _placementReport;
+}
+
+void NetSender::slotApplyPlacement()
+{
+    ThreadPlacement placement;
+    {
+        QMutexLocker lock(&_mutex);
+        placement = _placement;
+    }
+
+    const PlacementReport report = ThreadPlacer::apply("network", placement);
+
+    QMutexLocker lock(&_mutex);
+    _placementReport = report;
+}
+
+void NetSender::slotSend()
+{
+    _sendScheduled = false;
+
+    QByteArray dump;
+    int64_t time = 0;
+    {
+        QMutexLocker lock(&_mutex);
+        if(!_hasPending)
+            return;
+
+        dump.swap(_pending);
+        time = _pendingTime;
+        _hasPending = false;
+    }
+
+    if(_multicast.isOpen())
+        _multicast.publish(dump, time);
+
+    send(dump, time);
+}
+
+void NetSender::send(const QByteArray &dump, int64_t time)
+{
+    bool connected = (_socket != nullptr) &&
+            (_socket->state() == QAbstractSocket::ConnectedState);
+
+    //сервер не успевает принимать - не наращиваем буфер сокета
+    if(!connected || _socket->bytesToWrite() > MAX_BUFFERED)
+    {
+        QMutexLocker lock(&_mutex);
+        ++_stats.dropped;
+        return;
+    }
+
+    QByteArray message = dump;
+    if(_protocol == NET_PROTOCOL::DELTA)
+    {
+        message = _encoder.encode(dump, time);
+        if(message.isEmpty())
+            return;
+    }
+    else if(_protocol == NET_PROTOCOL::FRAMED)
+    {
+        message = _framer.snapshot(dump, time);
+        if(message.isEmpty())
+            return;
+    }
+
+    //запись выполняется циклом событий потока без ожидания
+    int64_t ret = _socket->write(message);
+    if(ret != message.size())
+    {
+        //неотправленное сообщение не подтверждено - следующий кадр полный
+        _encoder.reset();
+        QMutexLocker lock(&_mutex);
+        ++_stats.dropped;
+        return;
+    }
+
+    QMutexLocker lock(&_mutex);
+    ++_stats.sent;
+    _stats.bytes += uint64_t(ret);
+}
+
+void NetSender::setKeepAlive()
+{
+    _socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+
+    int fd = int(_socket->socketDescriptor());
+    if(fd < 0)
+        return;
+
+    int maxIdle = 5; /* seconds */
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &maxIdle, sizeof(maxIdle));
+
+    int count = 3;  // send up to 3 keepalive packets out, then disconnect if no response
+    setsockopt(fd, SOL_TCP, TCP_KEEPCNT, &count, sizeof(count));
+
+    int interval = 2;   // send a keepalive packet out every 2 seconds (after the 5 second idle period)
+    setsockopt(fd, SOL_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+}
+
+void NetSender::scheduleReconnect()
+{
+    if(_stopped || _reconnectTimer->isActive())
+        return;
+
+    _reconnectTimer->start(_reconnectInterval);
+    _reconnectInterval = qMin(_reconnectInterval * 2, RECONNECT_MAX);
+}
+
+void NetSender::slotConnect()
+{
+    if(_stopped || _socket == nullptr)
+        return;
+
+    if(_socket->state() != QAbstractSocket::UnconnectedState)
+        _socket->abort();
+
+    {
+        QMutexLocker lock(&_mutex);
+        ++_stats.reconnects;
+    }
+    //результат подключения приходит сигналом connected или error,
+    //при отсутствии ответа сервера - по таймеру ожидания
+    _socket->connectToHost(_ip, _port);
+    _connectTimer->start(CONNECT_TIMEOUT);
+}
+
+void NetSender::slotConnectTimeout()
+{
+    if(_stopped || _socket == nullptr ||
+            _socket->state() == QAbstractSocket::ConnectedState ||
+            _socket->state() == QAbstractSocket::UnconnectedState)
+        return;
+
+    qDebug()<<"[NetSender] : connect timeout"<<_ip<<_port;
+    //abort не выдает сигнал error - повторное подключение планируется здесь
+    _socket->abort();
+    scheduleReconnect();
+}
+
+void NetSender::slotConnected()
+{
+    _connectTimer->stop();
+    setKeepAlive();
+    _reconnectInterval = RECONNECT_MIN;
+    //сервер не имеет состояния - начинаем с полного кадра
+    _encoder.reset();
+    _requests.reset();
+    qDebug()<<"[NetSender] : connected to"<<_ip<<_port;
+}
+
+void NetSender::slotDisconnected()
+{
+    qDebug()<<"[NetSender] : disconnected from"<<_ip<<_port;
+    scheduleReconnect();
+}
+
+void NetSender::slotReadyRead()
+{
+    const QByteArray data = _socket->readAll();
+    const int64_t received = Clock::nowMSec();
+
+    //ответы передаются только в потоке кадров - в других форматах
+    //сервер их не разберет и запросов не отправляет
+    if(_protocol != NET_PROTOCOL::FRAMED)
+        return;
+
+    _requests.feed(data, [this, received](const FrameHeader& header, const char*)
+    {
+        if(header.type != FRAME_PING)
+            return;
+
+        const QByteArray pong = _framer.pong(header.time, received, Clock::nowMSec());
+        _socket->write(pong);
+
+        QMutexLocker lock(&_mutex);
+        _stats.bytes += uint64_t(pong.size());
+    });
+}
+
+void NetSender::slotError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+    if(_socket != nullptr && _socket->state() != QAbstractSocket::ConnectedState)
+    {
+        _connectTimer->stop();
+        scheduleReconnect();
+    }
+}
+
+void NetSender::slotPrintStats()
+{
+    NetSenderStats s = stats();
+    qDebug()<<"[NetSender] : sent"<<s.sent
+           <<"bytes"<<s.bytes
+           <<"coalesced"<<s.coalesced
+           <<"dropped"<<s.dropped
+           <<"reconnects"<<s.reconnects;
+
+    if(_multicast.isOpen())
+        qDebug()<<"[NetSender] : multicast datagrams"<<_multicast.stats().datagrams
+               <<"bytes"<<_multicast.stats().bytes
+               <<"errors"<<_multicast.stats().errors;
+}
@@ -0,0 +1,186 @@
+#ifndef NETSENDER_H
+#define NETSENDER_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QMutex>
+#include <atomic>
+
+#include "interface/INetworkWorker.h"
+#include "protocol/DeltaEncoder.h"
+#include "protocol/FrameCodec.h"
+#include "pipeline/ThreadPlacement.h"
+#include "MulticastPublisher.h"
+
+/*!
+ * @brief  Счетчики отправки данных на сервер
+ */
+struct NetSenderStats
+{
+    ///< отправлено сообщений
+    uint64_t sent = 0;
+    ///< отправлено байт
+    uint64_t bytes = 0;
+    ///< снимки, вытесненные более новым снимком до отправки
+    uint64_t coalesced = 0;
+    ///< снимки, отброшенные из-за отсутствия подключения или переполнения буфера сокета
+    uint64_t dropped = 0;
+    ///< попытки подключения
+    uint64_t reconnects = 0;
+};
+
+/*!
+ * \brief The NetSender class
+ * Отправка снимков состояния самолётов на сервер в отдельном потоке.
+ * Поток приема данных только кладет снимок в очередь и никогда не ждет сокет.
+ * Очередь хранит один снимок: каждый снимок содержит полный список самолётов,
+ * поэтому неотправленный снимок заменяется более новым.
+ * Подключение выполняется без блокировки, повторные попытки - с
+ * экспоненциально растущим интервалом. Попытка, не завершившаяся
+ * за CONNECT_TIMEOUT (сервер не отвечает на SYN), прерывается.
+ * В формате кадров пункт отвечает на запросы сервера FRAME_PING,
+ * по которым сервер оценивает смещение часов пункта.
+ * Дополнительно снимки могут рассылаться в группу UDP multicast.
+ * Объект должен жить в собственном потоке (moveToThread).
+ * \author Данильченко Артём
+ */
+class NetSender : public QObject
+{
+    Q_OBJECT
+
+    ///< начальный интервал повторного подключения, мс
+    const int RECONNECT_MIN = 250;
+    ///< максимальный интервал повторного подключения, мс
+    const int RECONNECT_MAX = 30000;
+    ///< время ожидания подключения, мс
+    const int CONNECT_TIMEOUT = 5000;
+    ///< максимальный объем неотправленных данных в буфере сокета, байт
+    const int64_t MAX_BUFFERED = 256 * 1024;
+    ///< период вывода счетчиков, мс
+    const int STATS_PERIOD = 60000;
+
+    QString _ip;
+    uint16_t _port = 0;
+
+    ///< сокет, создается в потоке отправки
+    QTcpSocket* _socket = nullptr;
+    ///< таймер повторного подключения
+    QTimer* _reconnectTimer = nullptr;
+    ///< таймер ожидания подключения
+    QTimer* _connectTimer = nullptr;
+    ///< таймер вывода счетчиков
+    QTimer* _statsTimer = nullptr;
+    ///< текущий интервал повторного подключения, мс
+    int _reconnectInterval = RECONNECT_MIN;
+    bool _stopped = true;
+
+    ///< формат передачи данных
+    std::atomic<NET_PROTOCOL> _protocol;
+    ///< формирование разностных сообщений, используется только потоком отправки
+    DeltaEncoder _encoder;
+    ///< формирование кадров, используется только потоком отправки
+    FrameWriter _framer;
+    ///< разбор кадров, принятых от сервера
+    FrameParser _requests;
+
+    ///< рассылка снимков в группу multicast
+    MulticastPublisher _multicast;
+
+    ///< защита очереди и счетчиков
+    QMutex _mutex;
+    ///< ожидающий отправки снимок
+    QByteArray _pending;
+    ///< время формирования ожидающего снимка, мс
+    int64_t _pendingTime = 0;
+    bool _hasPending = false;
+    ///< отправка уже запланирована в потоке отправки
+    std::atomic<bool> _sendScheduled;
+    NetSenderStats _stats;
+    ///< размещение потока отправки: запрошенное и фактическое
+    ThreadPlacement _placement;
+    PlacementReport _placementReport;
+
+    /*!
+     * \brief setKeepAlive настройка проверки соединения на уровне TCP
+     */
+    void setKeepAlive();
+    /*!
+     * \brief scheduleReconnect повторное подключение с удвоением интервала
+     */
+    void scheduleReconnect();
+    /*!
+     * \brief send отправка снимка в сокет
+     * \param dump - список самолётов
+     * \param time - время формирования снимка, мс
+     */
+    void send(const QByteArray& dump, int64_t time);
+
+public:
+    NetSender(const QString& ip, uint16_t port);
+    ~NetSender() override;
+
+    /*!
+     * \brief push постановка снимка в очередь отправки.
+     * Вызывается из любого потока, не блокируется на сети
+     * \param dump - список самолётов (IDemodulator::getRawDumpOfObjectsInfo)
+     * \param time - время формирования снимка, мс
+     */
+    void push(const QByteArray& dump, int64_t time);
+    /*!
+     * \brief setNetProtocol выбор формата передачи данных
+     */
+    void setNetProtocol(NET_PROTOCOL protocol) { _protocol = protocol; }
+    /*!
+     * \brief stats текущие значения счетчиков
+     */
+    NetSenderStats stats();
+    /*!
+     * \brief setPlacement размещение потока отправки.
+     * Вызывается из любого потока, применяется потоком отправки
+     */
+    void setPlacement(const ThreadPlacement& placement);
+    /*!
+     * \brief placement фактическое размещение потока отправки
+     */
+    PlacementReport placement();
+
+public slots:
+    /*!
+     * \brief start создание сокета и подключение к серверу
+     */
+    void start();
+    /*!
+     * \brief stop закрытие подключения
+     */
+    void stop();
+    /*!
+     * \brief setMulticast включение рассылки снимков
+     * \param group - адрес группы, пустая строка - рассылка выключена
+     * \param port - порт получателей
+     */
+    void setMulticast(const QString& group, quint16 port);
+
+private slots:
+    void slotSend();
+    /*!
+     * \brief slotApplyPlacement применение размещения к потоку отправки
+     */
+    void slotApplyPlacement();
+    void slotConnect();
+    void slotConnected();
+    /*!
+     * \brief slotConnectTimeout прерывание зависшей попытки подключения
+     */
+    void slotConnectTimeout();
+    void slotDisconnected();
+    /*!
+     * \brief slotReadyRead прием запросов сервера: ответ на FRAME_PING
+     * отправляется сразу, минуя очередь снимков
+     */
+    void slotReadyRead();
+    void slotError(QAbstractSocket::SocketError error);
+    void slotPrintStats();
+};
+
+#endif // NETSENDER_H
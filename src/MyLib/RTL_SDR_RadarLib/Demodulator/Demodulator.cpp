@@ -31,9 +31,14 @@
 #include <math.h>
 #include <QDateTime>
 #include <QDebug>
+#include <QFile>
+#include <QSaveFile>
 
 #include "Demodulator.h"
+#include "StateSnapshot.h"
 #include "objects/air/Aircraft.h"
+#include "time/Clock.h"
+#include "protocol/Crc32.h"
 
 /* Capability table. */
 static const char *ca_str[8] = {
@@ -123,6 +128,7 @@ Demodulator::~Demodulator()
 bool Demodulator::setDataForDemodulate(const QVector<uint8_t> &vector)
 {
     computeMagnitudeVector(vector,_magnitude);
+    return true;
 }
 
 void Demodulator::run()
@@ -156,12 +162,23 @@ QByteArray Demodulator::getRawDumpOfObjectsInfo()
 }
 
 bool Demodulator::demodulate()
+{
+    return demodulate(_magnitude);
+}
+
+void Demodulator::computeMagnitude(const QVector<uint8_t> &vector,
+                                   QVector<uint16_t> &magnitude) const
+{
+    computeMagnitudeVector(vector, magnitude);
+}
+
+bool Demodulator::demodulate(QVector<uint16_t> &magnitude)
 {
     if(_pool.isNull())
         return  false;
 
     _pool->lockPool();
-    detectModeS(_magnitude.data(),_magnitude.size());
+    detectModeS(magnitude.data(),magnitude.size());
     _pool->unlockPool();
     return true;
 }
@@ -174,15 +191,194 @@ int32_t Demodulator::getCountObject()
     return _pool->values().count();
 }
 
+bool Demodulator::saveState(const QString &fileName)
+{
+    if(_pool.isNull() || fileName.isEmpty())
+        return false;
+
+    const uint32_t now = uint32_t(time(NULL));
+    QByteArray payload;
+
+    /* ICAO cache: only entries that are still valid. */
+    uint32_t icaoCount = 0;
+    for(int i = 0; i < MODES_ICAO_CACHE_LEN; i++)
+    {
+        SnapshotIcaoEntry entry;
+        entry.icao = icao_cache[i*2];
+        entry.seen = icao_cache[i*2+1];
+        if(entry.icao == 0 || now - entry.seen > MODES_ICAO_CACHE_TTL)
+            continue;
+
+        payload.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        ++icaoCount;
+    }
+
+    uint32_t aircraftCount = 0;
+    _pool->lockPool();
+    for(auto &object: _pool->values())
+    {
+        QSharedPointer<Aircraft> air = qSharedPointerCast<Aircraft>(object);
+        if(air.isNull())
+            continue;
+
+        SnapshotAircraft record;
+        memset(&record, 0, sizeof(record));
+        record.icao = air->getICAO();
+        QByteArray flight = air->getFlightInfo().toLatin1();
+        memcpy(record.flight, flight.constData(),
+               size_t(qMin(flight.size(), int(sizeof(record.flight)) - 1)));
+        record.altitude = air->getAltitude();
+        record.speed = air->getSpeed();
+        record.course = air->getCourse();
+        record.lat = air->getLatitude();
+        record.lon = air->getLongitude();
+        record.tstart = air->getNSecStart();
+        record.tstop = air->getNSecStop();
+        record.messages = air->getNumberMsg();
+        record.oddCprLat = air->getOddCprLat();
+        record.oddCprLon = air->getOddCprLon();
+        record.oddCprTime = air->getOddCprTime();
+        record.evenCprLat = air->getEvenCprLat();
+        record.evenCprLon = air->getEvenCprLon();
+        record.evenCprTime = air->getEvenCprTime();
+
+        payload.append(reinterpret_cast<const char*>(&record), sizeof(record));
+        ++aircraftCount;
+    }
+    _pool->unlockPool();
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.savedAt = Clock::nowNSec();
+    header.icaoCount = icaoCount;
+    header.aircraftCount = aircraftCount;
+    header.payloadSize = uint32_t(payload.size());
+    header.checksum = frameCrc32(payload.constData(), size_t(payload.size()));
+
+    /* QSaveFile writes a temporary file and renames it on commit,
+     * so a crash while saving keeps the previous snapshot. */
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        addDebugMsg(QString("Can't save state to %1\n").arg(fileName));
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(payload);
+
+    return file.commit();
+}
+
+int32_t Demodulator::loadState(const QString &fileName)
+{
+    if(_pool.isNull())
+        return -1;
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    QByteArray data = file.readAll();
+    if(data.size() < int(sizeof(SnapshotHeader)))
+        return -1;
+
+    SnapshotHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+
+    const char* payload = data.constData() + sizeof(header);
+    const qint64 expectedSize = qint64(header.icaoCount) * qint64(sizeof(SnapshotIcaoEntry)) +
+            qint64(header.aircraftCount) * qint64(sizeof(SnapshotAircraft));
+
+    if(memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != SNAPSHOT_VERSION ||
+            qint64(header.payloadSize) != expectedSize ||
+            qint64(header.payloadSize) != qint64(data.size()) - qint64(sizeof(header)) ||
+            header.checksum != frameCrc32(payload, header.payloadSize))
+    {
+        qDebug()<<"[Demodulator] : wrong state file"<<fileName;
+        return -1;
+    }
+
+    /* ICAO cache entries expire by MODES_ICAO_CACHE_TTL. */
+    const uint32_t now = uint32_t(time(NULL));
+    for(uint32_t i = 0; i < header.icaoCount; i++)
+    {
+        SnapshotIcaoEntry entry;
+        memcpy(&entry, payload, sizeof(entry));
+        payload += sizeof(entry);
+
+        if(entry.icao == 0 || now - entry.seen > MODES_ICAO_CACHE_TTL)
+            continue;
+
+        uint32_t h = ICAOCacheHashAddress(entry.icao);
+        icao_cache[h*2] = entry.icao;
+        icao_cache[h*2+1] = entry.seen;
+    }
+
+    /* Aircraft expire by the pool TTL of the object type. */
+    const int64_t nowNs = Clock::nowNSec();
+    const int64_t ttl = Clock::fromMSec(_pool->getObjectTTL(OBJECT_TYPE::air));
+    int32_t counter = 0;
+
+    _pool->lockPool();
+    for(uint32_t i = 0; i < header.aircraftCount; i++)
+    {
+        SnapshotAircraft record;
+        memcpy(&record, payload, sizeof(record));
+        payload += sizeof(record);
+
+        if(record.icao == 0 ||
+                nowNs - record.tstop > ttl ||
+                _pool->isExistsObject(record.icao))
+            continue;
+
+        QSharedPointer<Aircraft> air =
+                qSharedPointerCast<Aircraft>(_pool->createNewObject(record.icao,
+                                                                    record.tstart,
+                                                                    Position()));
+        if(air.isNull())
+            continue;
+
+        const int64_t lastMs = Clock::toMSec(record.tstop);
+        record.flight[sizeof(record.flight) - 1] = 0;
+        if(record.flight[0] != 0)
+            air->setFlightInfo(record.flight);
+        air->setAltitude(record.altitude);
+        air->setNumberMsg(record.messages);
+
+        if(fabs(record.lat) <= 90.0 && fabs(record.lon) <= 180.0 &&
+                air->updatePosition(lastMs, Position(record.lon, record.lat)))
+            _pool->updateGeoIndex(record.icao);
+
+        if(record.speed > 0)
+            air->updateVelocity(lastMs, record.speed, record.course);
+
+        air->setOddCprLat(record.oddCprLat);
+        air->setOddCprLon(record.oddCprLon);
+        air->setOddCprTime(record.oddCprTime);
+        air->setEvenCprLat(record.evenCprLat);
+        air->setEvenCprLon(record.evenCprLon);
+        air->setEvenCprTime(record.evenCprTime);
+        air->setNSecStop(record.tstop);
+        ++counter;
+    }
+    _pool->unlockPool();
+
+    qDebug()<<"[Demodulator] : restored aircrafts"<<counter;
+    return counter;
+}
+
 
 /* Turn I/Q samples pointed by data into the magnitude vector
  * pointed by magnitude. */
 void Demodulator::computeMagnitudeVector(const QVector<uint8_t> &vector,
-                                         QVector<uint16_t> &magnitude)
+                                         QVector<uint16_t> &magnitude) const
 {
     int len = vector.size();
-    if(_magnitude.size() < len / 2)
-        _magnitude.resize(len / 2);
+    if(magnitude.size() != len / 2)
+        magnitude.resize(len / 2);
 
     uint16_t *m = magnitude.data();
     const unsigned char *p = vector.data();
@@ -460,7 +656,7 @@ good_preamble:
         }
 
         /* Retry with phase correction if possible. */
-        if (!good_message && !use_correction)
+        if (!good_message && !use_correction && phase_correction)
         {
             j--;
             use_correction = true;
@@ -631,7 +827,7 @@ void Demodulator::decodeModesMessage(struct modesMessage *mm, unsigned char *msg
             mm->crc = modesChecksum(msg,mm->msgbits);
             mm->crcok = 1;
         } else
-            if (aggressive && mm->msgtype == 17 &&
+            if (aggressive && two_bits_fix && mm->msgtype == 17 &&
                     (mm->errorbit = fixTwoBitsErrors(msg,mm->msgbits)) != -1)
             {
                 mm->crc = modesChecksum(msg,mm->msgbits);
@@ -984,6 +1180,11 @@ void Demodulator::interactiveReceiveData(struct modesMessage *mm)
     addr = (mm->aa1 << 16) | (mm->aa2 << 8) | mm->aa3;
     if(addr == 0)
         return;
+
+    /* One clock read per message, QDateTime is built only for display. */
+    const int64_t now = Clock::nowNSec();
+    const int64_t nowMs = Clock::toMSec(now);
+
     /* Loookup our aircraft or create a new one. */
 
     QSharedPointer<Aircraft> air = nullptr;
@@ -991,7 +1192,7 @@ void Demodulator::interactiveReceiveData(struct modesMessage *mm)
     if (!_pool->isExistsObject(addr))
     {
         air = qSharedPointerCast<Aircraft>(_pool->createNewObject(addr,
-                                                                  QDateTime::currentDateTime(),
+                                                                  now,
                                                                   Position()));
         addDebugMsg(QString("Add new aircraft with ICAO : %1\n")
                     .arg(addr,16,16));
@@ -1020,7 +1221,7 @@ void Demodulator::interactiveReceiveData(struct modesMessage *mm)
         return;
     }
 
-    air->setDateTimeStop(QDateTime::currentDateTime());
+    air->setNSecStop(now);
 
     if (mm->msgtype == 0 || mm->msgtype == 4 || mm->msgtype == 20)
         air->setAltitude( mm->altitude / CONVERT_FT_TO_METERS);
@@ -1037,25 +1238,34 @@ void Demodulator::interactiveReceiveData(struct modesMessage *mm)
             {
                 air->setOddCprLat( mm->raw_latitude);
                 air->setOddCprLon(mm->raw_longitude);
-                air->setOddCprTime(QDateTime::currentMSecsSinceEpoch());
+                air->setOddCprTime(nowMs);
             }
             else
             {
                 air->setEvenCprLat(mm->raw_latitude);
                 air->setEvenCprLon(mm->raw_longitude);
-                air->setEvenCprTime(QDateTime::currentMSecsSinceEpoch());
+                air->setEvenCprTime(nowMs);
             }
             /* If the two data is less than 10 seconds apart, compute
              * the position. */
             if (abs(air->getEvenCprTime() - air->getOddCprTime()) <= 10000)
-                decodeCPR(air);
+            {
+                if(decodeCPR(air))
+                {
+                    air->updateTrack(nowMs);
+                    _pool->updateGeoIndex(addr);
+                    archiveAircraft(air, nowMs);
+                }
+            }
         }
         else if (mm->metype == 19)
         {
             if (mm->mesub == 1 || mm->mesub == 2)
             {
-                air->setSpeed( mm->velocity * CONVERT_KN_TO_KM_P_H);
-                air->setCourse(mm->heading);
+                air->updateVelocity(nowMs,
+                                    mm->velocity * CONVERT_KN_TO_KM_P_H,
+                                    mm->heading);
+                archiveAircraft(air, nowMs);
             }
         }
     }
@@ -1071,7 +1281,7 @@ void Demodulator::interactiveReceiveData(struct modesMessage *mm)
  *    simplicity. This may provide a position that is less fresh of a few
  *    seconds.
  */
-void Demodulator::decodeCPR(QSharedPointer<Aircraft> a)
+bool Demodulator::decodeCPR(QSharedPointer<Aircraft> a)
 {
     const double AirDlat0 = 360.0 / 60.0;
     const double AirDlat1 = 360.0 / 59.0;
@@ -1092,7 +1302,10 @@ void Demodulator::decodeCPR(QSharedPointer<Aircraft> a)
 
     /* Check that both are in the same latitude zone, or abort. */
     if (cprNLFunction(rlat0) != cprNLFunction(rlat1))
-        return;
+        return false;
+
+    double lat = 0.0;
+    double lon = 0.0;
 
     /* Compute ni and the longitude index m */
     if (a->getEvenCprTime() > a->getOddCprTime())
@@ -1101,8 +1314,8 @@ void Demodulator::decodeCPR(QSharedPointer<Aircraft> a)
         int ni = cprNFunction(rlat0,0);
         int m = int(floor((((lon0 * (cprNLFunction(rlat0)-1.0)) -
                             (lon1 * cprNLFunction(rlat0))) / 131072.0) + 0.5));
-        a->setLongitude(cprDlonFunction(rlat0,0) * (cprModFunction(m,ni)+lon0/131072));
-        a->setLatitude(rlat0);
+        lon = cprDlonFunction(rlat0,0) * (cprModFunction(m,ni)+lon0/131072);
+        lat = rlat0;
     }
     else
     {
@@ -1110,11 +1323,15 @@ void Demodulator::decodeCPR(QSharedPointer<Aircraft> a)
         int ni = cprNFunction(rlat1,1);
         int m = int(floor((((lon0 * (cprNLFunction(rlat1) - 1.0)) -
                             (lon1 * cprNLFunction(rlat1))) / 131072.0) + 0.5));
-        a->setLongitude(cprDlonFunction(rlat1,1) * (cprModFunction(m,ni)+lon1/131072.0));
-        a->setLatitude(rlat1);
+        lon = cprDlonFunction(rlat1,1) * (cprModFunction(m,ni)+lon1/131072.0);
+        lat = rlat1;
     }
-    if (a->getLongitude() > 180.0)
-        a->setLongitude(a->getLongitude() - 360.0);
+    if (lon > 180.0)
+        lon -= 360.0;
+
+    /* Reject solutions that don't fit the aircraft track. */
+    return a->updatePosition(qMax(a->getEvenCprTime(), a->getOddCprTime()),
+                             Position(lon, lat));
 }
 
 int Demodulator::cprModFunction(int a, int b)
@@ -1497,24 +1714,36 @@ QString Demodulator::getMEDescription(int metype, int mesub)
 
 
 /* When in interactive mode If we don't receive new nessages within
- * MODES_INTERACTIVE_TTL seconds we remove the aircraft from the list. */
+ * the TTL configured in the pool we remove the aircraft from the list.
+ * The pool keeps a timing wheel, so only expired entries are visited. */
 void Demodulator::interactiveRemoveStaleAircrafts()
 {
-    int64_t now = QDateTime::currentMSecsSinceEpoch();
+    int removed = _pool->removeStaleObjects(Clock::nowMSec());
 
-    for(auto &a: _pool->values())
-    {
-        if((now - a->getMSecStop()) > MODES_INTERACTIVE_TTL)
-        {
+    if(removed > 0)
+        addDebugMsg(QString("Remove stale aircrafts : %1\n").arg(removed));
+}
+
+void Demodulator::archiveAircraft(const QSharedPointer<Aircraft> &air, int64_t time)
+{
+    if(_archive.isNull())
+        return;
 
-            addDebugMsg(QString("Remove aircraft with ICAO : %1 \n last update : %2\n")
-                        .arg(a->getId(),16,16)
-                        .arg(a->getDateTimeStop().toString("hh:mm:ss.zzz")));
+    /* Only aircraft with a decoded position are archived. */
+    Position pos = air->getGeoCoord();
+    if(fabs(pos.latitude()) > 90.0 || fabs(pos.longitude()) > 180.0)
+        return;
 
-            _pool->deleteObject(a->getId());
-            a.clear();
-        }
-    }
+    ArchivePoint point;
+    point.icao = air->getICAO();
+    point.time = time;
+    point.latitude = pos.latitude();
+    point.longitude = pos.longitude();
+    point.altitude = air->getAltitude();
+    point.speed = air->getSpeed();
+    point.course = air->getCourse();
+
+    _archive->append(point);
 }
 
 void Demodulator::addDebugMsg(const QString &str)
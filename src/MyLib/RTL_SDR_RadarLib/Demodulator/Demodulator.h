@@ -38,6 +38,7 @@
 #include "interface/IDemodulator.h"
 #include "interface/IPoolObject.h"
 #include "interface/ILogger.h"
+#include "interface/ITrackArchive.h"
 
 #include "sdr_dev/include/constant.h"
 
@@ -101,6 +102,7 @@ class DEMODULATORSHARED_EXPORT Demodulator : public IDemodulator
 
     QSharedPointer<IPoolObject> _pool;
     QSharedPointer<ILogger> _log;
+    QSharedPointer<ITrackArchive> _archive;
 
     /* Statistics */
     uint64_t stat_valid_preamble = 0;
@@ -119,14 +121,16 @@ class DEMODULATORSHARED_EXPORT Demodulator : public IDemodulator
     bool check_crc = true;
     /* Debugging mode. */
     bool debug = false;
-    /* Interactive mode: TTL before deletion. */
-    int interactive_ttl = MODES_INTERACTIVE_TTL;
     /* Print only ICAO addresses. */
     bool onlyaddr = false;
     /* Use metric units. */
     bool metric = true;
     /* Aggressive detection algorithm. */
     bool aggressive = false;
+    ///< исправление двухбитовых ошибок в агрессивном режиме
+    bool two_bits_fix = true;
+    ///< повторная демодуляция с коррекцией фазы
+    bool phase_correction = true;
     ///< вектор рассчета огибающей
     uint16_t* maglut;
 public:
@@ -136,6 +140,10 @@ public:
      *  \brief внедрение зависимости модуля логгирования
      */
     void setLogger(QSharedPointer<ILogger> log) override { _log = log;}
+    /*!
+     *  \brief внедрение зависимости архива траекторий
+     */
+    void setTrackArchive(QSharedPointer<ITrackArchive> archive) override { _archive = archive; }
     /*!
      *  \brief установка массива данных для демодуляции
      *  \param  vector - массив 8битных отсчётов
@@ -155,10 +163,40 @@ public:
      *  \brief функция демодуляции
      */
     bool demodulate() override;
+    /*!
+     *  \brief расчет огибающей без изменения состояния
+     */
+    void computeMagnitude(const QVector<uint8_t>& vector,
+                          QVector<uint16_t>& magnitude) const override;
+    /*!
+     *  \brief демодуляция по рассчитанной огибающей
+     */
+    bool demodulate(QVector<uint16_t>& magnitude) override;
+    /*!
+     *  \brief агрессивный режим обнаружения
+     */
+    void setAggressive(bool state) override { aggressive = state; }
+    bool isAggressive() const override { return aggressive; }
+    /*!
+     *  \brief исправление двухбитовых ошибок в агрессивном режиме
+     */
+    void setTwoBitsFix(bool state) override { two_bits_fix = state; }
+    /*!
+     *  \brief повторная демодуляция с коррекцией фазы
+     */
+    void setPhaseCorrection(bool state) override { phase_correction = state; }
     /*!
      *  \brief получение количества объектов
      */
     int32_t getCountObject() override;
+    /*!
+     *  \brief сохранение состояния в файл
+     */
+    bool saveState(const QString& fileName) override;
+    /*!
+     *  \brief восстановление состояния из файла
+     */
+    int32_t loadState(const QString& fileName) override;
 
 private:
     /*!
@@ -169,7 +207,7 @@ private:
      * \param magnitude - вектор огибающей
      */
     void computeMagnitudeVector(const QVector<uint8_t> &vector,
-                                QVector<uint16_t> &magnitude);
+                                QVector<uint16_t> &magnitude) const;
     /*!
      * \brief detectModeS
      * Detect a Mode S messages inside the magnitude buffer pointed by 'm' and of
@@ -326,8 +364,10 @@ private:
 
     /*!
      * \brief decodeCPR Decoding ADS-B position
+     * \return true - position updated, false - CPR halves are in different
+     * zones or the solution was rejected by the track predictor
      */
-    void decodeCPR(QSharedPointer<Aircraft> a);
+    bool decodeCPR(QSharedPointer<Aircraft> a);
 
     /*!
      * \brief cprModFunction
@@ -360,10 +400,17 @@ private:
     /*!
      * \brief interactiveRemoveStaleAircrafts
      * When in interactive mode If we don't receive new nessages within
-     * MODES_INTERACTIVE_TTL seconds we remove the aircraft from the list.
+     * the TTL of the object type (see IPoolObject::setObjectTTL)
+     * we remove the aircraft from the list.
      */
     void interactiveRemoveStaleAircrafts();
 
+    /*!
+     * \brief archiveAircraft запись состояния самолёта в архив траекторий
+     * \param time - время в мс с начала эпохи
+     */
+    void archiveAircraft(const QSharedPointer<Aircraft>& air, int64_t time);
+
     /*!
      * \brief addDebugMsg add debug message in log
      */
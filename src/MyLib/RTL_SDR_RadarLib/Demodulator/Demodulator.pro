@@ -25,15 +25,25 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
         Demodulator.cpp \
     ../../../include/objects/base/BaseObject.cpp \
-    ../../../include/objects/air/Aircraft.cpp
+    ../../../include/objects/air/Aircraft.cpp \
+    ../../../include/objects/air/TrackHistory.cpp \
+    ../../../include/objects/air/TrackPredictor.cpp \
+    ../../../include/protocol/Crc32.cpp
 
 HEADERS += \
         ../../../include/interface/IDemodulator.h \
         Demodulator.h \
+        StateSnapshot.h \
+    ../../../include/interface/ITrackArchive.h \
         demodulator_global.h \ 
     ../../../include/objects/base/BaseObject.h \
+    ../../../include/objects/base/StateColumns.h \
+    ../../../include/time/Clock.h \
     ../../../include/objects/air/Aircraft.h \
     ../../../include/objects/air/StructAircraft.h \
+    ../../../include/objects/air/TrackHistory.h \
+    ../../../include/objects/air/TrackPredictor.h \
+    ../../../include/protocol/Crc32.h \
     ../../../include/interface/IObject.h
 
 unix {
@@ -0,0 +1,88 @@
+#ifndef STATESNAPSHOT_H
+#define STATESNAPSHOT_H
+
+#include <stdint.h>
+
+/*
+ * Layout of the demodulator state file:
+ *
+ *   SnapshotHeader
+ *   SnapshotIcaoEntry[icaoCount]        recently seen ICAO addresses
+ *   SnapshotAircraft[aircraftCount]     live aircraft
+ *
+ * checksum is CRC-32 (frameCrc32) over everything after the header.
+ */
+
+///< сигнатура файла
+constexpr char SNAPSHOT_MAGIC[4] = { 'R', 'S', 'N', 'P' };
+///< версия формата
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+/*!
+ * @brief  Заголовок файла состояния демодулятора.
+ */
+#pragma pack(push,1)
+struct SnapshotHeader
+{
+    /* File signature */
+    char magic[4];
+    /* Format version */
+    uint32_t version;
+    /* Save time, ns since epoch */
+    int64_t savedAt;
+    /* Number of ICAO cache entries */
+    uint32_t icaoCount;
+    /* Number of aircraft records */
+    uint32_t aircraftCount;
+    /* Size of the data after the header */
+    uint32_t payloadSize;
+    /* Checksum of the data after the header */
+    uint32_t checksum;
+};
+
+/*!
+ * @brief  Адрес из кэша недавно принятых адресов ICAO.
+ */
+struct SnapshotIcaoEntry
+{
+    /* ICAO address */
+    uint32_t icao;
+    /* Time the address was seen, s since epoch */
+    uint32_t seen;
+};
+
+/*!
+ * @brief  Состояние самолёта.
+ */
+struct SnapshotAircraft
+{
+    /* ICAO address */
+    uint32_t icao;
+    /* Flight number */
+    char flight[9];
+    /* Altitude, m */
+    float altitude;
+    /* Speed, km/h */
+    float speed;
+    /* Course, degrees */
+    float course;
+    /* Latitude, degrees */
+    double lat;
+    /* Longitude, degrees */
+    double lon;
+    /* First and last message time, ns since epoch */
+    int64_t tstart;
+    int64_t tstop;
+    /* Number of Mode S messages received. */
+    uint64_t messages;
+    /* Pending CPR halves, time in ms since epoch */
+    int32_t oddCprLat;
+    int32_t oddCprLon;
+    int64_t oddCprTime;
+    int32_t evenCprLat;
+    int32_t evenCprLon;
+    int64_t evenCprTime;
+};
+#pragma pack(pop)
+
+#endif // STATESNAPSHOT_H
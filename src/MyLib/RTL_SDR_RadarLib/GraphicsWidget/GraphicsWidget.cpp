@@ -255,7 +255,7 @@ void GraphicsWidget::updateObjectOnScene(QSharedPointer<IObject> &object)
         return;
 
     graphItem->setRotateAngle(object->getCourse());
-    graphItem->setGeoPosition(object->getGeoCoord());
+    graphItem->setGeoPosition(object->getPredictedGeoCoord(QDateTime::currentMSecsSinceEpoch()));
     graphItem->setAzimuth(object->getAzimuth());
     graphItem->setText(QString::number(object->getId(),16) + "/" + object->getObjectName());
 }
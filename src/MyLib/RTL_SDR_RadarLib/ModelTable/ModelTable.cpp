@@ -160,6 +160,8 @@ QVariant ModelTable::headerData(int section, Qt::Orientation orientation, int ro
             return trUtf8("Скорость");
         case GEOCOORD:
             return trUtf8("Ш,°/\nД,°");
+        case INFO:
+            return trUtf8("Борт /\nВладелец");
     }
 
     return QVariant();
@@ -204,6 +206,8 @@ void ModelTable::appendData(QSharedPointer<IObject> &object)
                 .arg(object->getGeoCoord().latitude())
                 .arg(object->getGeoCoord().longitude()));
 
+    data.insert(INFO, object->getObjectDescription());
+
     int row = _listSrc.count();
     beginInsertRows( QModelIndex(), row, row );
     _listSrc.insert(object->getId(), data);
@@ -279,6 +283,8 @@ void ModelTable::updateData(QSharedPointer<IObject> &object)
             .arg(lon);
 
     _listSrc[object->getId()][GEOCOORD] = str_geo;
+
+    _listSrc[object->getId()][INFO] = object->getObjectDescription();
 }
 
 
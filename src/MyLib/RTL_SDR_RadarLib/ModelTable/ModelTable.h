@@ -29,6 +29,7 @@ enum Column {
     ALTITUDE,
     SPEED,
     GEOCOORD,
+    INFO,
     LAST
 };
 
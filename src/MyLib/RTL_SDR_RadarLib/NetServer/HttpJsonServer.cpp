@@ -0,0 +1,63 @@
+#include "HttpJsonServer.h"
+
+#include <QDebug>
+
+#include "http/HttpWorker.h"
+
+HttpJsonServer::HttpJsonServer(QSharedPointer<IPoolObject> pool)
+{
+    _thread = new QThread();
+    _worker = new HttpWorker(pool);
+    _worker->moveToThread(_thread);
+    _thread->start();
+
+    qDebug()<<"create HttpJsonServer";
+}
+
+HttpJsonServer::~HttpJsonServer()
+{
+    stop();
+
+    _thread->quit();
+    _thread->wait();
+
+    delete _worker;
+    delete _thread;
+
+    qDebug()<<"delete HttpJsonServer";
+}
+
+bool HttpJsonServer::start(uint16_t port)
+{
+    bool result = false;
+    QMetaObject::invokeMethod(_worker, "listen",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, result),
+                              Q_ARG(quint16, port));
+    return result;
+}
+
+void HttpJsonServer::stop()
+{
+    if(_thread->isRunning())
+        QMetaObject::invokeMethod(_worker, "close", Qt::BlockingQueuedConnection);
+}
+
+bool HttpJsonServer::isListening()
+{
+    bool result = false;
+    QMetaObject::invokeMethod(_worker, "isListening",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, result));
+    return result;
+}
+
+void HttpJsonServer::setReceiverStats(const QJsonObject &stats)
+{
+    _worker->setReceiverStats(stats);
+}
+
+HttpServerStats HttpJsonServer::stats()
+{
+    return _worker->stats();
+}
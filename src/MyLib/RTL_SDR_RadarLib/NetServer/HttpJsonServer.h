@@ -0,0 +1,40 @@
+#ifndef HTTPJSONSERVER_H
+#define HTTPJSONSERVER_H
+
+#include <QThread>
+#include <QSharedPointer>
+
+#include "netserver_global.h"
+#include "interface/IHttpServer.h"
+#include "interface/IPoolObject.h"
+
+class HttpWorker;
+
+/*!
+ * \brief The HttpJsonServer class
+ * Встроенный HTTP сервер: выдача списка самолётов (/data/aircraft.json)
+ * и счетчиков приемника (/data/stats.json) браузерам и скриптам.
+ * Подключения обслуживаются циклом событий отдельного потока.
+ * \author Данильченко Артем
+ */
+class NETSERVERSHARED_EXPORT HttpJsonServer : public IHttpServer
+{
+    QThread* _thread = nullptr;
+    HttpWorker* _worker = nullptr;
+
+public:
+    /*!
+     * \brief HttpJsonServer конструктор
+     * \param pool - пул объектов, данные которого выдаются клиентам
+     */
+    explicit HttpJsonServer(QSharedPointer<IPoolObject> pool);
+    ~HttpJsonServer() override;
+
+    bool start(uint16_t port) override;
+    void stop() override;
+    bool isListening() override;
+    void setReceiverStats(const QJsonObject& stats) override;
+    HttpServerStats stats() override;
+};
+
+#endif // HTTPJSONSERVER_H
@@ -0,0 +1,63 @@
+#include "IngestServer.h"
+
+#include <QDebug>
+
+#include "ingest/IngestWorker.h"
+
+IngestServer::IngestServer(QSharedPointer<IPoolObject> pool)
+{
+    _thread = new QThread();
+    _worker = new IngestWorker(pool);
+    _worker->moveToThread(_thread);
+    _thread->start();
+
+    qDebug()<<"create IngestServer";
+}
+
+IngestServer::~IngestServer()
+{
+    stop();
+
+    _thread->quit();
+    _thread->wait();
+
+    delete _worker;
+    delete _thread;
+
+    qDebug()<<"delete IngestServer";
+}
+
+bool IngestServer::start(uint16_t port)
+{
+    bool result = false;
+    QMetaObject::invokeMethod(_worker, "listen",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, result),
+                              Q_ARG(quint16, port));
+    return result;
+}
+
+void IngestServer::stop()
+{
+    if(_thread->isRunning())
+        QMetaObject::invokeMethod(_worker, "close", Qt::BlockingQueuedConnection);
+}
+
+bool IngestServer::isListening()
+{
+    bool result = false;
+    QMetaObject::invokeMethod(_worker, "isListening",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, result));
+    return result;
+}
+
+QVector<FeederStats> IngestServer::feederStats()
+{
+    return _worker->stats();
+}
+
+MergeStats IngestServer::mergeStats()
+{
+    return _worker->mergeStats();
+}
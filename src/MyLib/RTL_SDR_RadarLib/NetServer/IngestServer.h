@@ -0,0 +1,40 @@
+#ifndef INGESTSERVER_H
+#define INGESTSERVER_H
+
+#include <QThread>
+#include <QSharedPointer>
+
+#include "netserver_global.h"
+#include "interface/IIngestServer.h"
+#include "interface/IPoolObject.h"
+
+class IngestWorker;
+
+/*!
+ * \brief The IngestServer class
+ * Сервер сбора данных от приемных пунктов (RaspberryApp).
+ * Подключения обслуживаются циклом событий отдельного потока,
+ * данные всех пунктов объединяются в одном пуле объектов.
+ * \author Данильченко Артем
+ */
+class NETSERVERSHARED_EXPORT IngestServer : public IIngestServer
+{
+    QThread* _thread = nullptr;
+    IngestWorker* _worker = nullptr;
+
+public:
+    /*!
+     * \brief IngestServer конструктор
+     * \param pool - пул объектов для объединения данных
+     */
+    explicit IngestServer(QSharedPointer<IPoolObject> pool);
+    ~IngestServer() override;
+
+    bool start(uint16_t port) override;
+    void stop() override;
+    bool isListening() override;
+    QVector<FeederStats> feederStats() override;
+    MergeStats mergeStats() override;
+};
+
+#endif // INGESTSERVER_H
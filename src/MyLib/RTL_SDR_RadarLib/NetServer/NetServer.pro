@@ -0,0 +1,72 @@
+#-------------------------------------------------
+#
+# Сервер сбора данных от приемных пунктов и выдачи SBS-1 и JSON
+#
+#-------------------------------------------------
+
+QT       += gui network
+
+TARGET = NetServer
+TEMPLATE = lib
+
+DEFINES += NETSERVER_LIBRARY
+
+SOURCES += IngestServer.cpp \
+    ingest/IngestWorker.cpp \
+    ingest/FeederConnection.cpp \
+    ingest/MergeEngine.cpp \
+    ingest/ClockOffset.cpp \
+    SbsServer.cpp \
+    sbs/SbsWorker.cpp \
+    sbs/SbsFormatter.cpp \
+    HttpJsonServer.cpp \
+    http/HttpWorker.cpp \
+    http/HttpRequestParser.cpp \
+    http/JsonSnapshot.cpp \
+    ../../../include/protocol/DeltaDecoder.cpp \
+    ../../../include/protocol/DeltaEncoder.cpp \
+    ../../../include/protocol/FrameCodec.cpp \
+    ../../../include/protocol/Crc32.cpp \
+    ../../../include/objects/base/BaseObject.cpp \
+    ../../../include/objects/air/Aircraft.cpp \
+    ../../../include/objects/air/TrackHistory.cpp \
+    ../../../include/objects/air/TrackPredictor.cpp
+
+HEADERS += IngestServer.h \
+        netserver_global.h \
+    ingest/IngestWorker.h \
+    ingest/FeederConnection.h \
+    ingest/MergeEngine.h \
+    ingest/ClockOffset.h \
+    SbsServer.h \
+    sbs/SbsWorker.h \
+    sbs/SbsFormatter.h \
+    HttpJsonServer.h \
+    http/HttpWorker.h \
+    http/HttpRequestParser.h \
+    http/JsonSnapshot.h \
+    ../../../include/interface/IIngestServer.h \
+    ../../../include/interface/ISbsServer.h \
+    ../../../include/interface/IHttpServer.h \
+    ../../../include/interface/IPoolObject.h \
+    ../../../include/objects/air/StructAircraft.h \
+    ../../../include/protocol/DeltaProtocol.h \
+    ../../../include/protocol/DeltaDecoder.h \
+    ../../../include/protocol/FrameProtocol.h \
+    ../../../include/protocol/FrameCodec.h \
+    ../../../include/protocol/Crc32.h \
+    ../../../include/objects/base/BaseObject.h \
+    ../../../include/objects/air/Aircraft.h \
+    ../../../include/time/Clock.h
+
+unix {
+    target.path = /usr/lib
+    INSTALLS += target
+}
+
+
+include( ../../../../common.pri )
+include( ../../../../lib.pri )
+
+#сжатие ответов HTTP сервера
+LIBS += -lz
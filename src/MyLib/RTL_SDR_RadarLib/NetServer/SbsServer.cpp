@@ -0,0 +1,58 @@
+#include "SbsServer.h"
+
+#include <QDebug>
+
+#include "sbs/SbsWorker.h"
+
+SbsServer::SbsServer(QSharedPointer<IPoolObject> pool)
+{
+    _thread = new QThread();
+    _worker = new SbsWorker(pool);
+    _worker->moveToThread(_thread);
+    _thread->start();
+
+    qDebug()<<"create SbsServer";
+}
+
+SbsServer::~SbsServer()
+{
+    stop();
+
+    _thread->quit();
+    _thread->wait();
+
+    delete _worker;
+    delete _thread;
+
+    qDebug()<<"delete SbsServer";
+}
+
+bool SbsServer::start(uint16_t port)
+{
+    bool result = false;
+    QMetaObject::invokeMethod(_worker, "listen",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, result),
+                              Q_ARG(quint16, port));
+    return result;
+}
+
+void SbsServer::stop()
+{
+    if(_thread->isRunning())
+        QMetaObject::invokeMethod(_worker, "close", Qt::BlockingQueuedConnection);
+}
+
+bool SbsServer::isListening()
+{
+    bool result = false;
+    QMetaObject::invokeMethod(_worker, "isListening",
+                              Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, result));
+    return result;
+}
+
+SbsServerStats SbsServer::stats()
+{
+    return _worker->stats();
+}
@@ -0,0 +1,39 @@
+#ifndef SBSSERVER_H
+#define SBSSERVER_H
+
+#include <QThread>
+#include <QSharedPointer>
+
+#include "netserver_global.h"
+#include "interface/ISbsServer.h"
+#include "interface/IPoolObject.h"
+
+class SbsWorker;
+
+/*!
+ * \brief The SbsServer class
+ * Сервер выдачи данных о самолётах в формате SBS-1 (BaseStation)
+ * сторонним программам (Virtual Radar Server, PlanePlotter и т.п.).
+ * Подключения обслуживаются циклом событий отдельного потока.
+ * \author Данильченко Артем
+ */
+class NETSERVERSHARED_EXPORT SbsServer : public ISbsServer
+{
+    QThread* _thread = nullptr;
+    SbsWorker* _worker = nullptr;
+
+public:
+    /*!
+     * \brief SbsServer конструктор
+     * \param pool - пул объектов, данные которого выдаются клиентам
+     */
+    explicit SbsServer(QSharedPointer<IPoolObject> pool);
+    ~SbsServer() override;
+
+    bool start(uint16_t port) override;
+    void stop() override;
+    bool isListening() override;
+    SbsServerStats stats() override;
+};
+
+#endif // SBSSERVER_H
@@ -0,0 +1,60 @@
+#include "HttpRequestParser.h"
+
+#include <QList>
+
+HttpRequestParser::RESULT HttpRequestParser::next(HttpRequest &request)
+{
+    const int end = _buffer.indexOf("\r\n\r\n");
+    if(end < 0)
+        return (_buffer.size() > MAX_HEADER_SIZE) ? RESULT::BAD : RESULT::INCOMPLETE;
+    if(end > MAX_HEADER_SIZE)
+        return RESULT::BAD;
+
+    const QList<QByteArray> lines = _buffer.left(end).split('\n');
+    _buffer.remove(0, end + 4);
+
+    //строка запроса: метод, путь, версия
+    const QList<QByteArray> start = lines.first().trimmed().split(' ');
+    if(start.size() != 3 || !start.at(2).startsWith("HTTP/1."))
+        return RESULT::BAD;
+
+    request = HttpRequest();
+    request.method = start.at(0);
+    request.path = start.at(1);
+    const int query = request.path.indexOf('?');
+    if(query >= 0)
+        request.path.truncate(query);
+
+    //HTTP/1.0 закрывает подключение, если не запрошено иное
+    request.keepAlive = (start.at(2) != "HTTP/1.0");
+
+    for(int i = 1; i < lines.size(); i++)
+    {
+        const QByteArray& line = lines.at(i);
+        const int colon = line.indexOf(':');
+        if(colon <= 0)
+            continue;
+
+        const QByteArray name = line.left(colon).trimmed().toLower();
+        const QByteArray value = line.mid(colon + 1).trimmed();
+
+        if(name == "content-length" && value.toLongLong() != 0)
+            return RESULT::BAD;
+        else if(name == "transfer-encoding")
+            return RESULT::BAD;
+        else if(name == "connection")
+        {
+            const QByteArray token = value.toLower();
+            if(token.contains("close"))
+                request.keepAlive = false;
+            else if(token.contains("keep-alive"))
+                request.keepAlive = true;
+        }
+        else if(name == "accept-encoding")
+            request.acceptGzip = value.toLower().contains("gzip");
+        else if(name == "if-none-match")
+            request.ifNoneMatch = value;
+    }
+
+    return RESULT::READY;
+}
@@ -0,0 +1,55 @@
+#ifndef HTTPREQUESTPARSER_H
+#define HTTPREQUESTPARSER_H
+
+#include <QByteArray>
+
+/*!
+ * @brief  Разобранный запрос HTTP
+ */
+struct HttpRequest
+{
+    QByteArray method;
+    ///< путь без параметров запроса
+    QByteArray path;
+    ///< подключение остается открытым после ответа
+    bool keepAlive = true;
+    ///< клиент принимает сжатый ответ
+    bool acceptGzip = false;
+    ///< значение заголовка If-None-Match
+    QByteArray ifNoneMatch;
+};
+
+/*!
+ * \brief The HttpRequestParser class
+ * Разбор потока запросов HTTP/1.x одного подключения.
+ * Поддерживаются только запросы без тела (GET, HEAD),
+ * в том числе несколько запросов подряд без ожидания ответа.
+ * \author Данильченко Артем
+ */
+class HttpRequestParser
+{
+    ///< предельный размер заголовков запроса
+    static constexpr int MAX_HEADER_SIZE = 8 * 1024;
+
+    QByteArray _buffer;
+
+public:
+    enum class RESULT
+    {
+        INCOMPLETE = 0, ///< запрос принят не полностью
+        READY,          ///< запрос разобран
+        BAD             ///< ошибка, подключение должно быть закрыто
+    };
+
+    /*!
+     * \brief append добавление принятых данных
+     */
+    void append(const QByteArray& data) { _buffer.append(data); }
+    /*!
+     * \brief next извлечение очередного запроса из принятых данных
+     * \param request - разобранный запрос
+     */
+    RESULT next(HttpRequest& request);
+};
+
+#endif // HTTPREQUESTPARSER_H
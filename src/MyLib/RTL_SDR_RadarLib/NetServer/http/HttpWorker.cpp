@@ -0,0 +1,270 @@
+#include "HttpWorker.h"
+
+#include <QDebug>
+
+#include "time/Clock.h"
+
+HttpWorker::HttpWorker(QSharedPointer<IPoolObject> pool):
+    _pool(pool)
+{
+    qDebug()<<"create HttpWorker";
+}
+
+HttpWorker::~HttpWorker()
+{
+    close();
+    _pool.clear();
+    qDebug()<<"delete HttpWorker";
+}
+
+bool HttpWorker::listen(quint16 port)
+{
+    if(_server == nullptr)
+    {
+        _server = new QTcpServer(this);
+        connect(_server, &QTcpServer::newConnection,
+                this, &HttpWorker::slotNewConnection);
+
+        _idleTimer = new QTimer(this);
+        connect(_idleTimer, &QTimer::timeout,
+                this, &HttpWorker::slotCheckIdle);
+    }
+
+    if(_server->isListening())
+        _server->close();
+
+    if(!_server->listen(QHostAddress::Any, port))
+    {
+        qDebug()<<"[HttpWorker] : listen error"<<port<<_server->errorString();
+        return false;
+    }
+
+    _idleTimer->start(IDLE_CHECK_PERIOD);
+    qDebug()<<"[HttpWorker] : listen port"<<port;
+    return true;
+}
+
+bool HttpWorker::isListening()
+{
+    return (_server != nullptr) && _server->isListening();
+}
+
+void HttpWorker::close()
+{
+    if(_server != nullptr)
+        _server->close();
+    if(_idleTimer != nullptr)
+        _idleTimer->stop();
+
+    for(QTcpSocket* socket : _connections.keys())
+        closeConnection(socket);
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.connections = 0;
+}
+
+void HttpWorker::setReceiverStats(const QJsonObject &stats)
+{
+    QMutexLocker lock(&_receiverMutex);
+    _receiver = stats;
+}
+
+HttpServerStats HttpWorker::stats()
+{
+    QMutexLocker lock(&_statsMutex);
+    return _stats;
+}
+
+void HttpWorker::slotNewConnection()
+{
+    while(_server->hasPendingConnections())
+    {
+        QTcpSocket* socket = _server->nextPendingConnection();
+
+        Connection connection;
+        connection.lastActivity = Clock::nowMSec();
+        _connections.insert(socket, connection);
+
+        connect(socket, &QTcpSocket::readyRead,
+                this, &HttpWorker::slotReadyRead);
+        connect(socket, &QTcpSocket::disconnected,
+                this, &HttpWorker::slotDisconnected);
+    }
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.connections = _connections.size();
+}
+
+void HttpWorker::slotReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if(socket == nullptr || !_connections.contains(socket))
+        return;
+
+    const int64_t now = Clock::nowMSec();
+    Connection& connection = _connections[socket];
+    connection.lastActivity = now;
+    connection.parser.append(socket->readAll());
+
+    //обработка всех запросов, переданных без ожидания ответа
+    while(true)
+    {
+        HttpRequest request;
+        const HttpRequestParser::RESULT result = _connections[socket].parser.next(request);
+        if(result == HttpRequestParser::RESULT::INCOMPLETE)
+            return;
+
+        if(result == HttpRequestParser::RESULT::BAD)
+        {
+            request.keepAlive = false;
+            writeResponse(socket, "400 Bad Request", request, QByteArray(), false);
+            socket->disconnectFromHost();
+            return;
+        }
+
+        if(!respond(socket, request, now))
+        {
+            socket->disconnectFromHost();
+            return;
+        }
+    }
+}
+
+void HttpWorker::slotDisconnected()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if(socket == nullptr || !_connections.contains(socket))
+        return;
+
+    closeConnection(socket);
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.connections = _connections.size();
+}
+
+void HttpWorker::slotCheckIdle()
+{
+    const int64_t now = Clock::nowMSec();
+    for(auto it = _connections.begin(); it != _connections.end(); ++it)
+    {
+        if(now - it->lastActivity > IDLE_TIMEOUT)
+            it.key()->disconnectFromHost();
+    }
+}
+
+void HttpWorker::closeConnection(QTcpSocket *socket)
+{
+    _connections.remove(socket);
+
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+}
+
+void HttpWorker::refresh(int64_t now)
+{
+    if(_snapshot.generation() != 0 && now - _snapshot.time() < REFRESH_PERIOD)
+        return;
+
+    QJsonObject receiver;
+    {
+        QMutexLocker lock(&_receiverMutex);
+        receiver = _receiver;
+    }
+
+    //пул занят - до следующего запроса выдается прежний снимок;
+    //первый снимок формируется с ожиданием, иначе выдавать нечего
+    if(_snapshot.rebuild(_pool.data(), receiver, now, _snapshot.generation() == 0))
+    {
+        QMutexLocker lock(&_statsMutex);
+        _stats.generations++;
+    }
+}
+
+bool HttpWorker::respond(QTcpSocket *socket, const HttpRequest &request, int64_t now)
+{
+    {
+        QMutexLocker lock(&_statsMutex);
+        _stats.requests++;
+    }
+
+    if(socket->bytesToWrite() > CLIENT_BUFFER_LIMIT)
+        return false;
+
+    if(request.method != "GET" && request.method != "HEAD")
+    {
+        writeResponse(socket, "405 Method Not Allowed", request, QByteArray(), false);
+        return request.keepAlive;
+    }
+
+    const bool aircraft = (request.path == "/aircraft.json" ||
+                           request.path == "/data/aircraft.json");
+    const bool stats = (request.path == "/stats.json" ||
+                        request.path == "/data/stats.json");
+    if(!aircraft && !stats)
+    {
+        writeResponse(socket, "404 Not Found", request, QByteArray(), false);
+        return request.keepAlive;
+    }
+
+    refresh(now);
+    if(_snapshot.generation() == 0)
+    {
+        writeResponse(socket, "503 Service Unavailable", request, QByteArray(), false);
+        return request.keepAlive;
+    }
+
+    if(!request.ifNoneMatch.isEmpty() && request.ifNoneMatch == _snapshot.etag())
+    {
+        {
+            QMutexLocker lock(&_statsMutex);
+            _stats.notModified++;
+        }
+        writeResponse(socket, "304 Not Modified", request, QByteArray(), false);
+        return request.keepAlive;
+    }
+
+    //при ошибке сжатия выдаются несжатые данные
+    bool gzip = request.acceptGzip;
+    if(gzip && (aircraft ? _snapshot.aircraft(true) : _snapshot.stats(true)).isEmpty())
+        gzip = false;
+
+    const QByteArray& body = aircraft ? _snapshot.aircraft(gzip) : _snapshot.stats(gzip);
+    writeResponse(socket, "200 OK", request, body, gzip);
+    return request.keepAlive;
+}
+
+void HttpWorker::writeResponse(QTcpSocket *socket,
+                               const QByteArray &status,
+                               const HttpRequest &request,
+                               const QByteArray &body,
+                               bool gzip)
+{
+    QByteArray header;
+    header.reserve(256);
+    header.append("HTTP/1.1 ").append(status).append("\r\n");
+    header.append("Server: RTL_SDR_Radar\r\n");
+    header.append("Content-Length: ").append(QByteArray::number(body.size())).append("\r\n");
+    if(status.startsWith("200") || status.startsWith("304"))
+    {
+        header.append("Content-Type: application/json\r\n");
+        header.append("Cache-Control: no-cache\r\n");
+        header.append("Access-Control-Allow-Origin: *\r\n");
+        header.append("Vary: Accept-Encoding\r\n");
+        header.append("ETag: ").append(_snapshot.etag()).append("\r\n");
+    }
+    if(gzip)
+        header.append("Content-Encoding: gzip\r\n");
+    header.append(request.keepAlive ? "Connection: keep-alive\r\n\r\n"
+                                    : "Connection: close\r\n\r\n");
+
+    qint64 bytes = socket->write(header);
+    //тело общее для всех ответов поколения и не копируется до передачи в сокет
+    if(request.method != "HEAD" && !body.isEmpty())
+        bytes += socket->write(body);
+
+    QMutexLocker lock(&_statsMutex);
+    if(gzip && request.method != "HEAD")
+        _stats.gzipResponses++;
+    _stats.bytes += uint64_t(qMax<qint64>(bytes, 0));
+}
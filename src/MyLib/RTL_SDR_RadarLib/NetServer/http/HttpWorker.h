@@ -0,0 +1,98 @@
+#ifndef HTTPWORKER_H
+#define HTTPWORKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "interface/IPoolObject.h"
+#include "interface/IHttpServer.h"
+#include "HttpRequestParser.h"
+#include "JsonSnapshot.h"
+
+/*!
+ * \brief The HttpWorker class
+ * Обслуживание запросов HTTP в отдельном потоке. Снимок пула
+ * формируется по запросу не чаще одного раза за период обновления,
+ * все запросы одного поколения получают одни и те же буферы,
+ * поэтому стоимость ответа не зависит от числа клиентов.
+ * \author Данильченко Артем
+ */
+class HttpWorker : public QObject
+{
+    Q_OBJECT
+
+    ///< период обновления снимка пула, мс
+    const int64_t REFRESH_PERIOD = 1000;
+    ///< период проверки неактивных подключений, мс
+    const int IDLE_CHECK_PERIOD = 5000;
+    ///< время бездействия до закрытия подключения, мс
+    const int64_t IDLE_TIMEOUT = 30000;
+    ///< предел неотправленных данных клиента, байт
+    const qint64 CLIENT_BUFFER_LIMIT = 1024 * 1024;
+
+    /*!
+     * @brief  Состояние подключения
+     */
+    struct Connection
+    {
+        HttpRequestParser parser;
+        int64_t lastActivity = 0;
+    };
+
+    QSharedPointer<IPoolObject> _pool;
+    QTcpServer* _server = nullptr;
+    QTimer* _idleTimer = nullptr;
+    QHash<QTcpSocket*, Connection> _connections;
+    JsonSnapshot _snapshot;
+
+    QMutex _receiverMutex;
+    QJsonObject _receiver;
+
+    ///< копия счетчиков для чтения из других потоков
+    QMutex _statsMutex;
+    HttpServerStats _stats;
+
+    /*!
+     * \brief respond ответ на запрос
+     * \return false - подключение должно быть закрыто
+     */
+    bool respond(QTcpSocket* socket, const HttpRequest& request, int64_t now);
+    /*!
+     * \brief writeResponse передача заголовка и тела ответа
+     */
+    void writeResponse(QTcpSocket* socket,
+                       const QByteArray& status,
+                       const HttpRequest& request,
+                       const QByteArray& body,
+                       bool gzip);
+    /*!
+     * \brief refresh обновление снимка, если текущее поколение устарело
+     */
+    void refresh(int64_t now);
+    void closeConnection(QTcpSocket* socket);
+
+public:
+    explicit HttpWorker(QSharedPointer<IPoolObject> pool);
+    ~HttpWorker() override;
+
+    void setReceiverStats(const QJsonObject& stats);
+    HttpServerStats stats();
+
+public slots:
+    bool listen(quint16 port);
+    bool isListening();
+    void close();
+
+private slots:
+    void slotNewConnection();
+    void slotReadyRead();
+    void slotDisconnected();
+    void slotCheckIdle();
+};
+
+#endif // HTTPWORKER_H
@@ -0,0 +1,105 @@
+#include "JsonSnapshot.h"
+
+#include <string.h>
+#include <zlib.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "interface/IPoolObject.h"
+#include "objects/air/Aircraft.h"
+#include "sdr_dev/include/constant.h"
+
+bool JsonSnapshot::rebuild(IPoolObject *pool, const QJsonObject &receiver, int64_t now,
+                           bool wait)
+{
+    if(pool == nullptr)
+        return false;
+
+    if(wait)
+        pool->lockPool();
+    else if(!pool->tryLockPool())
+        return false;
+
+    QJsonArray list;
+    for(auto& object : pool->values())
+    {
+        Aircraft* air = dynamic_cast<Aircraft*>(object.data());
+        if(air == nullptr)
+            continue;
+
+        QJsonObject a;
+        a.insert("hex", QString("%1").arg(air->getICAO(), 6, 16, QChar('0')));
+
+        const QString flight = air->getFlightInfo().trimmed();
+        if(!flight.isEmpty())
+            a.insert("flight", flight);
+
+        //единицы как у dump1090: футы и узлы
+        a.insert("altitude", qRound(air->getAltitude() * CONVERT_FT_TO_METERS));
+        if(air->getSpeed() > 0.0f)
+        {
+            a.insert("speed", qRound(air->getSpeed() / CONVERT_KN_TO_KM_P_H));
+            a.insert("track", qRound(air->getCourse()));
+        }
+        if(air->isValidGeoCoord())
+        {
+            a.insert("lat", air->getLatitude());
+            a.insert("lon", air->getLongitude());
+        }
+        a.insert("messages", double(air->getNumberMsg()));
+        a.insert("seen", double(now - air->getMSecStop()) / 1000.0);
+
+        list.append(a);
+    }
+
+    pool->unlockPool();
+
+    _generation++;
+    _time = now;
+
+    QJsonObject aircraft;
+    aircraft.insert("now", double(now) / 1000.0);
+    aircraft.insert("generation", double(_generation));
+    aircraft.insert("aircraft", list);
+
+    QJsonObject stats;
+    stats.insert("now", double(now) / 1000.0);
+    stats.insert("generation", double(_generation));
+    stats.insert("aircraft", list.size());
+    stats.insert("receiver", receiver);
+
+    _aircraft = QJsonDocument(aircraft).toJson(QJsonDocument::Compact);
+    _aircraftGzip = gzip(_aircraft);
+    _stats = QJsonDocument(stats).toJson(QJsonDocument::Compact);
+    _statsGzip = gzip(_stats);
+
+    return true;
+}
+
+QByteArray JsonSnapshot::gzip(const QByteArray &data)
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    //15 + 16 - окно 32 КиБ с заголовком gzip
+    if(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED,
+                    15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return QByteArray();
+
+    QByteArray out(int(deflateBound(&stream, uLong(data.size()))), Qt::Uninitialized);
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = uInt(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = uInt(out.size());
+
+    const int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+
+    if(result != Z_STREAM_END)
+        return QByteArray();
+
+    out.resize(int(stream.total_out));
+    return out;
+}
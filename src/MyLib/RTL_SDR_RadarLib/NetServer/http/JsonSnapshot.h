@@ -0,0 +1,58 @@
+#ifndef JSONSNAPSHOT_H
+#define JSONSNAPSHOT_H
+
+#include <QByteArray>
+#include <QJsonObject>
+
+class IPoolObject;
+
+/*!
+ * \brief The JsonSnapshot class
+ * Снимок пула объектов в формате JSON. Снимок формируется один раз
+ * за поколение и сразу сжимается gzip, после чего одни и те же
+ * неизменяемые буферы передаются во всех ответах до следующего поколения.
+ * \author Данильченко Артем
+ */
+class JsonSnapshot
+{
+    ///< номер поколения снимка, 0 - снимок не сформирован
+    uint64_t _generation = 0;
+    ///< время формирования снимка, мс с начала эпохи
+    int64_t _time = 0;
+
+    QByteArray _aircraft;
+    QByteArray _aircraftGzip;
+    QByteArray _stats;
+    QByteArray _statsGzip;
+
+public:
+    /*!
+     * \brief rebuild формирование нового поколения снимка
+     * \param pool - пул объектов
+     * \param receiver - счетчики приемника
+     * \param now - текущее время, мс с начала эпохи
+     * \param wait - ожидать освобождения пула, иначе при занятом пуле
+     * снимок не формируется
+     * \return false - пул занят, снимок не изменился
+     */
+    bool rebuild(IPoolObject* pool, const QJsonObject& receiver, int64_t now,
+                 bool wait = false);
+
+    uint64_t generation() const { return _generation; }
+    int64_t time() const { return _time; }
+    /*!
+     * \brief etag метка поколения для условных запросов
+     */
+    QByteArray etag() const { return "\"" + QByteArray::number(_generation) + "\""; }
+
+    const QByteArray& aircraft(bool gzip) const { return gzip ? _aircraftGzip : _aircraft; }
+    const QByteArray& stats(bool gzip) const { return gzip ? _statsGzip : _stats; }
+
+    /*!
+     * \brief gzip сжатие данных в формате gzip (RFC 1952)
+     * \return сжатые данные или пустой массив при ошибке
+     */
+    static QByteArray gzip(const QByteArray& data);
+};
+
+#endif // JSONSNAPSHOT_H
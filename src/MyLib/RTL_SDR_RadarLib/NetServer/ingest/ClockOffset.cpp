@@ -0,0 +1,47 @@
+#include "ClockOffset.h"
+
+#include <math.h>
+
+bool ClockOffset::addSample(int64_t t1, int64_t t2, int64_t t3, int64_t t4)
+{
+    const int64_t rtt = (t4 - t1) - (t3 - t2);
+    if(t4 < t1 || t3 < t2 || rtt < 0)
+        return false;
+
+    Sample& sample = _samples[_next];
+    sample.offset = ((t2 - t1) + (t3 - t4)) / 2;
+    sample.rtt = rtt;
+    _next = (_next + 1) % FILTER_SIZE;
+    if(_count < FILTER_SIZE)
+        _count++;
+
+    const Sample* best = &_samples[0];
+    for(int i = 1; i < _count; i++)
+    {
+        if(_samples[i].rtt < best->rtt)
+            best = &_samples[i];
+    }
+
+    if(_valid)
+        _offset += ALPHA * (double(best->offset) - _offset);
+    else
+        _offset = double(best->offset);
+
+    _rtt = best->rtt;
+    _valid = true;
+    return true;
+}
+
+void ClockOffset::reset()
+{
+    _count = 0;
+    _next = 0;
+    _offset = 0.0;
+    _rtt = -1;
+    _valid = false;
+}
+
+int64_t ClockOffset::offset() const
+{
+    return _valid ? int64_t(llround(_offset)) : 0;
+}
@@ -0,0 +1,62 @@
+#ifndef CLOCKOFFSET_H
+#define CLOCKOFFSET_H
+
+#include <stdint.h>
+
+/*!
+ * \brief The ClockOffset class
+ * Оценка смещения часов приемного пункта относительно сервера по
+ * обмену FRAME_PING/FRAME_PONG. Как в фильтре NTP, из последних замеров
+ * выбирается замер с наименьшим временем обмена (наименее искаженный
+ * очередями), оценка сглаживается, чтобы отслеживать медленный уход часов.
+ * \author Данильченко Артем
+ */
+class ClockOffset
+{
+    ///< количество хранимых замеров
+    static constexpr int FILTER_SIZE = 8;
+    ///< коэффициент сглаживания
+    static constexpr double ALPHA = 0.25;
+
+    struct Sample
+    {
+        int64_t offset = 0;
+        int64_t rtt = 0;
+    };
+
+    Sample _samples[FILTER_SIZE];
+    int _count = 0;
+    int _next = 0;
+
+    double _offset = 0.0;
+    int64_t _rtt = -1;
+    bool _valid = false;
+
+public:
+    /*!
+     * \brief addSample учет обмена метками времени
+     * \param t1 - отправка запроса, часы сервера
+     * \param t2 - прием запроса, часы пункта
+     * \param t3 - отправка ответа, часы пункта
+     * \param t4 - прием ответа, часы сервера
+     * \return false - метки противоречивы, замер отброшен
+     */
+    bool addSample(int64_t t1, int64_t t2, int64_t t3, int64_t t4);
+    void reset();
+
+    bool isValid() const { return _valid; }
+    /*!
+     * \brief offset смещение: часы пункта минус часы сервера, мс
+     */
+    int64_t offset() const;
+    /*!
+     * \brief rtt время обмена выбранного замера, мс, -1 - нет замеров
+     */
+    int64_t rtt() const { return _rtt; }
+    /*!
+     * \brief toServer перевод времени пункта в шкалу сервера
+     */
+    int64_t toServer(int64_t feederTime) const { return feederTime - offset(); }
+};
+
+#endif // CLOCKOFFSET_H
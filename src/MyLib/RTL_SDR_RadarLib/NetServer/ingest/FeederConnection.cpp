@@ -0,0 +1,204 @@
+#include "FeederConnection.h"
+
+#include <string.h>
+
+FeederConnection::FeederConnection(int id, const QString &address, int64_t now):
+    _id(id)
+{
+    _stats.address = address;
+    _stats.connectedAt = now;
+}
+
+bool FeederConnection::feed(const QByteArray &data, int64_t now, QVector<StructAircraft> &records)
+{
+    _stats.bytes += uint64_t(data.size());
+    const int first = records.size();
+    bool ok = true;
+
+    if(_format == STREAM_FORMAT::FRAMED)
+        parseFramed(data.constData(), data.size(), now, records);
+    else
+    {
+        _buffer.append(data);
+
+        if(_format == STREAM_FORMAT::UNKNOWN)
+        {
+            uint32_t magic;
+            if(_buffer.size() < int(sizeof(magic)))
+                return true;
+
+            memcpy(&magic, _buffer.constData(), sizeof(magic));
+            if(magic == DELTA_MAGIC)
+                _format = STREAM_FORMAT::DELTA;
+            else if(magic == FRAME_SYNC)
+                _format = STREAM_FORMAT::FRAMED;
+            else
+                _format = STREAM_FORMAT::RAW_DUMP;
+        }
+
+        if(_format == STREAM_FORMAT::FRAMED)
+        {
+            parseFramed(_buffer.constData(), _buffer.size(), now, records);
+            _buffer.clear();
+        }
+        else
+            ok = (_format == STREAM_FORMAT::DELTA) ? parseDelta(records)
+                                                   : parseRawDump(records);
+    }
+
+    if(!ok)
+    {
+        ++_stats.errors;
+        _buffer.clear();
+    }
+
+    //перевод времени записей в шкалу сервера
+    const int64_t offset = _clock.offset();
+    int64_t seen = 0;
+    for(int i = first; i < records.size(); i++)
+    {
+        StructAircraft& a = records[i];
+        if(a.seen > 0)
+            a.seen -= offset;
+        //задержка по самой свежей записи порции
+        seen = qMax(seen, a.seen);
+    }
+    updateLag(seen, now);
+    _stats.records += uint64_t(records.size() - first);
+
+    return ok;
+}
+
+bool FeederConnection::parseRawDump(QVector<StructAircraft> &records)
+{
+    const int headerSize = int(sizeof(uint32_t) + sizeof(int32_t));
+    int pos = 0;
+
+    while(_buffer.size() - pos >= headerSize)
+    {
+        uint32_t frameSize;
+        int32_t count;
+        memcpy(&frameSize, _buffer.constData() + pos, sizeof(frameSize));
+        memcpy(&count, _buffer.constData() + pos + sizeof(frameSize), sizeof(count));
+
+        if(frameSize != sizeof(StructAircraft) || count < 0 || count > MAX_RECORDS)
+            return false;
+
+        const int messageSize = headerSize + count * int(frameSize);
+        if(_buffer.size() - pos < messageSize)
+            break;
+
+        const char* p = _buffer.constData() + pos + headerSize;
+        for(int i = 0; i < count; i++)
+        {
+            StructAircraft a;
+            memcpy(&a, p + i * int(frameSize), sizeof(a));
+            a.flight[sizeof(a.flight) - 1] = 0;
+            records.append(a);
+        }
+
+        pos += messageSize;
+        ++_stats.messages;
+    }
+
+    _buffer.remove(0, pos);
+    return true;
+}
+
+bool FeederConnection::parseDelta(QVector<StructAircraft> &records)
+{
+    forever
+    {
+        int size = DeltaDecoder::messageSize(_buffer);
+        if(size < 0)
+            return false;
+        if(size == 0 || size > _buffer.size())
+            break;
+
+        //пропущенное сообщение - ждем полного кадра.
+        //Передаются только самолёты из сообщения: неизменившиеся
+        //не увеличивают счетчики и не считаются устаревшими при слиянии
+        if(_decoder.apply(_buffer.left(size)))
+        {
+            const QHash<uint32_t, StructAircraft>& objects = _decoder.objects();
+            for(uint32_t icao : _decoder.updated())
+            {
+                auto it = objects.constFind(icao);
+                if(it != objects.constEnd())
+                    records.append(it.value());
+            }
+        }
+        else
+            ++_stats.errors;
+
+        _buffer.remove(0, size);
+        ++_stats.messages;
+    }
+
+    return true;
+}
+
+void FeederConnection::parseFramed(const char *data, int size, int64_t now,
+                                   QVector<StructAircraft> &records)
+{
+    const FrameParserStats before = _frames.stats();
+
+    _frames.feed(data, size, [this, now, &records](const FrameHeader& header, const char* payload)
+    {
+        //кадры неизвестных типов пропускаются
+        if(header.type == FRAME_RECORDS && !FrameParser::records(header, payload, records))
+            ++_stats.errors;
+        else if(header.type == FRAME_PONG)
+        {
+            FramePong pong;
+            if(FrameParser::pong(header, payload, pong) &&
+                    _clock.addSample(pong.originate, pong.receive, header.time, now))
+            {
+                _stats.clockSynced = true;
+                _stats.clockOffset = _clock.offset();
+                _stats.rtt = _clock.rtt();
+            }
+        }
+        ++_stats.messages;
+    });
+
+    const FrameParserStats& after = _frames.stats();
+    _stats.errors += (after.headerErrors - before.headerErrors) +
+            (after.crcErrors - before.crcErrors) +
+            (after.lostFrames - before.lostFrames);
+}
+
+void FeederConnection::updateLag(int64_t seen, int64_t now)
+{
+    if(seen <= 0)
+        return;
+
+    _stats.lag = now - seen;
+    if(_stats.lag > _stats.maxLag)
+        _stats.maxLag = _stats.lag;
+
+    if(_stats.latency == 0.0)
+        _stats.latency = double(_stats.lag);
+    else
+        _stats.latency += LATENCY_ALPHA * (double(_stats.lag) - _stats.latency);
+}
+
+QByteArray FeederConnection::ping(int64_t now)
+{
+    if(_format != STREAM_FORMAT::FRAMED || now - _lastPing < PING_PERIOD)
+        return QByteArray();
+
+    _lastPing = now;
+    return _writer.ping(now);
+}
+
+void FeederConnection::updateRates(int64_t elapsed)
+{
+    if(elapsed <= 0)
+        return;
+
+    _stats.bytesPerSec = double(_stats.bytes - _lastBytes) * 1000.0 / elapsed;
+    _stats.recordsPerSec = double(_stats.records - _lastRecords) * 1000.0 / elapsed;
+    _lastBytes = _stats.bytes;
+    _lastRecords = _stats.records;
+}
@@ -0,0 +1,115 @@
+#ifndef FEEDERCONNECTION_H
+#define FEEDERCONNECTION_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "interface/IIngestServer.h"
+#include "objects/air/StructAircraft.h"
+#include "protocol/DeltaDecoder.h"
+#include "protocol/FrameCodec.h"
+#include "ClockOffset.h"
+
+/*!
+ * \brief The FeederConnection class
+ * Разбор потока данных одного приемного пункта. Поддерживается полный
+ * список самолётов (IDemodulator::getRawDumpOfObjectsInfo():
+ * размер записи, количество записей, записи StructAircraft)
+ * разностный протокол (DeltaProtocol.h) и кадры с синхронизацией
+ * (FrameProtocol.h). Формат определяется по первому сообщению.
+ * Для потока кадров смещение часов пункта оценивается обменом
+ * FRAME_PING/FRAME_PONG, время записей переводится в шкалу сервера.
+ * \author Данильченко Артем
+ */
+class FeederConnection
+{
+    enum class STREAM_FORMAT
+    {
+        UNKNOWN,
+        RAW_DUMP,
+        DELTA,
+        FRAMED
+    };
+
+    ///< максимальное количество записей в сообщении
+    static constexpr int32_t MAX_RECORDS = 65535;
+    ///< период обмена метками времени, мс
+    static constexpr int64_t PING_PERIOD = 2000;
+    ///< коэффициент сглаживания задержки
+    static constexpr double LATENCY_ALPHA = 0.1;
+
+    ///< идентификатор источника для объединения данных
+    int _id = 0;
+    STREAM_FORMAT _format = STREAM_FORMAT::UNKNOWN;
+    ///< принятые и не разобранные данные
+    QByteArray _buffer;
+    ///< состояние разностного протокола
+    DeltaDecoder _decoder;
+    ///< разбор потока кадров
+    FrameParser _frames;
+    ///< формирование кадров FRAME_PING
+    FrameWriter _writer;
+    ///< смещение часов пункта
+    ClockOffset _clock;
+    ///< время последнего FRAME_PING
+    int64_t _lastPing = 0;
+
+    ///< счетчики
+    FeederStats _stats;
+    uint64_t _lastBytes = 0;
+    uint64_t _lastRecords = 0;
+
+    /*!
+     * \brief parseRawDump разбор сообщений полного списка
+     * \return false - нарушена структура потока
+     */
+    bool parseRawDump(QVector<StructAircraft>& records);
+    /*!
+     * \brief parseDelta разбор сообщений разностного протокола
+     * \return false - нарушена структура потока
+     */
+    bool parseDelta(QVector<StructAircraft>& records);
+    /*!
+     * \brief parseFramed разбор потока кадров без копирования данных.
+     * Поврежденные участки пропускаются, подключение не закрывается
+     */
+    void parseFramed(const char* data, int size, int64_t now,
+                     QVector<StructAircraft>& records);
+    /*!
+     * \brief updateLag пересчет задержки
+     * \param seen - время последнего обновления самолёта, мс
+     * \param now - время приема, мс
+     */
+    void updateLag(int64_t seen, int64_t now);
+
+public:
+    FeederConnection(int id, const QString& address, int64_t now);
+
+    int id() const { return _id; }
+
+    /*!
+     * \brief feed разбор очередной порции данных
+     * \param data - принятые данные
+     * \param now - время приема, мс с начала эпохи
+     * \param records - обновлённые записи о самолётах
+     * \return false - нарушена структура потока, подключение
+     * необходимо закрыть
+     */
+    bool feed(const QByteArray& data, int64_t now, QVector<StructAircraft>& records);
+    /*!
+     * \brief updateRates пересчет скорости приема
+     * \param elapsed - время с предыдущего пересчета, мс
+     */
+    void updateRates(int64_t elapsed);
+    /*!
+     * \brief ping очередной запрос обмена метками времени
+     * \param now - текущее время, мс
+     * \return кадр FRAME_PING или пустой массив, если отправлять
+     * не нужно или пункт не использует поток кадров
+     */
+    QByteArray ping(int64_t now);
+
+    const FeederStats& stats() const { return _stats; }
+};
+
+#endif // FEEDERCONNECTION_H
@@ -0,0 +1,223 @@
+#include "IngestWorker.h"
+
+#include <QDebug>
+
+#include "objects/air/Aircraft.h"
+#include "time/Clock.h"
+
+IngestWorker::IngestWorker(QSharedPointer<IPoolObject> pool):
+    _pool(pool)
+{
+    qDebug()<<"create IngestWorker";
+}
+
+IngestWorker::~IngestWorker()
+{
+    close();
+    _pool.clear();
+    qDebug()<<"delete IngestWorker";
+}
+
+bool IngestWorker::listen(quint16 port)
+{
+    if(_server == nullptr)
+    {
+        _server = new QTcpServer(this);
+        connect(_server, &QTcpServer::newConnection,
+                this, &IngestWorker::slotNewConnection);
+
+        _statsTimer = new QTimer(this);
+        connect(_statsTimer, &QTimer::timeout,
+                this, &IngestWorker::slotUpdateStats);
+    }
+
+    if(_server->isListening())
+        _server->close();
+
+    if(!_server->listen(QHostAddress::Any, port))
+    {
+        qDebug()<<"[IngestWorker] : listen error"<<port<<_server->errorString();
+        return false;
+    }
+
+    _statsTime = Clock::nowMSec();
+    _statsTimer->start(STATS_PERIOD);
+    qDebug()<<"[IngestWorker] : listen port"<<port;
+    return true;
+}
+
+bool IngestWorker::isListening()
+{
+    return (_server != nullptr) && _server->isListening();
+}
+
+void IngestWorker::close()
+{
+    if(_server != nullptr)
+        _server->close();
+    if(_statsTimer != nullptr)
+        _statsTimer->stop();
+
+    for(QTcpSocket* socket : _feeders.keys())
+        closeFeeder(socket);
+
+    _merge.clear();
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.clear();
+}
+
+QVector<FeederStats> IngestWorker::stats()
+{
+    QMutexLocker lock(&_statsMutex);
+    return _stats;
+}
+
+MergeStats IngestWorker::mergeStats()
+{
+    QMutexLocker lock(&_statsMutex);
+    return _mergeStats;
+}
+
+void IngestWorker::slotNewConnection()
+{
+    while(_server->hasPendingConnections())
+    {
+        QTcpSocket* socket = _server->nextPendingConnection();
+        QString address = QString("%1:%2")
+                .arg(socket->peerAddress().toString())
+                .arg(socket->peerPort());
+
+        _feeders.insert(socket, new FeederConnection(_nextSource++, address, Clock::nowMSec()));
+
+        connect(socket, &QTcpSocket::readyRead,
+                this, &IngestWorker::slotReadyRead);
+        connect(socket, &QTcpSocket::disconnected,
+                this, &IngestWorker::slotDisconnected);
+
+        qDebug()<<"[IngestWorker] : feeder connected"<<address;
+    }
+}
+
+void IngestWorker::slotReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    FeederConnection* feeder = _feeders.value(socket, nullptr);
+    if(feeder == nullptr)
+        return;
+
+    const int64_t now = Clock::nowMSec();
+    QVector<StructAircraft> records;
+
+    if(!feeder->feed(socket->readAll(), now, records))
+    {
+        //поток рассинхронизирован - подключение закрывается,
+        //приемный пункт переподключится и начнет с начала сообщения
+        qDebug()<<"[IngestWorker] : broken stream from"<<feeder->stats().address;
+        socket->abort();
+        return;
+    }
+
+    if(!records.isEmpty())
+        mergeRecords(feeder->id(), records, now);
+}
+
+void IngestWorker::slotDisconnected()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if(socket == nullptr || !_feeders.contains(socket))
+        return;
+
+    qDebug()<<"[IngestWorker] : feeder disconnected"<<_feeders.value(socket)->stats().address;
+    closeFeeder(socket);
+}
+
+void IngestWorker::closeFeeder(QTcpSocket *socket)
+{
+    FeederConnection* feeder = _feeders.take(socket);
+    delete feeder;
+
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+}
+
+void IngestWorker::slotUpdateStats()
+{
+    const int64_t now = Clock::nowMSec();
+    const int64_t elapsed = now - _statsTime;
+    _statsTime = now;
+
+    QVector<FeederStats> stats;
+    stats.reserve(_feeders.size());
+    for(auto it = _feeders.begin(); it != _feeders.end(); ++it)
+    {
+        FeederConnection* feeder = it.value();
+
+        //обмен метками времени для оценки смещения часов пункта
+        const QByteArray ping = feeder->ping(now);
+        if(!ping.isEmpty())
+            it.key()->write(ping);
+
+        feeder->updateRates(elapsed);
+        stats.append(feeder->stats());
+    }
+
+    _merge.removeStale(now, MERGE_TTL);
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.swap(stats);
+    _mergeStats = _merge.stats();
+}
+
+void IngestWorker::mergeRecords(int source, QVector<StructAircraft> &records, int64_t now)
+{
+    if(_pool.isNull())
+        return;
+
+    //выбор источника выполняется до блокировки пула
+    int count = 0;
+    for(int i = 0; i < records.size(); i++)
+    {
+        StructAircraft record = records.at(i);
+        if((record.icao & 0xffffff) == 0)
+            continue;
+        if(record.seen <= 0)
+            record.seen = now;
+        if(_merge.merge(source, record, now))
+            records[count++] = record;
+    }
+    records.resize(count);
+
+    if(records.isEmpty())
+        return;
+
+    _pool->lockPool();
+    for(const StructAircraft& a : records)
+    {
+        const uint32_t icao = a.icao & 0xffffff;
+
+        QSharedPointer<Aircraft> air;
+        if(!_pool->isExistsObject(icao))
+        {
+            air = qSharedPointerCast<Aircraft>(_pool->createNewObject(icao,
+                                                                      Clock::fromMSec(a.seen)));
+        }
+        else
+        {
+            air = qSharedPointerCast<Aircraft>(_pool->getObjectByID(icao));
+            if(air.isNull() || air->getMSecStop() >= a.seen)
+                continue;
+
+            air->setObjectState(OBJECT_STATE::UPDATE_OBJECT);
+        }
+
+        if(air.isNull())
+            continue;
+
+        air->unserialize(QByteArray::fromRawData(reinterpret_cast<const char*>(&a),
+                                                 sizeof(a)));
+        _pool->updateGeoIndex(icao);
+    }
+    _pool->unlockPool();
+}
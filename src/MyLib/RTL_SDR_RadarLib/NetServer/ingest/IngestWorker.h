@@ -0,0 +1,85 @@
+#ifndef INGESTWORKER_H
+#define INGESTWORKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "interface/IPoolObject.h"
+#include "interface/IIngestServer.h"
+#include "FeederConnection.h"
+#include "MergeEngine.h"
+
+/*!
+ * \brief The IngestWorker class
+ * Прием данных от приемных пунктов. Выполняется в отдельном потоке:
+ * все подключения обслуживаются одним циклом событий потока,
+ * принятые записи объединяются в общем пуле объектов.
+ * \author Данильченко Артем
+ */
+class IngestWorker : public QObject
+{
+    Q_OBJECT
+
+    ///< период пересчета счетчиков, мс
+    const int STATS_PERIOD = 1000;
+    ///< время хранения состояния объединения самолёта без записей, мс
+    const int64_t MERGE_TTL = 60000;
+
+    QSharedPointer<IPoolObject> _pool;
+    QTcpServer* _server = nullptr;
+    QTimer* _statsTimer = nullptr;
+    ///< подключения приемных пунктов
+    QHash<QTcpSocket*, FeederConnection*> _feeders;
+    ///< время последнего пересчета счетчиков
+    int64_t _statsTime = 0;
+    ///< идентификатор следующего подключения
+    int _nextSource = 0;
+    ///< выбор источника данных самолёта
+    MergeEngine _merge;
+
+    ///< копия счетчиков для чтения из других потоков
+    QMutex _statsMutex;
+    QVector<FeederStats> _stats;
+    MergeStats _mergeStats;
+
+    /*!
+     * \brief mergeRecords объединение записей в пуле объектов.
+     * Записи отбираются MergeEngine, затем запись применяется, если
+     * она новее состояния самолёта в пуле, поэтому самолёт, видимый
+     * несколькими пунктами, не откатывается к более старым данным
+     * \param source - идентификатор приемного пункта
+     */
+    void mergeRecords(int source, QVector<StructAircraft>& records, int64_t now);
+    void closeFeeder(QTcpSocket* socket);
+
+public:
+    explicit IngestWorker(QSharedPointer<IPoolObject> pool);
+    ~IngestWorker() override;
+
+    /*!
+     * \brief stats счетчики подключений на момент последнего пересчета
+     */
+    QVector<FeederStats> stats();
+    /*!
+     * \brief mergeStats счетчики объединения на момент последнего пересчета
+     */
+    MergeStats mergeStats();
+
+public slots:
+    bool listen(quint16 port);
+    bool isListening();
+    void close();
+
+private slots:
+    void slotNewConnection();
+    void slotReadyRead();
+    void slotDisconnected();
+    void slotUpdateStats();
+};
+
+#endif // INGESTWORKER_H
@@ -0,0 +1,118 @@
+#include "MergeEngine.h"
+
+int MergeEngine::slot(Entry &entry, int source)
+{
+    int result = 0;
+    for(int i = 0; i < MAX_SOURCES; i++)
+    {
+        const Source& s = entry.sources[i];
+        if(s.id == source)
+            return i;
+
+        //свободная ячейка предпочтительнее занятой
+        const Source& r = entry.sources[result];
+        if(r.id >= 0 && (s.id < 0 || s.arrival < r.arrival))
+            result = i;
+    }
+
+    if(result == entry.chosen)
+        entry.chosen = -1;
+
+    entry.sources[result] = Source();
+    entry.sources[result].id = source;
+    return result;
+}
+
+bool MergeEngine::merge(int source, StructAircraft &record, int64_t now)
+{
+    _stats.records++;
+
+    const uint32_t icao = record.icao & 0xffffff;
+    Entry& entry = _entries[icao];
+
+    const int index = slot(entry, source);
+    Source& s = entry.sources[index];
+
+    //сообщения суммируются по приращениям счетчика каждого пункта;
+    //уменьшение счетчика - пункт перезапущен и считает заново.
+    //Переподключившийся пункт получает новый идентификатор, а его счетчик
+    //продолжается: первая запись неизвестного источника только задает
+    //начало отсчета, если самолёт уже учитывается
+    const uint64_t key = baselineKey(icao, source);
+    const bool known = _baselines.contains(key);
+    Baseline& baseline = _baselines[key];
+    uint32_t added = 0;
+    if(!known)
+        added = (entry.seen == 0) ? record.messages : 0;
+    else if(record.messages >= baseline.messages)
+        added = record.messages - baseline.messages;
+    else
+        added = record.messages;
+    entry.messages += added;
+    baseline.messages = record.messages;
+    baseline.arrival = now;
+
+    if(s.arrival > 0 && record.seen > s.seen)
+    {
+        const double rate = added * 1000.0 / double(record.seen - s.seen);
+        s.rate += RATE_ALPHA * (rate - s.rate);
+    }
+
+    s.arrival = now;
+    if(record.seen > s.seen)
+        s.seen = record.seen;
+
+    if(record.seen <= entry.seen)
+    {
+        _stats.stale++;
+        return false;
+    }
+
+    if(entry.chosen >= 0 && entry.chosen != index)
+    {
+        const Source& chosen = entry.sources[entry.chosen];
+        const bool lost = (now - chosen.arrival > SOURCE_TIMEOUT);
+        const bool ahead = (record.seen - entry.seen >= SWITCH_MARGIN);
+        const bool better = (s.rate > chosen.rate * QUALITY_RATIO);
+
+        if(!lost && !ahead && !better)
+        {
+            _stats.held++;
+            return false;
+        }
+        _stats.sourceSwitches++;
+    }
+
+    entry.chosen = index;
+    entry.seen = record.seen;
+    record.messages = uint32_t(qMin<uint64_t>(entry.messages, UINT32_MAX));
+
+    _stats.applied++;
+    return true;
+}
+
+void MergeEngine::removeStale(int64_t now, int64_t ttl)
+{
+    for(auto it = _entries.begin(); it != _entries.end();)
+    {
+        if(now - it->seen > ttl)
+            it = _entries.erase(it);
+        else
+            ++it;
+    }
+
+    for(auto it = _baselines.begin(); it != _baselines.end();)
+    {
+        if(now - it->arrival > ttl)
+            it = _baselines.erase(it);
+        else
+            ++it;
+    }
+}
+
+MergeStats MergeEngine::stats() const
+{
+    MergeStats stats = _stats;
+    stats.aircraft = _entries.size();
+    return stats;
+}
@@ -0,0 +1,119 @@
+#ifndef MERGEENGINE_H
+#define MERGEENGINE_H
+
+#include <QHash>
+
+#include "interface/IIngestServer.h"
+#include "objects/air/StructAircraft.h"
+
+/*!
+ * \brief The MergeEngine class
+ * Объединение записей одного самолёта от нескольких приемных пунктов.
+ * Для каждого адреса ICAO хранится состояние источников: время последней
+ * записи, счетчик сообщений и темп приема. Запись применяется, только если
+ * она новее примененной, а смена выбранного источника выполняется с
+ * гистерезисом, чтобы положение не переключалось между пунктами на
+ * каждой записи. Счетчики сообщений разных пунктов суммируются по
+ * приращениям; счетчик нового источника уже учитываемого самолёта
+ * (в том числе переподключившегося пункта) учитывается со второй записи.
+ * Обработка записи - O(1).
+ * \author Данильченко Артем
+ */
+class MergeEngine
+{
+    ///< наибольшее количество источников одного самолёта
+    static constexpr int MAX_SOURCES = 4;
+    ///< время без записей, после которого источник считается потерянным, мс
+    static constexpr int64_t SOURCE_TIMEOUT = 3000;
+    ///< опережение записи другого источника для смены выбранного, мс
+    static constexpr int64_t SWITCH_MARGIN = 1000;
+    ///< во сколько раз темп сообщений другого источника должен быть выше
+    static constexpr double QUALITY_RATIO = 1.5;
+    ///< коэффициент сглаживания темпа сообщений
+    static constexpr double RATE_ALPHA = 0.3;
+
+    /*!
+     * @brief  Состояние источника для одного самолёта
+     */
+    struct Source
+    {
+        ///< идентификатор источника, -1 - свободно
+        int id = -1;
+        ///< время последней записи источника
+        int64_t seen = 0;
+        ///< время приема последней записи
+        int64_t arrival = 0;
+        ///< сглаженный темп сообщений, сообщений/с
+        double rate = 0.0;
+    };
+
+    /*!
+     * @brief  Состояние самолёта
+     */
+    struct Entry
+    {
+        Source sources[MAX_SOURCES];
+        ///< индекс выбранного источника, -1 - не выбран
+        int chosen = -1;
+        ///< время примененной записи
+        int64_t seen = 0;
+        ///< сумма сообщений всех источников
+        uint64_t messages = 0;
+    };
+
+    /*!
+     * @brief  Последний счетчик сообщений пункта для самолёта.
+     * Хранится отдельно от ячеек источников: после вытеснения ячейки
+     * вернувшийся пункт продолжает счет с прежнего значения
+     */
+    struct Baseline
+    {
+        ///< счетчик сообщений пункта
+        uint32_t messages = 0;
+        ///< время приема последней записи
+        int64_t arrival = 0;
+    };
+
+    QHash<uint32_t, Entry> _entries;
+    ///< ключ - адрес ICAO и идентификатор пункта, см. baselineKey()
+    QHash<uint64_t, Baseline> _baselines;
+    MergeStats _stats;
+
+    /*!
+     * \brief slot ячейка источника: существующая, свободная
+     * или занятая источником, дольше всех не передававшим данные
+     */
+    static int slot(Entry& entry, int source);
+    /*!
+     * \brief baselineKey ключ счетчика пункта: идентификатор пункта
+     * в старших 32 битах, адрес ICAO - в младших
+     */
+    static uint64_t baselineKey(uint32_t icao, int source)
+    {
+        return (uint64_t(uint32_t(source)) << 32) | icao;
+    }
+
+public:
+    MergeEngine() = default;
+
+    /*!
+     * \brief merge учет записи приемного пункта
+     * \param source - идентификатор приемного пункта
+     * \param record - запись, время seen в шкале сервера; при применении
+     * поле messages заменяется суммой сообщений всех пунктов
+     * \param now - время приема, мс с начала эпохи
+     * \return true - запись нужно применить к пулу объектов
+     */
+    bool merge(int source, StructAircraft& record, int64_t now);
+    /*!
+     * \brief removeStale удаление самолётов без записей
+     * \param now - текущее время, мс
+     * \param ttl - время хранения, мс
+     */
+    void removeStale(int64_t now, int64_t ttl);
+    void clear() { _entries.clear(); _baselines.clear(); }
+
+    MergeStats stats() const;
+};
+
+#endif // MERGEENGINE_H
@@ -0,0 +1,12 @@
+#ifndef NETSERVER_GLOBAL_H
+#define NETSERVER_GLOBAL_H
+
+#include <QtCore/qglobal.h>
+
+#if defined(NETSERVER_LIBRARY)
+#  define NETSERVERSHARED_EXPORT Q_DECL_EXPORT
+#else
+#  define NETSERVERSHARED_EXPORT Q_DECL_IMPORT
+#endif
+
+#endif // NETSERVER_GLOBAL_H
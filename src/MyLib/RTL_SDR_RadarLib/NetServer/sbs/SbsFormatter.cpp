@@ -0,0 +1,147 @@
+#include "SbsFormatter.h"
+
+#include <QDateTime>
+
+#include "objects/air/Aircraft.h"
+#include "sdr_dev/include/constant.h"
+
+QByteArray SbsFormatter::timestamp(int64_t msec)
+{
+    //формат BaseStation использует местное время
+    const QDateTime dt = QDateTime::fromMSecsSinceEpoch(msec);
+    return dt.toString("yyyy/MM/dd,HH:mm:ss.zzz").toLatin1();
+}
+
+void SbsFormatter::appendMessage(QByteArray &out,
+                                 int type,
+                                 uint32_t icao,
+                                 const QByteArray &generated,
+                                 const QByteArray &logged,
+                                 const QByteArray &callsign,
+                                 const QByteArray &altitude,
+                                 const QByteArray &speed,
+                                 const QByteArray &course,
+                                 const QByteArray &latitude,
+                                 const QByteArray &longitude)
+{
+    //MSG,type,session,aircraft,hex,flight,date gen,time gen,date log,time log,
+    //callsign,altitude,ground speed,track,lat,lon,vertical rate,squawk,
+    //alert,emergency,spi,on ground
+    out.append("MSG,");
+    out.append(QByteArray::number(type));
+    out.append(",1,1,");
+    out.append(QByteArray::number(icao & 0xffffff, 16).toUpper().rightJustified(6, '0'));
+    out.append(",1,");
+    out.append(generated);
+    out.append(',');
+    out.append(logged);
+    out.append(',');
+    out.append(callsign);
+    out.append(',');
+    out.append(altitude);
+    out.append(',');
+    out.append(speed);
+    out.append(',');
+    out.append(course);
+    out.append(',');
+    out.append(latitude);
+    out.append(',');
+    out.append(longitude);
+    out.append(",,,0,0,0,0\r\n");
+}
+
+int SbsFormatter::format(Aircraft *air, int64_t now, QByteArray &out)
+{
+    if(air == nullptr)
+        return 0;
+
+    const uint32_t icao = air->getICAO();
+    const int64_t seen = air->getMSecStop();
+    _present.insert(icao);
+
+    auto it = _sent.find(icao);
+    const bool isNew = (it == _sent.end());
+    if(isNew)
+        it = _sent.insert(icao, SentState());
+    else if(it->seen == seen)
+        return 0;
+
+    SentState& sent = *it;
+
+    if(_loggedTime != now)
+    {
+        _loggedTime = now;
+        _logged = timestamp(now);
+    }
+    const QByteArray generated = timestamp(seen);
+    const QByteArray none;
+
+    int count = 0;
+
+    const QByteArray callsign = air->getFlightInfo().trimmed().toLatin1();
+    if(!callsign.isEmpty() && callsign != sent.callsign)
+    {
+        appendMessage(out, 1, icao, generated, _logged,
+                      callsign, none, none, none, none, none);
+        sent.callsign = callsign;
+        count++;
+    }
+
+    const float altitude = air->getAltitude();
+    const QByteArray altitudeFt = QByteArray::number(qRound(altitude * CONVERT_FT_TO_METERS));
+
+    if(air->isValidGeoCoord())
+    {
+        const double latitude = air->getLatitude();
+        const double longitude = air->getLongitude();
+        if(isNew || latitude != sent.latitude || longitude != sent.longitude ||
+                altitude != sent.altitude)
+        {
+            appendMessage(out, 3, icao, generated, _logged,
+                          none, altitudeFt, none, none,
+                          QByteArray::number(latitude, 'f', 5),
+                          QByteArray::number(longitude, 'f', 5));
+            sent.latitude = latitude;
+            sent.longitude = longitude;
+            sent.altitude = altitude;
+            count++;
+        }
+    }
+    else if(altitude != sent.altitude)
+    {
+        //высота без координат - сообщение наблюдения
+        appendMessage(out, 5, icao, generated, _logged,
+                      none, altitudeFt, none, none, none, none);
+        sent.altitude = altitude;
+        count++;
+    }
+
+    const float speed = air->getSpeed();
+    const float course = air->getCourse();
+    if(speed > 0.0f && (speed != sent.speed || course != sent.course))
+    {
+        appendMessage(out, 4, icao, generated, _logged,
+                      none, none,
+                      QByteArray::number(qRound(speed / CONVERT_KN_TO_KM_P_H)),
+                      QByteArray::number(qRound(course)),
+                      none, none);
+        sent.speed = speed;
+        sent.course = course;
+        count++;
+    }
+
+    sent.seen = seen;
+    return count;
+}
+
+void SbsFormatter::finishCycle()
+{
+    for(auto it = _sent.begin(); it != _sent.end();)
+    {
+        if(_present.contains(it.key()))
+            ++it;
+        else
+            it = _sent.erase(it);
+    }
+    _present.clear();
+}
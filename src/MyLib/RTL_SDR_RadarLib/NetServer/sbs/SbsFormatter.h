@@ -0,0 +1,80 @@
+#ifndef SBSFORMATTER_H
+#define SBSFORMATTER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+
+class Aircraft;
+
+/*!
+ * \brief The SbsFormatter class
+ * Формирование сообщений SBS-1 (BaseStation, порт 30003) по изменениям
+ * самолётов относительно предыдущего вызова:
+ * MSG,1 - позывной, MSG,3 - высота и координаты, MSG,4 - скорость и курс.
+ * Высота передается в футах, скорость в узлах.
+ * \author Данильченко Артем
+ */
+class SbsFormatter
+{
+    /*!
+     * @brief  Переданное состояние самолёта
+     */
+    struct SentState
+    {
+        QByteArray callsign;
+        int64_t seen = 0;
+        float altitude = 0.0f;
+        double latitude = 0.0;
+        double longitude = 0.0;
+        float speed = 0.0f;
+        float course = 0.0f;
+    };
+
+    ///< переданное состояние по адресу ICAO
+    QHash<uint32_t, SentState> _sent;
+    ///< самолёты, обработанные в текущем цикле
+    QSet<uint32_t> _present;
+    ///< время записи сообщений и его текстовое представление
+    int64_t _loggedTime = -1;
+    QByteArray _logged;
+
+    /*!
+     * \brief timestamp дата и время в формате SBS-1: "yyyy/MM/dd,HH:mm:ss.zzz"
+     */
+    static QByteArray timestamp(int64_t msec);
+    static void appendMessage(QByteArray& out,
+                              int type,
+                              uint32_t icao,
+                              const QByteArray& generated,
+                              const QByteArray& logged,
+                              const QByteArray& callsign,
+                              const QByteArray& altitude,
+                              const QByteArray& speed,
+                              const QByteArray& course,
+                              const QByteArray& latitude,
+                              const QByteArray& longitude);
+
+public:
+    SbsFormatter() = default;
+
+    /*!
+     * \brief format добавление сообщений по изменениям самолёта
+     * \param air - самолёт
+     * \param now - время формирования, мс с начала эпохи
+     * \param out - буфер сообщений
+     * \return количество добавленных сообщений
+     */
+    int format(Aircraft* air, int64_t now, QByteArray& out);
+    /*!
+     * \brief finishCycle завершение цикла просмотра пула:
+     * забываются самолёты, не встретившиеся в цикле
+     */
+    void finishCycle();
+    /*!
+     * \brief reset следующий цикл передает все самолёты полностью
+     */
+    void reset() { _sent.clear(); _present.clear(); }
+};
+
+#endif // SBSFORMATTER_H
@@ -0,0 +1,206 @@
+#include "SbsWorker.h"
+
+#include <QDebug>
+
+#include "objects/air/Aircraft.h"
+#include "time/Clock.h"
+
+SbsWorker::SbsWorker(QSharedPointer<IPoolObject> pool):
+    _pool(pool)
+{
+    qDebug()<<"create SbsWorker";
+}
+
+SbsWorker::~SbsWorker()
+{
+    close();
+    _pool.clear();
+    qDebug()<<"delete SbsWorker";
+}
+
+bool SbsWorker::listen(quint16 port)
+{
+    if(_server == nullptr)
+    {
+        _server = new QTcpServer(this);
+        connect(_server, &QTcpServer::newConnection,
+                this, &SbsWorker::slotNewConnection);
+
+        _pollTimer = new QTimer(this);
+        connect(_pollTimer, &QTimer::timeout,
+                this, &SbsWorker::slotPoll);
+    }
+
+    if(_server->isListening())
+        _server->close();
+
+    if(!_server->listen(QHostAddress::Any, port))
+    {
+        qDebug()<<"[SbsWorker] : listen error"<<port<<_server->errorString();
+        return false;
+    }
+
+    _formatter.reset();
+    _pollTimer->start(POLL_PERIOD);
+    qDebug()<<"[SbsWorker] : listen port"<<port;
+    return true;
+}
+
+bool SbsWorker::isListening()
+{
+    return (_server != nullptr) && _server->isListening();
+}
+
+void SbsWorker::close()
+{
+    if(_server != nullptr)
+        _server->close();
+    if(_pollTimer != nullptr)
+        _pollTimer->stop();
+
+    for(QTcpSocket* socket : _clients.keys())
+        closeClient(socket);
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.clients = 0;
+}
+
+SbsServerStats SbsWorker::stats()
+{
+    QMutexLocker lock(&_statsMutex);
+    return _stats;
+}
+
+void SbsWorker::slotNewConnection()
+{
+    while(_server->hasPendingConnections())
+    {
+        QTcpSocket* socket = _server->nextPendingConnection();
+
+        Client client;
+        client.address = QString("%1:%2")
+                .arg(socket->peerAddress().toString())
+                .arg(socket->peerPort());
+        client.lastDelivered = Clock::nowMSec();
+
+        connect(socket, &QTcpSocket::readyRead,
+                this, &SbsWorker::slotReadyRead);
+        connect(socket, &QTcpSocket::disconnected,
+                this, &SbsWorker::slotDisconnected);
+
+        qDebug()<<"[SbsWorker] : client connected"<<client.address;
+        _clients.insert(socket, client);
+    }
+
+    //новый клиент должен получить все самолёты, а не только изменения
+    _formatter.reset();
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.clients = _clients.size();
+}
+
+void SbsWorker::slotReadyRead()
+{
+    //клиенты SBS-1 ничего не передают, входящие данные отбрасываются
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if(socket != nullptr)
+        socket->readAll();
+}
+
+void SbsWorker::slotDisconnected()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if(socket == nullptr || !_clients.contains(socket))
+        return;
+
+    qDebug()<<"[SbsWorker] : client disconnected"<<_clients.value(socket).address;
+    closeClient(socket);
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.clients = _clients.size();
+}
+
+void SbsWorker::closeClient(QTcpSocket *socket)
+{
+    _clients.remove(socket);
+
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+}
+
+void SbsWorker::slotPoll()
+{
+    if(_pool.isNull() || _clients.isEmpty())
+        return;
+
+    //пул занят - сообщения будут сформированы в следующем цикле
+    if(!_pool->tryLockPool())
+        return;
+
+    const int64_t now = Clock::nowMSec();
+    QByteArray batch;
+    int messages = 0;
+
+    for(auto& object : _pool->values())
+    {
+        Aircraft* air = dynamic_cast<Aircraft*>(object.data());
+        if(air != nullptr)
+            messages += _formatter.format(air, now, batch);
+    }
+    _formatter.finishCycle();
+
+    _pool->unlockPool();
+
+    if(batch.isEmpty())
+        return;
+
+    {
+        QMutexLocker lock(&_statsMutex);
+        _stats.messages += uint64_t(messages);
+        _stats.batches++;
+    }
+
+    broadcast(batch, now);
+}
+
+void SbsWorker::broadcast(const QByteArray &batch, int64_t now)
+{
+    uint64_t bytes = 0;
+    uint64_t skipped = 0;
+    uint64_t slow = 0;
+
+    for(QTcpSocket* socket : _clients.keys())
+    {
+        Client& client = _clients[socket];
+
+        if(socket->bytesToWrite() > CLIENT_BUFFER_LIMIT)
+        {
+            //клиент не успевает принимать данные - пакет пропускается,
+            //чтобы не задерживать остальных клиентов
+            client.skipped++;
+            skipped++;
+
+            if(now - client.lastDelivered > SLOW_CLIENT_TIMEOUT)
+            {
+                qDebug()<<"[SbsWorker] : slow client disconnected"<<client.address
+                       <<"skipped"<<client.skipped;
+                closeClient(socket);
+                slow++;
+            }
+            continue;
+        }
+
+        //общий буфер не копируется при передаче, копию делает сокет
+        socket->write(batch);
+        client.lastDelivered = now;
+        client.skipped = 0;
+        bytes += uint64_t(batch.size());
+    }
+
+    QMutexLocker lock(&_statsMutex);
+    _stats.bytes += bytes;
+    _stats.skipped += skipped;
+    _stats.slowDisconnects += slow;
+    _stats.clients = _clients.size();
+}
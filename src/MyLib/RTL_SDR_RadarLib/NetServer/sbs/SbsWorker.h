@@ -0,0 +1,83 @@
+#ifndef SBSWORKER_H
+#define SBSWORKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "interface/IPoolObject.h"
+#include "interface/ISbsServer.h"
+#include "SbsFormatter.h"
+
+/*!
+ * \brief The SbsWorker class
+ * Выдача данных о самолётах в формате SBS-1. Выполняется в отдельном
+ * потоке: сообщения формируются один раз за цикл опроса пула в общий
+ * буфер, который затем передается всем клиентам. Клиент, не успевающий
+ * принимать данные, пропускает пакеты, а при длительной задержке отключается.
+ * \author Данильченко Артем
+ */
+class SbsWorker : public QObject
+{
+    Q_OBJECT
+
+    ///< период опроса пула объектов, мс
+    const int POLL_PERIOD = 500;
+    ///< предел неотправленных данных клиента, байт
+    const qint64 CLIENT_BUFFER_LIMIT = 64 * 1024;
+    ///< время без доставки пакетов до отключения клиента, мс
+    const int64_t SLOW_CLIENT_TIMEOUT = 30000;
+
+    /*!
+     * @brief  Состояние подключенного клиента
+     */
+    struct Client
+    {
+        QString address;
+        ///< время последней передачи пакета клиенту
+        int64_t lastDelivered = 0;
+        ///< пропущенные пакеты подряд
+        uint64_t skipped = 0;
+    };
+
+    QSharedPointer<IPoolObject> _pool;
+    QTcpServer* _server = nullptr;
+    QTimer* _pollTimer = nullptr;
+    QHash<QTcpSocket*, Client> _clients;
+    SbsFormatter _formatter;
+
+    ///< копия счетчиков для чтения из других потоков
+    QMutex _statsMutex;
+    SbsServerStats _stats;
+
+    /*!
+     * \brief broadcast передача пакета всем клиентам
+     * \param batch - общий буфер сообщений цикла
+     * \param now - текущее время, мс
+     */
+    void broadcast(const QByteArray& batch, int64_t now);
+    void closeClient(QTcpSocket* socket);
+
+public:
+    explicit SbsWorker(QSharedPointer<IPoolObject> pool);
+    ~SbsWorker() override;
+
+    SbsServerStats stats();
+
+public slots:
+    bool listen(quint16 port);
+    bool isListening();
+    void close();
+
+private slots:
+    void slotNewConnection();
+    void slotReadyRead();
+    void slotDisconnected();
+    void slotPoll();
+};
+
+#endif // SBSWORKER_H
@@ -1,10 +1,13 @@
 #include "PoolObject.h"
+#include "time/Clock.h"
+#include "database/AircraftInfoLoader.h"
 
 
 PoolObject::PoolObject(OBJECT_TYPE type):
     _container(pHash(new QHash<uint64_t,
                      QSharedPointer<IObject>> ())),
-    _type(type)
+    _type(type),
+    _expiryWheel(QDateTime::currentMSecsSinceEpoch())
 {
     qDebug()<<"PoolObject() -> create";
 }
@@ -24,6 +27,14 @@ QSharedPointer<IObject> PoolObject::createNewObject(uint64_t id,
                                                     QDateTime reg_time,
                                                     Position geoPosition,
                                                     bool isImit)
+{
+    return createNewObject(id, Clock::fromDateTime(reg_time), geoPosition, isImit);
+}
+
+QSharedPointer<IObject> PoolObject::createNewObject(uint64_t id,
+                                                    int64_t reg_time,
+                                                    Position geoPosition,
+                                                    bool isImit)
 {
     if(id == 0)
         return  QSharedPointer<IObject>();
@@ -38,6 +49,7 @@ QSharedPointer<IObject> PoolObject::createNewObject(uint64_t id,
             {
                 t_id = _container->key(iter);
                 object = _container->take(t_id);
+                _geoIndex.remove(t_id);
                 break;
             }
         }
@@ -60,13 +72,18 @@ QSharedPointer<IObject> PoolObject::createNewObject(uint64_t id,
 
         object->setId(id);
         object->setObjectState(OBJECT_STATE::NEW_OBJECT);
-        object->setDateTimeStart(reg_time);
-        object->setDateTimeStop(reg_time);
+        object->setNSecStart(reg_time);
+        object->setNSecStop(reg_time);
         object->setGeoCoord(geoPosition);
     }
 
     if(!object.isNull())
+    {
         _container->insert(id,object);
+        scheduleExpiry(object);
+        _geoIndex.update(id, object->getGeoCoord());
+        loadAircraftInfo(_database.data(), object.data());
+    }
 
    return object;
 }
@@ -127,16 +144,129 @@ void PoolObject::deleteMarkedObjects()
 
     std::for_each(_container->begin(),
                   _container->end(),
-                  [](QSharedPointer<IObject> iter)
+                  [this](QSharedPointer<IObject> iter)
     {
         if(iter->getObjectState() == OBJECT_STATE::DELETE_OBJECT)
+        {
+            _geoIndex.remove(iter->getId());
             iter->resetObjectData();
+        }
     });
 }
 
 void PoolObject::deleteObject(uint64_t id)
 {
     if(_container->contains(id))
+    {
+        _geoIndex.remove(id);
         _container->value(id)->resetObjectData();
+    }
 }
 
+void PoolObject::setObjectTTL(OBJECT_TYPE type, int64_t ttl)
+{
+    if(ttl > 0)
+        _ttl.insert(type, ttl);
+}
+
+int64_t PoolObject::getObjectTTL(OBJECT_TYPE type)
+{
+    return _ttl.value(type, DEFAULT_TTL);
+}
+
+void PoolObject::scheduleExpiry(const QSharedPointer<IObject> &object)
+{
+    uint64_t id = object->getId();
+    if(_scheduled.contains(id))
+        return;
+
+    _scheduled.insert(id);
+    _expiryWheel.schedule(id,
+                          object->getMSecStop() + getObjectTTL(object->getTypeObject()));
+}
+
+int PoolObject::removeStaleObjects(int64_t now)
+{
+    int counter = 0;
+
+    _expiryWheel.advance(now, [this, now, &counter](uint64_t id) -> int64_t
+    {
+        QSharedPointer<IObject> object = _container->value(id);
+
+        //объект удалён или переиспользован под другой id
+        if(object.isNull() || !object->getInUse() || object->getId() != id)
+        {
+            _scheduled.remove(id);
+            return 0;
+        }
+
+        //объект обновлялся - переносим срок истечения
+        int64_t deadline = object->getMSecStop() + getObjectTTL(object->getTypeObject());
+        if(deadline > now)
+            return deadline;
+
+        _geoIndex.remove(id);
+        object->resetObjectData();
+        _scheduled.remove(id);
+        ++counter;
+        return 0;
+    });
+
+    return counter;
+}
+
+void PoolObject::updateGeoIndex(uint64_t id)
+{
+    QSharedPointer<IObject> object = getObjectByID(id);
+    if(object.isNull())
+    {
+        _geoIndex.remove(id);
+        return;
+    }
+
+    _geoIndex.update(id, object->getGeoCoord());
+}
+
+QList<QSharedPointer<IObject> > PoolObject::toObjects(const QVector<uint64_t> &ids)
+{
+    QList<QSharedPointer<IObject> > list;
+    list.reserve(ids.size());
+
+    for(uint64_t id : ids)
+    {
+        QSharedPointer<IObject> object = getObjectByID(id);
+        if(!object.isNull())
+            list.append(object);
+    }
+    return list;
+}
+
+QList<QSharedPointer<IObject> > PoolObject::valuesInRect(const Position &southWest,
+                                                         const Position &northEast)
+{
+    return toObjects(_geoIndex.queryRect(southWest.longitude(),
+                                         southWest.latitude(),
+                                         northEast.longitude(),
+                                         northEast.latitude()));
+}
+
+QList<QSharedPointer<IObject> > PoolObject::valuesInRadius(const Position &center,
+                                                           double radius)
+{
+    return toObjects(_geoIndex.queryRadius(center, radius));
+}
+
+QSharedPointer<IObject> PoolObject::nearestObject(const Position &center,
+                                                  double maxRadius)
+{
+    uint64_t id = _geoIndex.nearest(center, maxRadius);
+    if(id == 0)
+        return QSharedPointer<IObject>();
+
+    return getObjectByID(id);
+}
+
+void PoolObject::setAircraftDatabase(QSharedPointer<IAircraftDatabase> database)
+{
+    _database = database;
+}
@@ -6,17 +6,44 @@
 #include <QSharedPointer>
 #include <QDateTime>
 #include <QMutex>
+#include <QMap>
+#include <QSet>
 
 #include "interface/IPoolObject.h"
 #include "factory/FactoryObjects.h"
+#include "expiry/TimingWheel.h"
+#include "index/SpatialGrid.h"
 
 
 class POOLOBJECTSHARED_EXPORT PoolObject : public IPoolObject
 {
+    ///< время жизни объекта по умолчанию, мс
+    const int64_t DEFAULT_TTL = 60000;
+
     pHash _container;
     QMutex _mutex;
     FactoryObjects _factory;
     OBJECT_TYPE _type = OBJECT_TYPE::base;
+    ///< время жизни объектов по типам
+    QMap<OBJECT_TYPE, int64_t> _ttl;
+    ///< колесо таймеров для удаления устаревших объектов
+    TimingWheel _expiryWheel;
+    ///< идентификаторы объектов, находящихся в колесе таймеров
+    QSet<uint64_t> _scheduled;
+    ///< пространственный индекс объектов
+    SpatialGrid _geoIndex;
+    ///< справочник самолётов
+    QSharedPointer<IAircraftDatabase> _database;
+
+    /*!
+     * \brief scheduleExpiry постановка объекта на контроль времени жизни
+     * \param object - объект пула
+     */
+    void scheduleExpiry(const QSharedPointer<IObject> &object);
+    /*!
+     * \brief toObjects преобразование списка идентификаторов в список объектов
+     */
+    QList<QSharedPointer<IObject>> toObjects(const QVector<uint64_t> &ids);
 public:
     explicit PoolObject(OBJECT_TYPE type);
     ~PoolObject() override;
@@ -26,6 +53,11 @@ public:
                                             Position geoPosition = Position(),
                                             bool isImit = false) override;
 
+    QSharedPointer<IObject> createNewObject(uint64_t id,
+                                            int64_t reg_time,
+                                            Position geoPosition = Position(),
+                                            bool isImit = false) override;
+
     QList<QSharedPointer<IObject> > values() override;
 
     QList<QSharedPointer<IObject> > allValues() override;
@@ -39,6 +71,20 @@ public:
     void deleteMarkedObjects() override;
     void deleteObject(uint64_t id) override;
 
+    void setObjectTTL(OBJECT_TYPE type, int64_t ttl) override;
+    int64_t getObjectTTL(OBJECT_TYPE type) override;
+    int removeStaleObjects(int64_t now) override;
+
+    void updateGeoIndex(uint64_t id) override;
+    QList<QSharedPointer<IObject>> valuesInRect(const Position& southWest,
+                                                const Position& northEast) override;
+    QList<QSharedPointer<IObject>> valuesInRadius(const Position& center,
+                                                  double radius) override;
+    QSharedPointer<IObject> nearestObject(const Position& center,
+                                          double maxRadius) override;
+
+    void setAircraftDatabase(QSharedPointer<IAircraftDatabase> database) override;
+
     void lockPool() override { _mutex.lock(); }
     bool tryLockPool() override { return _mutex.tryLock(5);}
     void unlockPool() override { _mutex.unlock(); }
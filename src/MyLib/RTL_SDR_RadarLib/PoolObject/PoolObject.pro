@@ -15,8 +15,14 @@ SOURCES += PoolObject.cpp \
     ../../../include/coord/Position.cpp \
     ../../../include/coord/Conversions.cpp \
     factory/FactoryObjects.cpp \
+    expiry/TimingWheel.cpp \
+    index/SpatialGrid.cpp \
+    table/PoolObjectTable.cpp \
+    database/AircraftDatabase.cpp \
     ../../../include/objects/base/BaseObject.cpp \
-    ../../../include/objects/air/Aircraft.cpp
+    ../../../include/objects/air/Aircraft.cpp \
+    ../../../include/objects/air/TrackHistory.cpp \
+    ../../../include/objects/air/TrackPredictor.cpp
 
 HEADERS += PoolObject.h\
         poolobject_global.h \
@@ -26,9 +32,20 @@ HEADERS += PoolObject.h\
     ../../../include/coord/Position.h \
     ../../../include/coord/Conversions.h \
     factory/FactoryObjects.h \
+    expiry/TimingWheel.h \
+    index/SpatialGrid.h \
+    table/PoolObjectTable.h \
+    database/AircraftDatabase.h \
+    database/AircraftInfoLoader.h \
+    ../../../include/database/AircraftDbFormat.h \
+    ../../../include/interface/IAircraftDatabase.h \
     ../../../include/objects/base/BaseObject.h \
+    ../../../include/objects/base/StateColumns.h \
+    ../../../include/time/Clock.h \
     ../../../include/objects/air/Aircraft.h \
-    ../../../include/objects/air/StructAircraft.h
+    ../../../include/objects/air/StructAircraft.h \
+    ../../../include/objects/air/TrackHistory.h \
+    ../../../include/objects/air/TrackPredictor.h
 unix {
     target.path = /usr/lib
     INSTALLS += target
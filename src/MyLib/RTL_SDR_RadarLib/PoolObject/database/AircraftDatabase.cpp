@@ -0,0 +1,117 @@
+#include "AircraftDatabase.h"
+
+#include <algorithm>
+#include <string.h>
+#include <QDebug>
+
+AircraftDatabase::AircraftDatabase()
+{
+}
+
+AircraftDatabase::~AircraftDatabase()
+{
+    close();
+}
+
+bool AircraftDatabase::open(const QString &fileName)
+{
+    close();
+
+    _file.setFileName(fileName);
+    if(!_file.open(QIODevice::ReadOnly))
+    {
+        qDebug()<<"[AircraftDatabase] : can't open file"<<fileName;
+        return false;
+    }
+
+    qint64 size = _file.size();
+    if(size < qint64(sizeof(AircraftDbHeader)))
+    {
+        qDebug()<<"[AircraftDatabase] : file is too small"<<fileName;
+        close();
+        return false;
+    }
+
+    const uchar* data = _file.map(0, size);
+    if(data == nullptr)
+    {
+        qDebug()<<"[AircraftDatabase] : can't map file"<<fileName;
+        close();
+        return false;
+    }
+
+    AircraftDbHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    bool isValid = (memcmp(header.magic, AIRCRAFT_DB_MAGIC, sizeof(header.magic)) == 0) &&
+            (header.version == AIRCRAFT_DB_VERSION) &&
+            (qint64(header.recordsOffset) +
+             qint64(header.count) * qint64(sizeof(AircraftDbRecord)) <= size) &&
+            (qint64(header.stringsOffset) + qint64(header.stringsSize) <= size);
+
+    if(!isValid)
+    {
+        qDebug()<<"[AircraftDatabase] : wrong file format"<<fileName;
+        _file.unmap(const_cast<uchar*>(data));
+        close();
+        return false;
+    }
+
+    _data = data;
+    _records = reinterpret_cast<const AircraftDbRecord*>(_data + header.recordsOffset);
+    _strings = reinterpret_cast<const char*>(_data + header.stringsOffset);
+    _stringsSize = header.stringsSize;
+    _count = int(header.count);
+
+    qDebug()<<"[AircraftDatabase] : loaded records"<<_count;
+    return true;
+}
+
+void AircraftDatabase::close()
+{
+    if(_data != nullptr)
+        _file.unmap(const_cast<uchar*>(_data));
+
+    _data = nullptr;
+    _records = nullptr;
+    _strings = nullptr;
+    _stringsSize = 0;
+    _count = 0;
+
+    if(_file.isOpen())
+        _file.close();
+}
+
+QString AircraftDatabase::string(uint32_t offset) const
+{
+    if(offset == AIRCRAFT_DB_NO_STRING || offset >= _stringsSize)
+        return QString();
+
+    const char* str = _strings + offset;
+    size_t length = strnlen(str, _stringsSize - offset);
+
+    return QString::fromUtf8(str, int(length));
+}
+
+bool AircraftDatabase::lookup(uint32_t icao, AircraftInfo &info) const
+{
+    if(_records == nullptr)
+        return false;
+
+    const AircraftDbRecord* end = _records + _count;
+    const AircraftDbRecord* record = std::lower_bound(_records, end, icao,
+                                                      [](const AircraftDbRecord& r,
+                                                      uint32_t value)
+    {
+        return r.icao < value;
+    });
+
+    if(record == end || record->icao != icao)
+        return false;
+
+    info.registration = string(record->registration);
+    info.type = string(record->type);
+    info.owner = string(record->owner);
+
+    return true;
+}
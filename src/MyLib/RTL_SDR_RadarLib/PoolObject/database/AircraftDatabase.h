@@ -0,0 +1,55 @@
+#ifndef AIRCRAFTDATABASE_H
+#define AIRCRAFTDATABASE_H
+
+#include "../poolobject_global.h"
+
+#include <QFile>
+
+#include "interface/IAircraftDatabase.h"
+#include "database/AircraftDbFormat.h"
+
+/*!
+ * \brief The AircraftDatabase class
+ * Справочник самолётов в отображаемом в память файле.
+ * Файл не загружается целиком: записи отсортированы по адресу ICAO,
+ * поиск выполняется двоичным поиском по отображению, в память
+ * процесса попадают только прочитанные страницы.
+ * Файл создаётся утилитой AircraftDbBuilder.
+ * \author Данильченко Артем
+ */
+class POOLOBJECTSHARED_EXPORT AircraftDatabase : public IAircraftDatabase
+{
+    QFile _file;
+    ///< отображение файла в память
+    const uchar* _data = nullptr;
+    ///< записи справочника
+    const AircraftDbRecord* _records = nullptr;
+    ///< пул строк
+    const char* _strings = nullptr;
+    uint32_t _stringsSize = 0;
+    int _count = 0;
+
+    /*!
+     * \brief string строка из пула по смещению
+     */
+    QString string(uint32_t offset) const;
+public:
+    AircraftDatabase();
+    ~AircraftDatabase() override;
+    /*!
+     * \brief open открытие файла справочника
+     * \param fileName - путь к файлу
+     * \return true - файл открыт и прошёл проверку
+     */
+    bool open(const QString& fileName);
+    /*!
+     * \brief close закрытие файла справочника
+     */
+    void close();
+
+    bool isOpen() const override { return _data != nullptr; }
+    int count() const override { return _count; }
+    bool lookup(uint32_t icao, AircraftInfo& info) const override;
+};
+
+#endif // AIRCRAFTDATABASE_H
@@ -0,0 +1,29 @@
+#ifndef AIRCRAFTINFOLOADER_H
+#define AIRCRAFTINFOLOADER_H
+
+#include "interface/IAircraftDatabase.h"
+#include "objects/air/Aircraft.h"
+
+/*!
+ * \brief loadAircraftInfo заполнение справочных данных нового самолёта.
+ * Поиск выполняется один раз за время жизни объекта, повторные вызовы
+ * для того же самолёта ничего не делают
+ * \param database - справочник самолётов
+ * \param object - объект пула
+ */
+inline void loadAircraftInfo(IAircraftDatabase* database, IObject* object)
+{
+    if(database == nullptr || object == nullptr ||
+            object->getTypeObject() != OBJECT_TYPE::air)
+        return;
+
+    Aircraft* aircraft = dynamic_cast<Aircraft*>(object);
+    if(aircraft == nullptr || aircraft->isAircraftInfoLoaded())
+        return;
+
+    AircraftInfo info;
+    database->lookup(aircraft->getICAO(), info);
+    aircraft->setAircraftInfo(info);
+}
+
+#endif // AIRCRAFTINFOLOADER_H
@@ -0,0 +1,34 @@
+#include "TimingWheel.h"
+
+TimingWheel::TimingWheel(int64_t startTime,
+                         int64_t tick,
+                         uint32_t slotsCount):
+    _tick(tick > 0 ? tick : 1)
+{
+    uint32_t count = 1;
+    while(count < slotsCount)
+        count <<= 1;
+
+    _mask = count - 1;
+    _slots.resize(int(count));
+    _currentTick = startTime / _tick;
+}
+
+void TimingWheel::schedule(uint64_t id, int64_t deadline)
+{
+    int64_t tick = deadline / _tick;
+
+    //просроченные записи обрабатываются на следующем тике
+    if(tick <= _currentTick)
+        tick = _currentTick + 1;
+
+    _slots[int(tick & _mask)].append({id, deadline});
+    ++_size;
+}
+
+void TimingWheel::clear()
+{
+    for(auto &slot : _slots)
+        slot.clear();
+    _size = 0;
+}
@@ -0,0 +1,115 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <stdint.h>
+#include <QVector>
+
+/*!
+ * \brief The TimingWheel class
+ * Колесо таймеров для отслеживания времени жизни объектов.
+ * Объекты раскладываются по слотам в соответствии со сроком истечения,
+ * при продвижении колеса обрабатываются только слоты, время которых
+ * наступило. Стоимость продвижения пропорциональна количеству
+ * истекших записей, а не общему количеству объектов.
+ * \author Данильченко Артем
+ */
+class TimingWheel
+{
+public:
+    struct Entry
+    {
+        ///< идентификатор объекта
+        uint64_t id;
+        ///< время истечения в мс с начала эпохи
+        int64_t deadline;
+    };
+
+private:
+    ///< длительность одного слота в мс
+    int64_t _tick = 1000;
+    ///< маска индекса слота (количество слотов - степень двойки)
+    uint32_t _mask = 0;
+    ///< номер последнего обработанного тика
+    int64_t _currentTick = 0;
+    ///< количество записей в колесе
+    int _size = 0;
+    ///< слоты колеса
+    QVector<QVector<Entry>> _slots;
+    ///< буфер для обработки слота, память переиспользуется
+    QVector<Entry> _due;
+
+public:
+    /*!
+     * \brief TimingWheel конструктор
+     * \param startTime - время начала отсчёта в мс с начала эпохи
+     * \param tick - длительность слота в мс
+     * \param slotsCount - количество слотов, округляется до степени двойки
+     */
+    TimingWheel(int64_t startTime,
+                int64_t tick = 1000,
+                uint32_t slotsCount = 128);
+    /*!
+     * \brief schedule добавление записи в колесо
+     * \param id - идентификатор объекта
+     * \param deadline - время истечения в мс с начала эпохи
+     */
+    void schedule(uint64_t id, int64_t deadline);
+    /*!
+     * \brief size количество записей в колесе
+     */
+    int size() const { return _size; }
+    /*!
+     * \brief clear удаление всех записей
+     */
+    void clear();
+
+    /*!
+     * \brief advance продвижение колеса до текущего времени.
+     * Для каждой истекшей записи вызывается onExpired(id), который
+     * возвращает новое время истечения (запись будет перепланирована)
+     * или 0, если запись нужно удалить из колеса.
+     * \param now - текущее время в мс с начала эпохи
+     * \param onExpired - обработчик истекших записей
+     */
+    template<typename F>
+    void advance(int64_t now, F onExpired)
+    {
+        int64_t nowTick = now / _tick;
+        if(nowTick <= _currentTick)
+            return;
+
+        //за один проход каждый слот обрабатывается не более одного раза
+        int64_t lastTick = nowTick;
+        if(lastTick - _currentTick > int64_t(_slots.size()))
+            lastTick = _currentTick + _slots.size();
+
+        for(int64_t t = _currentTick + 1; t <= lastTick; ++t)
+        {
+            QVector<Entry>& slot = _slots[int(t & _mask)];
+            if(slot.isEmpty())
+                continue;
+
+            _due.swap(slot);
+            _size -= _due.size();
+            _currentTick = t;
+
+            for(const Entry& entry : _due)
+            {
+                //запись из следующего оборота колеса
+                if(entry.deadline > now)
+                {
+                    schedule(entry.id, entry.deadline);
+                    continue;
+                }
+
+                int64_t deadline = onExpired(entry.id);
+                if(deadline != 0)
+                    schedule(entry.id, deadline);
+            }
+            _due.clear();
+        }
+        _currentTick = nowTick;
+    }
+};
+
+#endif // TIMINGWHEEL_H
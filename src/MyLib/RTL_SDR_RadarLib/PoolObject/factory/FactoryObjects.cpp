@@ -1,7 +1,5 @@
 #include "FactoryObjects.h"
 
-#include <QDateTime>
-
 #include "objects/air/Aircraft.h"
 
 FactoryObjects::FactoryObjects()
@@ -11,7 +9,7 @@ FactoryObjects::FactoryObjects()
 
 IObject *FactoryObjects::createObject(OBJECT_TYPE type,
                                      uint64_t id,
-                                     QDateTime reg_time,
+                                     int64_t reg_time,
                                      bool isImit,
                                      Position geoPosition)
 {
@@ -25,12 +23,13 @@ IObject *FactoryObjects::createObject(OBJECT_TYPE type,
 
 
 IObject *FactoryObjects::createAircraft(uint32_t icao,
-                                        QDateTime reg_time,
+                                        int64_t reg_time,
                                         bool isImit,
                                         Position geoPosition)
 {
     IObject* object  = new Aircraft(icao, isImit);
-    object->setDateTimeStart(reg_time);
+    object->setNSecStart(reg_time);
+    object->setNSecStop(reg_time);
     object->setGeoCoord(geoPosition);
     return  object;
 }
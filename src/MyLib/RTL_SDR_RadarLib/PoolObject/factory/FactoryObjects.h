@@ -6,14 +6,14 @@
 class FactoryObjects
 {
     IObject* createAircraft(uint32_t icao,
-                            QDateTime reg_time,
+                            int64_t reg_time,
                             bool isImit = false,
                             Position geoPosition = Position());
 public:
     FactoryObjects();
     IObject* createObject(OBJECT_TYPE type,
                          uint64_t id,
-                         QDateTime reg_time,
+                         int64_t reg_time,
                          bool isImit = false,
                          Position geoPosition = Position());
 };
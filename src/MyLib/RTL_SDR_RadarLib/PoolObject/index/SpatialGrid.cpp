@@ -0,0 +1,274 @@
+#include <math.h>
+
+#include "SpatialGrid.h"
+#include "coord/Conversions.h"
+
+namespace
+{
+///< максимальная широта для расчета размеров ячейки в метрах
+const double MAX_LATITUDE = 89.9;
+}
+
+SpatialGrid::SpatialGrid(double cellSize):
+    _cellSize(cellSize > 0.0 ? cellSize : 0.25)
+{
+    _columns = int64_t(ceil(360.0 / _cellSize));
+    _rows = int64_t(ceil(180.0 / _cellSize));
+}
+
+int64_t SpatialGrid::row(double latitude) const
+{
+    int64_t r = int64_t(floor((latitude + 90.0) / _cellSize));
+    if(r < 0)
+        return 0;
+    if(r >= _rows)
+        return _rows - 1;
+    return r;
+}
+
+int64_t SpatialGrid::column(double longitude) const
+{
+    int64_t c = int64_t(floor((longitude + 180.0) / _cellSize)) % _columns;
+    if(c < 0)
+        c += _columns;
+    return c;
+}
+
+uint64_t SpatialGrid::cellKey(int64_t row, int64_t column) const
+{
+    column %= _columns;
+    if(column < 0)
+        column += _columns;
+    return uint64_t(row * _columns + column);
+}
+
+void SpatialGrid::removeFromCell(uint64_t cell, uint64_t id)
+{
+    auto iter = _cells.find(cell);
+    if(iter == _cells.end())
+        return;
+
+    QVector<uint64_t>& ids = iter.value();
+    int index = ids.indexOf(id);
+    if(index >= 0)
+    {
+        ids[index] = ids.last();
+        ids.removeLast();
+    }
+
+    if(ids.isEmpty())
+        _cells.erase(iter);
+}
+
+template<typename F>
+void SpatialGrid::forEachInCells(int64_t row0, int64_t row1,
+                                 int64_t col0, int64_t col1,
+                                 F func) const
+{
+    if(row0 < 0)
+        row0 = 0;
+    if(row1 >= _rows)
+        row1 = _rows - 1;
+    if(col1 - col0 >= _columns)
+    {
+        col0 = 0;
+        col1 = _columns - 1;
+    }
+
+    int64_t span = col1 - col0;
+    int64_t cellsCount = (row1 - row0 + 1) * (span + 1);
+
+    //область больше числа занятых ячеек - просматриваем только занятые
+    if(cellsCount > int64_t(_cells.size()))
+    {
+        for(auto iter = _cells.cbegin(); iter != _cells.cend(); ++iter)
+        {
+            int64_t r = int64_t(iter.key()) / _columns;
+            int64_t c = int64_t(iter.key()) % _columns;
+            int64_t offset = (c - col0) % _columns;
+            if(offset < 0)
+                offset += _columns;
+
+            if(r < row0 || r > row1 || offset > span)
+                continue;
+
+            for(uint64_t id : iter.value())
+                func(id, _objects.value(id).position);
+        }
+        return;
+    }
+
+    for(int64_t r = row0; r <= row1; ++r)
+    {
+        for(int64_t c = col0; c <= col1; ++c)
+        {
+            auto iter = _cells.constFind(cellKey(r, c));
+            if(iter == _cells.cend())
+                continue;
+
+            for(uint64_t id : iter.value())
+                func(id, _objects.value(id).position);
+        }
+    }
+}
+
+void SpatialGrid::update(uint64_t id, const Position &pos)
+{
+    if(!Conversions::isValidGeoCoord(pos))
+    {
+        remove(id);
+        return;
+    }
+
+    uint64_t cell = cellKey(row(pos.latitude()), column(pos.longitude()));
+
+    auto iter = _objects.find(id);
+    if(iter != _objects.end())
+    {
+        iter.value().position = pos;
+        if(iter.value().cell == cell)
+            return;
+
+        removeFromCell(iter.value().cell, id);
+        iter.value().cell = cell;
+    }
+    else
+        _objects.insert(id, {cell, pos});
+
+    _cells[cell].append(id);
+}
+
+void SpatialGrid::remove(uint64_t id)
+{
+    auto iter = _objects.find(id);
+    if(iter == _objects.end())
+        return;
+
+    removeFromCell(iter.value().cell, id);
+    _objects.erase(iter);
+}
+
+void SpatialGrid::clear()
+{
+    _cells.clear();
+    _objects.clear();
+}
+
+QVector<uint64_t> SpatialGrid::queryRect(double minLon, double minLat,
+                                         double maxLon, double maxLat) const
+{
+    QVector<uint64_t> result;
+
+    //область пересекает линию смены дат
+    if(minLon > maxLon)
+    {
+        result = queryRect(minLon, minLat, 180.0, maxLat);
+        result += queryRect(-180.0, minLat, maxLon, maxLat);
+        return result;
+    }
+
+    int64_t col0 = int64_t(floor((minLon + 180.0) / _cellSize));
+    int64_t col1 = int64_t(floor((maxLon + 180.0) / _cellSize));
+
+    forEachInCells(row(minLat), row(maxLat), col0, col1,
+                   [&](uint64_t id, const Position& pos)
+    {
+        if(pos.longitude() >= minLon && pos.longitude() <= maxLon &&
+                pos.latitude() >= minLat && pos.latitude() <= maxLat)
+            result.append(id);
+    });
+
+    return result;
+}
+
+QVector<uint64_t> SpatialGrid::queryRadius(const Position &center,
+                                           double radius) const
+{
+    QVector<uint64_t> result;
+    if(radius <= 0.0 || _objects.isEmpty())
+        return result;
+
+    double dLat = radius * Conversions::degreesLatPerMeter(center.latitude());
+    double edgeLat = fmin(fabs(center.latitude()) + dLat, MAX_LATITUDE);
+    double dLon = radius * Conversions::degreesLonPerMeter(edgeLat);
+
+    int64_t col0 = int64_t(floor((center.longitude() - dLon + 180.0) / _cellSize));
+    int64_t col1 = int64_t(floor((center.longitude() + dLon + 180.0) / _cellSize));
+
+    forEachInCells(row(center.latitude() - dLat), row(center.latitude() + dLat),
+                   col0, col1,
+                   [&](uint64_t id, const Position& pos)
+    {
+        if(center.flatDistanceEstimate(pos) <= radius)
+            result.append(id);
+    });
+
+    return result;
+}
+
+uint64_t SpatialGrid::nearest(const Position &center, double maxRadius) const
+{
+    uint64_t bestId = 0;
+    double bestDist = maxRadius;
+
+    auto check = [&](uint64_t id, const Position& pos)
+    {
+        double dist = center.flatDistanceEstimate(pos);
+        if(dist <= bestDist)
+        {
+            bestDist = dist;
+            bestId = id;
+        }
+    };
+
+    if(_objects.isEmpty())
+        return 0;
+
+    int64_t r0 = row(center.latitude());
+    int64_t c0 = int64_t(floor((center.longitude() + 180.0) / _cellSize));
+
+    //ячейки обходятся кольцами вокруг точки поиска
+    for(int64_t ring = 0; ; ++ring)
+    {
+        //кольцо охватывает больше ячеек, чем занято - полный просмотр
+        if((2 * ring + 1) * (2 * ring + 1) > int64_t(_objects.size()) * 4 ||
+                ring > _columns / 2)
+        {
+            for(auto iter = _objects.cbegin(); iter != _objects.cend(); ++iter)
+                check(iter.key(), iter.value().position);
+            break;
+        }
+
+        for(int64_t r = r0 - ring; r <= r0 + ring; ++r)
+        {
+            if(r < 0 || r >= _rows)
+                continue;
+
+            bool edgeRow = (r == r0 - ring || r == r0 + ring);
+            int64_t step = edgeRow ? 1 : 2 * ring;
+
+            for(int64_t c = c0 - ring; c <= c0 + ring; c += step)
+            {
+                auto iter = _cells.constFind(cellKey(r, c));
+                if(iter == _cells.cend())
+                    continue;
+
+                for(uint64_t id : iter.value())
+                    check(id, _objects.value(id).position);
+            }
+        }
+
+        //минимальный размер ячейки в метрах в пределах просмотренной области
+        double edgeLat = fmin(fabs(center.latitude()) + (ring + 1) * _cellSize,
+                              MAX_LATITUDE);
+        double cellMeters = _cellSize /
+                fmax(Conversions::degreesLatPerMeter(edgeLat),
+                     Conversions::degreesLonPerMeter(edgeLat));
+
+        //объекты в следующих кольцах не ближе ring * cellMeters
+        if(ring * cellMeters >= bestDist)
+            break;
+    }
+
+    return bestId;
+}
@@ -0,0 +1,103 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <stdint.h>
+#include <QHash>
+#include <QVector>
+
+#include "coord/Position.h"
+
+/*!
+ * \brief The SpatialGrid class
+ * Пространственный индекс объектов на регулярной сетке широта / долгота.
+ * Индекс обновляется инкрементально при изменении координат объекта,
+ * стоимость запросов пропорциональна количеству просмотренных ячеек
+ * и найденных объектов, а не общему количеству объектов.
+ * \author Данильченко Артем
+ */
+class SpatialGrid
+{
+    struct Entry
+    {
+        ///< ключ ячейки
+        uint64_t cell;
+        ///< координаты объекта на момент индексации
+        Position position;
+    };
+
+    ///< размер ячейки в градусах
+    double _cellSize = 0.25;
+    ///< количество ячеек по долготе
+    int64_t _columns = 0;
+    ///< количество ячеек по широте
+    int64_t _rows = 0;
+    ///< объекты в ячейках
+    QHash<uint64_t, QVector<uint64_t>> _cells;
+    ///< ячейка и координаты каждого объекта
+    QHash<uint64_t, Entry> _objects;
+
+    int64_t row(double latitude) const;
+    int64_t column(double longitude) const;
+    uint64_t cellKey(int64_t row, int64_t column) const;
+    void removeFromCell(uint64_t cell, uint64_t id);
+    /*!
+     * \brief forEachInCells обход объектов в прямоугольнике ячеек
+     * без проверки точных координат
+     */
+    template<typename F>
+    void forEachInCells(int64_t row0, int64_t row1,
+                        int64_t col0, int64_t col1,
+                        F func) const;
+
+public:
+    /*!
+     * \brief SpatialGrid конструктор
+     * \param cellSize - размер ячейки в градусах
+     */
+    explicit SpatialGrid(double cellSize = 0.25);
+    /*!
+     * \brief update добавление объекта или обновление его координат.
+     * Объект с некорректными координатами удаляется из индекса
+     * \param id - идентификатор объекта
+     * \param pos - геокоординаты
+     */
+    void update(uint64_t id, const Position& pos);
+    /*!
+     * \brief remove удаление объекта из индекса
+     * \param id - идентификатор объекта
+     */
+    void remove(uint64_t id);
+    /*!
+     * \brief clear очистка индекса
+     */
+    void clear();
+    /*!
+     * \brief size количество объектов в индексе
+     */
+    int size() const { return _objects.size(); }
+    /*!
+     * \brief queryRect поиск объектов в прямоугольной области.
+     * Если minLon > maxLon, область пересекает линию смены дат
+     * \param minLon, minLat - юго-западный угол, градусы
+     * \param maxLon, maxLat - северо-восточный угол, градусы
+     * \return идентификаторы найденных объектов
+     */
+    QVector<uint64_t> queryRect(double minLon, double minLat,
+                                double maxLon, double maxLat) const;
+    /*!
+     * \brief queryRadius поиск объектов в окружности
+     * \param center - центр окружности
+     * \param radius - радиус, м
+     * \return идентификаторы найденных объектов
+     */
+    QVector<uint64_t> queryRadius(const Position& center, double radius) const;
+    /*!
+     * \brief nearest поиск ближайшего объекта
+     * \param center - точка поиска
+     * \param maxRadius - максимальное расстояние поиска, м
+     * \return идентификатор объекта или 0, если объект не найден
+     */
+    uint64_t nearest(const Position& center, double maxRadius) const;
+};
+
+#endif // SPATIALGRID_H
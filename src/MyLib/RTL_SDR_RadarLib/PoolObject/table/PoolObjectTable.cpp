@@ -0,0 +1,347 @@
+#include "PoolObjectTable.h"
+
+#include <QDebug>
+
+#include "objects/base/BaseObject.h"
+#include "time/Clock.h"
+#include "../database/AircraftInfoLoader.h"
+
+PoolObjectTable::PoolObjectTable(OBJECT_TYPE type, int reserve):
+    _type(type),
+    _expiryWheel(Clock::nowMSec())
+{
+    _columns.reserve(reserve);
+    _objects.reserve(reserve);
+    qDebug()<<"PoolObjectTable() -> create";
+}
+
+PoolObjectTable::~PoolObjectTable()
+{
+    //объекты могут пережить пул - отвязываем их от массивов
+    for(auto &object : _objects)
+    {
+        BaseObject* base = dynamic_cast<BaseObject*>(object.data());
+        if(base != nullptr)
+            base->bindState(nullptr, -1);
+        object.clear();
+    }
+    _objects.clear();
+    _columns.clear();
+    qDebug()<<"~PoolObjectTable() -> delete";
+}
+
+int PoolObjectTable::findSlot(uint64_t id) const
+{
+    int slot = _slots.value(id, -1);
+    if(slot < 0 || _columns.id[slot] != id)
+        return -1;
+
+    return slot;
+}
+
+int PoolObjectTable::takeSlot()
+{
+    if(!_freeSlots.isEmpty())
+    {
+        int slot = _freeSlots.last();
+        _freeSlots.removeLast();
+        return slot;
+    }
+
+    //объект мог быть помечен удалённым без участия пула:
+    //такие слоты учитывает syncState объекта
+    while(!_columns.released.isEmpty())
+    {
+        int slot = _columns.released.last();
+        _columns.released.removeLast();
+        _columns.releasedMark[slot] = 0;
+
+        //объект снова используется или слот уже освобождён пулом
+        if(_columns.inUse[slot] != 0 || _objects[slot].isNull())
+            continue;
+
+        uint64_t oldId = _columns.id[slot];
+        if(_slots.value(oldId, -1) == slot)
+            _slots.remove(oldId);
+        _geoIndex.remove(oldId);
+        detachSlot(slot);
+        return slot;
+    }
+
+    _objects.append(QSharedPointer<IObject>());
+    return _columns.append();
+}
+
+void PoolObjectTable::releaseSlot(int slot)
+{
+    uint64_t id = _columns.id[slot];
+    if(id == 0)
+        return;
+
+    _geoIndex.remove(id);
+    _slots.remove(id);
+    detachSlot(slot);
+    _freeSlots.append(slot);
+}
+
+void PoolObjectTable::detachSlot(int slot)
+{
+    QSharedPointer<IObject> object = _objects[slot];
+    _objects[slot].clear();
+
+    if(!object.isNull())
+    {
+        //после отвязки изменения объекта не попадают в массивы
+        BaseObject* base = dynamic_cast<BaseObject*>(object.data());
+        if(base != nullptr)
+            base->bindState(nullptr, -1);
+        object->setObjectState(OBJECT_STATE::DELETE_OBJECT);
+    }
+
+    _columns.id[slot] = 0;
+    _columns.inUse[slot] = 0;
+    _columns.state[slot] = uint8_t(OBJECT_STATE::DELETE_OBJECT);
+}
+
+QSharedPointer<IObject> PoolObjectTable::createNewObject(uint64_t id,
+                                                         QDateTime reg_time,
+                                                         Position geoPosition,
+                                                         bool isImit)
+{
+    return createNewObject(id, Clock::fromDateTime(reg_time), geoPosition, isImit);
+}
+
+QSharedPointer<IObject> PoolObjectTable::createNewObject(uint64_t id,
+                                                         int64_t reg_time,
+                                                         Position geoPosition,
+                                                         bool isImit)
+{
+    if(id == 0)
+        return  QSharedPointer<IObject>();
+
+    int slot = findSlot(id);
+    if(slot < 0)
+        slot = takeSlot();
+
+    QSharedPointer<IObject> object = _objects[slot];
+    if(object.isNull())
+    {
+        object = QSharedPointer<IObject>(_factory.createObject(_type,
+                                                               id,
+                                                               reg_time,
+                                                               isImit,
+                                                               geoPosition));
+        if(object.isNull())
+        {
+            _freeSlots.append(slot);
+            return object;
+        }
+
+        _objects[slot] = object;
+        BaseObject* base = dynamic_cast<BaseObject*>(object.data());
+        if(base != nullptr)
+            base->bindState(&_columns, slot);
+    }
+    else
+    {
+        if(object->getInUse())
+            object->resetObjectData();
+
+        object->setId(id);
+        object->setObjectState(OBJECT_STATE::NEW_OBJECT);
+        object->setNSecStart(reg_time);
+        object->setNSecStop(reg_time);
+        object->setGeoCoord(geoPosition);
+    }
+
+    _slots.insert(id, slot);
+
+    if(!_scheduled.contains(id))
+    {
+        _scheduled.insert(id);
+        _expiryWheel.schedule(id, object->getMSecStop() + getObjectTTL(_type));
+    }
+    _geoIndex.update(id, object->getGeoCoord());
+    loadAircraftInfo(_database.data(), object.data());
+
+    return object;
+}
+
+QList<QSharedPointer<IObject> > PoolObjectTable::values()
+{
+    QList<QSharedPointer<IObject> > list;
+    const uint8_t* inUse = _columns.inUse.constData();
+    const uint64_t* ids = _columns.id.constData();
+
+    for(int slot = 0; slot < _columns.size(); ++slot)
+    {
+        if(inUse[slot] != 0 && ids[slot] != 0)
+            list.append(_objects[slot]);
+    }
+    return list;
+}
+
+QList<QSharedPointer<IObject> > PoolObjectTable::allValues()
+{
+    QList<QSharedPointer<IObject> > list;
+    for(auto &object : _objects)
+    {
+        if(!object.isNull())
+            list.append(object);
+    }
+    return list;
+}
+
+int PoolObjectTable::getObjectsCount()
+{
+    int counter = 0;
+    const uint8_t* inUse = _columns.inUse.constData();
+    const uint64_t* ids = _columns.id.constData();
+
+    for(int slot = 0; slot < _columns.size(); ++slot)
+    {
+        if(inUse[slot] != 0 && ids[slot] != 0)
+            ++counter;
+    }
+    return counter;
+}
+
+bool PoolObjectTable::isExistsObject(uint64_t id)
+{
+    int slot = findSlot(id);
+    return (slot >= 0 && _columns.inUse[slot] != 0);
+}
+
+QSharedPointer<IObject> PoolObjectTable::getObjectByID(uint64_t id)
+{
+    int slot = findSlot(id);
+    if(slot >= 0 && _columns.inUse[slot] != 0)
+        return _objects[slot];
+    else
+        return QSharedPointer<IObject>();
+}
+
+void PoolObjectTable::prepareAllObjectToDelete()
+{
+    for(auto &object : _objects)
+    {
+        if(!object.isNull())
+            object->setObjectState(OBJECT_STATE::DELETE_OBJECT);
+    }
+}
+
+void PoolObjectTable::deleteMarkedObjects()
+{
+    const uint8_t deleteState = uint8_t(OBJECT_STATE::DELETE_OBJECT);
+
+    for(int slot = 0; slot < _columns.size(); ++slot)
+    {
+        if(_columns.state[slot] == deleteState)
+            releaseSlot(slot);
+    }
+}
+
+void PoolObjectTable::deleteObject(uint64_t id)
+{
+    int slot = findSlot(id);
+    if(slot >= 0)
+        releaseSlot(slot);
+}
+
+void PoolObjectTable::setObjectTTL(OBJECT_TYPE type, int64_t ttl)
+{
+    if(ttl > 0)
+        _ttl.insert(type, ttl);
+}
+
+int64_t PoolObjectTable::getObjectTTL(OBJECT_TYPE type)
+{
+    return _ttl.value(type, DEFAULT_TTL);
+}
+
+int PoolObjectTable::removeStaleObjects(int64_t now)
+{
+    int counter = 0;
+    int64_t ttl = getObjectTTL(_type);
+
+    _expiryWheel.advance(now, [this, now, ttl, &counter](uint64_t id) -> int64_t
+    {
+        int slot = findSlot(id);
+
+        //объект удалён или слот переиспользован под другой id
+        if(slot < 0 || _columns.inUse[slot] == 0)
+        {
+            _scheduled.remove(id);
+            return 0;
+        }
+
+        //объект обновлялся - переносим срок истечения
+        int64_t deadline = Clock::toMSec(_columns.lastSeen[slot]) + ttl;
+        if(deadline > now)
+            return deadline;
+
+        releaseSlot(slot);
+        _scheduled.remove(id);
+        ++counter;
+        return 0;
+    });
+
+    return counter;
+}
+
+void PoolObjectTable::updateGeoIndex(uint64_t id)
+{
+    int slot = findSlot(id);
+    if(slot < 0 || _columns.inUse[slot] == 0)
+    {
+        _geoIndex.remove(id);
+        return;
+    }
+
+    _geoIndex.update(id, Position(_columns.longitude[slot],
+                                  _columns.latitude[slot]));
+}
+
+QList<QSharedPointer<IObject> > PoolObjectTable::toObjects(const QVector<uint64_t> &ids)
+{
+    QList<QSharedPointer<IObject> > list;
+    list.reserve(ids.size());
+
+    for(uint64_t id : ids)
+    {
+        QSharedPointer<IObject> object = getObjectByID(id);
+        if(!object.isNull())
+            list.append(object);
+    }
+    return list;
+}
+
+QList<QSharedPointer<IObject> > PoolObjectTable::valuesInRect(const Position &southWest,
+                                                              const Position &northEast)
+{
+    return toObjects(_geoIndex.queryRect(southWest.longitude(),
+                                         southWest.latitude(),
+                                         northEast.longitude(),
+                                         northEast.latitude()));
+}
+
+QList<QSharedPointer<IObject> > PoolObjectTable::valuesInRadius(const Position &center,
+                                                                double radius)
+{
+    return toObjects(_geoIndex.queryRadius(center, radius));
+}
+
+QSharedPointer<IObject> PoolObjectTable::nearestObject(const Position &center,
+                                                       double maxRadius)
+{
+    uint64_t id = _geoIndex.nearest(center, maxRadius);
+    if(id == 0)
+        return QSharedPointer<IObject>();
+
+    return getObjectByID(id);
+}
+
+void PoolObjectTable::setAircraftDatabase(QSharedPointer<IAircraftDatabase> database)
+{
+    _database = database;
+}
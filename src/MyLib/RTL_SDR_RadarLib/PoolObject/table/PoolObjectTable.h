@@ -0,0 +1,135 @@
+#ifndef POOLOBJECTTABLE_H
+#define POOLOBJECTTABLE_H
+
+#include "../poolobject_global.h"
+
+#include <QSharedPointer>
+#include <QMutex>
+#include <QMap>
+#include <QSet>
+
+#include "interface/IPoolObject.h"
+#include "objects/base/StateColumns.h"
+#include "../factory/FactoryObjects.h"
+#include "../expiry/TimingWheel.h"
+#include "../index/SpatialGrid.h"
+
+/*!
+ * \brief The PoolObjectTable class
+ * Пул объектов, хранящий часто используемые поля (id, координаты, высота,
+ * скорость, курс, время обновления, состояние) в непрерывных массивах,
+ * индексированных номером слота.
+ * Объекты остаются доступны через QSharedPointer<IObject> и
+ * дублируют изменения полей в массивы, поэтому пул совместим с
+ * существующими потребителями, а полный просмотр пула выполняется
+ * по массивам без обращения к объектам.
+ * Слоты освобождённых объектов используются повторно, объекты - нет:
+ * удалённый объект отвязывается от массивов и сохраняет свой id,
+ * поэтому указатель, оставшийся у потребителя, не начинает ссылаться
+ * на другой самолёт. Новый объект в слоте создаётся заново.
+ * \author Данильченко Артем
+ */
+class POOLOBJECTSHARED_EXPORT PoolObjectTable : public IPoolObject
+{
+    ///< время жизни объекта по умолчанию, мс
+    const int64_t DEFAULT_TTL = 60000;
+
+    QMutex _mutex;
+    FactoryObjects _factory;
+    OBJECT_TYPE _type = OBJECT_TYPE::base;
+
+    ///< массивы состояния объектов
+    StateColumns _columns;
+    ///< объекты по номерам слотов
+    QVector<QSharedPointer<IObject>> _objects;
+    ///< номер слота по идентификатору объекта
+    QHash<uint64_t, int> _slots;
+    ///< свободные слоты
+    QVector<int> _freeSlots;
+
+    ///< время жизни объектов по типам
+    QMap<OBJECT_TYPE, int64_t> _ttl;
+    ///< колесо таймеров для удаления устаревших объектов
+    TimingWheel _expiryWheel;
+    ///< идентификаторы объектов, находящихся в колесе таймеров
+    QSet<uint64_t> _scheduled;
+    ///< пространственный индекс объектов
+    SpatialGrid _geoIndex;
+    ///< справочник самолётов
+    QSharedPointer<IAircraftDatabase> _database;
+
+    /*!
+     * \brief findSlot номер слота используемого объекта
+     * \return номер слота или -1
+     */
+    int findSlot(uint64_t id) const;
+    /*!
+     * \brief takeSlot получение слота для нового объекта:
+     * свободный слот, слот неиспользуемого объекта или новый слот
+     */
+    int takeSlot();
+    /*!
+     * \brief releaseSlot освобождение слота с удалением объекта
+     */
+    void releaseSlot(int slot);
+    /*!
+     * \brief detachSlot отвязка объекта от слота: объект помечается
+     * удалённым и сохраняет id, слот очищается
+     */
+    void detachSlot(int slot);
+    QList<QSharedPointer<IObject>> toObjects(const QVector<uint64_t> &ids);
+
+public:
+    explicit PoolObjectTable(OBJECT_TYPE type, int reserve = 1024);
+    ~PoolObjectTable() override;
+
+    /*!
+     * \brief columns массивы состояния для просмотра пула.
+     * Обращение к массивам выполняется под блокировкой пула.
+     * Слоты с inUse == 0 не содержат актуальных объектов
+     */
+    const StateColumns& columns() const { return _columns; }
+
+    QSharedPointer<IObject> createNewObject(uint64_t id,
+                                            QDateTime reg_time,
+                                            Position geoPosition = Position(),
+                                            bool isImit = false) override;
+
+    QSharedPointer<IObject> createNewObject(uint64_t id,
+                                            int64_t reg_time,
+                                            Position geoPosition = Position(),
+                                            bool isImit = false) override;
+
+    QList<QSharedPointer<IObject> > values() override;
+
+    QList<QSharedPointer<IObject> > allValues() override;
+
+    int getObjectsCount()  override;
+
+    bool isExistsObject(uint64_t id) override;
+    QSharedPointer<IObject> getObjectByID(uint64_t id) override;
+
+    void prepareAllObjectToDelete() override;
+    void deleteMarkedObjects() override;
+    void deleteObject(uint64_t id) override;
+
+    void setObjectTTL(OBJECT_TYPE type, int64_t ttl) override;
+    int64_t getObjectTTL(OBJECT_TYPE type) override;
+    int removeStaleObjects(int64_t now) override;
+
+    void updateGeoIndex(uint64_t id) override;
+    QList<QSharedPointer<IObject>> valuesInRect(const Position& southWest,
+                                                const Position& northEast) override;
+    QList<QSharedPointer<IObject>> valuesInRadius(const Position& center,
+                                                  double radius) override;
+    QSharedPointer<IObject> nearestObject(const Position& center,
+                                          double maxRadius) override;
+
+    void setAircraftDatabase(QSharedPointer<IAircraftDatabase> database) override;
+
+    void lockPool() override { _mutex.lock(); }
+    bool tryLockPool() override { return _mutex.tryLock(5);}
+    void unlockPool() override { _mutex.unlock(); }
+};
+
+#endif // POOLOBJECTTABLE_H
@@ -5,9 +5,12 @@ SUBDIRS += \
     Demodulator \
     Carrier \
     PoolObject \
+    TrackArchive \
+    DSP \
     GraphicsWidget \
     RTL_SDR_Reciver \
     DataController \
+    NetServer \
     ModelTable
 
 CONFIG += ordered
@@ -0,0 +1,95 @@
+#include "TrackArchive.h"
+
+#include <algorithm>
+#include <QDir>
+#include <QDebug>
+
+#include "segment/SegmentFile.h"
+#include "writer/ArchiveWriter.h"
+
+TrackArchive::TrackArchive(const QString &dir):
+    _dir(dir)
+{
+    if(!QDir().mkpath(_dir))
+        qDebug()<<"[TrackArchive] : can't create directory"<<_dir;
+
+    _writer = std::unique_ptr<ArchiveWriter>(new ArchiveWriter(_dir));
+    _writer->start(QThread::LowPriority);
+    qDebug()<<"TrackArchive() -> create"<<_dir;
+}
+
+TrackArchive::~TrackArchive()
+{
+    _writer->stop();
+    _writer.reset();
+    qDebug()<<"~TrackArchive() -> delete";
+}
+
+void TrackArchive::append(const ArchivePoint &point)
+{
+    _writer->append(point);
+}
+
+void TrackArchive::flush()
+{
+    _writer->flush();
+}
+
+void TrackArchive::setRetention(int hours)
+{
+    _writer->setRetention(hours);
+}
+
+QVector<ArchivePoint> TrackArchive::query(const BlockFilter &filter)
+{
+    QVector<ArchivePoint> points;
+
+    for(const QString& fileName : SegmentFile::files(_dir, filter.from, filter.to))
+        SegmentFile::read(fileName, filter, points);
+
+    //блоки упорядочены внутри себя, между блоками - нет
+    std::stable_sort(points.begin(), points.end(),
+                     [](const ArchivePoint& a, const ArchivePoint& b)
+    {
+        return (a.icao < b.icao) || (a.icao == b.icao && a.time < b.time);
+    });
+
+    return points;
+}
+
+ArchiveTrack TrackArchive::queryByIcao(uint32_t icao, int64_t from, int64_t to)
+{
+    if(icao == 0 || from > to)
+        return ArchiveTrack();
+
+    BlockFilter filter;
+    filter.icao = icao;
+    filter.from = from;
+    filter.to = to;
+
+    return query(filter);
+}
+
+QHash<uint32_t, ArchiveTrack> TrackArchive::queryByRect(const Position &southWest,
+                                                        const Position &northEast,
+                                                        int64_t from,
+                                                        int64_t to)
+{
+    QHash<uint32_t, ArchiveTrack> tracks;
+    if(from > to)
+        return tracks;
+
+    BlockFilter filter;
+    filter.from = from;
+    filter.to = to;
+    filter.useRect = true;
+    filter.latMin = BlockCodec::toCoord(southWest.latitude());
+    filter.latMax = BlockCodec::toCoord(northEast.latitude());
+    filter.lonMin = BlockCodec::toCoord(southWest.longitude());
+    filter.lonMax = BlockCodec::toCoord(northEast.longitude());
+
+    for(const ArchivePoint& point : query(filter))
+        tracks[point.icao].append(point);
+
+    return tracks;
+}
@@ -0,0 +1,57 @@
+#ifndef TRACKARCHIVE_H
+#define TRACKARCHIVE_H
+
+#include <memory>
+
+#include "trackarchive_global.h"
+#include "interface/ITrackArchive.h"
+
+class ArchiveWriter;
+struct BlockFilter;
+
+/*!
+ * \brief The TrackArchive class
+ * Архив траекторий самолётов. Точки записываются только в конец
+ * файлов сегментов длительностью один час, внутри сегмента - блоками
+ * по столбцам с разностным кодированием. Заголовки блоков содержат
+ * интервал времени и границы координат и используются как разреженный
+ * индекс: запрос читает только сегменты и блоки, пересекающиеся
+ * с интервалом времени и прямоугольником.
+ * Запись выполняется отдельным потоком, точки, не записанные
+ * на момент запроса, в результат не попадают.
+ * Сегменты старше срока хранения (по умолчанию
+ * ARCHIVE_DEFAULT_RETENTION) удаляются потоком записи.
+ * \author Данильченко Артем
+ */
+class TRACKARCHIVESHARED_EXPORT TrackArchive : public ITrackArchive
+{
+    ///< каталог архива
+    QString _dir;
+    ///< поток записи
+    std::unique_ptr<ArchiveWriter> _writer;
+
+    /*!
+     * \brief query чтение точек сегментов интервала времени
+     */
+    QVector<ArchivePoint> query(const BlockFilter& filter);
+
+public:
+    /*!
+     * \brief TrackArchive конструктор
+     * \param dir - каталог архива, создается при отсутствии
+     */
+    explicit TrackArchive(const QString& dir);
+    ~TrackArchive() override;
+
+    void append(const ArchivePoint& point) override;
+    void flush() override;
+    void setRetention(int hours) override;
+
+    ArchiveTrack queryByIcao(uint32_t icao, int64_t from, int64_t to) override;
+    QHash<uint32_t, ArchiveTrack> queryByRect(const Position& southWest,
+                                              const Position& northEast,
+                                              int64_t from,
+                                              int64_t to) override;
+};
+
+#endif // TRACKARCHIVE_H
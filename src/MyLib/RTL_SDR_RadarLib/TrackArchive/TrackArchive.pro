@@ -0,0 +1,38 @@
+#-------------------------------------------------
+#
+# Архив траекторий самолётов
+#
+#-------------------------------------------------
+
+QT       += gui
+
+TARGET = TrackArchive
+TEMPLATE = lib
+
+DEFINES += TRACKARCHIVE_LIBRARY
+
+SOURCES += TrackArchive.cpp \
+    ../../../include/coord/Position.cpp \
+    ../../../include/protocol/Crc32.cpp \
+    segment/BlockCodec.cpp \
+    segment/SegmentFile.cpp \
+    writer/ArchiveWriter.cpp
+
+HEADERS += TrackArchive.h \
+        trackarchive_global.h \
+    ../../../include/interface/ITrackArchive.h \
+    ../../../include/coord/Position.h \
+    ../../../include/protocol/Crc32.h \
+    segment/SegmentFormat.h \
+    segment/BlockCodec.h \
+    segment/SegmentFile.h \
+    writer/ArchiveWriter.h
+
+unix {
+    target.path = /usr/lib
+    INSTALLS += target
+}
+
+
+include( ../../../../common.pri )
+include( ../../../../lib.pri )
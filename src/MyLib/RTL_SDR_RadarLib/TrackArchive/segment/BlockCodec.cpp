@@ -0,0 +1,223 @@
+#include "BlockCodec.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "protocol/Crc32.h"
+
+bool BlockFilter::overlaps(const SegmentBlockHeader &header) const
+{
+    if(header.timeMax < from || header.timeMin > to)
+        return false;
+
+    if(icao != 0 && (icao < header.icaoMin || icao > header.icaoMax))
+        return false;
+
+    if(useRect &&
+            (header.latMax < latMin || header.latMin > latMax ||
+             header.lonMax < lonMin || header.lonMin > lonMax))
+        return false;
+
+    return true;
+}
+
+void BlockCodec::writeVarint(QByteArray &out, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        out.append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+bool BlockCodec::readVarint(const uint8_t *&p, const uint8_t *end, uint64_t &value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        if(p >= end)
+            return false;
+
+        uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+void BlockCodec::writeColumn(QByteArray &out, const QVector<int64_t> &values, int64_t start)
+{
+    QByteArray column;
+    column.reserve(values.size() * 2);
+
+    int64_t prev = start;
+    for(int64_t value : values)
+    {
+        writeVarint(column, zigzag(value - prev));
+        prev = value;
+    }
+
+    writeVarint(out, uint64_t(column.size()));
+    out.append(column);
+}
+
+bool BlockCodec::readColumn(const uint8_t *p, const uint8_t *end,
+                            int count, int64_t start, QVector<int64_t> &values)
+{
+    values.resize(count);
+
+    int64_t prev = start;
+    for(int i = 0; i < count; i++)
+    {
+        uint64_t delta;
+        if(!readVarint(p, end, delta))
+            return false;
+
+        prev += unzigzag(delta);
+        values[i] = prev;
+    }
+    return true;
+}
+
+int32_t BlockCodec::toCoord(double degrees)
+{
+    return int32_t(lround(degrees / SEGMENT_COORD_LSB));
+}
+
+double BlockCodec::fromCoord(int32_t value)
+{
+    return value * SEGMENT_COORD_LSB;
+}
+
+QByteArray BlockCodec::encode(const QVector<ArchivePoint> &points)
+{
+    if(points.isEmpty())
+        return QByteArray();
+
+    SegmentBlockHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SEGMENT_BLOCK_MAGIC;
+    header.count = uint32_t(points.size());
+
+    const int count = points.size();
+    QVector<int64_t> columns[SEGMENT_COLUMNS];
+    for(auto &column : columns)
+        column.resize(count);
+
+    header.timeMin = header.timeMax = points.first().time;
+    header.latMin = header.latMax = toCoord(points.first().latitude);
+    header.lonMin = header.lonMax = toCoord(points.first().longitude);
+    header.icaoMin = header.icaoMax = points.first().icao;
+
+    for(int i = 0; i < count; i++)
+    {
+        const ArchivePoint& point = points.at(i);
+        int32_t lat = toCoord(point.latitude);
+        int32_t lon = toCoord(point.longitude);
+
+        columns[0][i] = point.icao;
+        columns[1][i] = point.time;
+        columns[2][i] = lat;
+        columns[3][i] = lon;
+        columns[4][i] = lround(point.altitude);
+        columns[5][i] = lround(point.speed / SEGMENT_TENTH_LSB);
+        columns[6][i] = lround(point.course / SEGMENT_TENTH_LSB);
+
+        header.timeMin = qMin(header.timeMin, point.time);
+        header.timeMax = qMax(header.timeMax, point.time);
+        header.latMin = qMin(header.latMin, lat);
+        header.latMax = qMax(header.latMax, lat);
+        header.lonMin = qMin(header.lonMin, lon);
+        header.lonMax = qMax(header.lonMax, lon);
+        header.icaoMin = qMin(header.icaoMin, point.icao);
+        header.icaoMax = qMax(header.icaoMax, point.icao);
+    }
+
+    QByteArray payload;
+    for(int c = 0; c < SEGMENT_COLUMNS; c++)
+        writeColumn(payload, columns[c], (c == 1) ? header.timeMin : 0);
+
+    header.payloadSize = uint32_t(payload.size());
+    header.checksum = frameCrc32(payload.constData(), size_t(payload.size()));
+
+    QByteArray block(reinterpret_cast<const char*>(&header), sizeof(header));
+    block.append(payload);
+    return block;
+}
+
+bool BlockCodec::decode(const SegmentBlockHeader &header,
+                        const QByteArray &payload,
+                        const BlockFilter &filter,
+                        QVector<ArchivePoint> &points)
+{
+    if(header.payloadSize != uint32_t(payload.size()) ||
+            header.checksum != frameCrc32(payload.constData(), size_t(payload.size())))
+        return false;
+
+    const int count = int(header.count);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(payload.constData());
+    const uint8_t* end = p + payload.size();
+
+    //границы столбцов
+    const uint8_t* begin[SEGMENT_COLUMNS];
+    const uint8_t* finish[SEGMENT_COLUMNS];
+    for(int c = 0; c < SEGMENT_COLUMNS; c++)
+    {
+        uint64_t size;
+        if(!readVarint(p, end, size) || size > uint64_t(end - p))
+            return false;
+
+        begin[c] = p;
+        finish[c] = p + size;
+        p += size;
+    }
+
+    //отбор по адресу и времени
+    QVector<int64_t> icao, time;
+    if(!readColumn(begin[0], finish[0], count, 0, icao) ||
+            !readColumn(begin[1], finish[1], count, header.timeMin, time))
+        return false;
+
+    QVector<int> rows;
+    for(int i = 0; i < count; i++)
+    {
+        if(filter.icao != 0 && uint32_t(icao[i]) != filter.icao)
+            continue;
+        if(time[i] < filter.from || time[i] > filter.to)
+            continue;
+        rows.append(i);
+    }
+
+    if(rows.isEmpty())
+        return true;
+
+    QVector<int64_t> lat, lon, alt, speed, course;
+    if(!readColumn(begin[2], finish[2], count, 0, lat) ||
+            !readColumn(begin[3], finish[3], count, 0, lon) ||
+            !readColumn(begin[4], finish[4], count, 0, alt) ||
+            !readColumn(begin[5], finish[5], count, 0, speed) ||
+            !readColumn(begin[6], finish[6], count, 0, course))
+        return false;
+
+    for(int i : rows)
+    {
+        if(filter.useRect &&
+                (lat[i] < filter.latMin || lat[i] > filter.latMax ||
+                 lon[i] < filter.lonMin || lon[i] > filter.lonMax))
+            continue;
+
+        ArchivePoint point;
+        point.icao = uint32_t(icao[i]);
+        point.time = time[i];
+        point.latitude = fromCoord(int32_t(lat[i]));
+        point.longitude = fromCoord(int32_t(lon[i]));
+        point.altitude = float(alt[i]);
+        point.speed = float(speed[i] * SEGMENT_TENTH_LSB);
+        point.course = float(course[i] * SEGMENT_TENTH_LSB);
+        points.append(point);
+    }
+
+    return true;
+}
@@ -0,0 +1,92 @@
+#ifndef BLOCKCODEC_H
+#define BLOCKCODEC_H
+
+#include <stdint.h>
+#include <QByteArray>
+#include <QVector>
+
+#include "interface/ITrackArchive.h"
+#include "SegmentFormat.h"
+
+/*!
+ * @brief  Условия отбора точек при чтении блока
+ */
+struct BlockFilter
+{
+    ///< адрес ICAO, 0 - любой
+    uint32_t icao = 0;
+    ///< интервал времени, мс с начала эпохи
+    int64_t from = 0;
+    int64_t to = INT64_MAX;
+    ///< использовать прямоугольник
+    bool useRect = false;
+    ///< прямоугольник, единицы SEGMENT_COORD_LSB
+    int32_t latMin = 0;
+    int32_t latMax = 0;
+    int32_t lonMin = 0;
+    int32_t lonMax = 0;
+
+    /*!
+     * \brief overlaps может ли блок содержать подходящие точки
+     */
+    bool overlaps(const SegmentBlockHeader& header) const;
+};
+
+/*!
+ * \brief The BlockCodec class
+ * Кодирование блока точек по столбцам: разности соседних значений
+ * в зигзаг-кодировании записываются целыми переменной длины.
+ * Координаты, скорость и курс квантуются (см. SegmentFormat.h).
+ * \author Данильченко Артем
+ */
+class BlockCodec
+{
+    static void writeVarint(QByteArray& out, uint64_t value);
+    static bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value);
+
+    static inline uint64_t zigzag(int64_t value)
+    {
+        return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+    }
+    static inline int64_t unzigzag(uint64_t value)
+    {
+        return int64_t(value >> 1) ^ -int64_t(value & 1);
+    }
+    /*!
+     * \brief writeColumn запись столбца разностей с префиксом размера
+     */
+    static void writeColumn(QByteArray& out, const QVector<int64_t>& values, int64_t start);
+    /*!
+     * \brief readColumn чтение столбца разностей
+     * \return false - данные повреждены
+     */
+    static bool readColumn(const uint8_t* p, const uint8_t* end,
+                           int count, int64_t start, QVector<int64_t>& values);
+
+public:
+    static int32_t toCoord(double degrees);
+    static double fromCoord(int32_t value);
+    /*!
+     * \brief encode кодирование блока
+     * \param points - точки, упорядоченные по адресу ICAO и времени,
+     * не более SEGMENT_MAX_BLOCK_POINTS
+     * \return заголовок и данные блока
+     */
+    static QByteArray encode(const QVector<ArchivePoint>& points);
+    /*!
+     * \brief decode декодирование подходящих точек блока.
+     * Столбцы координат и параметров декодируются только при наличии
+     * точек, подходящих по адресу и времени
+     * \param header - заголовок блока
+     * \param payload - данные блока
+     * \param filter - условия отбора
+     * \param points - выходной массив, точки добавляются в конец
+     * \return false - данные блока повреждены
+     */
+    static bool decode(const SegmentBlockHeader& header,
+                       const QByteArray& payload,
+                       const BlockFilter& filter,
+                       QVector<ArchivePoint>& points);
+};
+
+#endif // BLOCKCODEC_H
@@ -0,0 +1,170 @@
+#include "SegmentFile.h"
+
+#include <algorithm>
+#include <string.h>
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QDebug>
+
+static const char* SEGMENT_NAME_FORMAT = "yyyyMMdd_hh";
+static const char* SEGMENT_DATE_FORMAT = "yyyyMMdd";
+static const char* SEGMENT_HOUR_FORMAT = "hh";
+static const char* SEGMENT_SUFFIX = ".seg";
+
+int64_t SegmentFile::segmentStart(int64_t time)
+{
+    int64_t start = time - time % SEGMENT_DURATION;
+    if(time < 0 && start != time)
+        start -= SEGMENT_DURATION;
+    return start;
+}
+
+QString SegmentFile::fileName(const QString &dir, int64_t segmentStart)
+{
+    QString name = QDateTime::fromMSecsSinceEpoch(segmentStart, Qt::UTC)
+            .toString(SEGMENT_NAME_FORMAT);
+    return QDir(dir).filePath(name + SEGMENT_SUFFIX);
+}
+
+QStringList SegmentFile::files(const QString &dir, int64_t from, int64_t to)
+{
+    QStringList list;
+    QDir directory(dir);
+    QStringList names = directory.entryList(QStringList() << QString("*") + SEGMENT_SUFFIX,
+                                            QDir::Files,
+                                            QDir::Name);
+
+    for(const QString& name : names)
+    {
+        //имя в UTC: разбор в местном времени терял бы час перехода на летнее время
+        const QString base = name.left(name.size() - int(strlen(SEGMENT_SUFFIX)));
+        const QStringList parts = base.split('_');
+        if(parts.size() != 2)
+            continue;
+
+        QDateTime dt(QDate::fromString(parts.at(0), SEGMENT_DATE_FORMAT),
+                     QTime::fromString(parts.at(1), SEGMENT_HOUR_FORMAT),
+                     Qt::UTC);
+        if(!dt.isValid())
+            continue;
+
+        int64_t start = dt.toMSecsSinceEpoch();
+        if(start + SEGMENT_DURATION <= from || start > to)
+            continue;
+
+        list.append(directory.filePath(name));
+    }
+
+    return list;
+}
+
+QStringList SegmentFile::removeBefore(const QString &dir, int64_t time)
+{
+    QStringList removed;
+    for(const QString& fileName : files(dir, INT64_MIN, time - SEGMENT_DURATION))
+    {
+        if(QFile::remove(fileName))
+            removed.append(fileName);
+        else
+            qDebug()<<"[SegmentFile] : can't remove file"<<fileName;
+    }
+    return removed;
+}
+
+qint64 SegmentFile::validSize(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    const qint64 size = file.size();
+    qint64 pos = 0;
+    SegmentBlockHeader header;
+
+    while(pos + qint64(sizeof(header)) <= size)
+    {
+        if(!file.seek(pos) ||
+                file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+                header.magic != SEGMENT_BLOCK_MAGIC)
+            break;
+
+        qint64 next = pos + qint64(sizeof(header)) + header.payloadSize;
+        if(next > size)
+            break;
+
+        pos = next;
+    }
+
+    return pos;
+}
+
+bool SegmentFile::append(const QString &fileName, QVector<ArchivePoint> &points)
+{
+    if(points.isEmpty())
+        return true;
+
+    std::sort(points.begin(), points.end(),
+              [](const ArchivePoint& a, const ArchivePoint& b)
+    {
+        return (a.icao < b.icao) || (a.icao == b.icao && a.time < b.time);
+    });
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        qDebug()<<"[SegmentFile] : can't open file"<<fileName;
+        return false;
+    }
+
+    for(int i = 0; i < points.size(); i += SEGMENT_MAX_BLOCK_POINTS)
+    {
+        QByteArray block = BlockCodec::encode(points.mid(i, SEGMENT_MAX_BLOCK_POINTS));
+        if(file.write(block) != block.size())
+        {
+            qDebug()<<"[SegmentFile] : write error"<<fileName;
+            return false;
+        }
+    }
+
+    return file.flush();
+}
+
+int SegmentFile::read(const QString &fileName,
+                      const BlockFilter &filter,
+                      QVector<ArchivePoint> &points)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    //последний блок может дописываться в момент чтения
+    const qint64 size = file.size();
+    qint64 pos = 0;
+    int blocks = 0;
+    SegmentBlockHeader header;
+
+    while(pos + qint64(sizeof(header)) <= size)
+    {
+        if(!file.seek(pos) ||
+                file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+                header.magic != SEGMENT_BLOCK_MAGIC)
+            break;
+
+        qint64 next = pos + qint64(sizeof(header)) + header.payloadSize;
+        if(next > size)
+            break;
+
+        if(filter.overlaps(header))
+        {
+            QByteArray payload = file.read(header.payloadSize);
+            if(!BlockCodec::decode(header, payload, filter, points))
+                qDebug()<<"[SegmentFile] : broken block"<<fileName<<pos;
+            ++blocks;
+        }
+
+        pos = next;
+    }
+
+    return blocks;
+}
@@ -0,0 +1,64 @@
+#ifndef SEGMENTFILE_H
+#define SEGMENTFILE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "BlockCodec.h"
+
+/*!
+ * \brief The SegmentFile class
+ * Работа с файлами сегментов архива. Сегмент содержит точки одного
+ * часа (UTC), имя файла - время начала сегмента (yyyyMMdd_hh.seg).
+ * \author Данильченко Артем
+ */
+class SegmentFile
+{
+public:
+    /*!
+     * \brief segmentStart начало сегмента, содержащего момент времени
+     * \param time - время, мс с начала эпохи
+     */
+    static int64_t segmentStart(int64_t time);
+    /*!
+     * \brief fileName имя файла сегмента
+     */
+    static QString fileName(const QString& dir, int64_t segmentStart);
+    /*!
+     * \brief files файлы сегментов, пересекающихся с интервалом времени,
+     * по возрастанию времени
+     */
+    static QStringList files(const QString& dir, int64_t from, int64_t to);
+    /*!
+     * \brief removeBefore удаление сегментов, закончившихся до момента времени
+     * \param time - время, мс с начала эпохи
+     * \return удаленные файлы
+     */
+    static QStringList removeBefore(const QString& dir, int64_t time);
+    /*!
+     * \brief validSize размер файла без незавершённого последнего блока
+     */
+    static qint64 validSize(const QString& fileName);
+    /*!
+     * \brief append добавление точек в конец сегмента.
+     * Точки сортируются по адресу ICAO и времени и разбиваются на блоки
+     * \param fileName - имя файла
+     * \param points - точки одного сегмента
+     * \return результат записи
+     */
+    static bool append(const QString& fileName, QVector<ArchivePoint>& points);
+    /*!
+     * \brief read чтение подходящих точек сегмента.
+     * Данные блоков вне интервала времени или прямоугольника не читаются
+     * \param fileName - имя файла
+     * \param filter - условия отбора
+     * \param points - выходной массив, точки добавляются в конец
+     * \return количество прочитанных блоков или -1 в случае ошибки
+     */
+    static int read(const QString& fileName,
+                    const BlockFilter& filter,
+                    QVector<ArchivePoint>& points);
+};
+
+#endif // SEGMENTFILE_H
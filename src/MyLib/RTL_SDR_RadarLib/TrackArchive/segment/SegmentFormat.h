@@ -0,0 +1,69 @@
+#ifndef SEGMENTFORMAT_H
+#define SEGMENTFORMAT_H
+
+#include <stdint.h>
+
+/*
+ * A segment file holds the points of one hour (UTC) and is only appended.
+ * It is a sequence of blocks:
+ *
+ *   SegmentBlockHeader
+ *   payload[payloadSize]
+ *
+ * The payload stores the block columns one after another:
+ * icao, time, latitude, longitude, altitude, speed, course.
+ * Each column is prefixed by its size in bytes (varint), values are
+ * zigzag-encoded deltas to the previous row written as varints.
+ * Rows are sorted by icao and time, so deltas stay small.
+ * The header checksum is CRC-32 (frameCrc32) of the payload.
+ *
+ * Block headers carry the time range, the bounding box and the icao
+ * range of the block and serve as a sparse index: queries read headers
+ * and skip payloads of blocks outside of the requested window or
+ * aircraft. Blocks of one append are sorted by icao, so the icao range
+ * of a block is narrow.
+ */
+
+///< сигнатура блока; "TBLK" - прежний заголовок без диапазона ICAO
+constexpr uint32_t SEGMENT_BLOCK_MAGIC = 0x324c4254; /* "TBL2" */
+///< длительность сегмента, мс
+constexpr int64_t SEGMENT_DURATION = 3600 * 1000;
+///< максимальное количество точек в блоке
+constexpr int SEGMENT_MAX_BLOCK_POINTS = 4096;
+///< количество столбцов блока
+constexpr int SEGMENT_COLUMNS = 7;
+
+///< цена младшего разряда координат, градусы
+constexpr double SEGMENT_COORD_LSB = 1e-5;
+///< цена младшего разряда скорости и курса
+constexpr double SEGMENT_TENTH_LSB = 0.1;
+
+/*!
+ * @brief  Заголовок блока сегмента.
+ */
+#pragma pack(push,1)
+struct SegmentBlockHeader
+{
+    /* Block signature */
+    uint32_t magic;
+    /* Number of points */
+    uint32_t count;
+    /* Size of the payload after the header */
+    uint32_t payloadSize;
+    /* CRC-32 of the payload */
+    uint32_t checksum;
+    /* Time range, ms since epoch */
+    int64_t timeMin;
+    int64_t timeMax;
+    /* Bounding box, SEGMENT_COORD_LSB units */
+    int32_t latMin;
+    int32_t latMax;
+    int32_t lonMin;
+    int32_t lonMax;
+    /* ICAO address range */
+    uint32_t icaoMin;
+    uint32_t icaoMax;
+};
+#pragma pack(pop)
+
+#endif // SEGMENTFORMAT_H
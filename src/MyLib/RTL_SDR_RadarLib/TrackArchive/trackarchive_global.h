@@ -0,0 +1,12 @@
+#ifndef TRACKARCHIVE_GLOBAL_H
+#define TRACKARCHIVE_GLOBAL_H
+
+#include <QtCore/qglobal.h>
+
+#if defined(TRACKARCHIVE_LIBRARY)
+#  define TRACKARCHIVESHARED_EXPORT Q_DECL_EXPORT
+#else
+#  define TRACKARCHIVESHARED_EXPORT Q_DECL_IMPORT
+#endif
+
+#endif // TRACKARCHIVE_GLOBAL_H
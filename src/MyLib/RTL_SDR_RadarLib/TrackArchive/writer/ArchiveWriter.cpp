@@ -0,0 +1,148 @@
+#include "ArchiveWriter.h"
+
+#include <QMap>
+#include <QFile>
+#include <QDateTime>
+#include <QDebug>
+
+#include "../segment/SegmentFile.h"
+
+///< период проверки срока хранения, мс
+static const int64_t RETENTION_CHECK_PERIOD = 60 * 1000;
+
+ArchiveWriter::ArchiveWriter(const QString &dir):
+    _dir(dir),
+    _retention(int64_t(ARCHIVE_DEFAULT_RETENTION) * 3600 * 1000),
+    _dropped(0)
+{
+    _pending.reserve(_batchSize);
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    stop();
+}
+
+void ArchiveWriter::append(const ArchivePoint &point)
+{
+    QMutexLocker lock(&_mutex);
+    if(_pending.size() >= _maxPending)
+    {
+        ++_dropped;
+        return;
+    }
+
+    _pending.append(point);
+    if(_pending.size() == _batchSize)
+        _wakeUp.wakeOne();
+}
+
+void ArchiveWriter::flush()
+{
+    QMutexLocker lock(&_mutex);
+    const uint64_t request = ++_flushRequest;
+    _wakeUp.wakeOne();
+
+    while(_flushDone < request && isRunning())
+        _flushed.wait(&_mutex, 100);
+}
+
+void ArchiveWriter::stop()
+{
+    {
+        QMutexLocker lock(&_mutex);
+        _abort = true;
+        _wakeUp.wakeOne();
+    }
+    wait();
+}
+
+void ArchiveWriter::setRetention(int hours)
+{
+    _retention = int64_t(qMax(0, hours)) * 3600 * 1000;
+}
+
+void ArchiveWriter::run()
+{
+    QVector<ArchivePoint> batch;
+
+    forever
+    {
+        uint64_t request;
+        bool abort;
+        {
+            QMutexLocker lock(&_mutex);
+            if(!_abort &&
+                    _flushRequest == _flushDone &&
+                    _pending.size() < _batchSize)
+                _wakeUp.wait(&_mutex, _flushPeriod);
+
+            request = _flushRequest;
+            abort = _abort;
+            batch.swap(_pending);
+        }
+
+        writeBatch(batch);
+        batch.clear();
+        removeExpired();
+
+        {
+            QMutexLocker lock(&_mutex);
+            _flushDone = request;
+            _flushed.wakeAll();
+        }
+
+        if(abort)
+            break;
+    }
+}
+
+void ArchiveWriter::writeBatch(QVector<ArchivePoint> &batch)
+{
+    if(batch.isEmpty())
+        return;
+
+    //точки разных часов попадают в разные сегменты
+    QMap<int64_t, QVector<ArchivePoint>> segments;
+    for(const ArchivePoint& point : batch)
+        segments[SegmentFile::segmentStart(point.time)].append(point);
+
+    for(auto it = segments.begin(); it != segments.end(); ++it)
+    {
+        QString fileName = SegmentFile::fileName(_dir, it.key());
+
+        //отбрасываем блок, не дописанный до аварийного завершения
+        if(!_checkedFiles.contains(fileName))
+        {
+            _checkedFiles.insert(fileName);
+            QFile file(fileName);
+            if(file.exists())
+            {
+                qint64 size = SegmentFile::validSize(fileName);
+                if(size < file.size())
+                    file.resize(size);
+            }
+        }
+
+        if(!SegmentFile::append(fileName, it.value()))
+            _checkedFiles.remove(fileName);
+    }
+}
+
+void ArchiveWriter::removeExpired()
+{
+    const int64_t retention = _retention;
+    if(retention <= 0)
+        return;
+
+    const int64_t now = QDateTime::currentMSecsSinceEpoch();
+    if(now - _retentionCheck < RETENTION_CHECK_PERIOD)
+        return;
+    _retentionCheck = now;
+
+    for(const QString& fileName : SegmentFile::removeBefore(_dir, now - retention))
+    {
+        _checkedFiles.remove(fileName);
+        qDebug()<<"[ArchiveWriter] : expired segment removed"<<fileName;
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef ARCHIVEWRITER_H
+#define ARCHIVEWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QSet>
+#include <atomic>
+
+#include "interface/ITrackArchive.h"
+
+/*!
+ * \brief The ArchiveWriter class
+ * Поток записи архива. Точки накапливаются в очереди и записываются
+ * пакетами по истечении периода записи или при заполнении пакета,
+ * поэтому поток демодуляции не выполняет файловых операций.
+ * Тот же поток удаляет сегменты старше срока хранения.
+ * \author Данильченко Артем
+ */
+class ArchiveWriter : public QThread
+{
+    ///< каталог архива
+    QString _dir;
+    ///< период записи, мс
+    unsigned long _flushPeriod = 1000;
+    ///< размер пакета, при котором запись начинается досрочно
+    int _batchSize = 4096;
+    ///< максимальный размер очереди, точки сверх него отбрасываются.
+    ///< Около 8 с при 2000 сообщений о положении и скорости в секунду
+    ///< (~800 Кб): запись отстаёт дольше только при отказе диска
+    int _maxPending = 16384;
+    ///< срок хранения сегментов, мс; 0 - без ограничения
+    std::atomic<int64_t> _retention;
+    ///< время последнего удаления устаревших сегментов, мс
+    int64_t _retentionCheck = 0;
+
+    QMutex _mutex;
+    QWaitCondition _wakeUp;
+    QWaitCondition _flushed;
+    ///< очередь точек
+    QVector<ArchivePoint> _pending;
+    ///< номер последнего запроса и выполненной записи
+    uint64_t _flushRequest = 0;
+    uint64_t _flushDone = 0;
+    bool _abort = false;
+
+    ///< проверенные на незавершённую запись файлы
+    QSet<QString> _checkedFiles;
+    ///< количество отброшенных точек
+    std::atomic<uint64_t> _dropped;
+
+    /*!
+     * \brief writeBatch запись пакета точек по сегментам
+     */
+    void writeBatch(QVector<ArchivePoint>& batch);
+    /*!
+     * \brief removeExpired удаление сегментов старше срока хранения,
+     * не чаще одного раза в RETENTION_CHECK_PERIOD
+     */
+    void removeExpired();
+
+protected:
+    void run() override;
+
+public:
+    explicit ArchiveWriter(const QString& dir);
+    ~ArchiveWriter() override;
+
+    /*!
+     * \brief append добавление точки в очередь
+     */
+    void append(const ArchivePoint& point);
+    /*!
+     * \brief flush ожидание записи очереди
+     */
+    void flush();
+    /*!
+     * \brief stop запись очереди и завершение потока
+     */
+    void stop();
+    /*!
+     * \brief setRetention срок хранения сегментов
+     * \param hours - срок хранения, ч; 0 - без ограничения
+     */
+    void setRetention(int hours);
+
+    uint64_t getDroppedCount() const { return _dropped; }
+};
+
+#endif // ARCHIVEWRITER_H
@@ -102,7 +102,9 @@ QVector2D Position::flatOffsetMeters(const Position &dest) const
     const qreal lonPerMeter = Conversions::degreesLonPerMeter(avgLat);
     const qreal latPerMeter = Conversions::degreesLatPerMeter(avgLat);
 
-    const qreal lonDiffMeters = (dest.longitude() - this->longitude()) / lonPerMeter;
+    //через антимеридиан разность долгот берется по кратчайшему пути
+    const qreal lonDiffMeters = normalizeLongitude(dest.longitude() - this->longitude())
+            / lonPerMeter;
     const qreal latDiffMeters = (dest.latitude() - this->latitude()) / latPerMeter;
 
     return QVector2D(lonDiffMeters, latDiffMeters);
@@ -113,10 +115,22 @@ Position Position::flatOffsetToPosition(const QPointF& offset) const
     const qreal lonPerMeter = Conversions::degreesLonPerMeter(this->latitude());
     const qreal latPerMeter = Conversions::degreesLatPerMeter(this->latitude());
 
-    return Position(this->longitude() + offset.x() * lonPerMeter,
+    return Position(normalizeLongitude(this->longitude() + offset.x() * lonPerMeter),
                     this->latitude() + offset.y() * latPerMeter);
 }
 
+//static
+qreal Position::normalizeLongitude(qreal longitude)
+{
+    if(longitude >= -180.0 && longitude <= 180.0)
+        return longitude;
+
+    longitude = std::fmod(longitude + 180.0, 360.0);
+    if(longitude < 0.0)
+        longitude += 360.0;
+    return longitude - 180.0;
+}
+
 qreal Position::flatManhattanEstimate(const Position &other) const
 {
     const QVector2D offsetMeters = this->flatOffsetMeters(other);
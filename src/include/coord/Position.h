@@ -34,6 +34,11 @@ public:
     qreal flatManhattanEstimate(const Position& other) const;
     qreal angleTo(const Position& dest) const;
 
+    /*!
+     * \brief normalizeLongitude приведение долготы к диапазону [-180, 180]
+     */
+    static qreal normalizeLongitude(qreal longitude);
+
     static QVector3D Position2ENU(const Position& refPos, const Position& pos);
     static Position fromENU(const Position& refPos, const QVector3D& enu);
 
@@ -0,0 +1,60 @@
+#ifndef AIRCRAFTDBFORMAT_H
+#define AIRCRAFTDBFORMAT_H
+
+#include <stdint.h>
+
+/*
+ * Layout of the aircraft metadata file:
+ *
+ *   AircraftDbHeader
+ *   AircraftDbRecord[count]   sorted by icao
+ *   string pool               null-terminated UTF-8 strings
+ *
+ * String fields of a record are offsets into the string pool.
+ * Equal strings (type codes, operators) are stored once.
+ */
+
+///< сигнатура файла
+constexpr char AIRCRAFT_DB_MAGIC[4] = { 'A', 'C', 'D', 'B' };
+///< версия формата
+constexpr uint32_t AIRCRAFT_DB_VERSION = 1;
+///< смещение отсутствующей строки
+constexpr uint32_t AIRCRAFT_DB_NO_STRING = 0xffffffff;
+
+/*!
+ * @brief  Заголовок файла базы данных самолётов.
+ */
+#pragma pack(push,1)
+struct AircraftDbHeader
+{
+    /* File signature */
+    char magic[4];
+    /* Format version */
+    uint32_t version;
+    /* Number of records */
+    uint32_t count;
+    /* Offset of the first record from the file start */
+    uint32_t recordsOffset;
+    /* Offset of the string pool from the file start */
+    uint32_t stringsOffset;
+    /* Size of the string pool */
+    uint32_t stringsSize;
+};
+
+/*!
+ * @brief  Запись базы данных самолётов.
+ */
+struct AircraftDbRecord
+{
+    /* ICAO address */
+    uint32_t icao;
+    /* Registration, offset into the string pool */
+    uint32_t registration;
+    /* ICAO type code, offset into the string pool */
+    uint32_t type;
+    /* Operator, offset into the string pool */
+    uint32_t owner;
+};
+#pragma pack(pop)
+
+#endif // AIRCRAFTDBFORMAT_H
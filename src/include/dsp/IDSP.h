@@ -2,6 +2,7 @@
 #define IDSP_H
 
 #include "SrcDataAdc.h"
+#include "SpectrumFrame.h"
 /*!
  * \brief The IDSP class
  * Интерфейс для реализации цифровой обработки информации
@@ -31,5 +32,10 @@ public:
      * \return блок данных после обработки
      */
     virtual SrcDataAdc makeAll(const QVector<uint8_t>& vector) = 0;
+    /*!
+     * \brief spectrumFrame последний рассчитанный спектр и водопад
+     * \return копия данных, допускается вызов из любого потока
+     */
+    virtual SpectrumFrame spectrumFrame() = 0;
 };
 #endif // IDSP_H
@@ -0,0 +1,29 @@
+#ifndef SPECTRUMFRAME_H
+#define SPECTRUMFRAME_H
+
+#include <stdint.h>
+#include <QVector>
+
+/*!
+ * \brief The SpectrumFrame struct
+ * Спектр и водопад, рассчитанные модулем ЦОС
+ * \author Данильченко Артём
+ */
+struct SpectrumFrame
+{
+    ///< количество частотных отсчетов в строке
+    int bins = 0;
+    ///< частота дискретизации после децимации, Гц
+    double sampleRate = 0.0;
+    ///< строк рассчитано с начала работы
+    uint64_t rows = 0;
+    ///< блоки, пропущенные из-за занятости потока ЦОС
+    uint64_t skipped = 0;
+    ///< последний спектр, дБ, нулевая частота в центре строки
+    QVector<float> spectrum;
+    ///< строки водопада от старой к новой, waterfallRows x bins
+    QVector<float> waterfall;
+    int waterfallRows = 0;
+};
+
+#endif // SPECTRUMFRAME_H
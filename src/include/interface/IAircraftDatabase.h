@@ -0,0 +1,50 @@
+#ifndef IAIRCRAFTDATABASE_H
+#define IAIRCRAFTDATABASE_H
+
+#include <stdint.h>
+#include <QString>
+
+/*!
+ * @brief  Справочные данные самолёта
+ */
+struct AircraftInfo
+{
+    ///< регистрационный номер
+    QString registration;
+    ///< тип воздушного судна (код ICAO)
+    QString type;
+    ///< эксплуатант
+    QString owner;
+
+    bool isEmpty() const
+    {
+        return registration.isEmpty() && type.isEmpty() && owner.isEmpty();
+    }
+};
+
+/*!
+ * \brief The IAircraftDatabase class
+ * Интерфейс справочника самолётов по адресу ICAO
+ */
+class IAircraftDatabase
+{
+public:
+    virtual ~IAircraftDatabase(){}
+    /*!
+     * \brief isOpen проверка загрузки справочника
+     */
+    virtual bool isOpen() const = 0;
+    /*!
+     * \brief count количество записей в справочнике
+     */
+    virtual int count() const = 0;
+    /*!
+     * \brief lookup поиск записи по адресу ICAO
+     * \param icao - адрес ICAO
+     * \param info - найденные данные
+     * \return true - запись найдена
+     */
+    virtual bool lookup(uint32_t icao, AircraftInfo& info) const = 0;
+};
+
+#endif // IAIRCRAFTDATABASE_H
@@ -10,6 +10,7 @@
 #include "IDemodulator.h"
 #include "dsp/IDSP.h"
 #include "INetworkWorker.h"
+#include "IWorker.h"
 
 /*!
  * \brief The IDataController class
@@ -45,6 +46,52 @@ public:
      * алгоритмов ЦОС
      */
     virtual void setDSP(QSharedPointer<IDSP>) = 0;
+    /*!
+     * \brief setStateFile периодическое сохранение состояния демодулятора
+     * \param fileName - имя файла, пустая строка - сохранение отключено
+     * \param period - период сохранения в мс
+     */
+    virtual void setStateFile(const QString& fileName, int64_t period) = 0;
+    /*!
+     * \brief setNetProtocol выбор формата передачи данных на сервер
+     */
+    virtual void setNetProtocol(NET_PROTOCOL protocol) = 0;
+    /*!
+     * \brief setMulticast рассылка данных в группу UDP multicast
+     * \param group - адрес группы, пустая строка - рассылка выключена
+     * \param port - порт получателей
+     */
+    virtual void setMulticast(const QString& group, uint16_t port) = 0;
+    /*!
+     * \brief setStageConfig параметры стадии конвейера обработки,
+     * применяются при следующем запуске
+     * \param stage - стадия
+     * \param config - потоки, емкость очереди и поведение при переполнении
+     */
+    virtual void setStageConfig(PIPELINE_STAGE stage, const StageConfig& config) = 0;
+    /*!
+     * \brief stageStats счетчики стадий конвейера обработки
+     */
+    virtual QVector<StageStats> stageStats() = 0;
+    /*!
+     * \brief setThreadPolicy размещение потоков приема и обработки:
+     * привязка к ядрам, SCHED_FIFO или nice
+     */
+    virtual void setThreadPolicy(const ThreadPolicy& policy) = 0;
+    /*!
+     * \brief threadPlacement фактическое размещение потоков приема
+     * и обработки
+     */
+    virtual QVector<PlacementReport> threadPlacement() = 0;
+    /*!
+     * \brief setOverloadConfig пороги упрощения обработки при перегрузке:
+     * отключение исправления двухбитовых ошибок, коррекции фазы, ЦОС
+     */
+    virtual void setOverloadConfig(const OverloadConfig& config) = 0;
+    /*!
+     * \brief overloadStats отставание обработки и ступень упрощения
+     */
+    virtual OverloadStats overloadStats() = 0;
     /*!
      * \brief run запуск цикла приема и обработки данных
      */
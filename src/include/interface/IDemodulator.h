@@ -5,10 +5,12 @@
 #include <QVector>
 #include <QRunnable>
 #include <QByteArray>
+#include <QString>
 #include <QSharedPointer>
 
 class IPoolObject;
 class ILogger;
+class ITrackArchive;
 /*!
     \brief Интерфейсный класс для работы с демодулятором
     Наследуется от QRunnable, может быть запущен в отдельном потоке
@@ -23,6 +25,10 @@ public:
      *  \brief внедрение зависимости модуля логгирования
      */
     virtual void setLogger(QSharedPointer<ILogger> log) = 0;
+    /*!
+     *  \brief внедрение зависимости архива траекторий
+     */
+    virtual void setTrackArchive(QSharedPointer<ITrackArchive> archive) = 0;
     /*!
      *  \brief копирование массива данных для выполнения демодуляции
      */
@@ -38,12 +44,59 @@ public:
      *  \return результат выполнения
      */
     virtual bool demodulate() = 0;
+    /*!
+     *  \brief Расчет огибающей по отсчетам приемника без изменения состояния
+     *         демодулятора. Допускается вызов из нескольких потоков одновременно
+     *  \param vector - массив 8битных отсчётов I/Q
+     *  \param magnitude - вектор огибающей, размер устанавливается функцией
+     */
+    virtual void computeMagnitude(const QVector<uint8_t>& vector,
+                                  QVector<uint16_t>& magnitude) const = 0;
+    /*!
+     *  \brief Демодуляция по рассчитанной огибающей с обновлением пула объектов.
+     *         Вектор временно изменяется при коррекции фазы
+     *  \param magnitude - вектор огибающей
+     *  \return результат выполнения
+     */
+    virtual bool demodulate(QVector<uint16_t>& magnitude) = 0;
+    /*!
+     *  \brief Агрессивный режим обнаружения: принимаются сообщения с двумя
+     *         ошибками демодуляции, в DF17 исправляются двухбитовые ошибки.
+     *         Параметры алгоритма задаются до запуска демодуляции или
+     *         потоком демодуляции
+     */
+    virtual void setAggressive(bool state) = 0;
+    virtual bool isAggressive() const = 0;
+    /*!
+     *  \brief Исправление двухбитовых ошибок DF17 в агрессивном режиме
+     */
+    virtual void setTwoBitsFix(bool state) = 0;
+    /*!
+     *  \brief Повторная демодуляция сообщения с коррекцией фазы
+     */
+    virtual void setPhaseCorrection(bool state) = 0;
 
     /*!
      *  \brief Функция получения количества обнаруженных объектов
      *  \return количество объектов или -1 в случае ошибки
      */
     virtual int32_t getCountObject() = 0;
+
+    /*!
+     *  \brief Сохранение состояния демодулятора (самолёты в пуле,
+     *         кэш адресов ICAO, половины сообщений CPR) в файл.
+     *         Файл заменяется атомарно
+     *  \param fileName - имя файла
+     *  \return результат сохранения
+     */
+    virtual bool saveState(const QString& fileName) = 0;
+    /*!
+     *  \brief Восстановление состояния демодулятора из файла.
+     *         Устаревшие записи отбрасываются по времени жизни
+     *  \param fileName - имя файла
+     *  \return количество восстановленных самолётов или -1 в случае ошибки
+     */
+    virtual int32_t loadState(const QString& fileName) = 0;
 };
 
 #endif // IDEMODULATOR_H
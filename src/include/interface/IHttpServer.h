@@ -0,0 +1,60 @@
+#ifndef IHTTPSERVER_H
+#define IHTTPSERVER_H
+
+#include <stdint.h>
+#include <QJsonObject>
+
+/*!
+ * @brief  Счетчики HTTP сервера
+ */
+struct HttpServerStats
+{
+    ///< открытые подключения
+    int connections = 0;
+    ///< обработанные запросы
+    uint64_t requests = 0;
+    ///< ответы 304 - у клиента актуальные данные
+    uint64_t notModified = 0;
+    ///< ответы, переданные сжатыми
+    uint64_t gzipResponses = 0;
+    ///< сформированные снимки пула объектов
+    uint64_t generations = 0;
+    ///< передано байт
+    uint64_t bytes = 0;
+};
+
+/*!
+ * \brief The IHttpServer class
+ * Интерфейс встроенного HTTP сервера, выдающего список самолётов
+ * (aircraft.json) и счетчики приемника (stats.json) в формате JSON
+ */
+class IHttpServer
+{
+public:
+    virtual ~IHttpServer(){}
+    /*!
+     * \brief start запуск приема подключений
+     * \param port - порт сервера
+     * \return результат запуска
+     */
+    virtual bool start(uint16_t port) = 0;
+    /*!
+     * \brief stop закрытие всех подключений
+     */
+    virtual void stop() = 0;
+    /*!
+     * \brief isListening сервер принимает подключения
+     */
+    virtual bool isListening() = 0;
+    /*!
+     * \brief setReceiverStats счетчики приемника для выдачи в stats.json,
+     * применяются при формировании следующего снимка
+     */
+    virtual void setReceiverStats(const QJsonObject& stats) = 0;
+    /*!
+     * \brief stats счетчики сервера
+     */
+    virtual HttpServerStats stats() = 0;
+};
+
+#endif // IHTTPSERVER_H
@@ -0,0 +1,97 @@
+#ifndef IINGESTSERVER_H
+#define IINGESTSERVER_H
+
+#include <stdint.h>
+#include <QString>
+#include <QVector>
+
+/*!
+ * @brief  Счетчики подключения приемного пункта
+ */
+struct FeederStats
+{
+    ///< адрес и порт приемного пункта
+    QString address;
+    ///< время подключения, мс с начала эпохи
+    int64_t connectedAt = 0;
+    ///< принято байт
+    uint64_t bytes = 0;
+    ///< принято сообщений
+    uint64_t messages = 0;
+    ///< принято записей о самолётах
+    uint64_t records = 0;
+    ///< ошибки разбора потока
+    uint64_t errors = 0;
+    ///< скорость приема за последнюю секунду, байт/с
+    double bytesPerSec = 0.0;
+    ///< скорость приема за последнюю секунду, записей/с
+    double recordsPerSec = 0.0;
+    ///< задержка последней записи относительно времени приема, мс.
+    ///< Время записи переводится в шкалу сервера, если смещение часов известно
+    int64_t lag = 0;
+    ///< максимальная задержка, мс
+    int64_t maxLag = 0;
+    ///< сглаженная задержка от приема сигнала антенной до занесения
+    ///< в пул объектов, мс; до отображения добавляется период обновления экрана
+    double latency = 0.0;
+    ///< смещение часов пункта относительно сервера известно
+    bool clockSynced = false;
+    ///< смещение часов: часы пункта минус часы сервера, мс
+    int64_t clockOffset = 0;
+    ///< время обмена метками времени, мс, -1 - нет замеров
+    int64_t rtt = -1;
+};
+
+/*!
+ * @brief  Счетчики объединения данных приемных пунктов
+ */
+struct MergeStats
+{
+    ///< принятые записи
+    uint64_t records = 0;
+    ///< записи, примененные к пулу
+    uint64_t applied = 0;
+    ///< записи старее уже примененных
+    uint64_t stale = 0;
+    ///< более свежие записи других пунктов, отклоненные
+    ///< для устойчивости выбранного источника
+    uint64_t held = 0;
+    ///< смены выбранного источника самолёта
+    uint64_t sourceSwitches = 0;
+    ///< отслеживаемые самолёты
+    int aircraft = 0;
+};
+
+/*!
+ * \brief The IIngestServer class
+ * Интерфейс сервера сбора данных от приемных пунктов
+ */
+class IIngestServer
+{
+public:
+    virtual ~IIngestServer(){}
+    /*!
+     * \brief start запуск приема подключений
+     * \param port - порт сервера
+     * \return результат запуска
+     */
+    virtual bool start(uint16_t port) = 0;
+    /*!
+     * \brief stop закрытие всех подключений
+     */
+    virtual void stop() = 0;
+    /*!
+     * \brief isListening сервер принимает подключения
+     */
+    virtual bool isListening() = 0;
+    /*!
+     * \brief feederStats счетчики подключенных приемных пунктов
+     */
+    virtual QVector<FeederStats> feederStats() = 0;
+    /*!
+     * \brief mergeStats счетчики объединения данных
+     */
+    virtual MergeStats mergeStats() = 0;
+};
+
+#endif // IINGESTSERVER_H
@@ -5,6 +5,20 @@
 
 class IPackageController;
 class ILogger;
+
+/*!
+ * \brief The NET_PROTOCOL enum
+ * Формат передачи данных о самолётах на сервер
+ */
+enum class NET_PROTOCOL
+{
+    ///< полный список самолётов в каждом сообщении
+    RAW_DUMP = 0,
+    ///< изменённые поля, удаления и периодический полный кадр
+    DELTA,
+    ///< полный список самолётов пачкой кадров с синхронизацией и CRC (FrameProtocol.h)
+    FRAMED
+};
 /*!
  * \brief The INetworkWorker class
  * Интерфейс класса для реализации сетевого взаимодействия
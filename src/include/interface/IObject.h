@@ -94,6 +94,29 @@ public:
      */
     virtual qint64 getMSecStop() const = 0;
 
+    /*!
+     * \brief setNSecStart - время начала регистрации
+     * \param ns - время в нс с начала эпохи
+     */
+    virtual void setNSecStart(int64_t ns) = 0;
+    /*!
+     * \brief getNSecStart - время начала регистрации
+     * \return время в нс с начала эпохи
+     */
+    virtual int64_t getNSecStart() const = 0;
+
+    /*!
+     * \brief setNSecStop - время последней регистрации.
+     * Основной способ обновления времени при обработке сообщений
+     * \param ns - время в нс с начала эпохи
+     */
+    virtual void setNSecStop(int64_t ns) = 0;
+    /*!
+     * \brief getNSecStop - время последней регистрации
+     * \return время в нс с начала эпохи
+     */
+    virtual int64_t getNSecStop() const = 0;
+
     /*!
      * \brief setObjectState -установка текущего состояни объекта
      * \param state - состояние - новый / обновлен / удаление / не обновлен
@@ -115,6 +138,11 @@ public:
      * \return строка
      */
     virtual QString getObjectName() = 0;
+    /*!
+     * \brief getObjectDescription справочная информация об объекте
+     * \return строка или пустая строка, если информации нет
+     */
+    virtual QString getObjectDescription() = 0;
 
     /*!
      * \brief setAzimuth установка значения пеленга
@@ -168,6 +196,13 @@ public:
      * \return значение широты / долготы
      */
     virtual Position getGeoCoord() const = 0;
+    /*!
+     * \brief getPredictedGeoCoord - прогноз геокоординат на заданный момент
+     * времени. Используется при отрисовке между обновлениями данных
+     * \param msec - время в мс с начала эпохи
+     * \return прогнозируемые значения широты / долготы
+     */
+    virtual Position getPredictedGeoCoord(int64_t msec) const = 0;
     /*!
      * \brief isValidGeoCoord - проверка на корректность геокоординат
      * \return true - координаты корректны
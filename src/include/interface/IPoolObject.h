@@ -5,6 +5,7 @@
 #include <QSharedPointer>
 
 #include "IObject.h"
+#include "IAircraftDatabase.h"
 
 typedef  QSharedPointer< QHash<uint64_t, QSharedPointer<IObject> > > pHash;
 
@@ -25,6 +26,18 @@ public:
                                                     QDateTime reg_time,
                                                     Position geoPosition = Position(),
                                                     bool isImit = false) = 0;
+    /*!
+     * \brief createNewObject функция создания нового объекта в пуле
+     * \param id - уникальный id
+     * \param reg_time - время регистрации в нс с начала эпохи
+     * \param geoPosition - геокоординаты если есть
+     * \param isImit - создание ими
+     * \return указатель на новый объект
+     */
+    virtual QSharedPointer<IObject> createNewObject(uint64_t id,
+                                                    int64_t reg_time,
+                                                    Position geoPosition = Position(),
+                                                    bool isImit = false) = 0;
     /*!
      * \brief values получение списка указателей на существующие объекты.
      * Объекты которые помечены, как неактулаьные выведены не будут.
@@ -77,6 +90,63 @@ public:
      * \param id - идентификатор объекта
      */
     virtual void deleteObject(uint64_t id) = 0;
+    /*!
+     * \brief setObjectTTL - установка времени жизни объектов заданного типа.
+     * Объект, не обновлявшийся дольше этого времени, удаляется из пула
+     * \param type - тип объекта
+     * \param ttl - время жизни в мс
+     */
+    virtual void setObjectTTL(OBJECT_TYPE type, int64_t ttl) = 0;
+    /*!
+     * \brief getObjectTTL - получение времени жизни объектов заданного типа
+     * \param type - тип объекта
+     * \return время жизни в мс
+     */
+    virtual int64_t getObjectTTL(OBJECT_TYPE type) = 0;
+    /*!
+     * \brief removeStaleObjects - удаление объектов, время жизни которых истекло.
+     * Стоимость вызова пропорциональна количеству истекших объектов
+     * \param now - текущее время в мс с начала эпохи
+     * \return количество удалённых объектов
+     */
+    virtual int removeStaleObjects(int64_t now) = 0;
+    /*!
+     * \brief updateGeoIndex - обновление положения объекта в пространственном
+     * индексе. Вызывается после изменения геокоординат объекта
+     * \param id - идентификатор объекта
+     */
+    virtual void updateGeoIndex(uint64_t id) = 0;
+    /*!
+     * \brief valuesInRect - поиск объектов в прямоугольной области
+     * \param southWest - юго-западный угол области
+     * \param northEast - северо-восточный угол области
+     * \return список умных указателей на объекты
+     */
+    virtual QList<QSharedPointer<IObject>> valuesInRect(const Position& southWest,
+                                                        const Position& northEast) = 0;
+    /*!
+     * \brief valuesInRadius - поиск объектов в окружности
+     * \param center - центр окружности
+     * \param radius - радиус в метрах
+     * \return список умных указателей на объекты
+     */
+    virtual QList<QSharedPointer<IObject>> valuesInRadius(const Position& center,
+                                                          double radius) = 0;
+    /*!
+     * \brief nearestObject - поиск ближайшего объекта
+     * \param center - точка поиска
+     * \param maxRadius - максимальное расстояние в метрах
+     * \return указатель на объект или nullptr если объектов нет
+     */
+    virtual QSharedPointer<IObject> nearestObject(const Position& center,
+                                                  double maxRadius) = 0;
+    /*!
+     * \brief setAircraftDatabase - подключение справочника самолётов.
+     * Поиск в справочнике выполняется один раз для каждого нового
+     * самолёта, результат сохраняется в объекте
+     * \param database - справочник или nullptr для отключения
+     */
+    virtual void setAircraftDatabase(QSharedPointer<IAircraftDatabase> database) = 0;
     /*!
      * \brief lockPool блокировка пула объектов
      * для внесения изменния параметров объектов
@@ -0,0 +1,54 @@
+#ifndef ISBSSERVER_H
+#define ISBSSERVER_H
+
+#include <stdint.h>
+
+/*!
+ * @brief  Счетчики сервера выдачи SBS-1
+ */
+struct SbsServerStats
+{
+    ///< подключенные клиенты
+    int clients = 0;
+    ///< сформировано сообщений
+    uint64_t messages = 0;
+    ///< сформировано пакетов рассылки
+    uint64_t batches = 0;
+    ///< передано байт всем клиентам
+    uint64_t bytes = 0;
+    ///< пакеты, пропущенные медленными клиентами
+    uint64_t skipped = 0;
+    ///< клиенты, отключенные из-за переполнения буфера
+    uint64_t slowDisconnects = 0;
+};
+
+/*!
+ * \brief The ISbsServer class
+ * Интерфейс сервера выдачи данных о самолётах в текстовом
+ * формате SBS-1 (BaseStation) сторонним программам
+ */
+class ISbsServer
+{
+public:
+    virtual ~ISbsServer(){}
+    /*!
+     * \brief start запуск приема подключений
+     * \param port - порт сервера, стандартный порт формата - 30003
+     * \return результат запуска
+     */
+    virtual bool start(uint16_t port) = 0;
+    /*!
+     * \brief stop закрытие всех подключений
+     */
+    virtual void stop() = 0;
+    /*!
+     * \brief isListening сервер принимает подключения
+     */
+    virtual bool isListening() = 0;
+    /*!
+     * \brief stats счетчики сервера
+     */
+    virtual SbsServerStats stats() = 0;
+};
+
+#endif // ISBSSERVER_H
@@ -0,0 +1,84 @@
+#ifndef ITRACKARCHIVE_H
+#define ITRACKARCHIVE_H
+
+#include <stdint.h>
+#include <QHash>
+#include <QVector>
+
+#include "coord/Position.h"
+
+/*!
+ * @brief  Точка траектории в архиве
+ */
+struct ArchivePoint
+{
+    ///< адрес ICAO
+    uint32_t icao = 0;
+    ///< время, мс с начала эпохи
+    int64_t time = 0;
+    ///< широта, градусы
+    double latitude = 0.0;
+    ///< долгота, градусы
+    double longitude = 0.0;
+    ///< высота, м
+    float altitude = 0.0f;
+    ///< скорость, км/ч
+    float speed = 0.0f;
+    ///< курс, градусы
+    float course = 0.0f;
+};
+
+///< траектория - точки одного самолёта по возрастанию времени
+typedef QVector<ArchivePoint> ArchiveTrack;
+
+///< срок хранения архива по умолчанию, ч
+constexpr int ARCHIVE_DEFAULT_RETENTION = 72;
+
+/*!
+ * \brief The ITrackArchive class
+ * Интерфейс архива траекторий. Запись выполняется без блокировки
+ * вызывающего потока, запросы ограничиваются интервалом времени.
+ */
+class ITrackArchive
+{
+public:
+    virtual ~ITrackArchive(){}
+    /*!
+     * \brief append добавление точки в очередь записи
+     * \param point - точка траектории
+     */
+    virtual void append(const ArchivePoint& point) = 0;
+    /*!
+     * \brief flush ожидание записи всех добавленных точек
+     */
+    virtual void flush() = 0;
+    /*!
+     * \brief setRetention срок хранения архива. Сегменты, закончившиеся
+     * раньше, удаляются потоком записи
+     * \param hours - срок хранения, ч; 0 - архив хранится без ограничения
+     */
+    virtual void setRetention(int hours) = 0;
+    /*!
+     * \brief queryByIcao траектория самолёта за интервал времени
+     * \param icao - адрес ICAO
+     * \param from - начало интервала, мс с начала эпохи
+     * \param to - конец интервала, мс с начала эпохи
+     * \return траектория
+     */
+    virtual ArchiveTrack queryByIcao(uint32_t icao, int64_t from, int64_t to) = 0;
+    /*!
+     * \brief queryByRect траектории в прямоугольнике за интервал времени
+     * \param southWest - юго-западный угол
+     * \param northEast - северо-восточный угол
+     * \param from - начало интервала, мс с начала эпохи
+     * \param to - конец интервала, мс с начала эпохи
+     * \return траектории по адресам ICAO, содержащие только точки
+     * внутри прямоугольника
+     */
+    virtual QHash<uint32_t, ArchiveTrack> queryByRect(const Position& southWest,
+                                                      const Position& northEast,
+                                                      int64_t from,
+                                                      int64_t to) = 0;
+};
+
+#endif // ITRACKARCHIVE_H
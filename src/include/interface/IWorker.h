@@ -9,6 +9,21 @@
 #include "IDemodulator.h"
 #include "dsp/IDSP.h"
 #include "INetworkWorker.h"
+#include "pipeline/StageConfig.h"
+#include "pipeline/ThreadPolicy.h"
+#include "pipeline/OverloadGovernor.h"
+
+/*!
+ * \brief The PIPELINE_STAGE enum
+ * Стадии конвейера приема и обработки данных
+ */
+enum class PIPELINE_STAGE : uint8_t
+{
+    ACQUISITION = 0,  ///< чтение блока отсчетов с приемника
+    MAGNITUDE,        ///< расчет огибающей
+    DEMODULATION,     ///< демодуляция и обновление пула объектов (сопровождение)
+    OUTPUTS           ///< ЦОС и отправка снимков пула
+};
 /*!
  * \brief The IWorker class
  *  Интерфейс класса получения и обработки данных от приемника
@@ -49,6 +64,55 @@ public:
      * \param msleep - время в мс
      */
     virtual void setTimeout(uint64_t msleep) = 0;
+    /*!
+     * \brief setStateFile периодическое сохранение состояния демодулятора
+     * \param fileName - имя файла, пустая строка - сохранение отключено
+     * \param period - период сохранения в мс
+     */
+    virtual void setStateFile(const QString& fileName, int64_t period) = 0;
+    /*!
+     * \brief setNetProtocol выбор формата передачи данных на сервер
+     */
+    virtual void setNetProtocol(NET_PROTOCOL protocol) = 0;
+    /*!
+     * \brief setMulticast рассылка данных в группу UDP multicast
+     * \param group - адрес группы, пустая строка - рассылка выключена
+     * \param port - порт получателей
+     */
+    virtual void setMulticast(const QString& group, uint16_t port) = 0;
+    /*!
+     * \brief setStageConfig параметры стадии конвейера.
+     * Применяются при следующем запуске exec
+     * \param stage - стадия
+     * \param config - потоки, емкость очереди и поведение при переполнении
+     */
+    virtual void setStageConfig(PIPELINE_STAGE stage, const StageConfig& config) = 0;
+    /*!
+     * \brief stageStats счетчики стадий конвейера,
+     * допускается вызов из любого потока
+     */
+    virtual QVector<StageStats> stageStats() = 0;
+    /*!
+     * \brief setThreadPolicy размещение потоков стадий и потока
+     * отправки данных. Размещение стадий применяется при следующем
+     * запуске exec, потока отправки - сразу
+     */
+    virtual void setThreadPolicy(const ThreadPolicy& policy) = 0;
+    /*!
+     * \brief threadPlacement фактическое размещение потоков,
+     * допускается вызов из любого потока
+     */
+    virtual QVector<PlacementReport> threadPlacement() = 0;
+    /*!
+     * \brief setOverloadConfig пороги упрощения обработки при перегрузке,
+     * применяются при следующем запуске exec
+     */
+    virtual void setOverloadConfig(const OverloadConfig& config) = 0;
+    /*!
+     * \brief overloadStats отставание обработки и ступень упрощения,
+     * допускается вызов из любого потока
+     */
+    virtual OverloadStats overloadStats() = 0;
 public slots:
     /*!
     * \brief exec запуск цикла получения и обработки данных
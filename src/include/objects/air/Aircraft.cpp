@@ -7,7 +7,7 @@
 #include "StructAircraft.h"
 
 Aircraft::Aircraft(uint32_t icao, bool isImit) : BaseObject(icao,
-                                                            QDateTime::currentDateTime(),
+                                                            Clock::nowNSec(),
                                                             OBJECT_TYPE::air,
                                                             isImit,
                                                             Position())
@@ -36,14 +36,64 @@ QString Aircraft::getFlightInfo() const
     return QString(_flight);
 }
 
+void Aircraft::setAircraftInfo(const AircraftInfo &info)
+{
+    _info = info;
+    _infoIcao = getICAO();
+}
+
+QString Aircraft::getObjectDescription()
+{
+    if(_info.isEmpty())
+        return QString();
+
+    return QString("%1 %2\n%3")
+            .arg(_info.registration)
+            .arg(_info.type)
+            .arg(_info.owner);
+}
+
 void Aircraft::setLongitude(double lon)
 {
     _geoCoord.setLongitude(lon);
+    syncState();
 }
 
 void Aircraft::setLatitude(double lat)
 {
     _geoCoord.setLatitude(lat);
+    syncState();
+}
+
+bool Aircraft::updatePosition(int64_t time, const Position &pos)
+{
+    if(!_predictor.updatePosition(time, pos))
+        return false;
+
+    _geoCoord = _predictor.getPosition();
+    syncState();
+    return true;
+}
+
+void Aircraft::updateVelocity(int64_t time, float speed, float course)
+{
+    _speed = speed;
+    _course = course;
+    _predictor.updateVelocity(time, speed, course);
+    syncState();
+}
+
+Position Aircraft::getPredictedGeoCoord(int64_t msec) const
+{
+    if(!_predictor.isValid())
+        return _geoCoord;
+
+    return _predictor.predict(msec);
+}
+
+bool Aircraft::updateTrack(int64_t time)
+{
+    return _track.append(time, _geoCoord, _altitude, _speed);
 }
 
 QString Aircraft::toString()
@@ -91,8 +141,35 @@ QByteArray Aircraft::serialize()
 
 bool Aircraft::unserialize(QByteArray array)
 {
-    Q_UNUSED(array);
-    return false;
+    if(array.size() < int(sizeof(StructAircraft)))
+        return false;
+
+    StructAircraft a;
+    memcpy((char*)&a, array.constData(), sizeof (StructAircraft));
+
+    if((a.icao & 0xffffff) != getICAO())
+        return false;
+
+    a.flight[sizeof(a.flight) - 1] = 0;
+    if(a.flight[0] != 0)
+        setFlightInfo(a.flight);
+
+    const int64_t seen = a.seen;
+    setAltitude(float(a.altitude) / VALUE_LSB);
+
+    //отсутствие координат передается значением вне диапазона
+    double lon = a.lon * LON_VALUE_LSB;
+    double lat = a.lat * LAT_VALUE_LSB;
+    if(fabs(lat) <= 90.0 && fabs(lon) <= 180.0 && (lat != 0.0 || lon != 0.0))
+        updatePosition(seen, Position(lon, lat));
+
+    if(a.speed != 0)
+        updateVelocity(seen, float(a.speed) / VALUE_LSB, float(a.course) / VALUE_LSB);
+
+    _messages = a.messages;
+    setNSecStop(Clock::fromMSec(seen));
+
+    return true;
 }
 
 uint32_t Aircraft::serializedFrameSize()
@@ -112,5 +189,9 @@ void Aircraft::resetObjectData()
     _even_cprlon = 0;
     _even_cprtime = 0;
     _messages = 0;
+    _track.clear();
+    _predictor.reset();
+    _info = AircraftInfo();
+    _infoIcao = 0;
 }
 
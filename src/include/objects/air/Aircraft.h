@@ -5,6 +5,9 @@
 #include <QString>
 #include <math.h>
 #include "objects/base/BaseObject.h"
+#include "TrackHistory.h"
+#include "TrackPredictor.h"
+#include "interface/IAircraftDatabase.h"
 /*!
  * \brief The Aircraft class
  * Класс объекта типа самолёт
@@ -31,6 +34,15 @@ class Aircraft : public BaseObject
     int64_t _odd_cprtime;
     int64_t _even_cprtime;
 
+    /* Position history, downsampled. */
+    TrackHistory _track;
+    /* Position filter used for prediction and CPR gating. */
+    TrackPredictor _predictor;
+    /* Metadata from the aircraft database. */
+    AircraftInfo _info;
+    /* ICAO address the metadata was looked up for, 0 - no lookup yet. */
+    uint32_t _infoIcao = 0;
+
 public:
     Aircraft(uint32_t icao, bool isImit = false);
     ~Aircraft() = default;
@@ -49,6 +61,10 @@ public:
      * \return
      */
     uint64_t getNumberMsg() const { return _messages; }
+    /*!
+     * \brief setNumberMsg установка счётчика сообщений
+     */
+    void setNumberMsg(uint64_t val) { _messages = val; }
     /*!
      * \brief setFlightInfo имя рейса
      * \param val указатель на строку
@@ -77,6 +93,24 @@ public:
 
     void setEvenCprTime(int64_t val) { _even_cprtime = val; }
     int64_t getEvenCprTime() const { return _even_cprtime; }
+    /*!
+     * \brief setAircraftInfo сохранение справочных данных самолёта
+     * \param info - данные из справочника
+     */
+    void setAircraftInfo(const AircraftInfo& info);
+    /*!
+     * \brief getAircraftInfo справочные данные самолёта
+     */
+    const AircraftInfo& getAircraftInfo() const { return _info; }
+    /*!
+     * \brief isAircraftInfoLoaded выполнялся ли поиск в справочнике
+     * для текущего адреса ICAO
+     */
+    bool isAircraftInfoLoaded() const { return _infoIcao != 0 && _infoIcao == getICAO(); }
+    /*!
+     * \brief getObjectDescription регистрация, тип и эксплуатант
+     */
+    QString getObjectDescription() override;
     /*!
      * \brief setLongitude установка значения долготы
      * \param lon долгота
@@ -97,6 +131,38 @@ public:
      * \return  широта
      */
     double getLatitude() { return _geoCoord.latitude(); }
+    /*!
+     * \brief updatePosition обновление координат по решению CPR.
+     * Решение, не согласующееся с траекторией, отбрасывается
+     * \param time - время в мс с начала эпохи
+     * \param pos - декодированные геокоординаты
+     * \return true - координаты обновлены
+     */
+    bool updatePosition(int64_t time, const Position& pos);
+    /*!
+     * \brief updateVelocity обновление скорости и курса
+     * \param time - время в мс с начала эпохи
+     * \param speed - скорость, км/ч
+     * \param course - курс, градусы относительно севера
+     */
+    void updateVelocity(int64_t time, float speed, float course);
+    /*!
+     * \brief getPredictedGeoCoord экстраполяция положения самолёта
+     * \param msec - время в мс с начала эпохи
+     * \return прогнозируемые геокоординаты
+     */
+    Position getPredictedGeoCoord(int64_t msec) const override;
+    /*!
+     * \brief updateTrack добавление текущего положения в историю движения
+     * \param time - время в мс с начала эпохи
+     * \return true - точка сохранена, false - отброшена прореживанием
+     */
+    bool updateTrack(int64_t time);
+    /*!
+     * \brief getTrack история движения самолёта
+     * \return траектория
+     */
+    const TrackHistory& getTrack() const { return _track; }
     /*!
      * \brief toString сериализация данных в строку
      * \return
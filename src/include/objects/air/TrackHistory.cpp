@@ -0,0 +1,106 @@
+#include <math.h>
+#include <limits>
+
+#include "TrackHistory.h"
+
+namespace
+{
+const double LON_VALUE_LSB = 360.0 / pow(2, 31);
+const double LAT_VALUE_LSB = 180.0 / pow(2, 31);
+const float SPEED_VALUE_LSB = 0.1f;
+}
+
+TrackHistory::TrackHistory()
+{
+    clear();
+}
+
+void TrackHistory::clear()
+{
+    _baseTime = 0;
+    _head = 0;
+    _count = 0;
+}
+
+const TrackPoint &TrackHistory::last() const
+{
+    return _points[(_head + _count - 1) % CAPACITY];
+}
+
+bool TrackHistory::append(int64_t time,
+                          const Position &pos,
+                          float altitude,
+                          float speed)
+{
+    if(_count == 0)
+        _baseTime = time;
+
+    int64_t dt = time - _baseTime;
+    //смещение не помещается в точку - начинаем траекторию заново
+    if(dt < 0 || dt > int64_t(std::numeric_limits<uint32_t>::max()))
+    {
+        clear();
+        _baseTime = time;
+        dt = 0;
+    }
+
+    if(_count > 0)
+    {
+        const TrackPoint& prev = last();
+        int64_t interval = dt - int64_t(prev.dt);
+
+        if(interval < MIN_INTERVAL)
+            return false;
+
+        //неподвижный объект записывается с интервалом MAX_INTERVAL
+        if(interval < MAX_INTERVAL)
+        {
+            Position prevPos(prev.lon * LON_VALUE_LSB,
+                             prev.lat * LAT_VALUE_LSB);
+
+            if(prevPos.flatDistanceEstimate(pos) < MIN_DISTANCE &&
+                    fabsf(altitude - prev.altitude) < MIN_ALTITUDE_DELTA)
+                return false;
+        }
+    }
+
+    int index = (_head + _count) % CAPACITY;
+    if(_count < CAPACITY)
+        ++_count;
+    else
+        _head = (_head + 1) % CAPACITY;
+
+    TrackPoint& point = _points[index];
+    point.dt = uint32_t(dt);
+    point.lat = int32_t(pos.latitude() / LAT_VALUE_LSB);
+    point.lon = int32_t(pos.longitude() / LON_VALUE_LSB);
+
+    float alt = fmaxf(fminf(altitude, std::numeric_limits<int16_t>::max()),
+                      std::numeric_limits<int16_t>::min());
+    point.altitude = int16_t(alt);
+
+    float spd = fmaxf(fminf(speed / SPEED_VALUE_LSB,
+                            std::numeric_limits<uint16_t>::max()), 0.0f);
+    point.speed = uint16_t(spd);
+
+    return true;
+}
+
+const TrackPoint &TrackHistory::at(int index) const
+{
+    return _points[(_head + index) % CAPACITY];
+}
+
+TrackSample TrackHistory::sample(int index) const
+{
+    const TrackPoint& point = at(index);
+
+    TrackSample s;
+    s.time = _baseTime + point.dt;
+    s.position = Position(point.lon * LON_VALUE_LSB,
+                          point.lat * LAT_VALUE_LSB);
+    s.altitude = point.altitude;
+    s.speed = point.speed * SPEED_VALUE_LSB;
+
+    return s;
+}
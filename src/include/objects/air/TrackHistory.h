@@ -0,0 +1,114 @@
+#ifndef TRACKHISTORY_H
+#define TRACKHISTORY_H
+
+#include <stdint.h>
+
+#include "coord/Position.h"
+
+/*!
+ * @brief  Точка траектории в упакованном виде.
+ * Координаты квантуются так же, как в StructAircraft
+ */
+#pragma pack(push,1)
+struct TrackPoint
+{
+    /* Time offset from the track base time, ms */
+    uint32_t dt;
+    /* latitude, LSB = 180 / 2^31 */
+    int32_t lat;
+    /* longitude, LSB = 360 / 2^31 */
+    int32_t lon;
+    /* Altitude, meters */
+    int16_t altitude;
+    /* Speed, LSB = 0.1 km/h */
+    uint16_t speed;
+};
+#pragma pack(pop)
+
+/*!
+ * @brief  Точка траектории после распаковки
+ */
+struct TrackSample
+{
+    int64_t time;
+    Position position;
+    float altitude;
+    float speed;
+};
+
+/*!
+ * \brief The TrackHistory class
+ * Кольцевой буфер истории движения объекта фиксированного размера.
+ * Память под точки выделяется вместе с объектом, поэтому при повторном
+ * использовании объекта в пуле буфер только очищается.
+ * Точки прореживаются по времени и расстоянию: при емкости 128 точек
+ * и интервале 15 с история покрывает не менее 30 минут,
+ * 5000 объектов занимают ~10 Мб.
+ */
+class TrackHistory
+{
+public:
+    ///< емкость буфера, точек
+    static constexpr int CAPACITY = 128;
+    ///< минимальный интервал между точками, мс
+    static constexpr int64_t MIN_INTERVAL = 15000;
+    ///< максимальный интервал для неподвижного объекта, мс
+    static constexpr int64_t MAX_INTERVAL = 60000;
+    ///< минимальное смещение, при котором добавляется точка, м
+    static constexpr double MIN_DISTANCE = 200.0;
+    ///< минимальное изменение высоты, при котором добавляется точка, м
+    static constexpr float MIN_ALTITUDE_DELTA = 30.0f;
+
+private:
+    TrackPoint _points[CAPACITY];
+    ///< время начала траектории в мс с начала эпохи
+    int64_t _baseTime = 0;
+    ///< индекс самой старой точки
+    int _head = 0;
+    ///< количество точек в буфере
+    int _count = 0;
+
+    /*!
+     * \brief last последняя добавленная точка
+     */
+    const TrackPoint& last() const;
+
+public:
+    TrackHistory();
+    /*!
+     * \brief clear очистка траектории без освобождения памяти
+     */
+    void clear();
+    /*!
+     * \brief append добавление точки с прореживанием
+     * \param time - время в мс с начала эпохи
+     * \param pos - геокоординаты
+     * \param altitude - высота, м
+     * \param speed - скорость, км/ч
+     * \return true - точка сохранена, false - отброшена прореживанием
+     */
+    bool append(int64_t time,
+                const Position& pos,
+                float altitude,
+                float speed);
+    /*!
+     * \brief size количество точек в траектории
+     */
+    int size() const { return _count; }
+    /*!
+     * \brief isEmpty проверка на отсутствие точек
+     */
+    bool isEmpty() const { return _count == 0; }
+    /*!
+     * \brief at упакованная точка траектории
+     * \param index - 0 - самая старая точка
+     */
+    const TrackPoint& at(int index) const;
+    /*!
+     * \brief sample распакованная точка траектории
+     * \param index - 0 - самая старая точка
+     */
+    TrackSample sample(int index) const;
+};
+
+#endif // TRACKHISTORY_H
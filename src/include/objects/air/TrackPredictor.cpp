@@ -0,0 +1,122 @@
+#include <math.h>
+
+#include "TrackPredictor.h"
+
+namespace
+{
+const double KM_P_H_TO_M_P_S = 1.0 / 3.6;
+const double DEG_TO_RAD = M_PI / 180.0;
+}
+
+void TrackPredictor::initialize(int64_t time, const Position &pos)
+{
+    _position = pos;
+    _time = time;
+    _rejected = 0;
+    _valid = true;
+
+    //скорость из ADS-B сохраняется, оценка фильтра - нет
+    if(!hasVelocity(time))
+    {
+        _ve = 0.0;
+        _vn = 0.0;
+    }
+}
+
+bool TrackPredictor::hasVelocity(int64_t time) const
+{
+    return _velocityTime != 0 && time - _velocityTime <= VELOCITY_TIMEOUT;
+}
+
+void TrackPredictor::reset()
+{
+    _position = Position();
+    _ve = 0.0;
+    _vn = 0.0;
+    _time = 0;
+    _velocityTime = 0;
+    _valid = false;
+    _rejected = 0;
+}
+
+bool TrackPredictor::isPlausible(int64_t time, const Position &pos) const
+{
+    if(!_valid)
+        return true;
+
+    double dt = fabs(double(time - _time)) / 1000.0;
+    double gate = MIN_GATE + MAX_SPEED * dt;
+
+    return predict(time).flatDistanceEstimate(pos) <= gate;
+}
+
+bool TrackPredictor::updatePosition(int64_t time, const Position &pos)
+{
+    if(!_valid)
+    {
+        initialize(time, pos);
+        return true;
+    }
+
+    if(!isPlausible(time, pos))
+    {
+        if(++_rejected < MAX_REJECTED)
+            return false;
+
+        //траектория потеряна - начинаем заново
+        initialize(time, pos);
+        return true;
+    }
+    _rejected = 0;
+
+    double dt = double(time - _time) / 1000.0;
+    Position predicted = predict(time);
+    QVector2D residual = predicted.flatOffsetMeters(pos);
+
+    _position = predicted.flatOffsetToPosition(QPointF(ALPHA * residual.x(),
+                                                       ALPHA * residual.y()));
+
+    //скорость из ADS-B точнее оценки по координатам
+    if(dt > 0.0 && !hasVelocity(time))
+    {
+        _ve += BETA * residual.x() / dt;
+        _vn += BETA * residual.y() / dt;
+    }
+
+    if(time > _time)
+        _time = time;
+
+    return true;
+}
+
+void TrackPredictor::updateVelocity(int64_t time, float speed, float course)
+{
+    double v = double(speed) * KM_P_H_TO_M_P_S;
+    double angle = double(course) * DEG_TO_RAD;
+
+    if(_valid && time > _time)
+    {
+        //переносим опорную точку, чтобы смена скорости не сдвигала прогноз
+        _position = predict(time);
+        _time = time;
+    }
+
+    _ve = v * sin(angle);
+    _vn = v * cos(angle);
+    _velocityTime = time;
+}
+
+Position TrackPredictor::predict(int64_t time) const
+{
+    if(!_valid)
+        return _position;
+
+    int64_t dt = time - _time;
+    if(dt <= 0)
+        return _position;
+    if(dt > MAX_PREDICTION)
+        dt = MAX_PREDICTION;
+
+    double sec = double(dt) / 1000.0;
+    return _position.flatOffsetToPosition(QPointF(_ve * sec, _vn * sec));
+}
@@ -0,0 +1,106 @@
+#ifndef TRACKPREDICTOR_H
+#define TRACKPREDICTOR_H
+
+#include <stdint.h>
+
+#include "coord/Position.h"
+
+/*!
+ * \brief The TrackPredictor class
+ * Альфа-бета фильтр положения объекта в локальной плоской системе
+ * координат (восток / север, метры).
+ * Фильтр сглаживает координаты, полученные декодированием CPR,
+ * экстраполирует положение между обновлениями и отбраковывает
+ * решения, не согласующиеся с предыдущей траекторией.
+ * Скорость и курс из сообщений ADS-B (metype 19) заменяют
+ * оценку скорости фильтра.
+ */
+class TrackPredictor
+{
+public:
+    ///< коэффициент сглаживания положения
+    static constexpr double ALPHA = 0.6;
+    ///< коэффициент сглаживания скорости
+    static constexpr double BETA = 0.2;
+    ///< максимальная скорость объекта, м/с
+    static constexpr double MAX_SPEED = 400.0;
+    ///< минимальный размер строба, м
+    static constexpr double MIN_GATE = 1500.0;
+    ///< максимальное время экстраполяции, мс
+    static constexpr int64_t MAX_PREDICTION = 30000;
+    ///< время, в течение которого скорость из ADS-B считается актуальной, мс
+    static constexpr int64_t VELOCITY_TIMEOUT = 10000;
+    ///< количество подряд отброшенных решений до переинициализации
+    static constexpr int MAX_REJECTED = 3;
+
+private:
+    ///< оценка положения на момент _time
+    Position _position;
+    ///< скорость на восток, м/с
+    double _ve = 0.0;
+    ///< скорость на север, м/с
+    double _vn = 0.0;
+    ///< время последнего обновления положения, мс с начала эпохи
+    int64_t _time = 0;
+    ///< время последнего обновления скорости из ADS-B, мс с начала эпохи
+    int64_t _velocityTime = 0;
+    ///< признак инициализации фильтра
+    bool _valid = false;
+    ///< счётчик подряд отброшенных решений
+    int _rejected = 0;
+
+    /*!
+     * \brief initialize инициализация фильтра по первому измерению
+     */
+    void initialize(int64_t time, const Position &pos);
+    /*!
+     * \brief hasVelocity проверка актуальности скорости из ADS-B
+     */
+    bool hasVelocity(int64_t time) const;
+
+public:
+    TrackPredictor() = default;
+    /*!
+     * \brief reset сброс состояния фильтра
+     */
+    void reset();
+    /*!
+     * \brief isValid проверка инициализации фильтра
+     */
+    bool isValid() const { return _valid; }
+    /*!
+     * \brief isPlausible проверка попадания измерения в строб
+     * \param time - время измерения в мс с начала эпохи
+     * \param pos - измеренные геокоординаты
+     * \return true - измерение согласуется с траекторией
+     */
+    bool isPlausible(int64_t time, const Position &pos) const;
+    /*!
+     * \brief updatePosition обновление фильтра по измерению координат.
+     * Измерение вне строба отбрасывается, после MAX_REJECTED
+     * отброшенных подряд измерений фильтр инициализируется заново
+     * \param time - время измерения в мс с начала эпохи
+     * \param pos - измеренные геокоординаты
+     * \return true - измерение принято
+     */
+    bool updatePosition(int64_t time, const Position &pos);
+    /*!
+     * \brief updateVelocity обновление скорости по данным ADS-B
+     * \param time - время измерения в мс с начала эпохи
+     * \param speed - скорость, км/ч
+     * \param course - курс, градусы относительно севера
+     */
+    void updateVelocity(int64_t time, float speed, float course);
+    /*!
+     * \brief getPosition сглаженное положение на момент последнего обновления
+     */
+    Position getPosition() const { return _position; }
+    /*!
+     * \brief predict экстраполяция положения на заданный момент времени
+     * \param time - время в мс с начала эпохи
+     * \return прогнозируемые геокоординаты
+     */
+    Position predict(int64_t time) const;
+};
+
+#endif // TRACKPREDICTOR_H
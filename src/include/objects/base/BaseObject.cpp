@@ -1,7 +1,7 @@
 #include "BaseObject.h"
 
 BaseObject::BaseObject(uint64_t id,
-                       QDateTime tstart,
+                       int64_t tstart,
                        double azimuth,
                        double elevation,
                        OBJECT_TYPE type,
@@ -9,10 +9,8 @@ BaseObject::BaseObject(uint64_t id,
     _id(id),
     _typeObject(type),
     _isImitate(isImit),
-    _ms_tstart(tstart.toUTC().toMSecsSinceEpoch()),
-    _tstart(tstart),
-    _ms_tstop(tstart.toUTC().toMSecsSinceEpoch()),
-    _tstop(tstart),
+    _ns_tstart(tstart),
+    _ns_tstop(tstart),
     _azimuth(azimuth),
     _elevation(elevation)
 {
@@ -20,17 +18,15 @@ BaseObject::BaseObject(uint64_t id,
 }
 
 BaseObject::BaseObject(uint64_t id,
-                       QDateTime tstart,
+                       int64_t tstart,
                        OBJECT_TYPE type,
                        bool isImit,
                        Position geoPosition) :
     _id(id),
     _typeObject(type),
     _isImitate(isImit),
-    _ms_tstart(tstart.toUTC().toMSecsSinceEpoch()),
-    _tstart(tstart),
-    _ms_tstop(tstart.toUTC().toMSecsSinceEpoch()),
-    _tstop(tstart),
+    _ns_tstart(tstart),
+    _ns_tstop(tstart),
     _geoCoord(geoPosition)
 {
     _uuid = QUuid::createUuid();
@@ -40,6 +36,14 @@ BaseObject::~BaseObject()
 {
 }
 
+void BaseObject::bindState(StateColumns *columns, int slot)
+{
+    _columns = (columns != nullptr && slot >= 0 && slot < columns->size()) ?
+                columns : nullptr;
+    _slot = (_columns != nullptr) ? slot : -1;
+    syncState();
+}
+
 QUuid BaseObject::getUuid()
 {
     return  _uuid;
@@ -48,6 +52,7 @@ QUuid BaseObject::getUuid()
 void BaseObject::setId(uint64_t id)
 {
     _id = id;
+    syncState();
 }
 
 uint64_t BaseObject::getId() const
@@ -57,46 +62,44 @@ uint64_t BaseObject::getId() const
 
 void BaseObject::setDateTimeStart(const QDateTime &dt)
 {
-    _tstart = dt;
-    _ms_tstart = _tstart.toUTC().toMSecsSinceEpoch();
+    _ns_tstart = Clock::fromDateTime(dt);
 }
 
 QDateTime BaseObject::getDateTimeStart() const
 {
-    return _tstart;
+    return Clock::toDateTime(_ns_tstart);
 }
 
 void BaseObject::setDateTimeStop(const QDateTime &dt)
 {
-    _tstop = dt;
-    _ms_tstop = _tstop.toUTC().toMSecsSinceEpoch();
+    _ns_tstop = Clock::fromDateTime(dt);
+    syncState();
 }
 
 QDateTime BaseObject::getDateTimeStop() const
 {
-    return _tstop;
+    return Clock::toDateTime(_ns_tstop);
 }
 
 void BaseObject::setMSecStart(const qint64 dt)
 {
-    _ms_tstart = dt;
-    _tstart = QDateTime::fromMSecsSinceEpoch(dt).toUTC();
+    _ns_tstart = Clock::fromMSec(dt);
 }
 
 qint64 BaseObject::getMSecStart() const
 {
-    return _ms_tstart;
+    return Clock::toMSec(_ns_tstart);
 }
 
 void BaseObject::setMSecStop(const qint64 dt)
 {
-    _ms_tstop = dt;
-    _tstop = QDateTime::fromMSecsSinceEpoch(dt).toUTC();
+    _ns_tstop = Clock::fromMSec(dt);
+    syncState();
 }
 
 qint64 BaseObject::getMSecStop() const
 {
-    return _ms_tstop;
+    return Clock::toMSec(_ns_tstop);
 }
 
 void BaseObject::setObjectState(OBJECT_STATE state)
@@ -109,6 +112,8 @@ void BaseObject::setObjectState(OBJECT_STATE state)
 
     if(state == OBJECT_STATE::DELETE_OBJECT)
         setInUse(false);
+
+    syncState();
 }
 
 OBJECT_STATE BaseObject::getObjectState()
@@ -169,6 +174,7 @@ double BaseObject::getDistance_KM()
 void BaseObject::setGeoCoord(const Position &gp)
 {
     _geoCoord = gp;
+    syncState();
 }
 
 Position BaseObject::getGeoCoord() const
@@ -176,6 +182,12 @@ Position BaseObject::getGeoCoord() const
     return _geoCoord;
 }
 
+Position BaseObject::getPredictedGeoCoord(int64_t msec) const
+{
+    Q_UNUSED(msec);
+    return _geoCoord;
+}
+
 bool BaseObject::isValidGeoCoord()
 {
     return ((_geoCoord.latitude() > -90.0 && _geoCoord.latitude() < 90.0) &&
@@ -185,6 +197,7 @@ bool BaseObject::isValidGeoCoord()
 void BaseObject::setSpeed(float value)
 {
     _speed = value;
+    syncState();
 }
 
 float BaseObject::getSpeed() const
@@ -195,6 +208,7 @@ float BaseObject::getSpeed() const
 void BaseObject::setCourse(float crs)
 {
     _course = crs;
+    syncState();
 }
 
 float BaseObject::getCourse()
@@ -206,6 +220,7 @@ float BaseObject::getCourse()
 void BaseObject::setInUse(bool value)
 {
     _inUse = value;
+    syncState();
 }
 
 bool BaseObject::getInUse()
@@ -219,10 +234,8 @@ void BaseObject::resetObjectData()
     _nameObject = QString("--");
     _state = OBJECT_STATE::DELETE_OBJECT;
     _inUse = false;
-    _tstart = QDateTime();
-    _tstop = QDateTime();
-    _ms_tstart = 0;
-    _ms_tstop = 0;
+    _ns_tstart = 0;
+    _ns_tstop = 0;
 
     _geoCoord = Position(-200.0,-200.0);
     _speed = 0.0;
@@ -232,6 +245,7 @@ void BaseObject::resetObjectData()
     _distance = 0.0;
     _altitude = 0.0;
     _isImitate = false;
+    syncState();
 }
 
 float BaseObject::getAltitude() const
@@ -242,6 +256,7 @@ float BaseObject::getAltitude() const
 void BaseObject::setAltitude(float altitude)
 {
     _altitude = altitude;
+    syncState();
 }
 
 bool BaseObject::isImitated()
@@ -4,6 +4,8 @@
 #include <QDateTime>
 #include <QObject>
 #include "interface/IObject.h"
+#include "time/Clock.h"
+#include "StateColumns.h"
 /*!
  * \brief The BaseObject class
  * Базовый класс для всех радиотехнических объектов
@@ -29,17 +31,19 @@ class BaseObject :  public IObject
     OBJECT_TYPE _typeObject;
     ///< флаг имитированного объекта
     bool _isImitate = false;
+    ///< массивы состояния пула, в которые дублируются поля объекта
+    StateColumns* _columns = nullptr;
+    ///< номер слота объекта в массивах состояния
+    int _slot = -1;
 protected:
 
     QString _nameObject = QString("--");
 
-    //время когда был зарегестрирован объект
-    int64_t _ms_tstart = 0;
-    QDateTime  _tstart;
+    //время когда был зарегестрирован объект, нс с начала эпохи
+    int64_t _ns_tstart = 0;
 
-    //время когда последний раз были обновлены данные
-    int64_t _ms_tstop = 0;
-    QDateTime  _tstop;
+    //время когда последний раз были обновлены данные, нс с начала эпохи
+    int64_t _ns_tstop = 0;
 
     Position _geoCoord;
     //скорость
@@ -60,22 +64,58 @@ protected:
      * \param value - true - объект используется
      */
     void setInUse(bool value) override;
+    /*!
+     * \brief syncState запись часто используемых полей в массивы состояния.
+     * Вызывается после изменения любого из этих полей
+     */
+    inline void syncState()
+    {
+        if(_columns == nullptr)
+            return;
+
+        _columns->id[_slot] = _id;
+        _columns->latitude[_slot] = _geoCoord.latitude();
+        _columns->longitude[_slot] = _geoCoord.longitude();
+        _columns->altitude[_slot] = _altitude;
+        _columns->speed[_slot] = _speed;
+        _columns->course[_slot] = _course;
+        _columns->lastSeen[_slot] = _ns_tstop;
+        _columns->state[_slot] = uint8_t(_state);
+
+        //пул переиспользует слот, не просматривая массивы
+        if(!_inUse && _columns->inUse[_slot] != 0)
+            _columns->markReleased(_slot);
+        _columns->inUse[_slot] = _inUse ? 1 : 0;
+    }
 public:
     BaseObject(uint64_t id,
-               QDateTime tstart,
+               int64_t tstart,
                double azimuth,
                double elevation,
                OBJECT_TYPE type = OBJECT_TYPE::base,
                bool isImit = false);
 
     BaseObject(uint64_t id,
-               QDateTime tstart,
+               int64_t tstart,
                OBJECT_TYPE type = OBJECT_TYPE::base,
                bool isImit = false,
                Position geoPosition = Position());
 
     ~BaseObject() override;
 
+    /*!
+     * \brief bindState привязка объекта к слоту массивов состояния пула.
+     * После привязки изменения полей дублируются в массивы
+     * \param columns - массивы состояния, nullptr - отвязать объект
+     * \param slot - номер слота
+     */
+    void bindState(StateColumns* columns, int slot);
+    /*!
+     * \brief getStateSlot номер слота в массивах состояния
+     * \return номер слота или -1, если объект не привязан
+     */
+    int getStateSlot() const { return _slot; }
+
     /*!
      * \brief getUuid получение uuid
      * uuid генерируется при создании объекта
@@ -136,6 +176,28 @@ public:
      */
     qint64 getMSecStop() const override;
 
+    /*!
+     * \brief setNSecStart - время начала регистрации
+     * \param ns - время в нс с начала эпохи
+     */
+    void setNSecStart(int64_t ns) override { _ns_tstart = ns; }
+    /*!
+     * \brief getNSecStart - время начала регистрации
+     * \return время в нс с начала эпохи
+     */
+    int64_t getNSecStart() const override { return _ns_tstart; }
+
+    /*!
+     * \brief setNSecStop - время последней регистрации
+     * \param ns - время в нс с начала эпохи
+     */
+    void setNSecStop(int64_t ns) override { _ns_tstop = ns; syncState(); }
+    /*!
+     * \brief getNSecStop - время последней регистрации
+     * \return время в нс с начала эпохи
+     */
+    int64_t getNSecStop() const override { return _ns_tstop; }
+
     /*!
      * \brief setObjectState -установка текущего состояни объекта
      * \param state - состояние - новый / обновлен / удаление / не обновлен
@@ -157,6 +219,11 @@ public:
      * \return строка
      */
     QString getObjectName() override;
+    /*!
+     * \brief getObjectDescription справочная информация об объекте
+     * \return для базового объекта - пустая строка
+     */
+    QString getObjectDescription() override { return QString(); }
 
     /*!
      * \brief setAzimuth установка значения пеленга
@@ -211,6 +278,13 @@ public:
      * \return значение широты / долготы
      */
     Position getGeoCoord() const override;
+    /*!
+     * \brief getPredictedGeoCoord - прогноз геокоординат.
+     * Базовый объект не экстраполирует положение
+     * \param msec - время в мс с начала эпохи
+     * \return текущие значения широты / долготы
+     */
+    Position getPredictedGeoCoord(int64_t msec) const override;
     /*!
      * \brief isValidGeoCoord - проверка на корректность геокоординат
      * \return true - координаты корректны
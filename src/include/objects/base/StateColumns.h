@@ -0,0 +1,108 @@
+#ifndef STATECOLUMNS_H
+#define STATECOLUMNS_H
+
+#include <stdint.h>
+#include <QVector>
+
+/*!
+ * \brief The StateColumns struct
+ * Часто используемые поля объектов, разложенные по непрерывным массивам
+ * (structure of arrays). Индекс в массивах - номер слота объекта в пуле.
+ * Объект, привязанный к слоту, записывает изменения полей в массивы,
+ * поэтому просмотр всего пула не требует обращения к самим объектам.
+ */
+struct StateColumns
+{
+    ///< идентификатор объекта
+    QVector<uint64_t> id;
+    ///< широта, градусы
+    QVector<double> latitude;
+    ///< долгота, градусы
+    QVector<double> longitude;
+    ///< высота, м
+    QVector<float> altitude;
+    ///< скорость, км/ч
+    QVector<float> speed;
+    ///< курс, градусы
+    QVector<float> course;
+    ///< время последнего обновления, нс с начала эпохи
+    QVector<int64_t> lastSeen;
+    ///< состояние объекта (OBJECT_STATE)
+    QVector<uint8_t> state;
+    ///< флаг использования слота
+    QVector<uint8_t> inUse;
+    ///< слоты, объекты которых помечены неиспользуемыми без участия пула
+    QVector<int> released;
+    ///< флаг нахождения слота в released
+    QVector<uint8_t> releasedMark;
+
+    /*!
+     * \brief size количество слотов
+     */
+    int size() const { return id.size(); }
+    /*!
+     * \brief append добавление пустого слота
+     * \return номер слота
+     */
+    int append()
+    {
+        id.append(0);
+        latitude.append(-200.0);
+        longitude.append(-200.0);
+        altitude.append(0.0f);
+        speed.append(0.0f);
+        course.append(0.0f);
+        lastSeen.append(0);
+        state.append(0);
+        inUse.append(0);
+        releasedMark.append(0);
+        return id.size() - 1;
+    }
+    /*!
+     * \brief markReleased учет слота, объект которого перестал
+     * использоваться, для повторного использования без просмотра пула
+     */
+    void markReleased(int slot)
+    {
+        if(releasedMark[slot] != 0)
+            return;
+
+        releasedMark[slot] = 1;
+        released.append(slot);
+    }
+    /*!
+     * \brief reserve резервирование памяти под слоты
+     */
+    void reserve(int count)
+    {
+        id.reserve(count);
+        latitude.reserve(count);
+        longitude.reserve(count);
+        altitude.reserve(count);
+        speed.reserve(count);
+        course.reserve(count);
+        lastSeen.reserve(count);
+        state.reserve(count);
+        inUse.reserve(count);
+        releasedMark.reserve(count);
+    }
+    /*!
+     * \brief clear удаление всех слотов
+     */
+    void clear()
+    {
+        id.clear();
+        latitude.clear();
+        longitude.clear();
+        altitude.clear();
+        speed.clear();
+        course.clear();
+        lastSeen.clear();
+        state.clear();
+        inUse.clear();
+        released.clear();
+        releasedMark.clear();
+    }
+};
+
+#endif // STATECOLUMNS_H
@@ -0,0 +1,54 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <stddef.h>
+
+///< размер строки кэша для разнесения счетчиков разных потоков
+constexpr size_t PIPELINE_CACHE_LINE = 64;
+
+/*!
+ * \brief The BoundedQueue class
+ * Интерфейс ограниченной очереди без блокировок между стадиями
+ * конвейера. Операции не ожидают: при переполнении или отсутствии
+ * данных возвращается false, решение о повторе принимает стадия
+ * \author Данильченко Артем
+ */
+template<typename T>
+class BoundedQueue
+{
+public:
+    virtual ~BoundedQueue(){}
+    /*!
+     * \brief tryPush постановка элемента в очередь
+     * \param item - элемент, при успехе перемещается в очередь
+     * \return false - очередь заполнена, элемент не изменен
+     */
+    virtual bool tryPush(T& item) = 0;
+    /*!
+     * \brief tryPop извлечение элемента из очереди
+     * \return false - очередь пуста
+     */
+    virtual bool tryPop(T& item) = 0;
+    /*!
+     * \brief size приблизительное количество элементов в очереди
+     */
+    virtual int size() const = 0;
+    /*!
+     * \brief capacity емкость очереди
+     */
+    virtual int capacity() const = 0;
+
+protected:
+    /*!
+     * \brief roundCapacity округление емкости вверх до степени двойки
+     */
+    static int roundCapacity(int capacity)
+    {
+        int value = 2;
+        while(value < capacity)
+            value <<= 1;
+        return value;
+    }
+};
+
+#endif // BOUNDEDQUEUE_H
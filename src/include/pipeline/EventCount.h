@@ -0,0 +1,139 @@
+#ifndef EVENTCOUNT_H
+#define EVENTCOUNT_H
+
+#include <stdint.h>
+#include <atomic>
+
+#include "time/Clock.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/*!
+ * \brief The EventCount class
+ * Ожидание события для очередей без блокировок. Ожидающий поток
+ * регистрируется, повторно проверяет очередь и засыпает на futex,
+ * только если номер события не изменился. Уведомление без ожидающих
+ * потоков стоит одной атомарной операции чтения, системный вызов
+ * выполняется только при наличии ожидающих.
+ *
+ * Порядок использования ожидающим потоком:
+ * \code
+ * const uint32_t key = event.prepareWait();
+ * if(queue.tryPop(item))
+ *     event.cancelWait();
+ * else
+ *     event.wait(key, timeout);
+ * \endcode
+ * Время последнего уведомления с ожидающими потоками сохраняется:
+ * по нему пробужденный поток измеряет задержку планировщика
+ * от уведомления до начала своего выполнения
+ * \author Данильченко Артем
+ */
+class EventCount
+{
+    std::atomic<uint32_t> _epoch;
+    std::atomic<int32_t> _waiters;
+    ///< время последнего уведомления, нс монотонных часов
+    std::atomic<int64_t> _notified;
+
+#if !defined(__linux__)
+    std::mutex _mutex;
+    std::condition_variable _condition;
+#endif
+
+    void wake(int count)
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch),
+                FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(count == 1)
+            _condition.notify_one();
+        else
+            _condition.notify_all();
+#endif
+    }
+
+    void notify(int count)
+    {
+        //изменение очереди должно быть видно до проверки ожидающих
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(_waiters.load(std::memory_order_seq_cst) == 0)
+            return;
+
+        _notified.store(Clock::monotonicNSec(), std::memory_order_relaxed);
+        _epoch.fetch_add(1, std::memory_order_seq_cst);
+        wake(count);
+    }
+
+public:
+    EventCount() : _epoch(0), _waiters(0), _notified(0) {}
+
+    /*!
+     * \brief prepareWait регистрация ожидающего потока
+     * \return номер события для wait
+     */
+    uint32_t prepareWait()
+    {
+        _waiters.fetch_add(1, std::memory_order_seq_cst);
+        return _epoch.load(std::memory_order_seq_cst);
+    }
+    /*!
+     * \brief cancelWait отмена ожидания после успешной повторной проверки
+     */
+    void cancelWait()
+    {
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+    /*!
+     * \brief wait ожидание уведомления
+     * \param key - номер события, полученный prepareWait
+     * \param timeoutUSec - предельное время ожидания, мкс
+     * \return true - поток спал и разбужен уведомлением
+     */
+    bool wait(uint32_t key, int64_t timeoutUSec)
+    {
+#if defined(__linux__)
+        timespec timeout;
+        timeout.tv_sec = time_t(timeoutUSec / 1000000);
+        timeout.tv_nsec = long((timeoutUSec % 1000000) * 1000);
+        //при изменившемся номере события вызов сразу возвращает EAGAIN
+        const bool woken = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch),
+                                   FUTEX_WAIT_PRIVATE, key, &timeout, nullptr, 0) == 0;
+#else
+        std::unique_lock<std::mutex> lock(_mutex);
+        const bool woken = _condition.wait_for(lock, std::chrono::microseconds(timeoutUSec),
+                                               [this, key]()
+        {
+            return _epoch.load(std::memory_order_seq_cst) != key;
+        });
+#endif
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        return woken;
+    }
+    /*!
+     * \brief notifiedAt время последнего уведомления, нс монотонных часов.
+     * При нескольких уведомлениях подряд - время последнего из них
+     */
+    int64_t notifiedAt() const { return _notified.load(std::memory_order_relaxed); }
+    /*!
+     * \brief notifyOne пробуждение одного ожидающего потока
+     */
+    void notifyOne() { notify(1); }
+    /*!
+     * \brief notifyAll пробуждение всех ожидающих потоков
+     */
+    void notifyAll() { notify(INT32_MAX); }
+};
+
+#endif // EVENTCOUNT_H
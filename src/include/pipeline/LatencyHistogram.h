@@ -0,0 +1,101 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <stdint.h>
+#include <atomic>
+
+#include "pipeline/StageConfig.h"
+
+/*!
+ * \brief The LatencyHistogram class
+ * Гистограмма задержек с интервалами по степеням двойки микросекунд.
+ * Добавление значения - несколько атомарных операций без блокировок,
+ * допускается из нескольких потоков
+ * \author Данильченко Артем
+ */
+class LatencyHistogram
+{
+    ///< интервал i содержит значения [2^i - 1, 2^(i+1) - 1) мкс
+    static constexpr int BUCKETS = 40;
+
+    std::atomic<uint64_t> _buckets[BUCKETS];
+    std::atomic<uint64_t> _count;
+    std::atomic<uint64_t> _sum;
+    std::atomic<int64_t> _max;
+
+    static int bucket(int64_t usec)
+    {
+        uint64_t value = uint64_t(usec) + 1;
+        int index = 0;
+        while(value > 1 && index < BUCKETS - 1)
+        {
+            value >>= 1;
+            index++;
+        }
+        return index;
+    }
+
+    int64_t percentile(uint64_t count, double fraction) const
+    {
+        const uint64_t rank = uint64_t(double(count) * fraction);
+        uint64_t sum = 0;
+        for(int i = 0; i < BUCKETS; i++)
+        {
+            sum += _buckets[i].load(std::memory_order_relaxed);
+            if(sum > rank)
+            {
+                const int64_t upper = (int64_t(1) << (i + 1)) - 1;
+                const int64_t max = _max.load(std::memory_order_relaxed);
+                return (upper < max) ? upper : max;
+            }
+        }
+        return _max.load(std::memory_order_relaxed);
+    }
+
+public:
+    LatencyHistogram() : _count(0), _sum(0), _max(0)
+    {
+        for(int i = 0; i < BUCKETS; i++)
+            _buckets[i].store(0, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief add учет значения задержки
+     * \param usec - задержка, мкс
+     */
+    void add(int64_t usec)
+    {
+        if(usec < 0)
+            usec = 0;
+
+        _buckets[bucket(usec)].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(uint64_t(usec), std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t max = _max.load(std::memory_order_relaxed);
+        while(usec > max &&
+              !_max.compare_exchange_weak(max, usec, std::memory_order_relaxed))
+        {
+        }
+    }
+    /*!
+     * \brief stats значения с начала измерений. Счетчики читаются
+     * независимо, при параллельном добавлении возможна погрешность
+     * в одно значение
+     */
+    LatencyStats stats() const
+    {
+        LatencyStats stats;
+        stats.count = _count.load(std::memory_order_relaxed);
+        if(stats.count == 0)
+            return stats;
+
+        stats.average = double(_sum.load(std::memory_order_relaxed)) / double(stats.count);
+        stats.p50 = percentile(stats.count, 0.5);
+        stats.p99 = percentile(stats.count, 0.99);
+        stats.max = _max.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+#endif // LATENCYHISTOGRAM_H
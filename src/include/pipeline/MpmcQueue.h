@@ -0,0 +1,115 @@
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#include "pipeline/BoundedQueue.h"
+
+/*!
+ * \brief The MpmcQueue class
+ * Ограниченная очередь без блокировок для нескольких производителей
+ * и потребителей (алгоритм Д. Вьюкова). Каждая ячейка хранит номер
+ * последовательности: по нему производитель определяет, что ячейка
+ * свободна, а потребитель - что данные записаны. Используется там,
+ * где нельзя применить SpscQueue: список свободных блоков, в который
+ * блоки возвращают потоки всех стадий, и вход стадии с несколькими
+ * потоками обработки, например стадии выдачи
+ * \author Данильченко Артем
+ */
+template<typename T>
+class MpmcQueue : public BoundedQueue<T>
+{
+    struct Cell
+    {
+        std::atomic<uint64_t> sequence;
+        T data;
+    };
+
+    std::vector<Cell> _cells;
+    const uint64_t _mask;
+
+    char _padTail[PIPELINE_CACHE_LINE];
+    std::atomic<uint64_t> _tail;
+    char _padHead[PIPELINE_CACHE_LINE];
+    std::atomic<uint64_t> _head;
+    char _padEnd[PIPELINE_CACHE_LINE];
+
+public:
+    /*!
+     * \brief MpmcQueue конструктор
+     * \param capacity - емкость, округляется вверх до степени двойки
+     */
+    explicit MpmcQueue(int capacity) :
+        _cells(size_t(BoundedQueue<T>::roundCapacity(capacity))),
+        _mask(uint64_t(BoundedQueue<T>::roundCapacity(capacity)) - 1),
+        _tail(0),
+        _head(0)
+    {
+        for(size_t i = 0; i < _cells.size(); i++)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool tryPush(T& item) override
+    {
+        uint64_t pos = _tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for(;;)
+        {
+            cell = &_cells[size_t(pos & _mask)];
+            const uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+            const int64_t diff = int64_t(seq) - int64_t(pos);
+            if(diff == 0)
+            {
+                if(_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+                return false;
+            else
+                pos = _tail.load(std::memory_order_relaxed);
+        }
+
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item) override
+    {
+        uint64_t pos = _head.load(std::memory_order_relaxed);
+        Cell* cell;
+        for(;;)
+        {
+            cell = &_cells[size_t(pos & _mask)];
+            const uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+            const int64_t diff = int64_t(seq) - int64_t(pos + 1);
+            if(diff == 0)
+            {
+                if(_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+                return false;
+            else
+                pos = _head.load(std::memory_order_relaxed);
+        }
+
+        item = std::move(cell->data);
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    int size() const override
+    {
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        const uint64_t tail = _tail.load(std::memory_order_acquire);
+        return (tail > head) ? int(tail - head) : 0;
+    }
+
+    int capacity() const override { return int(_mask + 1); }
+};
+
+#endif // MPMCQUEUE_H
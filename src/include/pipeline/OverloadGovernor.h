@@ -0,0 +1,313 @@
+#ifndef OVERLOADGOVERNOR_H
+#define OVERLOADGOVERNOR_H
+
+#include <stdint.h>
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+/*!
+ * \brief The DEGRADATION_LEVEL enum
+ * Ступени упрощения обработки при перегрузке. Ступени накопительные:
+ * каждая следующая включает отключения предыдущих
+ */
+enum class DEGRADATION_LEVEL : uint8_t
+{
+    FULL = 0,               ///< все алгоритмы включены
+    NO_TWO_BITS_FIX,        ///< без исправления двухбитовых ошибок
+    NO_PHASE_CORRECTION,    ///< без повторной демодуляции с коррекцией фазы
+    NO_DSP                  ///< без расчета спектра
+};
+
+/*!
+ * @brief  Пороги перехода между ступенями упрощения
+ */
+struct OverloadConfig
+{
+    ///< контроль перегрузки включен
+    bool enabled = true;
+    ///< ступень NO_TWO_BITS_FIX пропускается: вне агрессивного режима
+    ///< двухбитовые ошибки не исправляются, и ступень не снижает нагрузку
+    bool skipTwoBitsFix = false;
+    ///< период оценки загрузки, мкс
+    int64_t periodUs = 1000000;
+    ///< отставание, при котором обработка упрощается, мкс
+    int64_t degradeBacklogUs = 250000;
+    ///< отставание, при котором есть запас для восстановления, мкс
+    int64_t recoverBacklogUs = 50000;
+    ///< доля потерянных за период блоков, при которой обработка упрощается
+    double degradeDropRatio = 0.02;
+    ///< минимальный интервал между упрощениями, мкс
+    int64_t degradeHoldUs = 2000000;
+    ///< время работы с запасом до возврата на ступень выше, мкс
+    int64_t recoverHoldUs = 10000000;
+    ///< окно поиска минимального отставания (опорного уровня), мкс
+    int64_t baselineWindowUs = 30000000;
+};
+
+/*!
+ * @brief  Состояние контроля перегрузки
+ */
+struct OverloadStats
+{
+    ///< текущая ступень упрощения
+    DEGRADATION_LEVEL level = DEGRADATION_LEVEL::FULL;
+    ///< отставание часов дискретизации от монотонных часов
+    ///< для последнего обработанного блока, мкс
+    int64_t lagUs = 0;
+    ///< отставание сверх опорного уровня, максимум за период, мкс
+    int64_t backlogUs = 0;
+    ///< максимальное отставание сверх опорного уровня, мкс
+    int64_t maxBacklogUs = 0;
+    ///< доля потерянных блоков за последний период
+    double dropRatio = 0.0;
+    ///< количество упрощений и восстановлений
+    uint64_t degradations = 0;
+    uint64_t recoveries = 0;
+    ///< периодов с перегрузкой
+    uint64_t overloadedPeriods = 0;
+};
+
+/*!
+ * \brief The OverloadGovernor class
+ * Обнаружение перегрузки демодуляции и выбор ступени упрощения.
+ * Для каждого обработанного блока сравнивается время по часам
+ * дискретизации (количество прочитанных отсчетов) с монотонным
+ * временем окончания обработки. Разность содержит постоянную часть -
+ * задержку конвейера и потерянные ранее отсчеты, поэтому перегрузка
+ * оценивается по превышению минимума разности за окно (опорного уровня).
+ * Признаки перегрузки за период: превышение отставания или потеря
+ * блоков до демодуляции. При перегрузке обработка упрощается на одну
+ * ступень не чаще degradeHoldUs, при запасе в течение recoverHoldUs -
+ * восстанавливается на одну ступень; отключенная ступень
+ * (OverloadConfig::skipTwoBitsFix) пропускается в обоих направлениях.
+ * update вызывается одним потоком (демодуляции), level и stats -
+ * из любого потока
+ * \author Данильченко Артем
+ */
+class OverloadGovernor
+{
+    OverloadConfig _config;
+    std::atomic<uint8_t> _level;
+
+    ///< начало текущего периода оценки, нс
+    int64_t _periodStart = 0;
+    ///< счетчики блоков на начало периода
+    uint64_t _periodBlocks = 0;
+    uint64_t _periodDropped = 0;
+    ///< максимальное отставание за период, нс
+    int64_t _periodMaxLag = std::numeric_limits<int64_t>::min();
+
+    ///< опорный уровень и минимум текущего окна, нс
+    int64_t _baseline = 0;
+    int64_t _windowMin = 0;
+    int64_t _windowStart = 0;
+    bool _hasBaseline = false;
+
+    ///< время последнего перехода и начала работы с запасом, нс
+    int64_t _transitionTime = 0;
+    int64_t _headroomSince = -1;
+
+    mutable std::mutex _statsMutex;
+    OverloadStats _stats;
+
+    static constexpr int64_t NSEC_PER_USEC = 1000;
+
+    void updateBaseline(int64_t lag, int64_t now)
+    {
+        if(!_hasBaseline)
+        {
+            _baseline = lag;
+            _windowMin = lag;
+            _windowStart = now;
+            _hasBaseline = true;
+            return;
+        }
+
+        if(lag < _baseline)
+            _baseline = lag;
+        if(lag < _windowMin)
+            _windowMin = lag;
+
+        //постоянный сдвиг (потерянные в приемнике отсчеты, повторное
+        //открытие устройства) принимается за новый опорный уровень
+        if(now - _windowStart >= _config.baselineWindowUs * NSEC_PER_USEC)
+        {
+            _baseline = _windowMin;
+            _windowMin = lag;
+            _windowStart = now;
+        }
+    }
+
+    /*!
+     * \brief step соседняя ступень с пропуском отключенной
+     * \param direction - 1 - упрощение, -1 - восстановление
+     */
+    DEGRADATION_LEVEL step(DEGRADATION_LEVEL level, int direction) const
+    {
+        level = DEGRADATION_LEVEL(int(level) + direction);
+        if(level == DEGRADATION_LEVEL::NO_TWO_BITS_FIX && _config.skipTwoBitsFix)
+            level = DEGRADATION_LEVEL(int(level) + direction);
+        return level;
+    }
+
+    bool evaluate(uint64_t blocks, uint64_t dropped, int64_t now)
+    {
+        const uint64_t periodBlocks = blocks - _periodBlocks;
+        const uint64_t periodDropped = dropped - _periodDropped;
+        const double dropRatio = (periodBlocks > 0) ? double(periodDropped) / double(periodBlocks)
+                                                    : 0.0;
+        const int64_t backlog = (_periodMaxLag - _baseline) / NSEC_PER_USEC;
+
+        const bool overloaded = backlog > _config.degradeBacklogUs ||
+                dropRatio > _config.degradeDropRatio;
+        const bool headroom = backlog < _config.recoverBacklogUs && periodDropped == 0;
+
+        DEGRADATION_LEVEL level = DEGRADATION_LEVEL(_level.load(std::memory_order_relaxed));
+        bool degraded = false;
+        bool recovered = false;
+
+        if(overloaded)
+        {
+            _headroomSince = -1;
+            if(level < DEGRADATION_LEVEL::NO_DSP &&
+                    now - _transitionTime >= _config.degradeHoldUs * NSEC_PER_USEC)
+            {
+                level = step(level, 1);
+                degraded = true;
+            }
+        }
+        else if(headroom)
+        {
+            if(_headroomSince < 0)
+                _headroomSince = now;
+
+            if(level > DEGRADATION_LEVEL::FULL &&
+                    now - _headroomSince >= _config.recoverHoldUs * NSEC_PER_USEC)
+            {
+                level = step(level, -1);
+                recovered = true;
+                //следующая ступень - после нового интервала с запасом
+                _headroomSince = now;
+            }
+        }
+        else
+            _headroomSince = -1;
+
+        if(degraded || recovered)
+        {
+            _transitionTime = now;
+            _level.store(uint8_t(level), std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        _stats.level = level;
+        _stats.backlogUs = backlog;
+        if(backlog > _stats.maxBacklogUs)
+            _stats.maxBacklogUs = backlog;
+        _stats.dropRatio = dropRatio;
+        if(overloaded)
+            _stats.overloadedPeriods++;
+        if(degraded)
+            _stats.degradations++;
+        if(recovered)
+            _stats.recoveries++;
+
+        return degraded || recovered;
+    }
+
+public:
+    explicit OverloadGovernor(const OverloadConfig& config = OverloadConfig()) :
+        _config(config),
+        _level(uint8_t(DEGRADATION_LEVEL::FULL))
+    {
+    }
+
+    /*!
+     * \brief reset начало контроля с полной обработки, счетчики сохраняются
+     * \param config - пороги перехода
+     * \param now - текущее время, нс монотонных часов
+     */
+    void reset(const OverloadConfig& config, int64_t now)
+    {
+        _config = config;
+        _level.store(uint8_t(DEGRADATION_LEVEL::FULL), std::memory_order_relaxed);
+        _periodStart = now;
+        _periodBlocks = 0;
+        _periodDropped = 0;
+        _periodMaxLag = std::numeric_limits<int64_t>::min();
+        _hasBaseline = false;
+        _transitionTime = now;
+        _headroomSince = -1;
+
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        _stats.level = DEGRADATION_LEVEL::FULL;
+        _stats.backlogUs = 0;
+        _stats.dropRatio = 0.0;
+    }
+    /*!
+     * \brief update учет обработанного блока
+     * \param lag - отставание часов дискретизации для блока, нс
+     * \param blocks - прочитано блоков с начала работы, включая потерянные
+     * \param dropped - потеряно блоков до демодуляции с начала работы
+     * \param now - текущее время, нс монотонных часов
+     * \return true - ступень упрощения изменилась
+     */
+    bool update(int64_t lag, uint64_t blocks, uint64_t dropped, int64_t now)
+    {
+        updateBaseline(lag, now);
+        if(lag > _periodMaxLag)
+            _periodMaxLag = lag;
+
+        {
+            std::lock_guard<std::mutex> lock(_statsMutex);
+            _stats.lagUs = lag / NSEC_PER_USEC;
+        }
+
+        if(!_config.enabled || now - _periodStart < _config.periodUs * NSEC_PER_USEC)
+            return false;
+
+        const bool changed = evaluate(blocks, dropped, now);
+
+        _periodStart = now;
+        _periodBlocks = blocks;
+        _periodDropped = dropped;
+        _periodMaxLag = std::numeric_limits<int64_t>::min();
+        return changed;
+    }
+    /*!
+     * \brief level текущая ступень упрощения
+     */
+    DEGRADATION_LEVEL level() const
+    {
+        return DEGRADATION_LEVEL(_level.load(std::memory_order_relaxed));
+    }
+    /*!
+     * \brief stats состояние контроля перегрузки
+     */
+    OverloadStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        return _stats;
+    }
+    /*!
+     * \brief levelName название ступени для журнала и метрик
+     */
+    static const char* levelName(DEGRADATION_LEVEL level)
+    {
+        switch(level)
+        {
+        case DEGRADATION_LEVEL::FULL:
+            return "full";
+        case DEGRADATION_LEVEL::NO_TWO_BITS_FIX:
+            return "no_two_bits_fix";
+        case DEGRADATION_LEVEL::NO_PHASE_CORRECTION:
+            return "no_phase_correction";
+        case DEGRADATION_LEVEL::NO_DSP:
+            return "no_dsp";
+        }
+        return "unknown";
+    }
+};
+
+#endif // OVERLOADGOVERNOR_H
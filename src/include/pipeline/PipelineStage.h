@@ -0,0 +1,452 @@
+#ifndef PIPELINESTAGE_H
+#define PIPELINESTAGE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QThread>
+
+#include "pipeline/StageConfig.h"
+#include "pipeline/SpscQueue.h"
+#include "pipeline/MpmcQueue.h"
+#include "pipeline/EventCount.h"
+#include "pipeline/LatencyHistogram.h"
+#include "pipeline/ThreadPlacement.h"
+#include "time/Clock.h"
+
+/*!
+ * \brief The StageThread class
+ * Поток стадии конвейера, выполняющий переданную функцию
+ */
+class StageThread : public QThread
+{
+    std::function<void()> _body;
+
+public:
+    explicit StageThread(const std::function<void()>& body) : _body(body) {}
+
+protected:
+    void run() override { _body(); }
+};
+
+/*!
+ * \brief The PipelineStageBase class
+ * Общая часть стадии конвейера: потоки обработки и счетчики.
+ * Стадия не владеет обрабатываемыми элементами - неиспользованный
+ * элемент возвращается владельцу функцией освобождения.
+ * Каждый поток при запуске применяет к себе размещение из параметров
+ * стадии и сохраняет фактическое размещение для отчета
+ * \author Данильченко Артем
+ */
+class PipelineStageBase
+{
+    std::vector<std::unique_ptr<StageThread>> _threads;
+    ///< фактическое размещение потоков текущего запуска
+    QVector<PlacementReport> _placement;
+    mutable std::mutex _placementMutex;
+
+    /*!
+     * \brief place применение размещения к потоку обработки
+     */
+    void place(int index)
+    {
+        const QString name = (_config.threads > 1) ? QString("%1#%2").arg(_name).arg(index)
+                                                   : _name;
+        const PlacementReport report = ThreadPlacer::apply(name, _config.placement);
+
+        std::lock_guard<std::mutex> lock(_placementMutex);
+        _placement.append(report);
+    }
+
+protected:
+    ///< количество повторных проверок перед засыпанием потока
+    static constexpr int SPIN_COUNT = 16;
+    ///< предельное время ожидания события, мкс. Поток просыпается
+    ///< по уведомлению, предел только страхует проверку остановки
+    static constexpr int64_t WAIT_TIMEOUT_US = 100000;
+
+    const QString _name;
+    const StageConfig _config;
+
+    std::atomic<bool> _running;
+    std::atomic<uint64_t> _processed;
+    std::atomic<uint64_t> _dropped;
+    std::atomic<uint64_t> _waits;
+    ///< задержка от начала конвейера до завершения обработки стадией
+    LatencyHistogram _latency;
+    ///< задержка от уведомления до выполнения разбуженного потока
+    LatencyHistogram _wakeup;
+
+    /*!
+     * \brief work цикл потока обработки, выполняется до остановки стадии
+     */
+    virtual void work() = 0;
+    /*!
+     * \brief drain освобождение элементов, оставшихся после остановки
+     */
+    virtual void drain() {}
+    /*!
+     * \brief queued количество элементов во входной очереди
+     */
+    virtual int queued() const { return 0; }
+    /*!
+     * \brief wakeAll пробуждение всех ожидающих потоков при остановке
+     */
+    virtual void wakeAll() {}
+
+public:
+    PipelineStageBase(const QString& name, const StageConfig& config) :
+        _name(name),
+        _config(config),
+        _running(false),
+        _processed(0),
+        _dropped(0),
+        _waits(0)
+    {
+    }
+
+    virtual ~PipelineStageBase() {}
+
+    /*!
+     * \brief start запуск потоков обработки
+     */
+    void start()
+    {
+        if(_running)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_placementMutex);
+            _placement.clear();
+        }
+
+        _running = true;
+        for(int i = 0; i < qMax(1, _config.threads); i++)
+        {
+            _threads.emplace_back(new StageThread([this, i]()
+            {
+                place(i);
+                work();
+            }));
+            _threads.back()->setObjectName(_name);
+            _threads.back()->start();
+        }
+    }
+    /*!
+     * \brief stop остановка потоков обработки. Элементы, оставшиеся
+     * в очереди, освобождаются без обработки. Стадии останавливаются
+     * от источника к выходу, чтобы в остановленную стадию не поступали
+     * новые элементы
+     */
+    void stop()
+    {
+        _running = false;
+        wakeAll();
+        for(auto& thread : _threads)
+            thread->wait();
+        _threads.clear();
+        drain();
+    }
+    /*!
+     * \brief isRunning стадия запущена
+     */
+    bool isRunning() const { return _running; }
+    /*!
+     * \brief name название стадии
+     */
+    const QString& name() const { return _name; }
+    /*!
+     * \brief countDropped учет элемента, отброшенного стадией
+     */
+    void countDropped() { _dropped.fetch_add(1, std::memory_order_relaxed); }
+    /*!
+     * \brief processed обработано элементов, без расчета остальных счетчиков
+     */
+    uint64_t processed() const { return _processed.load(std::memory_order_relaxed); }
+    /*!
+     * \brief dropped отброшено элементов, без расчета остальных счетчиков
+     */
+    uint64_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+    /*!
+     * \brief stats счетчики стадии, допускается вызов из любого потока
+     */
+    StageStats stats() const
+    {
+        StageStats stats;
+        stats.name = _name;
+        stats.threads = qMax(1, _config.threads);
+        stats.queued = queued();
+        stats.processed = _processed.load(std::memory_order_relaxed);
+        stats.dropped = _dropped.load(std::memory_order_relaxed);
+        stats.waits = _waits.load(std::memory_order_relaxed);
+        stats.latency = _latency.stats();
+        stats.wakeup = _wakeup.stats();
+        return stats;
+    }
+    /*!
+     * \brief placement фактическое размещение потоков обработки,
+     * допускается вызов из любого потока
+     */
+    QVector<PlacementReport> placement() const
+    {
+        std::lock_guard<std::mutex> lock(_placementMutex);
+        return _placement;
+    }
+};
+
+/*!
+ * \brief The PipelineNode class
+ * Стадия, передающая обработанные элементы следующей стадии
+ */
+template<typename T>
+class PipelineNode : public PipelineStageBase
+{
+public:
+    using Release = std::function<void(T&)>;
+    ///< время поступления элемента в конвейер, нс монотонных часов
+    using Timestamp = std::function<int64_t(const T&)>;
+
+    /*!
+     * \brief push постановка элемента во входную очередь стадии
+     * с учетом поведения при переполнении. Вызывается потоками
+     * предыдущей стадии
+     * \return false - элемент не принят и остается у вызывающего
+     */
+    virtual bool push(T& item) = 0;
+    /*!
+     * \brief setNext следующая стадия, nullptr - стадия последняя
+     */
+    void setNext(PipelineNode<T>* next) { _next = next; }
+    /*!
+     * \brief setRelease функция освобождения элемента, завершившего
+     * обработку или отброшенного
+     */
+    void setRelease(const Release& release) { _release = release; }
+    /*!
+     * \brief setLatencyProbe измерение задержки от поступления элемента
+     * в конвейер до завершения его обработки стадией
+     * \param timestamp - функция получения времени поступления элемента
+     */
+    void setLatencyProbe(const Timestamp& timestamp) { _timestamp = timestamp; }
+
+protected:
+    PipelineNode<T>* _next = nullptr;
+    Release _release;
+    Timestamp _timestamp;
+
+    PipelineNode(const QString& name, const StageConfig& config) :
+        PipelineStageBase(name, config) {}
+
+    /*!
+     * \brief forward передача обработанного элемента дальше
+     * \param accepted - результат обработки, false - элемент не передается
+     */
+    void forward(T& item, bool accepted)
+    {
+        if(accepted && _timestamp)
+            this->_latency.add((Clock::monotonicNSec() - _timestamp(item)) / 1000);
+
+        if(accepted && _next != nullptr && _next->push(item))
+            return;
+
+        if(_release)
+            _release(item);
+    }
+};
+
+/*!
+ * \brief The PipelineSource class
+ * Первая стадия конвейера: элементы формируются функцией-источником,
+ * входной очереди нет. Источник может ожидать данные внутри функции
+ */
+template<typename T>
+class PipelineSource : public PipelineNode<T>
+{
+public:
+    ///< формирование элемента, false - элемент не сформирован
+    using Producer = std::function<bool(T&)>;
+
+    PipelineSource(const QString& name, const StageConfig& config, const Producer& producer) :
+        PipelineNode<T>(name, config),
+        _producer(producer)
+    {
+    }
+
+    /*!
+     * \brief push источник не принимает элементы
+     */
+    bool push(T&) override { return false; }
+
+protected:
+    Producer _producer;
+
+    void work() override
+    {
+        while(this->_running)
+        {
+            T item = T();
+            if(!_producer(item))
+                continue;
+
+            this->_processed.fetch_add(1, std::memory_order_relaxed);
+            this->forward(item, true);
+        }
+    }
+};
+
+/*!
+ * \brief The PipelineStage class
+ * Стадия конвейера с входной очередью и пулом потоков обработки.
+ * При одном производителе и одном потоке обработки используется
+ * SpscQueue, иначе - MpmcQueue. При нескольких потоках функция
+ * обработки вызывается параллельно и должна это допускать.
+ * Свободные потоки обработки и ожидающие места производители спят
+ * на futex (EventCount) и пробуждаются только при изменении очереди
+ */
+template<typename T>
+class PipelineStage : public PipelineNode<T>
+{
+public:
+    ///< обработка элемента, false - элемент не передается следующей стадии
+    using Handler = std::function<bool(T&)>;
+
+    /*!
+     * \brief PipelineStage конструктор
+     * \param name - название стадии
+     * \param config - потоки, емкость очереди и поведение при переполнении
+     * \param producers - количество потоков предыдущей стадии
+     * \param handler - функция обработки
+     */
+    PipelineStage(const QString& name,
+                  const StageConfig& config,
+                  int producers,
+                  const Handler& handler) :
+        PipelineNode<T>(name, config),
+        _handler(handler)
+    {
+        if(producers <= 1 && config.threads <= 1)
+            _queue.reset(new SpscQueue<T>(config.capacity));
+        else
+            _queue.reset(new MpmcQueue<T>(config.capacity));
+    }
+
+    /*!
+     * \brief capacity емкость входной очереди после округления
+     */
+    int capacity() const { return _queue->capacity(); }
+
+    bool push(T& item) override
+    {
+        if(_queue->tryPush(item))
+        {
+            _notEmpty.notifyOne();
+            return true;
+        }
+
+        if(this->_config.policy == OVERFLOW_POLICY::DROP)
+        {
+            this->countDropped();
+            return false;
+        }
+
+        //противодавление: производитель ожидает освобождения места
+        this->_waits.fetch_add(1, std::memory_order_relaxed);
+        while(this->_running)
+        {
+            const uint32_t key = _notFull.prepareWait();
+            if(_queue->tryPush(item))
+            {
+                _notFull.cancelWait();
+                _notEmpty.notifyOne();
+                return true;
+            }
+            if(!this->_running)
+            {
+                _notFull.cancelWait();
+                break;
+            }
+            _notFull.wait(key, PipelineStageBase::WAIT_TIMEOUT_US);
+        }
+        return false;
+    }
+
+protected:
+    Handler _handler;
+    std::unique_ptr<BoundedQueue<T>> _queue;
+    ///< в очереди появился элемент
+    EventCount _notEmpty;
+    ///< в очереди освободилось место
+    EventCount _notFull;
+
+    /*!
+     * \brief pop извлечение элемента: короткое ожидание без сна,
+     * затем сон до уведомления производителя
+     * \return false - стадия остановлена
+     */
+    bool pop(T& item)
+    {
+        for(int i = 0; i < PipelineStageBase::SPIN_COUNT; i++)
+        {
+            if(_queue->tryPop(item))
+                return true;
+            QThread::yieldCurrentThread();
+        }
+
+        while(this->_running)
+        {
+            const uint32_t key = _notEmpty.prepareWait();
+            if(_queue->tryPop(item))
+            {
+                _notEmpty.cancelWait();
+                return true;
+            }
+            //остановка после регистрации видна здесь или будит wakeAll
+            if(!this->_running)
+            {
+                _notEmpty.cancelWait();
+                break;
+            }
+            if(_notEmpty.wait(key, PipelineStageBase::WAIT_TIMEOUT_US))
+                this->_wakeup.add((Clock::monotonicNSec() - _notEmpty.notifiedAt()) / 1000);
+        }
+        return false;
+    }
+
+    void work() override
+    {
+        T item = T();
+        while(this->_running)
+        {
+            if(!pop(item))
+                continue;
+
+            _notFull.notifyOne();
+            const bool accepted = _handler(item);
+            this->_processed.fetch_add(1, std::memory_order_relaxed);
+            this->forward(item, accepted);
+        }
+    }
+
+    void wakeAll() override
+    {
+        _notEmpty.notifyAll();
+        _notFull.notifyAll();
+    }
+
+    void drain() override
+    {
+        T item = T();
+        while(_queue->tryPop(item))
+        {
+            if(this->_release)
+                this->_release(item);
+        }
+    }
+
+    int queued() const override { return _queue->size(); }
+};
+
+#endif // PIPELINESTAGE_H
@@ -0,0 +1,88 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#include "pipeline/BoundedQueue.h"
+
+/*!
+ * \brief The SpscQueue class
+ * Ограниченная очередь без блокировок для одного производителя
+ * и одного потребителя. Кольцевой буфер размером 2^n, производитель
+ * изменяет только _tail, потребитель - только _head
+ * \author Данильченко Артем
+ */
+template<typename T>
+class SpscQueue : public BoundedQueue<T>
+{
+    std::vector<T> _buffer;
+    const uint64_t _mask;
+
+    ///< индексы разнесены по строкам кэша, чтобы потоки не мешали друг другу
+    char _padHead[PIPELINE_CACHE_LINE];
+    std::atomic<uint64_t> _head;
+    ///< копия _tail, известная потребителю
+    uint64_t _tailCache = 0;
+    char _padTail[PIPELINE_CACHE_LINE];
+    std::atomic<uint64_t> _tail;
+    ///< копия _head, известная производителю
+    uint64_t _headCache = 0;
+    char _padEnd[PIPELINE_CACHE_LINE];
+
+public:
+    /*!
+     * \brief SpscQueue конструктор
+     * \param capacity - емкость, округляется вверх до степени двойки
+     */
+    explicit SpscQueue(int capacity) :
+        _buffer(size_t(BoundedQueue<T>::roundCapacity(capacity))),
+        _mask(uint64_t(BoundedQueue<T>::roundCapacity(capacity)) - 1),
+        _head(0),
+        _tail(0)
+    {
+    }
+
+    bool tryPush(T& item) override
+    {
+        const uint64_t tail = _tail.load(std::memory_order_relaxed);
+        if(tail - _headCache > _mask)
+        {
+            _headCache = _head.load(std::memory_order_acquire);
+            if(tail - _headCache > _mask)
+                return false;
+        }
+
+        _buffer[size_t(tail & _mask)] = std::move(item);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item) override
+    {
+        const uint64_t head = _head.load(std::memory_order_relaxed);
+        if(head == _tailCache)
+        {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if(head == _tailCache)
+                return false;
+        }
+
+        item = std::move(_buffer[size_t(head & _mask)]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    int size() const override
+    {
+        //_head читается первым: _tail не может оказаться меньше
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        return int(_tail.load(std::memory_order_acquire) - head);
+    }
+
+    int capacity() const override { return int(_mask + 1); }
+};
+
+#endif // SPSCQUEUE_H
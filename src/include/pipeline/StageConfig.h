@@ -0,0 +1,77 @@
+#ifndef STAGECONFIG_H
+#define STAGECONFIG_H
+
+#include <stdint.h>
+#include <QString>
+
+#include "pipeline/ThreadPlacement.h"
+
+/*!
+ * \brief The OVERFLOW_POLICY enum
+ * Поведение стадии конвейера при заполненной входной очереди
+ */
+enum class OVERFLOW_POLICY : uint8_t
+{
+    DROP = 0,     ///< элемент отбрасывается, предыдущая стадия не ожидает
+    BLOCK         ///< предыдущая стадия ожидает освобождения места
+};
+
+/*!
+ * @brief  Параметры стадии конвейера
+ */
+struct StageConfig
+{
+    ///< количество потоков обработки
+    int threads = 1;
+    ///< емкость входной очереди
+    int capacity = 4;
+    ///< поведение при заполненной входной очереди
+    OVERFLOW_POLICY policy = OVERFLOW_POLICY::BLOCK;
+    ///< размещение потоков обработки
+    ThreadPlacement placement;
+
+    StageConfig() = default;
+    StageConfig(int threadsCount, int queueCapacity, OVERFLOW_POLICY overflow) :
+        threads(threadsCount), capacity(queueCapacity), policy(overflow) {}
+};
+
+/*!
+ * @brief  Задержка элементов от начала конвейера до завершения стадии, мкс
+ */
+struct LatencyStats
+{
+    ///< количество измерений
+    uint64_t count = 0;
+    ///< среднее значение
+    double average = 0.0;
+    ///< медиана и 99-й процентиль (верхняя граница интервала гистограммы)
+    int64_t p50 = 0;
+    int64_t p99 = 0;
+    ///< максимальное значение
+    int64_t max = 0;
+};
+
+/*!
+ * @brief  Счетчики стадии конвейера
+ */
+struct StageStats
+{
+    ///< название стадии
+    QString name;
+    ///< количество потоков обработки
+    int threads = 0;
+    ///< элементов во входной очереди
+    int queued = 0;
+    ///< обработано элементов
+    uint64_t processed = 0;
+    ///< отброшено элементов при заполненной очереди
+    uint64_t dropped = 0;
+    ///< ожиданий предыдущей стадии при заполненной очереди
+    uint64_t waits = 0;
+    ///< задержка от начала конвейера, если стадия ее измеряет
+    LatencyStats latency;
+    ///< задержка пробуждения потока обработки после уведомления
+    LatencyStats wakeup;
+};
+
+#endif // STAGECONFIG_H
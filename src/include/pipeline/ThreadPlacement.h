@@ -0,0 +1,226 @@
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+
+#include <stdint.h>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*!
+ * \brief The SCHED_CLASS enum
+ * Класс планирования потока
+ */
+enum class SCHED_CLASS : uint8_t
+{
+    NORMAL = 0,   ///< разделение времени (SCHED_OTHER) с уровнем nice
+    FIFO          ///< реальное время (SCHED_FIFO) с приоритетом
+};
+
+/*!
+ * @brief  Размещение потока: привязка к ядрам и планирование
+ */
+struct ThreadPlacement
+{
+    ///< допустимые ядра, пустой список - без привязки
+    QVector<int> cpus;
+    ///< класс планирования
+    SCHED_CLASS scheduling = SCHED_CLASS::NORMAL;
+    ///< приоритет SCHED_FIFO, 1..99
+    int priority = 0;
+    ///< уровень nice для SCHED_OTHER и при отказе в SCHED_FIFO
+    int nice = 0;
+
+    /*!
+     * \brief isDefault размещение не задано, поток не изменяется
+     */
+    bool isDefault() const
+    {
+        return cpus.isEmpty() && scheduling == SCHED_CLASS::NORMAL && nice == 0;
+    }
+};
+
+/*!
+ * @brief  Фактическое размещение потока после применения
+ */
+struct PlacementReport
+{
+    ///< название потока
+    QString name;
+    ///< идентификатор потока в системе
+    int64_t tid = 0;
+    ///< ядра, на которых поток может выполняться
+    QVector<int> cpus;
+    ///< класс планирования
+    SCHED_CLASS scheduling = SCHED_CLASS::NORMAL;
+    ///< приоритет SCHED_FIFO
+    int priority = 0;
+    ///< уровень nice
+    int nice = 0;
+    ///< запрошенное размещение применено не полностью
+    bool fallback = false;
+    ///< причины отказа
+    QStringList errors;
+};
+
+/*!
+ * \brief The ThreadPlacer class
+ * Применение размещения к текущему потоку. SCHED_FIFO и отрицательный
+ * nice требуют прав (CAP_SYS_NICE или RLIMIT_RTPRIO/RLIMIT_NICE):
+ * без них SCHED_FIFO заменяется уровнем nice, при отказе и в нем
+ * поток остается с прежним планированием. Отказ не прерывает работу,
+ * а отражается в отчете. Вне Linux размещение не поддерживается
+ * \author Данильченко Артем
+ */
+class ThreadPlacer
+{
+public:
+    ///< уровень nice вместо SCHED_FIFO, если nice не задан
+    static constexpr int FALLBACK_NICE = -10;
+
+    /*!
+     * \brief apply применение размещения к вызывающему потоку
+     * \param name - название потока для отчета
+     * \param placement - запрошенное размещение
+     * \return фактическое размещение
+     */
+    static PlacementReport apply(const QString& name, const ThreadPlacement& placement)
+    {
+#if defined(__linux__)
+        QStringList errors;
+        bool fallback = false;
+        const pid_t tid = pid_t(syscall(SYS_gettid));
+
+        if(!placement.cpus.isEmpty())
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for(int cpu : placement.cpus)
+            {
+                if(cpu >= 0 && cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &set);
+            }
+
+            const int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if(result != 0)
+            {
+                errors.append(QString("affinity: %1").arg(strerror(result)));
+                fallback = true;
+            }
+        }
+
+        int nice = placement.nice;
+        if(placement.scheduling == SCHED_CLASS::FIFO)
+        {
+            sched_param param;
+            memset(&param, 0, sizeof(param));
+            param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO),
+                                          placement.priority,
+                                          sched_get_priority_max(SCHED_FIFO));
+
+            const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if(result == 0)
+                nice = 0;
+            else
+            {
+                errors.append(QString("SCHED_FIFO: %1").arg(strerror(result)));
+                fallback = true;
+                if(nice == 0)
+                    nice = FALLBACK_NICE;
+            }
+        }
+
+        //в Linux nice относится к потоку, а не ко всему процессу
+        if(nice != 0 && setpriority(PRIO_PROCESS, id_t(tid), nice) != 0)
+        {
+            errors.append(QString("nice %1: %2").arg(nice).arg(strerror(errno)));
+            fallback = true;
+        }
+
+        PlacementReport report = current(name);
+        report.errors = errors;
+        report.fallback = fallback;
+        return report;
+#else
+        PlacementReport report = current(name);
+        if(!placement.isDefault())
+        {
+            report.errors.append(QString("thread placement is not supported"));
+            report.fallback = true;
+        }
+        return report;
+#endif
+    }
+    /*!
+     * \brief current размещение вызывающего потока
+     * \param name - название потока для отчета
+     */
+    static PlacementReport current(const QString& name)
+    {
+        PlacementReport report;
+        report.name = name;
+#if defined(__linux__)
+        const pid_t tid = pid_t(syscall(SYS_gettid));
+        report.tid = tid;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if(pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0)
+        {
+            for(int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+                if(CPU_ISSET(cpu, &set))
+                    report.cpus.append(cpu);
+            }
+        }
+
+        int policy = SCHED_OTHER;
+        sched_param param;
+        memset(&param, 0, sizeof(param));
+        if(pthread_getschedparam(pthread_self(), &policy, &param) == 0 &&
+                policy == SCHED_FIFO)
+        {
+            report.scheduling = SCHED_CLASS::FIFO;
+            report.priority = param.sched_priority;
+        }
+
+        errno = 0;
+        const int nice = getpriority(PRIO_PROCESS, id_t(tid));
+        if(errno == 0)
+            report.nice = nice;
+#endif
+        return report;
+    }
+    /*!
+     * \brief onlineCpus ядра, доступные вызывающему потоку.
+     * Вызывается до привязки потока - тогда это ядра процесса
+     */
+    static QVector<int> onlineCpus()
+    {
+        QVector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if(sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for(int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+                if(CPU_ISSET(cpu, &set))
+                    cpus.append(cpu);
+            }
+        }
+#endif
+        return cpus;
+    }
+};
+
+#endif // THREADPLACEMENT_H
@@ -0,0 +1,118 @@
+#include "ThreadPolicy.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QSettings>
+#include <QStringList>
+
+QVector<int> ThreadPolicy::parseCpus(const QStringList &list, bool *ok)
+{
+    QVector<int> cpus;
+    *ok = true;
+    for(const QString& item : list)
+    {
+        const QString value = item.trimmed();
+        if(value.isEmpty())
+            continue;
+
+        const QStringList range = value.split('-');
+        bool firstOk = false;
+        bool lastOk = false;
+        const int first = range.first().toInt(&firstOk);
+        const int last = (range.size() > 1) ? range.at(1).toInt(&lastOk) : first;
+        if(range.size() == 1)
+            lastOk = firstOk;
+
+        if(!firstOk || !lastOk || range.size() > 2 || first < 0 || last < first)
+        {
+            *ok = false;
+            continue;
+        }
+
+        for(int cpu = first; cpu <= last; cpu++)
+        {
+            if(!cpus.contains(cpu))
+                cpus.append(cpu);
+        }
+    }
+    return cpus;
+}
+
+ThreadPlacement ThreadPolicy::readPlacement(QSettings &settings, const QString &group)
+{
+    ThreadPlacement placement;
+    if(!settings.childGroups().contains(group))
+        return placement;
+
+    settings.beginGroup(group);
+
+    //значение "1,2" QSettings возвращает списком
+    bool ok = true;
+    placement.cpus = parseCpus(settings.value("cpus").toStringList(), &ok);
+    if(!ok)
+        qDebug()<<"thread policy"<<group<<"invalid cpus"<<settings.value("cpus");
+
+    const QString sched = settings.value("sched", "normal").toString().trimmed().toLower();
+    if(sched == "fifo")
+        placement.scheduling = SCHED_CLASS::FIFO;
+    else if(sched != "normal" && sched != "other")
+        qDebug()<<"thread policy"<<group<<"unknown sched"<<sched;
+
+    placement.priority = settings.value("priority", 0).toInt();
+    placement.nice = qBound(-20, settings.value("nice", 0).toInt(), 19);
+
+    settings.endGroup();
+    return placement;
+}
+
+bool ThreadPolicy::load(const QString &fileName, ThreadPolicy &policy)
+{
+    if(!QFile::exists(fileName))
+    {
+        qDebug()<<"thread policy file not found"<<fileName;
+        return false;
+    }
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    if(settings.status() != QSettings::NoError)
+    {
+        qDebug()<<"thread policy file format error"<<fileName;
+        return false;
+    }
+
+    policy.acquisition = readPlacement(settings, "acquisition");
+    policy.magnitude = readPlacement(settings, "magnitude");
+    policy.demodulation = readPlacement(settings, "demodulation");
+    policy.outputs = readPlacement(settings, "outputs");
+    policy.network = readPlacement(settings, "network");
+    policy.gui = readPlacement(settings, "gui");
+
+    if(settings.value("policy/isolate_acquisition", false).toBool())
+        policy.isolateAcquisition();
+
+    return true;
+}
+
+void ThreadPolicy::isolateAcquisition()
+{
+    if(acquisition.cpus.isEmpty())
+        return;
+
+    QVector<int> rest;
+    for(int cpu : ThreadPlacer::onlineCpus())
+    {
+        if(!acquisition.cpus.contains(cpu))
+            rest.append(cpu);
+    }
+
+    //единственное ядро изолировать не от чего
+    if(rest.isEmpty())
+        return;
+
+    ThreadPlacement* others[] = { &magnitude, &demodulation, &outputs, &network, &gui };
+    for(ThreadPlacement* placement : others)
+    {
+        if(placement->cpus.isEmpty())
+            placement->cpus = rest;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef THREADPOLICY_H
+#define THREADPOLICY_H
+
+#include <QString>
+#include <QVector>
+
+#include "pipeline/ThreadPlacement.h"
+
+class QSettings;
+
+/*!
+ * \brief The ThreadPolicy class
+ * Размещение потоков приемного пункта: стадий конвейера, потока
+ * отправки данных и основного потока (GUI). Чтение с приемника
+ * (rtlsdr_read_sync) выполняется потоком стадии чтения, поэтому
+ * размещение приемника совпадает с размещением этой стадии.
+ *
+ * Файл политики - INI, секция на поток:
+ * \code
+ * [acquisition]
+ * cpus=3
+ * sched=fifo
+ * priority=60
+ * [demodulation]
+ * cpus=2
+ * sched=fifo
+ * priority=50
+ * [network]
+ * nice=5
+ * [policy]
+ * isolate_acquisition=true
+ * \endcode
+ * cpus - список ядер или диапазонов (1,2 или 0-2), sched - fifo или normal,
+ * priority - приоритет SCHED_FIFO, nice - уровень nice.
+ * При isolate_acquisition потоки без заданных ядер размещаются
+ * на ядрах, не занятых стадией чтения
+ * \author Данильченко Артем
+ */
+class ThreadPolicy
+{
+    static ThreadPlacement readPlacement(QSettings& settings, const QString& group);
+    static QVector<int> parseCpus(const QStringList& list, bool* ok);
+
+public:
+    ///< стадии конвейера
+    ThreadPlacement acquisition;
+    ThreadPlacement magnitude;
+    ThreadPlacement demodulation;
+    ThreadPlacement outputs;
+    ///< поток отправки данных на сервер
+    ThreadPlacement network;
+    ///< основной поток приложения
+    ThreadPlacement gui;
+
+    /*!
+     * \brief load чтение политики из файла
+     * \param fileName - имя INI файла
+     * \param policy - результат
+     * \return false - файл не найден или содержит ошибки
+     */
+    static bool load(const QString& fileName, ThreadPolicy& policy);
+    /*!
+     * \brief isolateAcquisition размещение потоков без заданных ядер
+     * на ядрах, не занятых стадией чтения. Вызывается до привязки
+     * вызывающего потока
+     */
+    void isolateAcquisition();
+};
+
+#endif // THREADPOLICY_H
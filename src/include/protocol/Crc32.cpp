@@ -0,0 +1,31 @@
+#include "Crc32.h"
+
+namespace
+{
+struct Crc32Table
+{
+    uint32_t value[256];
+
+    Crc32Table()
+    {
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for(int k = 0; k < 8; k++)
+                c = (c & 1) ? (0xedb88320u ^ (c >> 1)) : (c >> 1);
+            value[i] = c;
+        }
+    }
+};
+}
+
+uint32_t frameCrc32(const char *data, size_t size, uint32_t crc)
+{
+    static const Crc32Table table;
+
+    crc = ~crc;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    for(size_t i = 0; i < size; i++)
+        crc = table.value[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
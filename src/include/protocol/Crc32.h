@@ -0,0 +1,15 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \brief crc32 контрольная сумма CRC-32 (IEEE 802.3)
+ * \param data - данные
+ * \param size - размер данных
+ * \param crc - значение для продолжения расчета по частям
+ */
+uint32_t frameCrc32(const char* data, size_t size, uint32_t crc = 0);
+
+#endif // CRC32_H
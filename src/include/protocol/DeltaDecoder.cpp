@@ -0,0 +1,116 @@
+#include "DeltaDecoder.h"
+
+#include <string.h>
+
+int DeltaDecoder::messageSize(const QByteArray &data)
+{
+    if(data.size() < int(sizeof(DeltaHeader)))
+        return 0;
+
+    DeltaHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    if(header.magic != DELTA_MAGIC || header.size < sizeof(header))
+        return -1;
+
+    return int(header.size);
+}
+
+bool DeltaDecoder::readRecord(const char *&p, const char *end,
+                              int64_t time, StructAircraft &a)
+{
+    auto read = [&p, end](void* dst, size_t size) -> bool
+    {
+        if(size_t(end - p) < size)
+            return false;
+        memcpy(dst, p, size);
+        p += size;
+        return true;
+    };
+
+    uint32_t key;
+    if(!read(&key, sizeof(key)))
+        return false;
+
+    const uint8_t mask = uint8_t(key >> 24);
+    a.icao = key & 0xffffff;
+
+    bool ok = true;
+    if(mask & DELTA_FIELD_FLIGHT)
+        ok = ok && read(a.flight, sizeof(a.flight));
+    if(mask & DELTA_FIELD_ALTITUDE)
+        ok = ok && read(&a.altitude, sizeof(a.altitude));
+    if(mask & DELTA_FIELD_SPEED)
+        ok = ok && read(&a.speed, sizeof(a.speed));
+    if(mask & DELTA_FIELD_COURSE)
+        ok = ok && read(&a.course, sizeof(a.course));
+    if(mask & DELTA_FIELD_LAT)
+        ok = ok && read(&a.lat, sizeof(a.lat));
+    if(mask & DELTA_FIELD_LON)
+        ok = ok && read(&a.lon, sizeof(a.lon));
+    if(mask & DELTA_FIELD_SEEN)
+    {
+        int32_t seen = 0;
+        ok = ok && read(&seen, sizeof(seen));
+        a.seen = time + seen;
+    }
+    if(mask & DELTA_FIELD_MESSAGES)
+        ok = ok && read(&a.messages, sizeof(a.messages));
+
+    a.flight[sizeof(a.flight) - 1] = 0;
+    return ok;
+}
+
+bool DeltaDecoder::apply(const QByteArray &message)
+{
+    if(messageSize(message) != message.size())
+        return false;
+
+    DeltaHeader header;
+    memcpy(&header, message.constData(), sizeof(header));
+
+    if(header.type != DELTA_KEYFRAME && header.type != DELTA_UPDATE)
+        return false;
+
+    //разностное сообщение применимо только к предыдущему сообщению
+    if(header.type == DELTA_UPDATE && (!_synced || header.baseSeq != _seq))
+    {
+        _synced = false;
+        return false;
+    }
+
+    //при ошибке разбора состояние неполное до следующего полного кадра
+    _synced = false;
+    _updated.clear();
+    if(header.type == DELTA_KEYFRAME)
+        _objects.clear();
+
+    const char* p = message.constData() + sizeof(header);
+    const char* end = message.constData() + message.size();
+
+    for(int i = 0; i < header.updateCount; i++)
+    {
+        uint32_t key;
+        if(size_t(end - p) < sizeof(key))
+            return false;
+        memcpy(&key, p, sizeof(key));
+
+        StructAircraft& a = _objects[key & 0xffffff];
+        if(!readRecord(p, end, header.time, a))
+            return false;
+        _updated.append(key & 0xffffff);
+    }
+
+    for(int i = 0; i < header.removeCount; i++)
+    {
+        uint32_t icao;
+        if(size_t(end - p) < sizeof(icao))
+            return false;
+        memcpy(&icao, p, sizeof(icao));
+        p += sizeof(icao);
+        _objects.remove(icao);
+    }
+
+    _seq = header.seq;
+    _synced = true;
+    return true;
+}
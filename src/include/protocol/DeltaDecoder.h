@@ -0,0 +1,63 @@
+#ifndef DELTADECODER_H
+#define DELTADECODER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include "objects/air/StructAircraft.h"
+#include "DeltaProtocol.h"
+
+/*!
+ * \brief The DeltaDecoder class
+ * Восстановление состояния самолётов по сообщениям
+ * инкрементального протокола.
+ * \author Данильченко Артем
+ */
+class DeltaDecoder
+{
+    ///< текущее состояние самолётов
+    QHash<uint32_t, StructAircraft> _objects;
+    ///< адреса самолётов, обновлённых последним сообщением
+    QVector<uint32_t> _updated;
+    ///< номер последнего применённого сообщения
+    uint32_t _seq = 0;
+    ///< получен полный кадр и нет пропусков
+    bool _synced = false;
+
+    static bool readRecord(const char*& p, const char* end,
+                           int64_t time, StructAircraft& a);
+
+public:
+    DeltaDecoder() = default;
+
+    /*!
+     * \brief messageSize размер сообщения по заголовку
+     * \param data - начало потока
+     * \return размер сообщения, 0 - заголовок не принят полностью,
+     * -1 - неверная сигнатура
+     */
+    static int messageSize(const QByteArray& data);
+    /*!
+     * \brief apply применение сообщения
+     * \return false - сообщение повреждено или пропущено предыдущее
+     * сообщение; состояние восстановится со следующим полным кадром
+     */
+    bool apply(const QByteArray& message);
+    /*!
+     * \brief isSynced состояние соответствует передатчику
+     */
+    bool isSynced() const { return _synced; }
+    /*!
+     * \brief objects текущее состояние самолётов
+     */
+    const QHash<uint32_t, StructAircraft>& objects() const { return _objects; }
+    /*!
+     * \brief updated адреса самолётов, записи которых содержало последнее
+     * применённое сообщение (для полного кадра - все самолёты).
+     * Неизменившиеся самолёты в список не входят
+     */
+    const QVector<uint32_t>& updated() const { return _updated; }
+};
+
+#endif // DELTADECODER_H
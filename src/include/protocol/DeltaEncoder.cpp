@@ -0,0 +1,157 @@
+#include "DeltaEncoder.h"
+
+#include <string.h>
+
+bool DeltaEncoder::parseRawDump(const QByteArray &dump, QVector<StructAircraft> &objects)
+{
+    objects.clear();
+
+    uint32_t frameSize = 0;
+    int32_t count = 0;
+    if(dump.size() < int(sizeof(frameSize) + sizeof(count)))
+        return false;
+
+    memcpy(&frameSize, dump.constData(), sizeof(frameSize));
+    memcpy(&count, dump.constData() + sizeof(frameSize), sizeof(count));
+
+    const int offset = int(sizeof(frameSize) + sizeof(count));
+    if(frameSize != sizeof(StructAircraft) || count < 0 ||
+            qint64(dump.size() - offset) < qint64(count) * frameSize)
+        return false;
+
+    objects.resize(count);
+    for(int i = 0; i < count; i++)
+        memcpy(&objects[i], dump.constData() + offset + i * int(frameSize), frameSize);
+
+    return true;
+}
+
+uint8_t DeltaEncoder::changedFields(const StructAircraft &prev, const StructAircraft &cur)
+{
+    uint8_t mask = 0;
+
+    if(memcmp(prev.flight, cur.flight, sizeof(cur.flight)) != 0)
+        mask |= DELTA_FIELD_FLIGHT;
+    if(prev.altitude != cur.altitude)
+        mask |= DELTA_FIELD_ALTITUDE;
+    if(prev.speed != cur.speed)
+        mask |= DELTA_FIELD_SPEED;
+    if(prev.course != cur.course)
+        mask |= DELTA_FIELD_COURSE;
+    if(prev.lat != cur.lat)
+        mask |= DELTA_FIELD_LAT;
+    if(prev.lon != cur.lon)
+        mask |= DELTA_FIELD_LON;
+    if(prev.seen != cur.seen)
+        mask |= DELTA_FIELD_SEEN;
+    if(prev.messages != cur.messages)
+        mask |= DELTA_FIELD_MESSAGES;
+
+    return mask;
+}
+
+void DeltaEncoder::writeRecord(QByteArray &out, const StructAircraft &a,
+                               uint8_t mask, int64_t time)
+{
+    uint32_t key = (a.icao & 0xffffff) | (uint32_t(mask) << 24);
+    out.append(reinterpret_cast<const char*>(&key), sizeof(key));
+
+    if(mask & DELTA_FIELD_FLIGHT)
+        out.append(a.flight, sizeof(a.flight));
+    if(mask & DELTA_FIELD_ALTITUDE)
+        out.append(reinterpret_cast<const char*>(&a.altitude), sizeof(a.altitude));
+    if(mask & DELTA_FIELD_SPEED)
+        out.append(reinterpret_cast<const char*>(&a.speed), sizeof(a.speed));
+    if(mask & DELTA_FIELD_COURSE)
+        out.append(reinterpret_cast<const char*>(&a.course), sizeof(a.course));
+    if(mask & DELTA_FIELD_LAT)
+        out.append(reinterpret_cast<const char*>(&a.lat), sizeof(a.lat));
+    if(mask & DELTA_FIELD_LON)
+        out.append(reinterpret_cast<const char*>(&a.lon), sizeof(a.lon));
+    if(mask & DELTA_FIELD_SEEN)
+    {
+        int32_t seen = int32_t(qBound<int64_t>(INT32_MIN, a.seen - time, INT32_MAX));
+        out.append(reinterpret_cast<const char*>(&seen), sizeof(seen));
+    }
+    if(mask & DELTA_FIELD_MESSAGES)
+        out.append(reinterpret_cast<const char*>(&a.messages), sizeof(a.messages));
+}
+
+QByteArray DeltaEncoder::encode(const QVector<StructAircraft> &objects, int64_t now)
+{
+    const bool keyframe = _needKeyframe || (now - _keyframeTime >= _keyframeInterval);
+
+    DeltaHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = DELTA_MAGIC;
+    header.type = keyframe ? DELTA_KEYFRAME : DELTA_UPDATE;
+    header.baseSeq = _seq;
+    header.seq = _seq + 1;
+    header.time = now;
+
+    QByteArray body;
+    QHash<uint32_t, StructAircraft> current;
+    current.reserve(objects.size());
+
+    for(const StructAircraft& a : objects)
+    {
+        const uint32_t icao = a.icao & 0xffffff;
+        if(icao == 0 || header.updateCount == UINT16_MAX)
+            continue;
+        current.insert(icao, a);
+
+        uint8_t mask = DELTA_FIELD_ALL;
+        if(!keyframe)
+        {
+            auto it = _sent.constFind(icao);
+            if(it != _sent.constEnd())
+                mask = changedFields(it.value(), a);
+        }
+
+        if(mask == 0)
+            continue;
+
+        writeRecord(body, a, mask, now);
+        ++header.updateCount;
+    }
+
+    //удаления передаются только в разностном сообщении
+    if(!keyframe)
+    {
+        for(auto it = _sent.constBegin(); it != _sent.constEnd(); ++it)
+        {
+            if(current.contains(it.key()) || header.removeCount == UINT16_MAX)
+                continue;
+
+            uint32_t icao = it.key();
+            body.append(reinterpret_cast<const char*>(&icao), sizeof(icao));
+            ++header.removeCount;
+        }
+
+        if(header.updateCount == 0 && header.removeCount == 0)
+            return QByteArray();
+    }
+
+    header.size = uint32_t(sizeof(header) + body.size());
+
+    _sent.swap(current);
+    _seq = header.seq;
+    if(keyframe)
+    {
+        _needKeyframe = false;
+        _keyframeTime = now;
+    }
+
+    QByteArray message(reinterpret_cast<const char*>(&header), sizeof(header));
+    message.append(body);
+    return message;
+}
+
+QByteArray DeltaEncoder::encode(const QByteArray &dump, int64_t now)
+{
+    QVector<StructAircraft> objects;
+    if(!parseRawDump(dump, objects))
+        return QByteArray();
+
+    return encode(objects, now);
+}
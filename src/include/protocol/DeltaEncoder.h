@@ -0,0 +1,68 @@
+#ifndef DELTAENCODER_H
+#define DELTAENCODER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+
+#include "objects/air/StructAircraft.h"
+#include "DeltaProtocol.h"
+
+/*!
+ * \brief The DeltaEncoder class
+ * Формирование сообщений инкрементального протокола: передаются только
+ * изменённые поля самолётов и удалённые самолёты относительно последнего
+ * отправленного сообщения, периодически передается полный кадр.
+ * \author Данильченко Артем
+ */
+class DeltaEncoder
+{
+    ///< состояние самолётов на момент последнего сообщения
+    QHash<uint32_t, StructAircraft> _sent;
+    ///< номер последнего сообщения
+    uint32_t _seq = 0;
+    ///< следующее сообщение - полный кадр
+    bool _needKeyframe = true;
+    ///< время последнего полного кадра, мс
+    int64_t _keyframeTime = 0;
+    ///< период полных кадров, мс
+    int64_t _keyframeInterval = 30000;
+
+    static uint8_t changedFields(const StructAircraft& prev, const StructAircraft& cur);
+    static void writeRecord(QByteArray& out, const StructAircraft& a,
+                            uint8_t mask, int64_t time);
+
+public:
+    DeltaEncoder() = default;
+
+    /*!
+     * \brief setKeyframeInterval период передачи полного кадра
+     * \param msec - период в мс
+     */
+    void setKeyframeInterval(int64_t msec) { if(msec > 0) _keyframeInterval = msec; }
+    /*!
+     * \brief reset передать полный кадр следующим сообщением.
+     * Вызывается при переподключении или ошибке отправки
+     */
+    void reset() { _needKeyframe = true; }
+    /*!
+     * \brief parseRawDump разбор массива, сформированного
+     * IDemodulator::getRawDumpOfObjectsInfo()
+     * \return false - неверный формат массива
+     */
+    static bool parseRawDump(const QByteArray& dump, QVector<StructAircraft>& objects);
+    /*!
+     * \brief encode формирование сообщения
+     * \param objects - текущее состояние всех самолётов
+     * \param now - текущее время, мс с начала эпохи
+     * \return сообщение; пустой массив, если изменений нет
+     */
+    QByteArray encode(const QVector<StructAircraft>& objects, int64_t now);
+    /*!
+     * \brief encode формирование сообщения по массиву
+     * IDemodulator::getRawDumpOfObjectsInfo()
+     */
+    QByteArray encode(const QByteArray& dump, int64_t now);
+};
+
+#endif // DELTAENCODER_H
@@ -0,0 +1,68 @@
+#ifndef DELTAPROTOCOL_H
+#define DELTAPROTOCOL_H
+
+#include <stdint.h>
+
+/*
+ * Incremental feeder protocol.
+ *
+ *   DeltaHeader
+ *   update records[updateCount]
+ *   uint32_t icao[removeCount]          aircraft removed since baseSeq
+ *
+ * Update record:
+ *   uint32_t key                        icao in bits 0..23, field mask
+ *                                       (DELTA_FIELD_*) in bits 24..31
+ *   changed fields in the order of the mask bits, encoded as in
+ *   StructAircraft, except seen: int32_t offset in ms from DeltaHeader.time
+ *
+ * A keyframe carries all fields of all aircraft and replaces the state of
+ * the receiver. A delta carries only changed fields and applies to the
+ * message with sequence number baseSeq; receivers drop deltas until the
+ * next keyframe when sequence numbers do not match.
+ */
+
+///< сигнатура сообщения
+constexpr uint32_t DELTA_MAGIC = 0x44534441; /* "ADSD" */
+
+///< типы сообщений
+constexpr uint8_t DELTA_KEYFRAME = 0;
+constexpr uint8_t DELTA_UPDATE = 1;
+
+///< признаки изменённых полей
+constexpr uint8_t DELTA_FIELD_FLIGHT   = 0x01;
+constexpr uint8_t DELTA_FIELD_ALTITUDE = 0x02;
+constexpr uint8_t DELTA_FIELD_SPEED    = 0x04;
+constexpr uint8_t DELTA_FIELD_COURSE   = 0x08;
+constexpr uint8_t DELTA_FIELD_LAT      = 0x10;
+constexpr uint8_t DELTA_FIELD_LON      = 0x20;
+constexpr uint8_t DELTA_FIELD_SEEN     = 0x40;
+constexpr uint8_t DELTA_FIELD_MESSAGES = 0x80;
+constexpr uint8_t DELTA_FIELD_ALL      = 0xff;
+
+/*!
+ * @brief  Заголовок сообщения инкрементального протокола.
+ */
+#pragma pack(push,1)
+struct DeltaHeader
+{
+    /* Message signature */
+    uint32_t magic;
+    /* Size of the whole message including the header */
+    uint32_t size;
+    /* DELTA_KEYFRAME or DELTA_UPDATE */
+    uint8_t type;
+    /* Sequence number of the message */
+    uint32_t seq;
+    /* Sequence number of the message the delta applies to */
+    uint32_t baseSeq;
+    /* Time the message was built, ms since epoch */
+    int64_t time;
+    /* Number of update records */
+    uint16_t updateCount;
+    /* Number of removed aircraft */
+    uint16_t removeCount;
+};
+#pragma pack(pop)
+
+#endif // DELTAPROTOCOL_H
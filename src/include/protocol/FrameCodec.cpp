@@ -0,0 +1,306 @@
+#include "FrameCodec.h"
+
+#include <string.h>
+
+#include "DeltaEncoder.h"
+
+namespace
+{
+constexpr int HEADER_SIZE = int(sizeof(FrameHeader));
+///< размер заголовка без контрольной суммы заголовка
+constexpr size_t HEADER_CRC_SIZE = sizeof(FrameHeader) - sizeof(uint32_t);
+///< байты слова синхронизации в порядке передачи
+constexpr char SYNC_BYTES[4] = { char(FRAME_SYNC & 0xff),
+                                 char((FRAME_SYNC >> 8) & 0xff),
+                                 char((FRAME_SYNC >> 16) & 0xff),
+                                 char((FRAME_SYNC >> 24) & 0xff) };
+
+/*!
+ * \brief findSync поиск полного слова синхронизации
+ * \return смещение слова или -1
+ */
+int findSync(const char* data, int size)
+{
+    const char* p = data;
+    const char* end = data + size - int(sizeof(SYNC_BYTES)) + 1;
+
+    while(p < end)
+    {
+        p = static_cast<const char*>(memchr(p, SYNC_BYTES[0], size_t(end - p)));
+        if(p == nullptr)
+            return -1;
+        if(memcmp(p, SYNC_BYTES, sizeof(SYNC_BYTES)) == 0)
+            return int(p - data);
+        ++p;
+    }
+    return -1;
+}
+
+/*!
+ * \brief syncPrefix длина окончания блока, совпадающего с началом
+ * слова синхронизации (слово разделено между порциями)
+ */
+int syncPrefix(const char* data, int size)
+{
+    for(int len = qMin(size, int(sizeof(SYNC_BYTES)) - 1); len > 0; len--)
+    {
+        if(memcmp(data + size - len, SYNC_BYTES, size_t(len)) == 0)
+            return len;
+    }
+    return 0;
+}
+}
+
+void FrameWriter::appendFrame(QByteArray &out,
+                              uint8_t type,
+                              uint8_t flags,
+                              uint16_t count,
+                              int64_t time,
+                              const char *payload,
+                              uint32_t length)
+{
+    FrameHeader header;
+    header.sync = FRAME_SYNC;
+    header.version = FRAME_VERSION;
+    header.type = type;
+    header.flags = flags;
+    header.count = count;
+    header.seq = _seq++;
+    header.time = time;
+    header.length = length;
+    header.payloadCrc = frameCrc32(payload, length);
+    header.headerCrc = frameCrc32(reinterpret_cast<const char*>(&header), HEADER_CRC_SIZE);
+
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    if(length > 0)
+        out.append(payload, int(length));
+}
+
+QByteArray FrameWriter::snapshot(const QVector<StructAircraft> &objects, int64_t time)
+{
+    const int count = objects.size();
+    int frames = (count + FRAME_BATCH_RECORDS - 1) / FRAME_BATCH_RECORDS;
+    if(frames == 0)
+        frames = 1;
+
+    QByteArray out;
+    out.reserve(frames * HEADER_SIZE + count * int(sizeof(StructAircraft)));
+
+    for(int frame = 0; frame < frames; frame++)
+    {
+        const int first = frame * FRAME_BATCH_RECORDS;
+        const int records = qMin(FRAME_BATCH_RECORDS, count - first);
+
+        uint8_t flags = 0;
+        if(frame == 0)
+            flags |= FRAME_FLAG_FIRST;
+        if(frame == frames - 1)
+            flags |= FRAME_FLAG_LAST;
+
+        appendFrame(out, FRAME_RECORDS, flags, uint16_t(records), time,
+                    reinterpret_cast<const char*>(objects.constData() + first),
+                    uint32_t(records) * sizeof(StructAircraft));
+    }
+
+    return out;
+}
+
+QByteArray FrameWriter::snapshot(const QByteArray &dump, int64_t time)
+{
+    QVector<StructAircraft> objects;
+    if(!DeltaEncoder::parseRawDump(dump, objects))
+        return QByteArray();
+
+    return snapshot(objects, time);
+}
+
+QByteArray FrameWriter::ping(int64_t now)
+{
+    QByteArray out;
+    appendFrame(out, FRAME_PING, FRAME_FLAG_FIRST | FRAME_FLAG_LAST, 0, now, nullptr, 0);
+    return out;
+}
+
+QByteArray FrameWriter::pong(int64_t originate, int64_t receive, int64_t now)
+{
+    FramePong pong;
+    pong.originate = originate;
+    pong.receive = receive;
+
+    QByteArray out;
+    appendFrame(out, FRAME_PONG, FRAME_FLAG_FIRST | FRAME_FLAG_LAST, 0, now,
+                reinterpret_cast<const char*>(&pong), sizeof(pong));
+    return out;
+}
+
+bool FrameParser::readHeader(const char *p, FrameHeader &header)
+{
+    memcpy(&header, p, sizeof(header));
+
+    if(header.headerCrc != frameCrc32(p, HEADER_CRC_SIZE))
+        return false;
+
+    return header.version == FRAME_VERSION && header.length <= FRAME_MAX_PAYLOAD;
+}
+
+void FrameParser::skip(int count)
+{
+    if(count <= 0)
+        return;
+
+    _stats.garbageBytes += uint64_t(count);
+    _skipped = true;
+}
+
+void FrameParser::deliver(const FrameHeader &header, const char *payload, const Handler &handler)
+{
+    if(_skipped)
+    {
+        _stats.resyncs++;
+        _skipped = false;
+    }
+
+    //разность по модулю 2^32 - нумерация может переполняться
+    if(_synced && int32_t(header.seq - _expected) > 0)
+        _stats.lostFrames += uint64_t(header.seq - _expected);
+
+    _synced = true;
+    _expected = header.seq + 1;
+    _stats.frames++;
+
+    if(handler)
+        handler(header, payload);
+}
+
+int FrameParser::parse(const char *data, int size, const Handler &handler)
+{
+    int pos = 0;
+
+    while(pos < size)
+    {
+        const int left = size - pos;
+        const int sync = findSync(data + pos, left);
+        if(sync < 0)
+        {
+            //начало слова синхронизации может прийти в следующей порции
+            const int keep = syncPrefix(data + pos, left);
+            skip(left - keep);
+            return size - keep;
+        }
+
+        skip(sync);
+        pos += sync;
+
+        if(size - pos < HEADER_SIZE)
+            return pos;
+
+        FrameHeader header;
+        if(!readHeader(data + pos, header))
+        {
+            //случайное совпадение слова синхронизации
+            _stats.headerErrors++;
+            skip(1);
+            pos += 1;
+            continue;
+        }
+
+        const int frameSize = HEADER_SIZE + int(header.length);
+        if(size - pos < frameSize)
+            return pos;
+
+        const char* payload = data + pos + HEADER_SIZE;
+        if(frameCrc32(payload, header.length) != header.payloadCrc)
+        {
+            //данные могли быть укорочены - следующий кадр ищется внутри
+            _stats.crcErrors++;
+            skip(1);
+            pos += 1;
+            continue;
+        }
+
+        deliver(header, payload, handler);
+        pos += frameSize;
+    }
+
+    return pos;
+}
+
+int FrameParser::pendingNeed() const
+{
+    if(_buffer.size() < HEADER_SIZE)
+        return HEADER_SIZE - _buffer.size();
+
+    FrameHeader header;
+    if(!readHeader(_buffer.constData(), header))
+        return 0;
+
+    return qMax(0, HEADER_SIZE + int(header.length) - _buffer.size());
+}
+
+void FrameParser::feed(const char *data, int size, const Handler &handler)
+{
+    if(data == nullptr || size <= 0)
+        return;
+
+    _stats.bytes += uint64_t(size);
+
+    //дополнение незавершенного кадра только недостающими байтами
+    while(!_buffer.isEmpty() && size > 0)
+    {
+        const int need = pendingNeed();
+        if(need > 0)
+        {
+            const int take = qMin(need, size);
+            _buffer.append(data, take);
+            data += take;
+            size -= take;
+            if(take < need)
+                return;
+        }
+
+        const int used = parse(_buffer.constData(), _buffer.size(), handler);
+        _buffer.remove(0, used);
+    }
+
+    if(!_buffer.isEmpty() || size <= 0)
+        return;
+
+    //кадры, целиком находящиеся в порции, разбираются на месте
+    const int used = parse(data, size, handler);
+    if(used < size)
+        _buffer.append(data + used, size - used);
+}
+
+void FrameParser::reset()
+{
+    _buffer.clear();
+    _synced = false;
+    _skipped = false;
+}
+
+bool FrameParser::records(const FrameHeader &header, const char *payload,
+                          QVector<StructAircraft> &out)
+{
+    if(header.type != FRAME_RECORDS ||
+            header.length != uint32_t(header.count) * sizeof(StructAircraft))
+        return false;
+
+    const int first = out.size();
+    out.resize(first + header.count);
+    if(header.count > 0)
+        memcpy(out.data() + first, payload, header.length);
+
+    for(int i = first; i < out.size(); i++)
+        out[i].flight[sizeof(out[i].flight) - 1] = 0;
+
+    return true;
+}
+
+bool FrameParser::pong(const FrameHeader &header, const char *payload, FramePong &out)
+{
+    if(header.type != FRAME_PONG || header.length != sizeof(FramePong))
+        return false;
+
+    memcpy(&out, payload, sizeof(out));
+    return true;
+}
@@ -0,0 +1,180 @@
+#ifndef FRAMECODEC_H
+#define FRAMECODEC_H
+
+#include <QByteArray>
+#include <QVector>
+#include <functional>
+
+#include "objects/air/StructAircraft.h"
+#include "FrameProtocol.h"
+#include "Crc32.h"
+
+/*!
+ * \brief The FrameWriter class
+ * Формирование кадров протокола FrameProtocol.h
+ * \author Данильченко Артем
+ */
+class FrameWriter
+{
+    ///< номер следующего кадра
+    uint32_t _seq = 0;
+
+public:
+    FrameWriter() = default;
+
+    /*!
+     * \brief appendFrame добавление кадра в массив
+     * \param out - массив
+     * \param type - тип кадра
+     * \param flags - признаки кадра
+     * \param count - количество записей
+     * \param time - время формирования, мс с начала эпохи
+     * \param payload - данные кадра
+     * \param length - размер данных
+     */
+    void appendFrame(QByteArray& out,
+                     uint8_t type,
+                     uint8_t flags,
+                     uint16_t count,
+                     int64_t time,
+                     const char* payload,
+                     uint32_t length);
+    /*!
+     * \brief snapshot снимок состояния самолётов пачкой кадров FRAME_RECORDS
+     * \param objects - все самолёты
+     * \param time - время формирования, мс с начала эпохи
+     * \return кадры, записанные подряд
+     */
+    QByteArray snapshot(const QVector<StructAircraft>& objects, int64_t time);
+    /*!
+     * \brief snapshot снимок по массиву IDemodulator::getRawDumpOfObjectsInfo()
+     * \return пустой массив - неверный формат массива
+     */
+    QByteArray snapshot(const QByteArray& dump, int64_t time);
+    /*!
+     * \brief ping запрос обмена метками времени
+     * \param now - время отправки (t1), мс с начала эпохи
+     */
+    QByteArray ping(int64_t now);
+    /*!
+     * \brief pong ответ на FRAME_PING
+     * \param originate - время из заголовка FRAME_PING (t1)
+     * \param receive - время приема FRAME_PING (t2)
+     * \param now - время отправки ответа (t3)
+     */
+    QByteArray pong(int64_t originate, int64_t receive, int64_t now);
+};
+
+/*!
+ * @brief  Счетчики разбора потока кадров
+ */
+struct FrameParserStats
+{
+    ///< принято байт
+    uint64_t bytes = 0;
+    ///< принято кадров
+    uint64_t frames = 0;
+    ///< байты вне кадров, пропущенные при поиске синхронизации
+    uint64_t garbageBytes = 0;
+    ///< заголовки с неверной контрольной суммой, версией или размером
+    uint64_t headerErrors = 0;
+    ///< кадры с неверной контрольной суммой данных
+    uint64_t crcErrors = 0;
+    ///< восстановления синхронизации после пропущенных байт
+    uint64_t resyncs = 0;
+    ///< пропущенные кадры по разрывам нумерации
+    uint64_t lostFrames = 0;
+};
+
+/*!
+ * \brief The FrameParser class
+ * Инкрементальный разбор потока кадров.
+ * Данные передаются порциями произвольного размера (как их вернул сокет).
+ * Кадры, целиком находящиеся в порции, передаются обработчику указателем
+ * на данные порции без копирования; копируется только незавершенный кадр
+ * на границе порций. После поврежденных или посторонних байт разбор
+ * продолжается со следующего слова синхронизации с верным заголовком.
+ * \author Данильченко Артем
+ */
+class FrameParser
+{
+public:
+    /*!
+     * \brief Handler обработчик кадра; данные действительны только
+     * во время вызова
+     */
+    using Handler = std::function<void(const FrameHeader& header, const char* payload)>;
+
+private:
+    ///< незавершенный кадр с предыдущих порций
+    QByteArray _buffer;
+    ///< номер ожидаемого кадра
+    uint32_t _expected = 0;
+    bool _synced = false;
+    ///< пропущены байты после последнего кадра
+    bool _skipped = false;
+    FrameParserStats _stats;
+
+    /*!
+     * \brief readHeader чтение и проверка заголовка
+     * \return заголовок верен
+     */
+    static bool readHeader(const char* p, FrameHeader& header);
+    /*!
+     * \brief parse разбор непрерывного блока данных
+     * \return количество обработанных байт; необработанный остаток
+     * начинается с незавершенного кадра
+     */
+    int parse(const char* data, int size, const Handler& handler);
+    /*!
+     * \brief pendingNeed количество байт, недостающих незавершенному кадру
+     * до полного заголовка или полного кадра; 0 - заголовок неверен
+     */
+    int pendingNeed() const;
+    void skip(int count);
+    void deliver(const FrameHeader& header, const char* payload, const Handler& handler);
+
+public:
+    FrameParser() = default;
+
+    /*!
+     * \brief feed разбор очередной порции данных
+     * \param data - данные
+     * \param size - размер данных
+     * \param handler - обработчик кадров
+     */
+    void feed(const char* data, int size, const Handler& handler);
+    /*!
+     * \brief feed разбор очередной порции данных
+     */
+    void feed(const QByteArray& data, const Handler& handler)
+    {
+        feed(data.constData(), data.size(), handler);
+    }
+    /*!
+     * \brief reset сброс состояния при переподключении
+     */
+    void reset();
+    /*!
+     * \brief buffered размер незавершенного кадра
+     */
+    int buffered() const { return _buffer.size(); }
+    /*!
+     * \brief stats счетчики разбора
+     */
+    const FrameParserStats& stats() const { return _stats; }
+    /*!
+     * \brief records добавление записей кадра FRAME_RECORDS
+     * \return false - кадр другого типа или размер данных не
+     * соответствует количеству записей
+     */
+    static bool records(const FrameHeader& header, const char* payload,
+                        QVector<StructAircraft>& out);
+    /*!
+     * \brief pong данные кадра FRAME_PONG
+     * \return false - кадр другого типа или неверного размера
+     */
+    static bool pong(const FrameHeader& header, const char* payload, FramePong& out);
+};
+
+#endif // FRAMECODEC_H
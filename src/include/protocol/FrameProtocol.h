@@ -0,0 +1,96 @@
+#ifndef FRAMEPROTOCOL_H
+#define FRAMEPROTOCOL_H
+
+#include <stdint.h>
+
+/*
+ * Framed feeder protocol.
+ *
+ *   FrameHeader
+ *   payload[length]
+ *
+ * Every frame starts with the sync word FRAME_SYNC. The header carries its
+ * own CRC-32, so a sync word that occurs by chance inside payload or
+ * garbage is rejected without waiting for `length` bytes; the payload is
+ * protected by a separate CRC-32. A receiver that loses track of the
+ * stream (partial write, corrupted bytes) scans forward for the next sync
+ * word whose header CRC matches.
+ *
+ * FRAME_RECORDS payload: StructAircraft records[count]. A snapshot (the
+ * full aircraft list) is sent as a batch of one or more FRAME_RECORDS
+ * frames; the first frame of the batch has FRAME_FLAG_FIRST, the last one
+ * FRAME_FLAG_LAST. Frame sequence numbers are consecutive over the
+ * connection, so lost frames are detected by gaps.
+ *
+ * Clock offset exchange (NTP-style). The server sends FRAME_PING with
+ * header.time = t1 (server clock) and no payload; the feeder answers with
+ * FRAME_PONG, header.time = t3 (feeder send time) and a FramePong payload
+ * echoing t1 and carrying t2 (feeder receive time). With t4 the server
+ * receive time:
+ *
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2    feeder clock minus server clock
+ *   rtt    = (t4 - t1) - (t3 - t2)
+ *
+ * Receivers skip frames with an unknown type; a new version number is
+ * only used for changes that old receivers cannot skip.
+ */
+
+///< слово синхронизации
+constexpr uint32_t FRAME_SYNC = 0x46534441; /* "ADSF" */
+///< версия формата
+constexpr uint8_t FRAME_VERSION = 1;
+///< максимальный размер данных кадра
+constexpr uint32_t FRAME_MAX_PAYLOAD = 1024 * 1024;
+///< количество записей в кадре при разбиении снимка
+constexpr int FRAME_BATCH_RECORDS = 256;
+
+///< типы кадров
+constexpr uint8_t FRAME_RECORDS = 1;
+constexpr uint8_t FRAME_PING    = 2;
+constexpr uint8_t FRAME_PONG    = 3;
+
+///< признаки кадра
+constexpr uint8_t FRAME_FLAG_FIRST = 0x01;
+constexpr uint8_t FRAME_FLAG_LAST  = 0x02;
+
+/*!
+ * @brief  Заголовок кадра.
+ */
+#pragma pack(push,1)
+struct FrameHeader
+{
+    /* Sync word FRAME_SYNC */
+    uint32_t sync;
+    /* Format version */
+    uint8_t version;
+    /* Frame type (FRAME_RECORDS) */
+    uint8_t type;
+    /* FRAME_FLAG_* */
+    uint8_t flags;
+    /* Number of records in the payload */
+    uint16_t count;
+    /* Frame sequence number */
+    uint32_t seq;
+    /* Time the frame was built, ms since epoch */
+    int64_t time;
+    /* Payload size */
+    uint32_t length;
+    /* CRC-32 of the payload */
+    uint32_t payloadCrc;
+    /* CRC-32 of the preceding header fields */
+    uint32_t headerCrc;
+};
+
+/*!
+ * @brief  Данные кадра FRAME_PONG.
+ */
+struct FramePong
+{
+    /* t1: header.time of the FRAME_PING, server clock */
+    int64_t originate;
+    /* t2: time the FRAME_PING was received, feeder clock */
+    int64_t receive;
+};
+#pragma pack(pop)
+
+#endif // FRAMEPROTOCOL_H
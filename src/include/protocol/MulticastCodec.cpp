@@ -0,0 +1,130 @@
+#include "MulticastCodec.h"
+
+#include <string.h>
+
+#include "DeltaEncoder.h"
+
+QVector<QByteArray> MulticastPacker::pack(const QVector<StructAircraft> &objects, int64_t time)
+{
+    const int count = objects.size();
+    int parts = (count + MCAST_RECORDS_PER_DATAGRAM - 1) / MCAST_RECORDS_PER_DATAGRAM;
+    if(parts == 0)
+        parts = 1;
+
+    QVector<QByteArray> datagrams;
+    datagrams.reserve(parts);
+
+    for(int part = 0; part < parts; part++)
+    {
+        const int first = part * MCAST_RECORDS_PER_DATAGRAM;
+        const int records = qMin(MCAST_RECORDS_PER_DATAGRAM, count - first);
+
+        MulticastHeader header;
+        header.magic = MCAST_MAGIC;
+        header.version = MCAST_VERSION;
+        header.seq = _seq++;
+        header.snapshot = _snapshot;
+        header.part = uint16_t(part);
+        header.parts = uint16_t(parts);
+        header.time = time;
+        header.count = uint16_t(records);
+
+        QByteArray datagram;
+        datagram.reserve(int(sizeof(header)) + records * int(sizeof(StructAircraft)));
+        datagram.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        if(records > 0)
+            datagram.append(reinterpret_cast<const char*>(objects.constData() + first),
+                            records * int(sizeof(StructAircraft)));
+
+        datagrams.append(datagram);
+    }
+
+    _snapshot++;
+    return datagrams;
+}
+
+QVector<QByteArray> MulticastPacker::pack(const QByteArray &dump, int64_t time)
+{
+    QVector<StructAircraft> objects;
+    if(!DeltaEncoder::parseRawDump(dump, objects))
+        return QVector<QByteArray>();
+
+    return pack(objects, time);
+}
+
+bool MulticastTracker::parse(const QByteArray &datagram,
+                             MulticastHeader &header,
+                             QVector<StructAircraft> &records)
+{
+    records.clear();
+
+    if(datagram.size() < int(sizeof(header)))
+        return false;
+
+    memcpy(&header, datagram.constData(), sizeof(header));
+    if(header.magic != MCAST_MAGIC || header.version != MCAST_VERSION)
+        return false;
+
+    if(header.parts == 0 || header.part >= header.parts)
+        return false;
+
+    const int payload = datagram.size() - int(sizeof(header));
+    if(payload != int(header.count) * int(sizeof(StructAircraft)))
+        return false;
+
+    records.resize(header.count);
+    if(header.count > 0)
+        memcpy(records.data(), datagram.constData() + sizeof(header), size_t(payload));
+
+    return true;
+}
+
+bool MulticastTracker::accept(const QByteArray &datagram,
+                              MulticastHeader &header,
+                              QVector<StructAircraft> &records)
+{
+    if(!parse(datagram, header, records))
+    {
+        _stats.invalid++;
+        return false;
+    }
+
+    _stats.received++;
+
+    if(!_synced)
+    {
+        _synced = true;
+        _expected = header.seq + 1;
+        return true;
+    }
+
+    //разность по модулю 2^32 - нумерация может переполняться
+    const int32_t gap = int32_t(header.seq - _expected);
+
+    if(gap == 0)
+    {
+        _expected++;
+        return true;
+    }
+
+    //перезапущенный передатчик начинает нумерацию заново (обычно с 0),
+    //поэтому возврат назад дальше окна перестановки - тоже перезапуск
+    if(gap > RESYNC_GAP || gap < -REORDER_WINDOW)
+    {
+        _stats.resyncs++;
+        _expected = header.seq + 1;
+        return true;
+    }
+
+    if(gap > 0)
+    {
+        _stats.lost += uint64_t(gap);
+        _expected = header.seq + 1;
+        return true;
+    }
+
+    //датаграмма уже учтена как потерянная или получена повторно
+    _stats.late++;
+    records.clear();
+    return false;
+}
@@ -0,0 +1,103 @@
+#ifndef MULTICASTCODEC_H
+#define MULTICASTCODEC_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "MulticastProtocol.h"
+
+/*!
+ * \brief The MulticastPacker class
+ * Разбиение снимка состояния самолётов на датаграммы рассылки
+ * с последовательной нумерацией.
+ * \author Данильченко Артем
+ */
+class MulticastPacker
+{
+    ///< номер следующей датаграммы
+    uint32_t _seq = 0;
+    ///< номер следующего снимка
+    uint32_t _snapshot = 0;
+
+public:
+    MulticastPacker() = default;
+
+    /*!
+     * \brief pack формирование датаграмм снимка
+     * \param objects - состояние всех самолётов
+     * \param time - время формирования снимка, мс с начала эпохи
+     * \return датаграммы; снимок без самолётов передается одной
+     * датаграммой без записей
+     */
+    QVector<QByteArray> pack(const QVector<StructAircraft>& objects, int64_t time);
+    /*!
+     * \brief pack формирование датаграмм по массиву
+     * IDemodulator::getRawDumpOfObjectsInfo()
+     * \return пустой список - неверный формат массива
+     */
+    QVector<QByteArray> pack(const QByteArray& dump, int64_t time);
+};
+
+/*!
+ * @brief  Счетчики приема рассылки
+ */
+struct MulticastRxStats
+{
+    ///< принято датаграмм
+    uint64_t received = 0;
+    ///< пропущено датаграмм по разрывам нумерации
+    uint64_t lost = 0;
+    ///< датаграммы, пришедшие после более поздних (повтор или перестановка)
+    uint64_t late = 0;
+    ///< датаграммы неверного формата
+    uint64_t invalid = 0;
+    ///< переходы на новую нумерацию (перезапуск передатчика)
+    uint64_t resyncs = 0;
+};
+
+/*!
+ * \brief The MulticastTracker class
+ * Разбор датаграмм рассылки и контроль потерь по номерам датаграмм
+ * \author Данильченко Артем
+ */
+class MulticastTracker
+{
+    ///< разрыв нумерации, после которого передатчик считается перезапущенным
+    static constexpr int32_t RESYNC_GAP = 100000;
+    ///< глубина перестановки датаграмм в сети; возврат нумерации
+    ///< дальше этого окна - перезапуск передатчика
+    static constexpr int32_t REORDER_WINDOW = 64;
+
+    ///< номер ожидаемой датаграммы
+    uint32_t _expected = 0;
+    bool _synced = false;
+    MulticastRxStats _stats;
+
+public:
+    MulticastTracker() = default;
+
+    /*!
+     * \brief parse разбор датаграммы
+     * \param datagram - датаграмма
+     * \param header - заголовок
+     * \param records - записи о самолётах
+     * \return false - неверный формат
+     */
+    static bool parse(const QByteArray& datagram,
+                      MulticastHeader& header,
+                      QVector<StructAircraft>& records);
+    /*!
+     * \brief accept разбор датаграммы с учетом нумерации
+     * \return false - неверный формат или устаревшая датаграмма,
+     * записи которой не применяются
+     */
+    bool accept(const QByteArray& datagram,
+                MulticastHeader& header,
+                QVector<StructAircraft>& records);
+    /*!
+     * \brief stats счетчики приема
+     */
+    const MulticastRxStats& stats() const { return _stats; }
+};
+
+#endif // MULTICASTCODEC_H
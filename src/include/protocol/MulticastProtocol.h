@@ -0,0 +1,60 @@
+#ifndef MULTICASTPROTOCOL_H
+#define MULTICASTPROTOCOL_H
+
+#include <stdint.h>
+
+#include "objects/air/StructAircraft.h"
+
+/*
+ * Multicast distribution of aircraft snapshots.
+ *
+ *   MulticastHeader
+ *   StructAircraft records[count]
+ *
+ * A snapshot (the full aircraft list) is split into datagrams that fit
+ * into one Ethernet frame, so no datagram is ever fragmented by IP and
+ * every datagram can be used on its own. Datagram sequence numbers are
+ * consecutive over all snapshots; receivers detect losses by gaps.
+ */
+
+///< сигнатура датаграммы
+constexpr uint32_t MCAST_MAGIC = 0x4d534441; /* "ADSM" */
+///< версия формата
+constexpr uint8_t MCAST_VERSION = 1;
+///< группа рассылки по умолчанию (область действия - организация)
+constexpr const char* MCAST_DEFAULT_GROUP = "239.255.77.1";
+///< порт рассылки по умолчанию
+constexpr uint16_t MCAST_DEFAULT_PORT = 30100;
+///< максимальный размер датаграммы: MTU 1500 - IPv4 20 - UDP 8
+constexpr int MCAST_MAX_DATAGRAM = 1472;
+
+/*!
+ * @brief  Заголовок датаграммы рассылки.
+ */
+#pragma pack(push,1)
+struct MulticastHeader
+{
+    /* Datagram signature */
+    uint32_t magic;
+    /* Format version */
+    uint8_t version;
+    /* Datagram sequence number, consecutive over all snapshots */
+    uint32_t seq;
+    /* Snapshot sequence number */
+    uint32_t snapshot;
+    /* Index of the datagram in the snapshot */
+    uint16_t part;
+    /* Number of datagrams in the snapshot */
+    uint16_t parts;
+    /* Time the snapshot was built, ms since epoch */
+    int64_t time;
+    /* Number of StructAircraft records in the datagram */
+    uint16_t count;
+};
+#pragma pack(pop)
+
+///< количество записей в датаграмме максимального размера
+constexpr int MCAST_RECORDS_PER_DATAGRAM =
+        (MCAST_MAX_DATAGRAM - int(sizeof(MulticastHeader))) / int(sizeof(StructAircraft));
+
+#endif // MULTICASTPROTOCOL_H
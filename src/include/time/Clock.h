@@ -0,0 +1,85 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+#include <chrono>
+#include <QDateTime>
+
+/*!
+ * \brief The Clock class
+ * Единое представление времени в программе - целое число наносекунд
+ * с начала эпохи (UTC). Преобразование в QDateTime выполняется только
+ * при отображении данных пользователю.
+ */
+class Clock
+{
+public:
+    static constexpr int64_t NSEC_PER_MSEC = 1000000;
+    static constexpr int64_t NSEC_PER_SEC = 1000000000;
+
+    /*!
+     * \brief nowNSec текущее время
+     * \return время в нс с начала эпохи
+     */
+    static inline int64_t nowNSec()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    /*!
+     * \brief nowMSec текущее время
+     * \return время в мс с начала эпохи
+     */
+    static inline int64_t nowMSec()
+    {
+        return nowNSec() / NSEC_PER_MSEC;
+    }
+    /*!
+     * \brief monotonicNSec время монотонных часов для измерения интервалов.
+     * Не связано с началом эпохи и не изменяется при переводе системных часов
+     * \return время в нс
+     */
+    static inline int64_t monotonicNSec()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    /*!
+     * \brief toMSec перевод нс в мс
+     */
+    static inline int64_t toMSec(int64_t nsec)
+    {
+        return nsec / NSEC_PER_MSEC;
+    }
+    /*!
+     * \brief fromMSec перевод мс в нс
+     */
+    static inline int64_t fromMSec(int64_t msec)
+    {
+        return msec * NSEC_PER_MSEC;
+    }
+    /*!
+     * \brief toDateTime преобразование для отображения
+     * \param nsec - время в нс с начала эпохи
+     * \return локальное время или невалидный QDateTime для нулевого времени
+     */
+    static inline QDateTime toDateTime(int64_t nsec)
+    {
+        if(nsec == 0)
+            return QDateTime();
+        return QDateTime::fromMSecsSinceEpoch(toMSec(nsec));
+    }
+    /*!
+     * \brief fromDateTime преобразование QDateTime во внутреннее представление
+     * \param dt - время
+     * \return время в нс с начала эпохи или 0 для невалидного времени
+     */
+    static inline int64_t fromDateTime(const QDateTime& dt)
+    {
+        if(!dt.isValid())
+            return 0;
+        return fromMSec(dt.toMSecsSinceEpoch());
+    }
+};
+
+#endif // CLOCK_H
@@ -0,0 +1,209 @@
+#include "AircraftDbTest.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <QFile>
+
+bool AircraftDbTest::writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(data) == data.size();
+}
+
+QByteArray AircraftDbTest::readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+int AircraftDbTest::build(const QByteArray &csv, const QString &fileName)
+{
+    const QString source = _dir.filePath("source.csv");
+    if(!writeFile(source, csv))
+        return -1;
+
+    AircraftDbWriter writer;
+    const int count = writer.readCsv(source);
+    if(count < 0 || !writer.write(fileName))
+        return -1;
+    return count;
+}
+
+void AircraftDbTest::roundTripTest()
+{
+    QVERIFY(_dir.isValid());
+    const QString fileName = _dir.filePath("roundtrip.db");
+
+    //строки не упорядочены, неверные адреса пропускаются
+    const QByteArray csv =
+            "icao24,registration,manufacturername,model,typecode,operator\r\n"
+            "4242a1,RA-89001,Sukhoi,Superjet 100,SU95,Aeroflot\r\n"
+            "3c6586,D-AIPX,Airbus,A320,A320,\"Lufthansa, German Airlines\"\r\n"
+            "00abcd,,,,,\r\n"
+            "zzzzzz,BAD,,,,\r\n"
+            "000000,ZERO,,,,\r\n"
+            "1000000,BIG,,,,\r\n"
+            "3c6587,D-AIPY,Airbus,A320,A320,\"Lufthansa, German Airlines\"\r\n";
+    QCOMPARE(build(csv, fileName), 4);
+
+    //одинаковые строки хранятся в пуле один раз
+    const char* strings[] = { "RA-89001", "SU95", "Aeroflot", "D-AIPX", "A320",
+                              "Lufthansa, German Airlines", "D-AIPY" };
+    uint32_t stringsSize = 0;
+    for(const char* str : strings)
+        stringsSize += uint32_t(strlen(str) + 1);
+
+    const QByteArray data = readFile(fileName);
+    QVERIFY(data.size() >= int(sizeof(AircraftDbHeader)));
+    AircraftDbHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    QCOMPARE(header.count, uint32_t(4));
+    QCOMPARE(header.stringsSize, stringsSize);
+    QCOMPARE(data.size(), int(sizeof(AircraftDbHeader) + 4 * sizeof(AircraftDbRecord) +
+                              stringsSize));
+
+    AircraftDatabase database;
+    AircraftInfo info;
+    QCOMPARE(database.isOpen(), false);
+    QCOMPARE(database.lookup(0x3c6586, info), false);
+
+    QVERIFY(database.open(fileName));
+    QVERIFY(database.isOpen());
+    QCOMPARE(database.count(), 4);
+
+    QVERIFY(database.lookup(0x3c6586, info));
+    QCOMPARE(info.registration, QString("D-AIPX"));
+    QCOMPARE(info.type, QString("A320"));
+    QCOMPARE(info.owner, QString("Lufthansa, German Airlines"));
+
+    QVERIFY(database.lookup(0x3c6587, info));
+    QCOMPARE(info.registration, QString("D-AIPY"));
+    QCOMPARE(info.owner, QString("Lufthansa, German Airlines"));
+
+    QVERIFY(database.lookup(0x4242a1, info));
+    QCOMPARE(info.registration, QString("RA-89001"));
+    QCOMPARE(info.type, QString("SU95"));
+    QCOMPARE(info.owner, QString("Aeroflot"));
+
+    //запись без справочных данных
+    QVERIFY(database.lookup(0x00abcd, info));
+    QVERIFY(info.isEmpty());
+
+    //отсутствующие адреса: до первой записи, между записями, после последней
+    QCOMPARE(database.lookup(0x000001, info), false);
+    QCOMPARE(database.lookup(0x3c6588, info), false);
+    QCOMPARE(database.lookup(0xffffff, info), false);
+    QCOMPARE(database.lookup(0, info), false);
+
+    database.close();
+    QCOMPARE(database.isOpen(), false);
+    QCOMPARE(database.count(), 0);
+    QCOMPARE(database.lookup(0x3c6586, info), false);
+}
+
+void AircraftDbTest::duplicateTest()
+{
+    QVERIFY(_dir.isValid());
+    const QString fileName = _dir.filePath("duplicate.db");
+
+    //столбцы определяются по имени, адрес в любом регистре
+    const QByteArray csv =
+            "registration,icao,owner,type\n"
+            "FIRST,3c6586,Lufthansa,A320\n"
+            "RA-89001,4242A1,Aeroflot,SU95\n"
+            "SECOND,3C6586,Lufthansa,A320\n"
+            "LAST, 3c6586 ,Lufthansa Cargo,B77L\n";
+    QCOMPARE(build(csv, fileName), 4);
+
+    AircraftDatabase database;
+    QVERIFY(database.open(fileName));
+    QCOMPARE(database.count(), 2);
+
+    //остаётся последняя запись адреса
+    AircraftInfo info;
+    QVERIFY(database.lookup(0x3c6586, info));
+    QCOMPARE(info.registration, QString("LAST"));
+    QCOMPARE(info.type, QString("B77L"));
+    QCOMPARE(info.owner, QString("Lufthansa Cargo"));
+
+    QVERIFY(database.lookup(0x4242a1, info));
+    QCOMPARE(info.registration, QString("RA-89001"));
+}
+
+void AircraftDbTest::missingColumnTest()
+{
+    QVERIFY(_dir.isValid());
+    const QString fileName = _dir.filePath("missing.db");
+
+    QCOMPARE(build("registration,typecode\nD-AIPX,A320\n", fileName), -1);
+    QCOMPARE(build(QByteArray(), fileName), -1);
+    QCOMPARE(QFile::exists(fileName), false);
+
+    AircraftDatabase database;
+    QCOMPARE(database.open(fileName), false);
+    QCOMPARE(database.isOpen(), false);
+}
+
+void AircraftDbTest::corruptFileTest()
+{
+    QVERIFY(_dir.isValid());
+    const QString fileName = _dir.filePath("valid.db");
+    const QString corrupt = _dir.filePath("corrupt.db");
+
+    QCOMPARE(build("icao24,registration,typecode,operator\n"
+                   "3c6586,D-AIPX,A320,Lufthansa\n"
+                   "4242a1,RA-89001,SU95,Aeroflot\n", fileName), 2);
+    const QByteArray valid = readFile(fileName);
+    QVERIFY(!valid.isEmpty());
+
+    QVector<QByteArray> damaged;
+
+    //неверная сигнатура
+    QByteArray data = valid;
+    data[0] = 'X';
+    damaged.append(data);
+
+    //неизвестная версия
+    data = valid;
+    const uint32_t version = AIRCRAFT_DB_VERSION + 1;
+    memcpy(data.data() + offsetof(AircraftDbHeader, version), &version, sizeof(version));
+    damaged.append(data);
+
+    //записи выходят за конец файла
+    data = valid;
+    const uint32_t count = 0x10000000;
+    memcpy(data.data() + offsetof(AircraftDbHeader, count), &count, sizeof(count));
+    damaged.append(data);
+
+    //пул строк усечен
+    damaged.append(valid.left(valid.size() - 1));
+
+    //файл короче заголовка и пустой файл
+    damaged.append(valid.left(int(sizeof(AircraftDbHeader)) - 1));
+    damaged.append(QByteArray());
+
+    for(const QByteArray& file : damaged)
+    {
+        QVERIFY(writeFile(corrupt, file));
+
+        //неудачное открытие закрывает ранее открытый файл
+        AircraftDatabase database;
+        QVERIFY(database.open(fileName));
+
+        AircraftInfo info;
+        QCOMPARE(database.open(corrupt), false);
+        QCOMPARE(database.isOpen(), false);
+        QCOMPARE(database.count(), 0);
+        QCOMPARE(database.lookup(0x3c6586, info), false);
+    }
+
+    AircraftDatabase database;
+    QCOMPARE(database.open(_dir.filePath("absent.db")), false);
+    QCOMPARE(database.isOpen(), false);
+}
+
+QTEST_APPLESS_MAIN(AircraftDbTest)
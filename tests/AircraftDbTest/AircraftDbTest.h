@@ -0,0 +1,40 @@
+#ifndef AIRCRAFTDBTEST_H
+#define AIRCRAFTDBTEST_H
+
+#include <QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/database/AircraftDatabase.h"
+#include "../MyApp/AircraftDbBuilder/AircraftDbWriter.h"
+
+/*!
+ * \brief The AircraftDbTest class
+ * Проверка AircraftDbWriter и AircraftDatabase: файл, сформированный
+ * из CSV-файла, открывается отображением в память, поиск находит
+ * записи независимо от порядка строк CSV, из повторяющихся адресов
+ * остаётся последняя запись, отсутствующий адрес не находится;
+ * файл с неверной сигнатурой, версией или размером не открывается
+ */
+class AircraftDbTest : public QObject
+{
+    Q_OBJECT
+    ///< каталог временных файлов
+    QTemporaryDir _dir;
+
+    static bool writeFile(const QString& fileName, const QByteArray& data);
+    static QByteArray readFile(const QString& fileName);
+    /*!
+     * \brief build формирование справочника из CSV-файла
+     * \return количество записей CSV-файла или -1 при ошибке
+     */
+    int build(const QByteArray& csv, const QString& fileName);
+
+private Q_SLOTS:
+    void roundTripTest();
+    void duplicateTest();
+    void missingColumnTest();
+    void corruptFileTest();
+};
+
+#endif // AIRCRAFTDBTEST_H
@@ -0,0 +1,30 @@
+#-------------------------------------------------
+#
+# Проверка справочника самолётов: формирование файла
+# из CSV-файла, поиск по отображению файла в память,
+# отказ от поврежденного файла
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = AircraftDbTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    AircraftDbTest.cpp \
+    ../../src/MyApp/AircraftDbBuilder/AircraftDbWriter.cpp
+
+HEADERS += \
+    AircraftDbTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
+
+LIBS += -lPoolObject
@@ -0,0 +1,285 @@
+#include "ArchiveCodecTest.h"
+
+#include <algorithm>
+#include <limits>
+#include <math.h>
+#include <string.h>
+
+ArchivePoint ArchiveCodecTest::makePoint(uint32_t icao, int64_t time,
+                                         double latitude, double longitude,
+                                         float altitude, float speed, float course)
+{
+    ArchivePoint point;
+    point.icao = icao;
+    point.time = time;
+    point.latitude = latitude;
+    point.longitude = longitude;
+    point.altitude = altitude;
+    point.speed = speed;
+    point.course = course;
+    return point;
+}
+
+bool ArchiveCodecTest::roundTrip(const QVector<ArchivePoint> &points,
+                                 QVector<ArchivePoint> &decoded,
+                                 SegmentBlockHeader *header)
+{
+    const QByteArray block = BlockCodec::encode(points);
+    if(block.size() < int(sizeof(SegmentBlockHeader)))
+        return false;
+
+    SegmentBlockHeader blockHeader;
+    memcpy(&blockHeader, block.constData(), sizeof(blockHeader));
+    if(header != nullptr)
+        *header = blockHeader;
+
+    decoded.clear();
+    return BlockCodec::decode(blockHeader,
+                              block.mid(int(sizeof(blockHeader))),
+                              BlockFilter(),
+                              decoded);
+}
+
+void ArchiveCodecTest::compare(const QVector<ArchivePoint> &expected,
+                               const QVector<ArchivePoint> &decoded)
+{
+    QCOMPARE(decoded.size(), expected.size());
+    for(int i = 0; i < expected.size(); i++)
+    {
+        const ArchivePoint& a = expected.at(i);
+        const ArchivePoint& b = decoded.at(i);
+
+        QCOMPARE(b.icao, a.icao);
+        QCOMPARE(b.time, a.time);
+        QCOMPARE(BlockCodec::toCoord(b.latitude), BlockCodec::toCoord(a.latitude));
+        QCOMPARE(BlockCodec::toCoord(b.longitude), BlockCodec::toCoord(a.longitude));
+        QCOMPARE(b.altitude, float(lround(a.altitude)));
+        QVERIFY(qAbs(b.speed - a.speed) <= SEGMENT_TENTH_LSB / 2 + 1e-4);
+        QVERIFY(qAbs(b.course - a.course) <= SEGMENT_TENTH_LSB / 2 + 1e-4);
+    }
+}
+
+void ArchiveCodecTest::varintSizeTest()
+{
+    QVector<ArchivePoint> points;
+    SegmentBlockHeader header;
+    QVector<ArchivePoint> decoded;
+
+    //все разности нулевые, кроме адреса: 7 столбцов по 1 байту размера
+    //и 1 байту значения
+    points.append(makePoint(1, BASE_TIME, 0.0, 0.0));
+    QVERIFY(roundTrip(points, decoded, &header));
+    QCOMPARE(header.payloadSize, uint32_t(14));
+    compare(points, decoded);
+
+    //zigzag(63) = 126 - 1 байт, zigzag(64) = 128 - 2 байта
+    points[0].icao = 63;
+    QVERIFY(roundTrip(points, decoded, &header));
+    QCOMPARE(header.payloadSize, uint32_t(14));
+    compare(points, decoded);
+
+    points[0].icao = 64;
+    QVERIFY(roundTrip(points, decoded, &header));
+    QCOMPARE(header.payloadSize, uint32_t(15));
+    compare(points, decoded);
+
+    //zigzag(-64) = 127 - 1 байт, zigzag(-65) = 129 - 2 байта
+    points[0].icao = 1;
+    points[0].altitude = -64.0f;
+    QVERIFY(roundTrip(points, decoded, &header));
+    QCOMPARE(header.payloadSize, uint32_t(14));
+    compare(points, decoded);
+
+    points[0].altitude = -65.0f;
+    QVERIFY(roundTrip(points, decoded, &header));
+    QCOMPARE(header.payloadSize, uint32_t(15));
+    compare(points, decoded);
+}
+
+void ArchiveCodecTest::varintBoundaryTest()
+{
+    //разности на границах длины: 7, 14, 21, 28, 35 и 42 бита
+    const int64_t deltas[] = { 0, 1, 63, 64, 127, 128,
+                               8191, 8192, 16383, 16384,
+                               (int64_t(1) << 20) - 1, int64_t(1) << 20,
+                               (int64_t(1) << 27) - 1, int64_t(1) << 27,
+                               (int64_t(1) << 34) - 1, int64_t(1) << 34,
+                               (int64_t(1) << 41) - 1, int64_t(1) << 41 };
+
+    QVector<ArchivePoint> points;
+    int64_t time = BASE_TIME;
+    int32_t lat = 0;
+    for(int64_t delta : deltas)
+    {
+        time += delta;
+        //разность координаты с чередованием знака
+        lat = (lat > 0) ? -int32_t(delta % 9000000) : int32_t(delta % 9000000);
+        points.append(makePoint(0x3c6586, time, BlockCodec::fromCoord(lat),
+                                BlockCodec::fromCoord(-lat)));
+    }
+
+    QVector<ArchivePoint> decoded;
+    QVERIFY(roundTrip(points, decoded));
+    compare(points, decoded);
+}
+
+void ArchiveCodecTest::negativeDeltaTest()
+{
+    //при смене адреса время и координаты идут назад
+    QVector<ArchivePoint> points;
+    points.append(makePoint(0x100000, BASE_TIME + 3600000, 89.99999, 179.99999,
+                            12000.0f, 950.0f, 359.9f));
+    points.append(makePoint(0x200000, BASE_TIME, -89.99999, -179.99999,
+                            -300.0f, 0.0f, 0.0f));
+    points.append(makePoint(0x200000, BASE_TIME + 1, 0.00001, -0.00001,
+                            -299.0f, 0.1f, 0.1f));
+    points.append(makePoint(0xffffff, BASE_TIME - 3600000, -45.5, 37.6,
+                            0.4f, 1234.5f, 180.0f));
+
+    SegmentBlockHeader header;
+    QVector<ArchivePoint> decoded;
+    QVERIFY(roundTrip(points, decoded, &header));
+    compare(points, decoded);
+
+    QCOMPARE(header.timeMin, int64_t(BASE_TIME - 3600000));
+    QCOMPARE(header.timeMax, int64_t(BASE_TIME + 3600000));
+    QCOMPARE(header.latMin, BlockCodec::toCoord(-89.99999));
+    QCOMPARE(header.lonMax, BlockCodec::toCoord(179.99999));
+}
+
+void ArchiveCodecTest::wideDeltaTest()
+{
+    //разность времени около 2^62: 10 байт после зигзаг-кодирования
+    const int64_t far = std::numeric_limits<int64_t>::max() / 2;
+
+    QVector<ArchivePoint> points;
+    points.append(makePoint(1, 0, 0.0, 0.0));
+    points.append(makePoint(1, far, 0.0, 0.0));
+    points.append(makePoint(2, 0, 0.0, 0.0));
+
+    QVector<ArchivePoint> decoded;
+    QVERIFY(roundTrip(points, decoded));
+    compare(points, decoded);
+}
+
+void ArchiveCodecTest::randomBlockTest()
+{
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<double> latitude(-90.0, 90.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::uniform_real_distribution<float> altitude(-500.0f, 15000.0f);
+    std::uniform_real_distribution<float> speed(0.0f, 1200.0f);
+    std::uniform_real_distribution<float> course(0.0f, 360.0f);
+
+    QVector<ArchivePoint> points;
+    for(int i = 0; i < SEGMENT_MAX_BLOCK_POINTS; i++)
+        points.append(makePoint(rng() & 0xffffff,
+                                BASE_TIME + int64_t(rng() % SEGMENT_DURATION),
+                                latitude(rng), longitude(rng),
+                                altitude(rng), speed(rng), course(rng)));
+
+    //точки блока упорядочены по адресу и времени
+    std::sort(points.begin(), points.end(), [](const ArchivePoint& a, const ArchivePoint& b)
+    {
+        return (a.icao != b.icao) ? a.icao < b.icao : a.time < b.time;
+    });
+
+    QVector<ArchivePoint> decoded;
+    QVERIFY(roundTrip(points, decoded));
+    compare(points, decoded);
+}
+
+void ArchiveCodecTest::filterTest()
+{
+    QVector<ArchivePoint> points;
+    for(int i = 0; i < 10; i++)
+        points.append(makePoint(0x100000, BASE_TIME + i * 1000, 55.0 + i * 0.1, 37.0));
+    for(int i = 0; i < 10; i++)
+        points.append(makePoint(0x200000, BASE_TIME + i * 1000, 59.0, 30.0 + i * 0.1));
+
+    const QByteArray block = BlockCodec::encode(points);
+    SegmentBlockHeader header;
+    memcpy(&header, block.constData(), sizeof(header));
+    const QByteArray payload = block.mid(int(sizeof(header)));
+
+    QVector<ArchivePoint> decoded;
+    BlockFilter filter;
+    filter.icao = 0x200000;
+    QVERIFY(BlockCodec::decode(header, payload, filter, decoded));
+    QCOMPARE(decoded.size(), 10);
+    for(const ArchivePoint& point : decoded)
+        QCOMPARE(point.icao, uint32_t(0x200000));
+
+    decoded.clear();
+    filter = BlockFilter();
+    filter.from = BASE_TIME + 2000;
+    filter.to = BASE_TIME + 4000;
+    QVERIFY(BlockCodec::decode(header, payload, filter, decoded));
+    QCOMPARE(decoded.size(), 6);
+
+    decoded.clear();
+    filter = BlockFilter();
+    filter.useRect = true;
+    filter.latMin = BlockCodec::toCoord(55.25);
+    filter.latMax = BlockCodec::toCoord(55.55);
+    filter.lonMin = BlockCodec::toCoord(36.0);
+    filter.lonMax = BlockCodec::toCoord(38.0);
+    QVERIFY(filter.overlaps(header));
+    QVERIFY(BlockCodec::decode(header, payload, filter, decoded));
+    QCOMPARE(decoded.size(), 3);
+
+    //блок вне интервала пропускается по заголовку
+    filter = BlockFilter();
+    filter.from = BASE_TIME + 10000;
+    QCOMPARE(filter.overlaps(header), false);
+
+    //и вне диапазона адресов ICAO
+    QCOMPARE(header.icaoMin, uint32_t(0x100000));
+    QCOMPARE(header.icaoMax, uint32_t(0x200000));
+    filter = BlockFilter();
+    filter.icao = 0x180000;
+    QVERIFY(filter.overlaps(header));
+    filter.icao = 0x0fffff;
+    QCOMPARE(filter.overlaps(header), false);
+    filter.icao = 0x200001;
+    QCOMPARE(filter.overlaps(header), false);
+}
+
+void ArchiveCodecTest::corruptionTest()
+{
+    QVector<ArchivePoint> points;
+    for(int i = 0; i < 100; i++)
+        points.append(makePoint(0x3c6586, BASE_TIME + i * 500, 55.75 + i * 0.001, 37.6,
+                                float(1000 + i), 800.0f, 90.0f));
+
+    const QByteArray block = BlockCodec::encode(points);
+    SegmentBlockHeader header;
+    memcpy(&header, block.constData(), sizeof(header));
+    const QByteArray payload = block.mid(int(sizeof(header)));
+
+    //любой измененный бит обнаруживается CRC-32
+    for(int i = 0; i < payload.size(); i++)
+    {
+        for(int bit = 0; bit < 8; bit++)
+        {
+            QByteArray damaged = payload;
+            damaged[i] = char(damaged.at(i) ^ (1 << bit));
+
+            QVector<ArchivePoint> decoded;
+            QCOMPARE(BlockCodec::decode(header, damaged, BlockFilter(), decoded), false);
+            QVERIFY(decoded.isEmpty());
+        }
+    }
+
+    //усеченные данные
+    QVector<ArchivePoint> decoded;
+    QCOMPARE(BlockCodec::decode(header, payload.left(payload.size() - 1),
+                                BlockFilter(), decoded), false);
+
+    //данные целы, но заголовок обещает больше точек, чем в столбцах
+    SegmentBlockHeader wrongCount = header;
+    wrongCount.count = header.count + 1;
+    QCOMPARE(BlockCodec::decode(wrongCount, payload, BlockFilter(), decoded), false);
+}
+
+QTEST_APPLESS_MAIN(ArchiveCodecTest)
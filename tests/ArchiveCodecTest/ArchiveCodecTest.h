@@ -0,0 +1,53 @@
+#ifndef ARCHIVECODECTEST_H
+#define ARCHIVECODECTEST_H
+
+#include <QtTest>
+#include <QObject>
+#include <random>
+
+#include "interface/ITrackArchive.h"
+#include "../MyLib/RTL_SDR_RadarLib/TrackArchive/segment/BlockCodec.h"
+
+/*!
+ * \brief The ArchiveCodecTest class
+ * Проверка BlockCodec: кодирование и декодирование столбцов блока
+ * без потерь сверх квантования, в том числе разностей на границах
+ * длины целого переменной длины, отрицательных и 64-битных разностей.
+ * Генератор инициализируется постоянным значением
+ */
+class ArchiveCodecTest : public QObject
+{
+    Q_OBJECT
+    static constexpr uint32_t SEED = 20200110;
+    ///< время начала, мс с начала эпохи
+    static constexpr int64_t BASE_TIME = 1577836800000;
+
+    static ArchivePoint makePoint(uint32_t icao, int64_t time,
+                                  double latitude, double longitude,
+                                  float altitude = 0.0f,
+                                  float speed = 0.0f,
+                                  float course = 0.0f);
+    /*!
+     * \brief roundTrip кодирование и декодирование блока без отбора
+     * \return false - блок не декодирован
+     */
+    static bool roundTrip(const QVector<ArchivePoint>& points,
+                          QVector<ArchivePoint>& decoded,
+                          SegmentBlockHeader* header = nullptr);
+    /*!
+     * \brief compare сравнение точек с учетом квантования
+     */
+    static void compare(const QVector<ArchivePoint>& expected,
+                        const QVector<ArchivePoint>& decoded);
+
+private Q_SLOTS:
+    void varintSizeTest();
+    void varintBoundaryTest();
+    void negativeDeltaTest();
+    void wideDeltaTest();
+    void randomBlockTest();
+    void filterTest();
+    void corruptionTest();
+};
+
+#endif // ARCHIVECODECTEST_H
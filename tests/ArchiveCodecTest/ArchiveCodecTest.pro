@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Проверка кодирования блоков архива траекторий:
+# разности в зигзаг-кодировании, целые переменной длины,
+# отбор точек и контрольная сумма
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = ArchiveCodecTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    ArchiveCodecTest.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/TrackArchive/segment/BlockCodec.cpp \
+    ../../src/include/protocol/Crc32.cpp
+
+HEADERS += \
+    ArchiveCodecTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
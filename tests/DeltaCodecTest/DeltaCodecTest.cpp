@@ -0,0 +1,261 @@
+#include "DeltaCodecTest.h"
+
+#include <string.h>
+
+StructAircraft DeltaCodecTest::makeAircraft(uint32_t icao, int64_t seen)
+{
+    StructAircraft a;
+    memset(&a, 0, sizeof(a));
+    a.icao = icao;
+    snprintf(a.flight, sizeof(a.flight), "AFL%05u", icao % 100000);
+    a.altitude = 10000 + icao % 1000;
+    a.speed = 800;
+    a.course = 90;
+    a.lat = 55750000 + int32_t(icao % 1000);
+    a.lon = 37600000 - int32_t(icao % 1000);
+    a.seen = seen;
+    a.messages = 10;
+    return a;
+}
+
+QVector<StructAircraft> DeltaCodecTest::makeObjects(int count, int64_t seen)
+{
+    QVector<StructAircraft> objects;
+    for(int i = 0; i < count; i++)
+        objects.append(makeAircraft(0x4b0000 + uint32_t(i), seen - i * 100));
+    return objects;
+}
+
+DeltaHeader DeltaCodecTest::header(const QByteArray &message)
+{
+    DeltaHeader header;
+    memset(&header, 0, sizeof(header));
+    if(message.size() >= int(sizeof(header)))
+        memcpy(&header, message.constData(), sizeof(header));
+    return header;
+}
+
+void DeltaCodecTest::compare(const DeltaDecoder &decoder,
+                             const QVector<StructAircraft> &objects)
+{
+    QCOMPARE(decoder.objects().size(), objects.size());
+    for(const StructAircraft& expected : objects)
+    {
+        //поля упакованной структуры читаются копией
+        const uint32_t icao = expected.icao;
+        QVERIFY(decoder.objects().contains(icao));
+        const StructAircraft a = decoder.objects().value(icao);
+
+        QCOMPARE(a.icao, expected.icao);
+        QCOMPARE(QByteArray(a.flight), QByteArray(expected.flight));
+        QCOMPARE(a.altitude, expected.altitude);
+        QCOMPARE(a.speed, expected.speed);
+        QCOMPARE(a.course, expected.course);
+        QCOMPARE(a.lat, expected.lat);
+        QCOMPARE(a.lon, expected.lon);
+        QCOMPARE(a.seen, expected.seen);
+        QCOMPARE(a.messages, expected.messages);
+    }
+}
+
+void DeltaCodecTest::keyframeTest()
+{
+    DeltaEncoder encoder;
+    DeltaDecoder decoder;
+    QCOMPARE(decoder.isSynced(), false);
+
+    const QVector<StructAircraft> objects = makeObjects(3, BASE_TIME);
+    const QByteArray message = encoder.encode(objects, BASE_TIME);
+
+    //первое сообщение - полный кадр со всеми полями
+    const DeltaHeader h = header(message);
+    QCOMPARE(h.magic, DELTA_MAGIC);
+    QCOMPARE(h.type, DELTA_KEYFRAME);
+    QCOMPARE(h.seq, uint32_t(1));
+    QCOMPARE(h.size, uint32_t(message.size()));
+    QCOMPARE(h.updateCount, uint16_t(3));
+    QCOMPARE(h.removeCount, uint16_t(0));
+    QCOMPARE(DeltaDecoder::messageSize(message), message.size());
+
+    QVERIFY(decoder.apply(message));
+    QVERIFY(decoder.isSynced());
+    QCOMPARE(decoder.updated().size(), 3);
+    compare(decoder, objects);
+
+    //полный кадр заменяет состояние целиком
+    const QVector<StructAircraft> other = makeObjects(1, BASE_TIME + 1000);
+    encoder.reset();
+    const QByteArray keyframe = encoder.encode(other, BASE_TIME + 1000);
+    QCOMPARE(header(keyframe).type, DELTA_KEYFRAME);
+    QVERIFY(decoder.apply(keyframe));
+    compare(decoder, other);
+}
+
+void DeltaCodecTest::fieldMaskTest()
+{
+    DeltaEncoder encoder;
+    DeltaDecoder decoder;
+
+    QVector<StructAircraft> objects = makeObjects(3, BASE_TIME);
+    QVERIFY(decoder.apply(encoder.encode(objects, BASE_TIME)));
+
+    //без изменений сообщение не формируется
+    QVERIFY(encoder.encode(objects, BASE_TIME + 500).isEmpty());
+
+    objects[0].altitude += 100;
+    objects[2].lat += 250;
+    const QByteArray message = encoder.encode(objects, BASE_TIME + 1000);
+
+    const DeltaHeader h = header(message);
+    QCOMPARE(h.type, DELTA_UPDATE);
+    QCOMPARE(h.baseSeq, uint32_t(1));
+    QCOMPARE(h.seq, uint32_t(2));
+    QCOMPARE(h.updateCount, uint16_t(2));
+    QCOMPARE(h.removeCount, uint16_t(0));
+
+    //записи содержат только изменённые поля
+    QCOMPARE(message.size(), int(sizeof(DeltaHeader) + 2 * sizeof(uint32_t) +
+                                 sizeof(objects[0].altitude) + sizeof(objects[2].lat)));
+    uint32_t key;
+    memcpy(&key, message.constData() + sizeof(DeltaHeader), sizeof(key));
+    QCOMPARE(key & 0xffffff, objects[0].icao);
+    QCOMPARE(uint8_t(key >> 24), DELTA_FIELD_ALTITUDE);
+    memcpy(&key, message.constData() + sizeof(DeltaHeader) + sizeof(key) +
+           sizeof(objects[0].altitude), sizeof(key));
+    QCOMPARE(key & 0xffffff, objects[2].icao);
+    QCOMPARE(uint8_t(key >> 24), DELTA_FIELD_LAT);
+
+    QVERIFY(decoder.apply(message));
+    QCOMPARE(decoder.updated().size(), 2);
+    QCOMPARE(decoder.updated().at(0), objects[0].icao);
+    QCOMPARE(decoder.updated().at(1), objects[2].icao);
+    compare(decoder, objects);
+
+    //время последнего сообщения передается смещением от времени сообщения
+    objects[1].seen = BASE_TIME + 1900;
+    strcpy(objects[1].flight, "SBI1234");
+    const QByteArray seen = encoder.encode(objects, BASE_TIME + 2000);
+    QCOMPARE(header(seen).updateCount, uint16_t(1));
+    memcpy(&key, seen.constData() + sizeof(DeltaHeader), sizeof(key));
+    QCOMPARE(uint8_t(key >> 24), uint8_t(DELTA_FIELD_FLIGHT | DELTA_FIELD_SEEN));
+
+    QVERIFY(decoder.apply(seen));
+    compare(decoder, objects);
+}
+
+void DeltaCodecTest::removalTest()
+{
+    DeltaEncoder encoder;
+    DeltaDecoder decoder;
+
+    QVector<StructAircraft> objects = makeObjects(3, BASE_TIME);
+    QVERIFY(decoder.apply(encoder.encode(objects, BASE_TIME)));
+
+    const uint32_t removed = objects.at(1).icao;
+    objects.remove(1);
+    const QByteArray message = encoder.encode(objects, BASE_TIME + 1000);
+
+    DeltaHeader h = header(message);
+    QCOMPARE(h.type, DELTA_UPDATE);
+    QCOMPARE(h.updateCount, uint16_t(0));
+    QCOMPARE(h.removeCount, uint16_t(1));
+    uint32_t icao;
+    memcpy(&icao, message.constData() + sizeof(DeltaHeader), sizeof(icao));
+    QCOMPARE(icao, removed);
+
+    QVERIFY(decoder.apply(message));
+    QCOMPARE(decoder.updated().size(), 0);
+    QCOMPARE(decoder.objects().contains(removed), false);
+    compare(decoder, objects);
+
+    //новый самолёт передается всеми полями
+    objects.append(makeAircraft(0x4c0001, BASE_TIME + 1500));
+    const QByteArray added = encoder.encode(objects, BASE_TIME + 2000);
+    h = header(added);
+    QCOMPARE(h.updateCount, uint16_t(1));
+    QCOMPARE(h.removeCount, uint16_t(0));
+    uint32_t key;
+    memcpy(&key, added.constData() + sizeof(DeltaHeader), sizeof(key));
+    QCOMPARE(uint8_t(key >> 24), DELTA_FIELD_ALL);
+
+    QVERIFY(decoder.apply(added));
+    compare(decoder, objects);
+}
+
+void DeltaCodecTest::sequenceGapTest()
+{
+    DeltaEncoder encoder;
+    DeltaDecoder decoder;
+
+    QVector<StructAircraft> objects = makeObjects(4, BASE_TIME);
+    QVERIFY(decoder.apply(encoder.encode(objects, BASE_TIME)));
+
+    //сообщение потеряно - следующие разностные не применяются
+    objects[0].altitude += 100;
+    const QByteArray lost = encoder.encode(objects, BASE_TIME + 1000);
+    QVERIFY(lost.isEmpty() != true);
+
+    objects[1].speed += 10;
+    QCOMPARE(decoder.apply(encoder.encode(objects, BASE_TIME + 2000)), false);
+    QCOMPARE(decoder.isSynced(), false);
+
+    objects[2].course += 5;
+    QCOMPARE(decoder.apply(encoder.encode(objects, BASE_TIME + 3000)), false);
+    QCOMPARE(decoder.isSynced(), false);
+
+    //полный кадр восстанавливает состояние
+    encoder.reset();
+    const QByteArray keyframe = encoder.encode(objects, BASE_TIME + 4000);
+    QCOMPARE(header(keyframe).type, DELTA_KEYFRAME);
+    QVERIFY(decoder.apply(keyframe));
+    QVERIFY(decoder.isSynced());
+    compare(decoder, objects);
+
+    //полный кадр передается и по истечении периода
+    encoder.setKeyframeInterval(5000);
+    objects[3].messages += 1;
+    QCOMPARE(header(encoder.encode(objects, BASE_TIME + 5000)).type, DELTA_UPDATE);
+    objects[3].messages += 1;
+    QCOMPARE(header(encoder.encode(objects, BASE_TIME + 9000)).type, DELTA_KEYFRAME);
+}
+
+void DeltaCodecTest::truncatedTest()
+{
+    DeltaEncoder encoder;
+    DeltaDecoder decoder;
+
+    QVector<StructAircraft> objects = makeObjects(3, BASE_TIME);
+    const QByteArray keyframe = encoder.encode(objects, BASE_TIME);
+
+    //заголовок не принят полностью или неверная сигнатура
+    QCOMPARE(DeltaDecoder::messageSize(keyframe.left(int(sizeof(DeltaHeader)) - 1)), 0);
+    QByteArray wrongMagic = keyframe;
+    wrongMagic[0] = char(wrongMagic.at(0) ^ 0xff);
+    QCOMPARE(DeltaDecoder::messageSize(wrongMagic), -1);
+    QCOMPARE(decoder.apply(wrongMagic), false);
+
+    QVERIFY(decoder.apply(keyframe));
+
+    objects[0].altitude += 100;
+    objects[1].lon += 100;
+    const QByteArray message = encoder.encode(objects, BASE_TIME + 1000);
+
+    //размер не совпадает с заголовком - сообщение отбрасывается целиком
+    QCOMPARE(decoder.apply(message.left(message.size() - 1)), false);
+    QVERIFY(decoder.isSynced());
+
+    //размер в заголовке исправлен, но последней записи не хватает данных
+    QByteArray truncated = message.left(message.size() - 1);
+    const uint32_t size = uint32_t(truncated.size());
+    memcpy(truncated.data() + offsetof(DeltaHeader, size), &size, sizeof(size));
+    QCOMPARE(decoder.apply(truncated), false);
+    QCOMPARE(decoder.isSynced(), false);
+
+    //до следующего полного кадра состояние не восстанавливается
+    QCOMPARE(decoder.apply(message), false);
+    encoder.reset();
+    QVERIFY(decoder.apply(encoder.encode(objects, BASE_TIME + 2000)));
+    compare(decoder, objects);
+}
+
+QTEST_APPLESS_MAIN(DeltaCodecTest)
@@ -0,0 +1,41 @@
+#ifndef DELTACODECTEST_H
+#define DELTACODECTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "protocol/DeltaEncoder.h"
+#include "protocol/DeltaDecoder.h"
+
+/*!
+ * \brief The DeltaCodecTest class
+ * Проверка DeltaEncoder и DeltaDecoder: состояние декодера после
+ * каждого сообщения совпадает с переданным кодеру списком самолётов,
+ * разностное сообщение содержит только изменённые поля, после пропуска
+ * сообщения декодер ждет полный кадр, поврежденное сообщение
+ * не применяется
+ */
+class DeltaCodecTest : public QObject
+{
+    Q_OBJECT
+    ///< время начала, мс с начала эпохи
+    static constexpr int64_t BASE_TIME = 1577836800000;
+
+    static StructAircraft makeAircraft(uint32_t icao, int64_t seen);
+    static QVector<StructAircraft> makeObjects(int count, int64_t seen);
+    static DeltaHeader header(const QByteArray& message);
+    /*!
+     * \brief compare сравнение состояния декодера со списком самолётов
+     */
+    static void compare(const DeltaDecoder& decoder,
+                        const QVector<StructAircraft>& objects);
+
+private Q_SLOTS:
+    void keyframeTest();
+    void fieldMaskTest();
+    void removalTest();
+    void sequenceGapTest();
+    void truncatedTest();
+};
+
+#endif // DELTACODECTEST_H
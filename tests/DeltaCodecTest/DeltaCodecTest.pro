@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Проверка инкрементального протокола приемного пункта:
+# полный кадр, изменённые поля, удаления, восстановление
+# после пропуска сообщения и поврежденные сообщения
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = DeltaCodecTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    DeltaCodecTest.cpp \
+    ../../src/include/protocol/DeltaEncoder.cpp \
+    ../../src/include/protocol/DeltaDecoder.cpp
+
+HEADERS += \
+    DeltaCodecTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
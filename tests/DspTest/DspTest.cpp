@@ -0,0 +1,156 @@
+#include "DspTest.h"
+
+#include <math.h>
+#include <QElapsedTimer>
+#include <QThread>
+
+SpectrumConfig DspTest::makeConfig()
+{
+    SpectrumConfig config;
+    config.fftSize = FFT_SIZE;
+    config.decimation = 1;
+    config.averages = 1;
+    config.blockStride = 1;
+    config.waterfallRows = WATERFALL_ROWS;
+    return config;
+}
+
+QVector<uint8_t> DspTest::makeTone(int bin, int count, double amplitude)
+{
+    QVector<uint8_t> samples(2 * count);
+    const double scale = 127.5 * amplitude;
+    for(int k = 0; k < count; k++)
+    {
+        const double phase = 2.0 * M_PI * bin * k / FFT_SIZE;
+        const long i = lround(127.5 + scale * cos(phase));
+        const long q = lround(127.5 + scale * sin(phase));
+        samples[2 * k] = uint8_t(qBound(0L, i, 255L));
+        samples[2 * k + 1] = uint8_t(qBound(0L, q, 255L));
+    }
+    return samples;
+}
+
+int DspTest::peakIndex(const float *row, int size)
+{
+    int peak = 0;
+    for(int i = 1; i < size; i++)
+        if(row[i] > row[peak])
+            peak = i;
+    return peak;
+}
+
+int DspTest::rowIndex(int bin)
+{
+    return (bin - (FFT_SIZE + 1) / 2 + FFT_SIZE) % FFT_SIZE;
+}
+
+bool DspTest::pushRow(SpectrumEngine &engine, const QVector<uint8_t> &samples)
+{
+    const uint64_t rows = engine.spectrumFrame().rows;
+    engine.makeAll(samples);
+
+    QElapsedTimer timer;
+    timer.start();
+    while(engine.spectrumFrame().rows == rows)
+    {
+        if(timer.elapsed() > ROW_TIMEOUT)
+            return false;
+        QThread::msleep(1);
+    }
+    return true;
+}
+
+void DspTest::fftPeakTest()
+{
+    SpectrumEngine engine(makeConfig());
+
+    const int bins[] = { 0, 1, 5, 17, 31, 40, 63 };
+    for(int bin : bins)
+    {
+        const SrcDataAdc result = engine.makeFFT(makeTone(bin, FFT_SIZE));
+        QCOMPARE(result.fftVector.size(), FFT_SIZE);
+
+        int peak = 0;
+        for(int k = 1; k < FFT_SIZE; k++)
+            if(std::abs(result.fftVector.at(k)) > std::abs(result.fftVector.at(peak)))
+                peak = k;
+        QCOMPARE(peak, bin);
+    }
+
+    //меньше fftSize отсчетов - расчет не выполняется
+    QVERIFY(engine.makeFFT(makeTone(5, FFT_SIZE - 1)).fftVector.isEmpty());
+}
+
+void DspTest::fullScaleTest()
+{
+    SpectrumEngine engine(makeConfig());
+    const int bin = 5;
+
+    QVERIFY(pushRow(engine, makeTone(bin, FFT_SIZE)));
+    SpectrumFrame frame = engine.spectrumFrame();
+    QCOMPARE(frame.bins, FFT_SIZE);
+    QCOMPARE(frame.spectrum.size(), FFT_SIZE);
+    QCOMPARE(peakIndex(frame.spectrum.constData(), FFT_SIZE), rowIndex(bin));
+
+    //тон полной шкалы на частоте отсчета БПФ дает 0 дБ
+    QVERIFY(qAbs(frame.spectrum.at(rowIndex(bin))) < 0.5f);
+
+    //вдали от тона остаются только шумы квантования
+    for(int k = 0; k < FFT_SIZE; k++)
+        if(qAbs(k - bin) > 2)
+            QVERIFY(frame.spectrum.at(rowIndex(k)) < -30.0f);
+
+    //половина шкалы - минус 6 дБ
+    QVERIFY(pushRow(engine, makeTone(bin, FFT_SIZE, 0.5)));
+    frame = engine.spectrumFrame();
+    QVERIFY(qAbs(frame.spectrum.at(rowIndex(bin)) + 6.02f) < 0.5f);
+}
+
+void DspTest::waterfallRotationTest()
+{
+    SpectrumEngine engine(makeConfig());
+
+    //строк больше, чем помещается в водопад: первые две вытесняются
+    const int bins[] = { 4, 8, 12, 16, 20, 24 };
+    for(int bin : bins)
+        QVERIFY(pushRow(engine, makeTone(bin, FFT_SIZE)));
+
+    const SpectrumFrame frame = engine.spectrumFrame();
+    QCOMPARE(frame.rows, uint64_t(6));
+    QCOMPARE(frame.waterfallRows, int(WATERFALL_ROWS));
+    QCOMPARE(frame.waterfall.size(), FFT_SIZE * WATERFALL_ROWS);
+    QCOMPARE(frame.skipped, uint64_t(0));
+
+    //строки от старой к новой
+    for(int r = 0; r < WATERFALL_ROWS; r++)
+    {
+        const float* row = frame.waterfall.constData() + r * FFT_SIZE;
+        QCOMPARE(peakIndex(row, FFT_SIZE), rowIndex(bins[2 + r]));
+    }
+
+    //последняя строка водопада совпадает со спектром
+    const float* last = frame.waterfall.constData() + (WATERFALL_ROWS - 1) * FFT_SIZE;
+    for(int k = 0; k < FFT_SIZE; k++)
+        QCOMPARE(last[k], frame.spectrum.at(k));
+}
+
+void DspTest::shortBlockTest()
+{
+    SpectrumEngine engine(makeConfig());
+
+    //блок короче строки не передается потоку ЦОС и не считается пропущенным
+    engine.makeAll(makeTone(3, FFT_SIZE - 1));
+    QCOMPARE(engine.spectrumFrame().rows, uint64_t(0));
+    QCOMPARE(engine.spectrumFrame().skipped, uint64_t(0));
+
+    //из длинного блока используется окончание
+    QVector<uint8_t> samples = makeTone(9, FFT_SIZE);
+    samples = makeTone(3, FFT_SIZE / 2) + samples;
+    QVERIFY(pushRow(engine, samples));
+
+    const SpectrumFrame frame = engine.spectrumFrame();
+    QCOMPARE(frame.rows, uint64_t(1));
+    QCOMPARE(peakIndex(frame.spectrum.constData(), FFT_SIZE), rowIndex(9));
+}
+
+QTEST_APPLESS_MAIN(DspTest)
@@ -0,0 +1,58 @@
+#ifndef DSPTEST_H
+#define DSPTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "../MyLib/RTL_SDR_RadarLib/DSP/SpectrumEngine.h"
+
+/*!
+ * \brief The DspTest class
+ * Проверка SpectrumEngine на синтетическом комплексном тоне:
+ * номер отсчета максимума синхронного БПФ, уровень 0 дБ для тона
+ * полной шкалы в строке спектра и порядок строк водопада от старой
+ * к новой после переполнения кольцевого буфера
+ */
+class DspTest : public QObject
+{
+    Q_OBJECT
+    ///< размер БПФ
+    static constexpr int FFT_SIZE = 64;
+    ///< строк в водопаде
+    static constexpr int WATERFALL_ROWS = 4;
+    ///< время ожидания строки от потока ЦОС, мс
+    static constexpr int ROW_TIMEOUT = 2000;
+
+    /*!
+     * \brief makeConfig параметры без прореживания и усреднения
+     */
+    static SpectrumConfig makeConfig();
+    /*!
+     * \brief makeTone отсчеты I/Q комплексного тона
+     * \param bin - номер отсчета БПФ, на который приходится тон
+     * \param amplitude - амплитуда относительно полной шкалы АЦП
+     */
+    static QVector<uint8_t> makeTone(int bin, int count, double amplitude = 1.0);
+    /*!
+     * \brief peakIndex номер максимального значения строки
+     */
+    static int peakIndex(const float* row, int size);
+    /*!
+     * \brief rowIndex номер отсчета строки спектра для отсчета БПФ:
+     * в строке нулевая частота находится в центре
+     */
+    static int rowIndex(int bin);
+    /*!
+     * \brief pushRow передача блока и ожидание строки потока ЦОС
+     * \return false - строка не рассчитана за ROW_TIMEOUT
+     */
+    static bool pushRow(SpectrumEngine& engine, const QVector<uint8_t>& samples);
+
+private Q_SLOTS:
+    void fftPeakTest();
+    void fullScaleTest();
+    void waterfallRotationTest();
+    void shortBlockTest();
+};
+
+#endif // DSPTEST_H
@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Проверка модуля ЦОС: положение тона в спектре,
+# уровень тона полной шкалы и порядок строк водопада
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = DspTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    DspTest.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/DSP/SpectrumEngine.cpp
+
+HEADERS += \
+    DspTest.h
+
+LIBS += -lfftw3f
+
+include( ../../common.pri )
+include( ../../app.pri )
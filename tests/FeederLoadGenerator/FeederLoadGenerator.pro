@@ -0,0 +1,38 @@
+#-------------------------------------------------
+#
+# Нагрузочная проверка сбора данных: N приемных пунктов
+# передают синтетические треки серверу IngestServer
+# через петлевой интерфейс
+#
+#-------------------------------------------------
+
+QT       += network
+QT       -= gui
+
+TARGET = FeederLoadGenerator
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    main.cpp \
+    SyntheticTrack.cpp \
+    SyntheticFeeder.cpp \
+    MergeProbe.cpp \
+    ../../src/include/protocol/DeltaEncoder.cpp \
+    ../../src/include/protocol/FrameCodec.cpp \
+    ../../src/include/protocol/Crc32.cpp
+
+HEADERS += \
+    SyntheticTrack.h \
+    SyntheticFeeder.h \
+    MergeProbe.h
+
+include( ../../common.pri )
+include( ../../app.pri )
+
+LIBS += -lNetServer \
+        -lPoolObject
@@ -0,0 +1,78 @@
+#include "MergeProbe.h"
+
+#include <algorithm>
+
+#include "time/Clock.h"
+
+MergeProbe::MergeProbe(QSharedPointer<IPoolObject> pool):
+    _pool(pool)
+{
+
+}
+
+void MergeProbe::start(int period)
+{
+    if(_timer == nullptr)
+    {
+        _timer = new QTimer(this);
+        _timer->setTimerType(Qt::PreciseTimer);
+        connect(_timer, &QTimer::timeout, this, &MergeProbe::slotSample);
+    }
+    _timer->start(period);
+}
+
+void MergeProbe::stop()
+{
+    if(_timer != nullptr)
+        _timer->stop();
+}
+
+void MergeProbe::slotSample()
+{
+    QVector<int64_t> latency;
+
+    const int64_t before = Clock::nowMSec();
+    _pool->lockPool();
+    const int64_t now = Clock::nowMSec();
+
+    for(auto& object : _pool->values())
+    {
+        const int64_t seen = object->getMSecStop();
+        auto it = _lastSeen.find(object->getId());
+        if(it == _lastSeen.end())
+            _lastSeen.insert(object->getId(), seen);
+        else if(it.value() != seen)
+        {
+            it.value() = seen;
+            latency.append(now - seen);
+        }
+    }
+
+    _pool->unlockPool();
+
+    QMutexLocker lock(&_mutex);
+    _latency += latency;
+    _lockWait = qMax(_lockWait, now - before);
+}
+
+MergeLatency MergeProbe::take()
+{
+    QVector<int64_t> latency;
+    MergeLatency result;
+    {
+        QMutexLocker lock(&_mutex);
+        latency.swap(_latency);
+        result.lockWait = _lockWait;
+        _lockWait = 0;
+    }
+
+    result.samples = latency.size();
+    if(latency.isEmpty())
+        return result;
+
+    std::sort(latency.begin(), latency.end());
+    result.p50 = latency.at(latency.size() / 2);
+    result.p99 = latency.at(qMin(latency.size() - 1, latency.size() * 99 / 100));
+    result.max = latency.last();
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef MERGEPROBE_H
+#define MERGEPROBE_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+
+#include "interface/IPoolObject.h"
+
+/*!
+ * @brief  Задержки объединения за интервал измерения
+ */
+struct MergeLatency
+{
+    ///< количество замеров
+    int samples = 0;
+    int64_t p50 = 0;
+    int64_t p99 = 0;
+    int64_t max = 0;
+    ///< наибольшее ожидание блокировки пула, мс
+    int64_t lockWait = 0;
+};
+
+/*!
+ * \brief The MergeProbe class
+ * Измерение задержки объединения на стороне сервера: пул опрашивается
+ * с малым периодом, для каждого обновлённого самолёта задержка - разность
+ * момента обнаружения обновления и времени формирования записи пунктом.
+ * Точность ограничена периодом опроса. Выполняется в отдельном потоке.
+ * \author Данильченко Артем
+ */
+class MergeProbe : public QObject
+{
+    Q_OBJECT
+
+    QSharedPointer<IPoolObject> _pool;
+    QTimer* _timer = nullptr;
+    ///< последнее замеченное время обновления по идентификатору
+    QHash<uint64_t, int64_t> _lastSeen;
+
+    QMutex _mutex;
+    QVector<int64_t> _latency;
+    int64_t _lockWait = 0;
+
+public:
+    explicit MergeProbe(QSharedPointer<IPoolObject> pool);
+
+    /*!
+     * \brief take замеры с предыдущего вызова
+     */
+    MergeLatency take();
+
+public slots:
+    void start(int period);
+    void stop();
+
+private slots:
+    void slotSample();
+};
+
+#endif // MERGEPROBE_H
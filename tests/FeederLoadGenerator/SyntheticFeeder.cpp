@@ -0,0 +1,115 @@
+#include "SyntheticFeeder.h"
+
+#include <string.h>
+
+#include "time/Clock.h"
+
+SyntheticFeeder::SyntheticFeeder(const QVector<SyntheticTrack> &tracks,
+                                 const QVector<int> &visible,
+                                 FEED_FORMAT format,
+                                 int64_t skew,
+                                 QObject *parent):
+    QObject(parent),
+    _tracks(tracks),
+    _visible(visible),
+    _format(format),
+    _skew(skew)
+{
+    _socket = new QTcpSocket(this);
+    connect(_socket, &QTcpSocket::readyRead, this, &SyntheticFeeder::slotReadyRead);
+    _timer = new QTimer(this);
+    connect(_timer, &QTimer::timeout, this, &SyntheticFeeder::slotTick);
+}
+
+void SyntheticFeeder::start(const QString &host, quint16 port, int period, int delay)
+{
+    _socket->connectToHost(host, port);
+    _socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    //пункты работают независимо - первые передачи разнесены по периоду
+    QTimer::singleShot(delay, this, [this, period]()
+    {
+        _timer->start(period);
+        slotTick();
+    });
+}
+
+void SyntheticFeeder::stop()
+{
+    _timer->stop();
+    _socket->abort();
+}
+
+bool SyntheticFeeder::isConnected() const
+{
+    return _socket->state() == QAbstractSocket::ConnectedState;
+}
+
+QByteArray SyntheticFeeder::encode(const QVector<StructAircraft> &objects, int64_t now)
+{
+    switch(_format)
+    {
+    case FEED_FORMAT::DELTA:
+        return _delta.encode(objects, now);
+    case FEED_FORMAT::FRAMED:
+        return _framer.snapshot(objects, now);
+    default:
+        break;
+    }
+
+    //формат IDemodulator::getRawDumpOfObjectsInfo()
+    const uint32_t frameSize = sizeof(StructAircraft);
+    const int32_t count = objects.size();
+
+    QByteArray dump;
+    dump.reserve(int(sizeof(frameSize) + sizeof(count)) + count * int(frameSize));
+    dump.append(reinterpret_cast<const char*>(&frameSize), sizeof(frameSize));
+    dump.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    dump.append(reinterpret_cast<const char*>(objects.constData()), count * int(frameSize));
+    return dump;
+}
+
+void SyntheticFeeder::slotTick()
+{
+    if(!isConnected())
+        return;
+
+    if(_socket->bytesToWrite() > MAX_BUFFERED)
+    {
+        _skipped++;
+        return;
+    }
+
+    const int64_t now = Clock::nowMSec();
+    _messages++;
+
+    //положение на реальный момент, время - по часам пункта
+    QVector<StructAircraft> objects;
+    objects.reserve(_visible.size());
+    for(int index : _visible)
+    {
+        objects.append(_tracks.at(index).sample(now, _messages));
+        objects.last().seen += _skew;
+    }
+
+    const QByteArray data = encode(objects, now + _skew);
+    _socket->write(data);
+
+    _snapshots++;
+    _bytes += uint64_t(data.size());
+}
+
+void SyntheticFeeder::slotReadyRead()
+{
+    const QByteArray data = _socket->readAll();
+    const int64_t received = Clock::nowMSec() + _skew;
+    if(_format != FEED_FORMAT::FRAMED)
+        return;
+
+    //ответ на запрос обмена метками времени, как в NetSender
+    _requests.feed(data, [this, received](const FrameHeader& header, const char*)
+    {
+        if(header.type == FRAME_PING)
+            _socket->write(_framer.pong(header.time, received, Clock::nowMSec() + _skew));
+    });
+}
@@ -0,0 +1,95 @@
+#ifndef SYNTHETICFEEDER_H
+#define SYNTHETICFEEDER_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QVector>
+
+#include "protocol/DeltaEncoder.h"
+#include "protocol/FrameCodec.h"
+#include "SyntheticTrack.h"
+
+/*!
+ * @brief  Формат потока приемного пункта
+ */
+enum class FEED_FORMAT
+{
+    RAW_DUMP = 0, ///< полный список (IDemodulator::getRawDumpOfObjectsInfo)
+    DELTA,        ///< разностный протокол
+    FRAMED        ///< кадры с синхронизацией
+};
+
+/*!
+ * \brief The SyntheticFeeder class
+ * Имитация приемного пункта RaspberryApp: с заданным периодом
+ * передает серверу снимок видимых им самолётов
+ * \author Данильченко Артем
+ */
+class SyntheticFeeder : public QObject
+{
+    Q_OBJECT
+
+    ///< предел неотправленных данных, байт: сервер не успевает принимать
+    const qint64 MAX_BUFFERED = 4 * 1024 * 1024;
+
+    const QVector<SyntheticTrack>& _tracks;
+    ///< индексы видимых пунктом треков
+    QVector<int> _visible;
+    FEED_FORMAT _format;
+    ///< уход часов пункта относительно реального времени, мс
+    int64_t _skew = 0;
+
+    QTcpSocket* _socket = nullptr;
+    QTimer* _timer = nullptr;
+    DeltaEncoder _delta;
+    FrameWriter _framer;
+    ///< разбор запросов FRAME_PING сервера
+    FrameParser _requests;
+    uint32_t _messages = 0;
+
+    uint64_t _snapshots = 0;
+    uint64_t _bytes = 0;
+    uint64_t _skipped = 0;
+
+    QByteArray encode(const QVector<StructAircraft>& objects, int64_t now);
+
+public:
+    /*!
+     * \brief SyntheticFeeder конструктор
+     * \param tracks - общий набор треков
+     * \param visible - индексы треков, видимых пунктом
+     * \param format - формат потока
+     * \param skew - уход часов пункта, мс
+     */
+    SyntheticFeeder(const QVector<SyntheticTrack>& tracks,
+                    const QVector<int>& visible,
+                    FEED_FORMAT format,
+                    int64_t skew,
+                    QObject* parent = nullptr);
+
+    /*!
+     * \brief start подключение и запуск передачи
+     * \param host - адрес сервера
+     * \param port - порт сервера
+     * \param period - период передачи снимков, мс
+     * \param delay - задержка первой передачи, мс
+     */
+    void start(const QString& host, quint16 port, int period, int delay);
+    void stop();
+
+    bool isConnected() const;
+    int64_t skew() const { return _skew; }
+    quint16 localPort() const { return _socket->localPort(); }
+    int visibleCount() const { return _visible.size(); }
+    uint64_t snapshots() const { return _snapshots; }
+    uint64_t bytes() const { return _bytes; }
+    ///< снимки, не переданные из-за переполнения буфера сокета
+    uint64_t skipped() const { return _skipped; }
+
+private slots:
+    void slotTick();
+    void slotReadyRead();
+};
+
+#endif // SYNTHETICFEEDER_H
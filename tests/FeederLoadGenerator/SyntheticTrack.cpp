@@ -0,0 +1,64 @@
+#include "SyntheticTrack.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+///< длина градуса широты, км
+constexpr double KM_PER_DEGREE = 111.32;
+///< цены младших разрядов полей StructAircraft (как в Aircraft)
+constexpr uint32_t VALUE_LSB = 100;
+const double LON_VALUE_LSB = 360.0 / pow(2, 31);
+const double LAT_VALUE_LSB = 180.0 / pow(2, 31);
+}
+
+SyntheticTrack::SyntheticTrack(uint32_t icao, double lat, double lon, std::mt19937 &rng):
+    _icao(icao & 0xffffff)
+{
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    memset(_flight, 0, sizeof(_flight));
+    snprintf(_flight, sizeof(_flight), "SYN%04u", unsigned(icao % 10000));
+
+    //центры окружностей в пределах 200 км от точки приема
+    _centerLat = lat + (unit(rng) - 0.5) * 400.0 / KM_PER_DEGREE;
+    _centerLon = lon + (unit(rng) - 0.5) * 400.0 / (KM_PER_DEGREE * cos(lat * M_PI / 180.0));
+    _radius = 5.0 + unit(rng) * 145.0;
+    _speed = float(300.0 + unit(rng) * 600.0);
+    _altitude = float(500.0 + unit(rng) * 11500.0);
+    _phase = unit(rng) * 2.0 * M_PI;
+
+    const double omega = double(_speed) / 3600.0 / _radius;
+    _omega = (unit(rng) < 0.5) ? omega : -omega;
+}
+
+StructAircraft SyntheticTrack::sample(int64_t msec, uint32_t messages) const
+{
+    const double angle = _phase + _omega * double(msec) / 1000.0;
+    const double kmPerLonDegree = KM_PER_DEGREE * cos(_centerLat * M_PI / 180.0);
+
+    const double lat = _centerLat + _radius * sin(angle) / KM_PER_DEGREE;
+    const double lon = _centerLon + _radius * cos(angle) / kmPerLonDegree;
+
+    //курс по касательной к окружности: север - 0, восток - 90
+    const double north = _omega * cos(angle);
+    const double east = -_omega * sin(angle);
+    double course = atan2(east, north) * 180.0 / M_PI;
+    if(course < 0.0)
+        course += 360.0;
+
+    StructAircraft a;
+    memset(&a, 0, sizeof(a));
+    a.icao = _icao;
+    memcpy(a.flight, _flight, sizeof(a.flight));
+    a.altitude = uint32_t(_altitude * VALUE_LSB);
+    a.speed = uint32_t(_speed * VALUE_LSB);
+    a.course = uint32_t(course * VALUE_LSB);
+    a.lat = int32_t(lat / LAT_VALUE_LSB);
+    a.lon = int32_t(lon / LON_VALUE_LSB);
+    a.seen = msec;
+    a.messages = messages;
+    return a;
+}
@@ -0,0 +1,53 @@
+#ifndef SYNTHETICTRACK_H
+#define SYNTHETICTRACK_H
+
+#include <random>
+
+#include "objects/air/StructAircraft.h"
+
+/*!
+ * \brief The SyntheticTrack class
+ * Синтетический трек: движение по окружности вокруг заданной точки
+ * с постоянными скоростью и высотой. Положение вычисляется по времени,
+ * поэтому все приемные пункты, видящие самолёт, передают
+ * согласованные координаты.
+ * \author Данильченко Артем
+ */
+class SyntheticTrack
+{
+    uint32_t _icao = 0;
+    char _flight[SIZE_TEXT];
+    double _centerLat = 0.0;
+    double _centerLon = 0.0;
+    ///< радиус окружности, км
+    double _radius = 0.0;
+    ///< угловая скорость со знаком направления, рад/с
+    double _omega = 0.0;
+    ///< начальный угол, рад
+    double _phase = 0.0;
+    ///< высота, м
+    float _altitude = 0.0f;
+    ///< скорость, км/ч
+    float _speed = 0.0f;
+
+public:
+    SyntheticTrack() = default;
+    /*!
+     * \brief SyntheticTrack случайный трек в окрестности точки
+     * \param icao - адрес ICAO
+     * \param lat, lon - центр зоны обзора, градусы
+     * \param rng - генератор случайных чисел
+     */
+    SyntheticTrack(uint32_t icao, double lat, double lon, std::mt19937& rng);
+
+    uint32_t icao() const { return _icao; }
+
+    /*!
+     * \brief sample запись о самолёте на момент времени
+     * \param msec - время, мс с начала эпохи
+     * \param messages - счетчик сообщений
+     */
+    StructAircraft sample(int64_t msec, uint32_t messages) const;
+};
+
+#endif // SYNTHETICTRACK_H
@@ -0,0 +1,265 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QThread>
+#include <QTimer>
+
+#include <random>
+#include <stdio.h>
+
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/PoolObject.h"
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/IngestServer.h"
+#include "time/Clock.h"
+#include "SyntheticFeeder.h"
+#include "MergeProbe.h"
+
+namespace
+{
+///< период опроса пула при измерении задержки объединения, мс
+constexpr int PROBE_PERIOD = 10;
+///< центр зоны обзора
+constexpr double CENTER_LAT = 55.75;
+constexpr double CENTER_LON = 37.62;
+
+/*!
+ * \brief residentMemory занимаемая процессом память, КиБ
+ */
+long residentMemory()
+{
+    QFile file("/proc/self/status");
+    if(!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    for(const QByteArray& line : file.readAll().split('\n'))
+    {
+        if(line.startsWith("VmRSS:"))
+            return line.mid(6).trimmed().split(' ').first().toLong();
+    }
+    return -1;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("FeederLoadGenerator");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Load generator for the RadarApp aggregation path: "
+                                     "N synthetic feeders stream over loopback to an "
+                                     "in-process IngestServer");
+    parser.addHelpOption();
+
+    QCommandLineOption feedersOption(QStringList() << "n" << "feeders",
+                                     "number of feeder connections", "count", "50");
+    QCommandLineOption aircraftOption(QStringList() << "a" << "aircraft",
+                                      "number of distinct aircraft", "count", "5000");
+    QCommandLineOption rateOption(QStringList() << "r" << "rate",
+                                  "snapshots per second per feeder", "hz", "1");
+    QCommandLineOption overlapOption(QStringList() << "o" << "overlap",
+                                     "share of aircraft also seen by a second feeder", "ratio", "0.2");
+    QCommandLineOption formatOption(QStringList() << "f" << "format",
+                                    "stream format: raw, delta or framed", "format", "raw");
+    QCommandLineOption durationOption(QStringList() << "d" << "duration",
+                                      "test duration, seconds", "sec", "60");
+    QCommandLineOption portOption(QStringList() << "p" << "port",
+                                  "loopback port of the ingest server", "port", "30005");
+    QCommandLineOption skewOption(QStringList() << "s" << "skew",
+                                  "random feeder clock error up to +-ms (estimated by the "
+                                  "server with the framed format)", "ms", "0");
+    QCommandLineOption remoteOption(QStringList() << "remote",
+                                    "send to an external RadarApp instead of the in-process "
+                                    "server (receiver side is not measured)", "host");
+    parser.addOption(feedersOption);
+    parser.addOption(aircraftOption);
+    parser.addOption(rateOption);
+    parser.addOption(overlapOption);
+    parser.addOption(formatOption);
+    parser.addOption(durationOption);
+    parser.addOption(portOption);
+    parser.addOption(skewOption);
+    parser.addOption(remoteOption);
+    parser.process(a);
+
+    const int feedersCount = qMax(1, parser.value(feedersOption).toInt());
+    const int aircraftCount = qMax(1, parser.value(aircraftOption).toInt());
+    const double rate = qMax(0.01, parser.value(rateOption).toDouble());
+    const double overlap = qBound(0.0, parser.value(overlapOption).toDouble(), 1.0);
+    const int duration = qMax(1, parser.value(durationOption).toInt());
+    const int skew = qMax(0, parser.value(skewOption).toInt());
+    const quint16 port = parser.value(portOption).toUShort();
+    const bool remote = parser.isSet(remoteOption);
+    const QString host = remote ? parser.value(remoteOption) : QString("127.0.0.1");
+    const int period = qMax(1, int(1000.0 / rate));
+
+    FEED_FORMAT format = FEED_FORMAT::RAW_DUMP;
+    if(parser.value(formatOption) == "delta")
+        format = FEED_FORMAT::DELTA;
+    else if(parser.value(formatOption) == "framed")
+        format = FEED_FORMAT::FRAMED;
+
+    //синтетические треки и распределение по приемным пунктам
+    std::mt19937 rng(12345);
+    QVector<SyntheticTrack> tracks;
+    tracks.reserve(aircraftCount);
+    for(int i = 0; i < aircraftCount; i++)
+        tracks.append(SyntheticTrack(uint32_t(0x100000 + i), CENTER_LAT, CENTER_LON, rng));
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    QVector<QVector<int>> visible(feedersCount);
+    for(int i = 0; i < aircraftCount; i++)
+    {
+        const int primary = i % feedersCount;
+        visible[primary].append(i);
+        if(feedersCount > 1 && unit(rng) < overlap)
+            visible[(primary + 1 + int(rng() % uint32_t(feedersCount - 1))) % feedersCount].append(i);
+    }
+
+    //приемная сторона в том же процессе
+    QSharedPointer<IPoolObject> pool;
+    QSharedPointer<IngestServer> server;
+    QThread probeThread;
+    MergeProbe* probe = nullptr;
+
+    if(!remote)
+    {
+        pool = QSharedPointer<IPoolObject>(new PoolObject(OBJECT_TYPE::air));
+        server = QSharedPointer<IngestServer>(new IngestServer(pool));
+        if(!server->start(port))
+        {
+            fprintf(stderr, "can't listen on port %u\n", port);
+            return 1;
+        }
+
+        probe = new MergeProbe(pool);
+        probe->moveToThread(&probeThread);
+        probeThread.start();
+        QMetaObject::invokeMethod(probe, "start", Qt::QueuedConnection,
+                                  Q_ARG(int, PROBE_PERIOD));
+    }
+
+    QVector<SyntheticFeeder*> feeders;
+    for(int i = 0; i < feedersCount; i++)
+    {
+        const int64_t feederSkew = (skew > 0) ? int64_t(rng() % uint32_t(2 * skew + 1)) - skew : 0;
+        SyntheticFeeder* feeder = new SyntheticFeeder(tracks, visible.at(i), format,
+                                                      feederSkew, &a);
+        feeder->start(host, port, period, period * i / feedersCount);
+        feeders.append(feeder);
+    }
+
+    printf("feeders %d aircraft %d rate %.2f Hz overlap %.2f format %s duration %d s\n",
+           feedersCount, aircraftCount, rate, overlap,
+           qPrintable(parser.value(formatOption)), duration);
+    printf("  time conn  pool   rec/s     KiB/s  lag max  merge p50/p99/max ms  lock ms   RSS MiB  skipped\n");
+
+    const int64_t started = Clock::nowMSec();
+    uint64_t totalRecords = 0;
+    double peakRecords = 0.0;
+    int64_t worstMerge = 0;
+    long peakMemory = 0;
+
+    QTimer report;
+    QObject::connect(&report, &QTimer::timeout, [&]()
+    {
+        const int64_t elapsed = Clock::nowMSec() - started;
+
+        int connected = 0;
+        uint64_t skipped = 0;
+        for(SyntheticFeeder* feeder : feeders)
+        {
+            connected += feeder->isConnected() ? 1 : 0;
+            skipped += feeder->skipped();
+        }
+
+        double recordsPerSec = 0.0;
+        double bytesPerSec = 0.0;
+        int64_t lag = 0;
+        int objects = 0;
+        MergeLatency merge;
+
+        if(!remote)
+        {
+            totalRecords = 0;
+            for(const FeederStats& stats : server->feederStats())
+            {
+                recordsPerSec += stats.recordsPerSec;
+                bytesPerSec += stats.bytesPerSec;
+                lag = qMax(lag, stats.maxLag);
+                totalRecords += stats.records;
+            }
+
+            pool->lockPool();
+            objects = pool->getObjectsCount();
+            pool->unlockPool();
+
+            merge = probe->take();
+        }
+
+        const long memory = residentMemory();
+        peakRecords = qMax(peakRecords, recordsPerSec);
+        worstMerge = qMax(worstMerge, merge.max);
+        peakMemory = qMax(peakMemory, memory);
+
+        printf("%6.1f %4d %5d %7.0f %9.0f %8lld %6lld/%lld/%lld %12lld %9.1f %8llu\n",
+               elapsed / 1000.0, connected, objects,
+               recordsPerSec, bytesPerSec / 1024.0, (long long)lag,
+               (long long)merge.p50, (long long)merge.p99, (long long)merge.max,
+               (long long)merge.lockWait, memory / 1024.0, (unsigned long long)skipped);
+        fflush(stdout);
+
+        if(elapsed >= duration * 1000)
+            a.quit();
+    });
+    report.start(1000);
+
+    const int result = a.exec();
+
+    MergeStats merge;
+    int synced = 0;
+    int64_t offsetError = 0;
+    if(!remote)
+    {
+        merge = server->mergeStats();
+
+        //точность оценки смещения часов: сравнение с заданным уходом
+        for(const FeederStats& stats : server->feederStats())
+        {
+            if(!stats.clockSynced)
+                continue;
+            for(SyntheticFeeder* feeder : feeders)
+            {
+                if(stats.address.endsWith(":" + QString::number(feeder->localPort())))
+                {
+                    offsetError = qMax(offsetError, qAbs(stats.clockOffset - feeder->skew()));
+                    synced++;
+                }
+            }
+        }
+    }
+
+    for(SyntheticFeeder* feeder : feeders)
+        feeder->stop();
+
+    if(!remote)
+    {
+        QMetaObject::invokeMethod(probe, "stop", Qt::BlockingQueuedConnection);
+        probeThread.quit();
+        probeThread.wait();
+        delete probe;
+
+        server->stop();
+        server.clear();
+        pool.clear();
+    }
+
+    printf("records %llu peak rec/s %.0f worst merge latency %lld ms peak RSS %.1f MiB\n",
+           (unsigned long long)totalRecords, peakRecords, (long long)worstMerge,
+           peakMemory / 1024.0);
+    printf("merge applied %llu stale %llu held %llu source switches %llu\n",
+           (unsigned long long)merge.applied, (unsigned long long)merge.stale,
+           (unsigned long long)merge.held, (unsigned long long)merge.sourceSwitches);
+    printf("clock synced feeders %d worst offset error %lld ms\n", synced, (long long)offsetError);
+    return result;
+}
@@ -0,0 +1,251 @@
+#include "FrameParserFuzzTest.h"
+
+#include <string.h>
+
+QVector<StructAircraft> FrameParserFuzzTest::makeObjects(int count, int64_t seen)
+{
+    QVector<StructAircraft> objects(count);
+    for(int i = 0; i < count; i++)
+    {
+        StructAircraft& a = objects[i];
+        memset(&a, 0, sizeof(a));
+        a.icao = uint32_t(0x400000 + i);
+        snprintf(a.flight, sizeof(a.flight), "FZ%05d", i);
+        a.altitude = uint32_t(1000 + i);
+        a.lat = 55000000 + i;
+        a.lon = 37000000 + i;
+        a.seen = seen;
+    }
+    return objects;
+}
+
+int FrameParserFuzzTest::feedRandom(FrameParser &parser, const QByteArray &data, int maxChunk)
+{
+    int frames = 0;
+    bool first = true;
+    uint32_t lastSeq = 0;
+
+    auto handler = [&frames, &first, &lastSeq](const FrameHeader& header, const char* payload)
+    {
+        //принятый кадр всегда целый: верный тип, размер и нумерация по возрастанию
+        QVector<StructAircraft> records;
+        QVERIFY(FrameParser::records(header, payload, records));
+        QCOMPARE(records.size(), int(header.count));
+        if(!first)
+            QVERIFY(int32_t(header.seq - lastSeq) > 0);
+        first = false;
+        lastSeq = header.seq;
+        frames++;
+    };
+
+    int pos = 0;
+    while(pos < data.size())
+    {
+        int chunk = 1 + int(_rng() % uint32_t(maxChunk));
+        chunk = qMin(chunk, data.size() - pos);
+        parser.feed(data.constData() + pos, chunk, handler);
+        pos += chunk;
+    }
+
+    return frames;
+}
+
+void FrameParserFuzzTest::initTestCase()
+{
+    _rng.seed(SEED);
+
+    FrameWriter writer;
+    for(int i = 0; i < SNAPSHOTS; i++)
+    {
+        const int count = int(_rng() % 600);
+        _stream.append(writer.snapshot(makeObjects(count, i), i));
+        _frames += (count == 0) ? 1 : (count + FRAME_BATCH_RECORDS - 1) / FRAME_BATCH_RECORDS;
+    }
+}
+
+void FrameParserFuzzTest::crcTest()
+{
+    //контрольное значение CRC-32 (IEEE 802.3)
+    QCOMPARE(frameCrc32("123456789", 9), uint32_t(0xcbf43926));
+    QCOMPARE(frameCrc32("", 0), uint32_t(0));
+    //расчет по частям совпадает с расчетом целиком
+    QCOMPARE(frameCrc32("6789", 4, frameCrc32("12345", 5)), uint32_t(0xcbf43926));
+}
+
+void FrameParserFuzzTest::roundTripTest()
+{
+    QVector<StructAircraft> objects = makeObjects(FRAME_BATCH_RECORDS * 2 + 3, 1000);
+
+    FrameWriter writer;
+    QByteArray stream = writer.snapshot(objects, 1000);
+
+    QVector<StructAircraft> received;
+    QVector<uint8_t> flags;
+    FrameParser parser;
+    parser.feed(stream, [&received, &flags](const FrameHeader& header, const char* payload)
+    {
+        QVERIFY(FrameParser::records(header, payload, received));
+        QCOMPARE(header.time, int64_t(1000));
+        flags.append(header.flags);
+    });
+
+    QCOMPARE(received.size(), objects.size());
+    QVERIFY(memcmp(received.constData(), objects.constData(),
+                   size_t(objects.size()) * sizeof(StructAircraft)) == 0);
+    QCOMPARE(flags, QVector<uint8_t>({ FRAME_FLAG_FIRST, 0, FRAME_FLAG_LAST }));
+    QCOMPARE(parser.buffered(), 0);
+
+    //пустой снимок - один кадр без записей
+    parser.feed(writer.snapshot(QVector<StructAircraft>(), 2000),
+                [](const FrameHeader& header, const char*)
+    {
+        QCOMPARE(int(header.count), 0);
+        QCOMPARE(header.flags, uint8_t(FRAME_FLAG_FIRST | FRAME_FLAG_LAST));
+    });
+    QCOMPARE(parser.stats().frames, uint64_t(4));
+
+    QVERIFY(writer.snapshot(QByteArray("bad"), 0).isEmpty());
+}
+
+void FrameParserFuzzTest::pingPongTest()
+{
+    FrameWriter server;
+    FrameWriter feeder;
+    FrameParser parser;
+
+    //запрос без данных, время отправки в заголовке
+    QVector<FrameHeader> headers;
+    parser.feed(server.ping(1000), [&headers](const FrameHeader& header, const char*)
+    {
+        headers.append(header);
+    });
+    QCOMPARE(headers.size(), 1);
+    QCOMPARE(headers.first().type, FRAME_PING);
+    QCOMPARE(headers.first().time, int64_t(1000));
+    QCOMPARE(headers.first().length, uint32_t(0));
+
+    //ответ в общем потоке с записями: записи его не принимают, и наоборот
+    QByteArray stream = feeder.snapshot(makeObjects(3, 1100), 1100);
+    stream.append(feeder.pong(1000, 1205, 1206));
+
+    int pongs = 0;
+    parser.feed(stream, [&pongs](const FrameHeader& header, const char* payload)
+    {
+        QVector<StructAircraft> records;
+        FramePong pong;
+        if(header.type == FRAME_PONG)
+        {
+            QVERIFY(FrameParser::pong(header, payload, pong));
+            QVERIFY(!FrameParser::records(header, payload, records));
+            QCOMPARE(pong.originate, int64_t(1000));
+            QCOMPARE(pong.receive, int64_t(1205));
+            QCOMPARE(header.time, int64_t(1206));
+            pongs++;
+        }
+        else
+            QVERIFY(!FrameParser::pong(header, payload, pong));
+    });
+    QCOMPARE(pongs, 1);
+    QCOMPARE(parser.stats().lostFrames, uint64_t(0));
+}
+
+void FrameParserFuzzTest::splitTest()
+{
+    for(int i = 0; i < ITERATIONS; i++)
+    {
+        FrameParser parser;
+        QCOMPARE(feedRandom(parser, _stream, (i % 2) ? 7 : 3000), _frames);
+        QCOMPARE(parser.stats().garbageBytes, uint64_t(0));
+        QCOMPARE(parser.stats().lostFrames, uint64_t(0));
+        QCOMPARE(parser.buffered(), 0);
+    }
+}
+
+void FrameParserFuzzTest::singleByteTest()
+{
+    FrameParser parser;
+    QCOMPARE(feedRandom(parser, _stream, 1), _frames);
+    QCOMPARE(parser.stats().bytes, uint64_t(_stream.size()));
+    QCOMPARE(parser.buffered(), 0);
+}
+
+void FrameParserFuzzTest::garbageTest()
+{
+    static const char syncBytes[] = "ADSF";
+
+    FrameWriter writer;
+    QByteArray stream;
+    int frames = 0;
+
+    for(int i = 0; i < 300; i++)
+    {
+        //посторонние байты, в том числе похожие на слово синхронизации
+        const int garbage = int(_rng() % 40);
+        for(int k = 0; k < garbage; k++)
+        {
+            char c = syncBytes[_rng() % 4];
+            if(_rng() % 3 == 0)
+                c = char(_rng());
+            stream.append(c);
+        }
+
+        stream.append(writer.snapshot(makeObjects(int(_rng() % 10), i), i));
+        frames++;
+    }
+
+    FrameParser parser;
+    QCOMPARE(feedRandom(parser, stream, 100), frames);
+    QCOMPARE(parser.stats().lostFrames, uint64_t(0));
+    QVERIFY(parser.stats().garbageBytes > 0);
+    QVERIFY(parser.stats().resyncs > 0);
+}
+
+void FrameParserFuzzTest::corruptionTest()
+{
+    for(int i = 0; i < ITERATIONS; i++)
+    {
+        QByteArray stream = _stream;
+        const int operations = 1 + int(_rng() % 20);
+
+        for(int k = 0; k < operations; k++)
+        {
+            const int at = int(_rng() % uint32_t(stream.size()));
+            switch(_rng() % 3)
+            {
+            case 0:
+                stream[at] = char(stream[at] ^ char(1 << (_rng() % 8)));
+                break;
+            case 1:
+                stream.remove(at, 1 + int(_rng() % 50));
+                break;
+            default:
+                stream.insert(at, QByteArray(1 + int(_rng() % 50), char(_rng())));
+                break;
+            }
+        }
+
+        FrameParser parser;
+        int frames = feedRandom(parser, stream, 2000);
+
+        //повреждение до 50 байт затрагивает не более трех соседних кадров
+        QVERIFY(frames >= _frames - 3 * operations);
+        QVERIFY(frames <= _frames);
+        QVERIFY(parser.buffered() <= int(sizeof(FrameHeader) + FRAME_MAX_PAYLOAD));
+    }
+}
+
+void FrameParserFuzzTest::randomInputTest()
+{
+    for(int i = 0; i < ITERATIONS; i++)
+    {
+        QByteArray data(int(_rng() % 5000), Qt::Uninitialized);
+        for(int k = 0; k < data.size(); k++)
+            data[k] = char(_rng());
+
+        FrameParser parser;
+        QCOMPARE(feedRandom(parser, data, 500), 0);
+        QCOMPARE(parser.stats().frames, uint64_t(0));
+    }
+}
+
+QTEST_APPLESS_MAIN(FrameParserFuzzTest)
@@ -0,0 +1,49 @@
+#ifndef FRAMEPARSERFUZZTEST_H
+#define FRAMEPARSERFUZZTEST_H
+
+#include <QtTest>
+#include <QObject>
+#include <random>
+
+#include "protocol/FrameCodec.h"
+
+/*!
+ * \brief The FrameParserFuzzTest class
+ * Проверка FrameParser: поток кадров подается порциями случайного
+ * размера, с посторонними байтами, инвертированными битами, выпавшими
+ * и вставленными участками. Генератор инициализируется постоянным
+ * значением, поэтому ошибка воспроизводится при повторном запуске
+ */
+class FrameParserFuzzTest : public QObject
+{
+    Q_OBJECT
+    static constexpr uint32_t SEED = 20190611;
+    static constexpr int SNAPSHOTS = 50;
+    static constexpr int ITERATIONS = 200;
+
+    std::mt19937 _rng;
+    ///< поток кадров без повреждений
+    QByteArray _stream;
+    ///< количество кадров в потоке
+    int _frames = 0;
+
+    static QVector<StructAircraft> makeObjects(int count, int64_t seen);
+    /*!
+     * \brief feedRandom подача данных порциями случайного размера
+     * \return количество принятых кадров
+     */
+    int feedRandom(FrameParser& parser, const QByteArray& data, int maxChunk);
+
+private Q_SLOTS:
+    void initTestCase();
+    void crcTest();
+    void roundTripTest();
+    void pingPongTest();
+    void splitTest();
+    void singleByteTest();
+    void garbageTest();
+    void corruptionTest();
+    void randomInputTest();
+};
+
+#endif // FRAMEPARSERFUZZTEST_H
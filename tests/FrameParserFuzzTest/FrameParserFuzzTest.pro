@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Проверка разбора потока кадров на случайно разбитых,
+# поврежденных и случайных данных
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = FrameParserFuzzTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    FrameParserFuzzTest.cpp \
+    ../../src/include/protocol/FrameCodec.cpp \
+    ../../src/include/protocol/Crc32.cpp \
+    ../../src/include/protocol/DeltaEncoder.cpp
+
+HEADERS += \
+    FrameParserFuzzTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
@@ -0,0 +1,198 @@
+#include "HttpServerTest.h"
+
+#include <zlib.h>
+#include <string.h>
+
+QByteArray HttpServerTest::gunzip(const QByteArray &data, bool &ok)
+{
+    ok = false;
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    //15 + 16 - только формат gzip
+    if(inflateInit2(&stream, 15 + 16) != Z_OK)
+        return QByteArray();
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = uInt(data.size());
+
+    QByteArray out;
+    char chunk[4096];
+    int result = Z_OK;
+    while(result == Z_OK)
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(chunk);
+        stream.avail_out = sizeof(chunk);
+        result = inflate(&stream, Z_NO_FLUSH);
+        out.append(chunk, int(sizeof(chunk) - stream.avail_out));
+    }
+    inflateEnd(&stream);
+
+    //сжатые данные должны закончиться вместе с потоком
+    ok = (result == Z_STREAM_END && stream.avail_in == 0);
+    return out;
+}
+
+void HttpServerTest::pipelineTest()
+{
+    HttpRequestParser parser;
+    HttpRequest request;
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::INCOMPLETE);
+
+    //два запроса и начало третьего в одном блоке
+    parser.append("GET /data/aircraft.json?_=1577836800 HTTP/1.1\r\n"
+                  "Host: radar\r\n"
+                  "Accept-Encoding: deflate, GZIP\r\n"
+                  "\r\n"
+                  "HEAD /data/stats.json HTTP/1.0\r\n"
+                  "If-None-Match: \"42\"\r\n"
+                  "\r\n"
+                  "GET /data/aircraft.json HTTP/1.1\r\n"
+                  "Connection: clo");
+
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::READY);
+    QCOMPARE(request.method, QByteArray("GET"));
+    QCOMPARE(request.path, QByteArray("/data/aircraft.json"));
+    QCOMPARE(request.keepAlive, true);
+    QCOMPARE(request.acceptGzip, true);
+    QVERIFY(request.ifNoneMatch.isEmpty());
+
+    //поля предыдущего запроса не переносятся в следующий
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::READY);
+    QCOMPARE(request.method, QByteArray("HEAD"));
+    QCOMPARE(request.path, QByteArray("/data/stats.json"));
+    QCOMPARE(request.keepAlive, false);
+    QCOMPARE(request.acceptGzip, false);
+    QCOMPARE(request.ifNoneMatch, QByteArray("\"42\""));
+
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::INCOMPLETE);
+
+    //окончание третьего запроса частями
+    parser.append("se\r\n");
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::INCOMPLETE);
+    parser.append("\r\nHEAD / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::READY);
+    QCOMPARE(request.method, QByteArray("GET"));
+    QCOMPARE(request.keepAlive, false);
+
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::READY);
+    QCOMPARE(request.path, QByteArray("/"));
+    QCOMPARE(request.keepAlive, true);
+
+    QCOMPARE(parser.next(request), HttpRequestParser::RESULT::INCOMPLETE);
+}
+
+void HttpServerTest::headerLimitTest()
+{
+    const QByteArray start = "GET / HTTP/1.1\r\nX-Pad: ";
+    const QByteArray end = "\r\n\r\n";
+    HttpRequest request;
+
+    //заголовки ровно 8 КиБ принимаются
+    {
+        HttpRequestParser parser;
+        parser.append(start + QByteArray(MAX_HEADER_SIZE - start.size(), 'a') + end);
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::READY);
+        QCOMPARE(request.path, QByteArray("/"));
+    }
+
+    //на байт длиннее - отказ
+    {
+        HttpRequestParser parser;
+        parser.append(start + QByteArray(MAX_HEADER_SIZE - start.size() + 1, 'a') + end);
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+
+    //незавершенные заголовки не накапливаются сверх предела
+    {
+        HttpRequestParser parser;
+        parser.append(start + QByteArray(MAX_HEADER_SIZE - start.size(), 'a'));
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::INCOMPLETE);
+        parser.append("a");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+}
+
+void HttpServerTest::bodyRejectTest()
+{
+    HttpRequest request;
+
+    //тело запроса не поддерживается: его нельзя отделить от следующего запроса
+    {
+        HttpRequestParser parser;
+        parser.append("POST /data/aircraft.json HTTP/1.1\r\n"
+                      "Transfer-Encoding: chunked\r\n\r\n"
+                      "5\r\nhello\r\n0\r\n\r\n");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+    {
+        HttpRequestParser parser;
+        parser.append("GET / HTTP/1.1\r\ntransfer-encoding: identity\r\n\r\n");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+    {
+        HttpRequestParser parser;
+        parser.append("POST / HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+
+    //пустое тело допустимо
+    {
+        HttpRequestParser parser;
+        parser.append("GET / HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::READY);
+    }
+
+    //неверная строка запроса
+    {
+        HttpRequestParser parser;
+        parser.append("GET /\r\n\r\n");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+    {
+        HttpRequestParser parser;
+        parser.append("GET / HTTP/2.0\r\n\r\n");
+        QCOMPARE(parser.next(request), HttpRequestParser::RESULT::BAD);
+    }
+}
+
+void HttpServerTest::gzipTest()
+{
+    QByteArray json = "{\"now\":1577836800.5,\"generation\":7,\"aircraft\":[";
+    for(int i = 0; i < 500; i++)
+    {
+        if(i > 0)
+            json.append(',');
+        json.append("{\"hex\":\"" + QByteArray::number(0x3c6586 + i, 16) +
+                    "\",\"altitude\":" + QByteArray::number(30000 + i * 25) +
+                    ",\"lat\":55.75,\"lon\":37.6,\"messages\":" + QByteArray::number(i) + "}");
+    }
+    json.append("]}");
+
+    const QByteArray packed = JsonSnapshot::gzip(json);
+    //заголовок gzip: сигнатура 1f 8b и метод deflate
+    QVERIFY(packed.size() > 10);
+    QCOMPARE(uint8_t(packed.at(0)), uint8_t(0x1f));
+    QCOMPARE(uint8_t(packed.at(1)), uint8_t(0x8b));
+    QCOMPARE(uint8_t(packed.at(2)), uint8_t(Z_DEFLATED));
+    QVERIFY(packed.size() < json.size() / 4);
+
+    bool ok = false;
+    QCOMPARE(gunzip(packed, ok), json);
+    QVERIFY(ok);
+
+    //пустой снимок - корректный поток gzip без данных
+    const QByteArray empty = JsonSnapshot::gzip(QByteArray());
+    QVERIFY(!empty.isEmpty());
+    QVERIFY(gunzip(empty, ok).isEmpty());
+    QVERIFY(ok);
+
+    //поврежденная контрольная сумма обнаруживается
+    QByteArray damaged = packed;
+    damaged[damaged.size() - 5] = char(damaged.at(damaged.size() - 5) ^ 0x01);
+    gunzip(damaged, ok);
+    QCOMPARE(ok, false);
+}
+
+QTEST_APPLESS_MAIN(HttpServerTest)
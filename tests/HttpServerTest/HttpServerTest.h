@@ -0,0 +1,37 @@
+#ifndef HTTPSERVERTEST_H
+#define HTTPSERVERTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/http/HttpRequestParser.h"
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/http/JsonSnapshot.h"
+
+/*!
+ * \brief The HttpServerTest class
+ * Проверка HttpRequestParser: несколько запросов в одном блоке данных
+ * и запрос, принятый частями, разбираются по порядку; заголовки
+ * длиннее 8 КиБ и запросы с телом отклоняются.
+ * Проверка JsonSnapshot::gzip: результат распаковывается zlib
+ * в исходные данные
+ */
+class HttpServerTest : public QObject
+{
+    Q_OBJECT
+    ///< предельный размер заголовков запроса
+    static constexpr int MAX_HEADER_SIZE = 8 * 1024;
+
+    /*!
+     * \brief gunzip распаковка данных в формате gzip
+     * \param ok - результат распаковки
+     */
+    static QByteArray gunzip(const QByteArray& data, bool& ok);
+
+private Q_SLOTS:
+    void pipelineTest();
+    void headerLimitTest();
+    void bodyRejectTest();
+    void gzipTest();
+};
+
+#endif // HTTPSERVERTEST_H
@@ -0,0 +1,37 @@
+#-------------------------------------------------
+#
+# Проверка встроенного HTTP сервера: разбор запросов,
+# идущих подряд, ограничение размера заголовков, отказ
+# от запросов с телом, сжатие снимка gzip
+#
+#-------------------------------------------------
+
+QT       += gui testlib
+
+TARGET = HttpServerTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    HttpServerTest.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/NetServer/http/HttpRequestParser.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/NetServer/http/JsonSnapshot.cpp \
+    ../../src/include/objects/base/BaseObject.cpp \
+    ../../src/include/objects/air/Aircraft.cpp \
+    ../../src/include/objects/air/TrackHistory.cpp \
+    ../../src/include/objects/air/TrackPredictor.cpp \
+    ../../src/include/coord/Position.cpp \
+    ../../src/include/coord/Conversions.cpp
+
+HEADERS += \
+    HttpServerTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
+
+#проверка сжатия ответов
+LIBS += -lz
@@ -0,0 +1,345 @@
+#include "IngestTest.h"
+
+#include <string.h>
+
+StructAircraft IngestTest::makeRecord(int64_t seen, uint32_t messages)
+{
+    StructAircraft record;
+    memset(&record, 0, sizeof(record));
+    record.icao = ICAO;
+    record.seen = seen;
+    record.messages = messages;
+    return record;
+}
+
+bool IngestTest::exchange(ClockOffset &clock, int64_t t1, int64_t offset,
+                          int64_t up, int64_t down)
+{
+    //пункт отвечает через 2 мс после приема запроса
+    const int64_t t2 = t1 + up + offset;
+    const int64_t t3 = t2 + 2;
+    const int64_t t4 = t3 - offset + down;
+    return clock.addSample(t1, t2, t3, t4);
+}
+
+void IngestTest::staleTest()
+{
+    MergeEngine engine;
+
+    StructAircraft record = makeRecord(BASE_TIME + 1000, 1);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 1000));
+
+    //запись того же времени и более ранняя не применяются
+    record = makeRecord(BASE_TIME + 1000, 2);
+    QVERIFY(!engine.merge(1, record, BASE_TIME + 1100));
+    record = makeRecord(BASE_TIME + 500, 3);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 1200));
+
+    record = makeRecord(BASE_TIME + 2000, 4);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 2000));
+
+    const MergeStats stats = engine.stats();
+    QCOMPARE(stats.records, uint64_t(4));
+    QCOMPARE(stats.applied, uint64_t(2));
+    QCOMPARE(stats.stale, uint64_t(2));
+    QCOMPARE(stats.held, uint64_t(0));
+    QCOMPARE(stats.aircraft, 1);
+}
+
+void IngestTest::heldTest()
+{
+    MergeEngine engine;
+
+    StructAircraft record = makeRecord(BASE_TIME, 10);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+
+    //более свежая запись другого пункта без заметного опережения
+    //не сменяет выбранный источник
+    for(int i = 1; i <= 5; i++)
+    {
+        record = makeRecord(BASE_TIME + i * 100, 10);
+        QVERIFY(!engine.merge(2, record, BASE_TIME + i * 100));
+    }
+
+    //выбранный источник продолжает применяться
+    record = makeRecord(BASE_TIME + 600, 11);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 600));
+
+    const MergeStats stats = engine.stats();
+    QCOMPARE(stats.applied, uint64_t(2));
+    QCOMPARE(stats.held, uint64_t(5));
+    QCOMPARE(stats.stale, uint64_t(0));
+    QCOMPARE(stats.sourceSwitches, uint64_t(0));
+}
+
+void IngestTest::switchAheadTest()
+{
+    MergeEngine engine;
+
+    StructAircraft record = makeRecord(BASE_TIME, 10);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+
+    record = makeRecord(BASE_TIME + 500, 10);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 500));
+
+    //опережение на 1.5 с - смена источника
+    record = makeRecord(BASE_TIME + 1500, 10);
+    QVERIFY(engine.merge(2, record, BASE_TIME + 1500));
+
+    //теперь удерживается новый источник
+    record = makeRecord(BASE_TIME + 1600, 10);
+    QVERIFY(!engine.merge(1, record, BASE_TIME + 1600));
+
+    const MergeStats stats = engine.stats();
+    QCOMPARE(stats.sourceSwitches, uint64_t(1));
+    QCOMPARE(stats.held, uint64_t(2));
+}
+
+void IngestTest::switchLostTest()
+{
+    MergeEngine engine;
+
+    StructAircraft record = makeRecord(BASE_TIME, 10);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+
+    record = makeRecord(BASE_TIME + 100, 10);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 100));
+
+    //выбранный пункт молчит 5 с - запись другого применяется
+    //без опережения
+    record = makeRecord(BASE_TIME + 200, 10);
+    QVERIFY(engine.merge(2, record, BASE_TIME + 5000));
+
+    QCOMPARE(engine.stats().sourceSwitches, uint64_t(1));
+}
+
+void IngestTest::switchRateTest()
+{
+    MergeEngine engine;
+
+    //пункт 1 принимает 1 сообщение/с, пункт 2 - 10 сообщений/с,
+    //записи пункта 2 на 100 мс новее
+    StructAircraft record = makeRecord(BASE_TIME, 1);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+    record = makeRecord(BASE_TIME + 100, 10);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 100));
+
+    //пункт 1 еще выбран: его запись новее примененной
+    record = makeRecord(BASE_TIME + 1000, 2);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 1000));
+
+    //темп пункта 2 в 10 раз выше - смена источника
+    record = makeRecord(BASE_TIME + 1100, 20);
+    QVERIFY(engine.merge(2, record, BASE_TIME + 1100));
+
+    //пункт 1 не лучше выбранного
+    record = makeRecord(BASE_TIME + 2000, 3);
+    QVERIFY(!engine.merge(1, record, BASE_TIME + 2000));
+
+    const MergeStats stats = engine.stats();
+    QCOMPARE(stats.sourceSwitches, uint64_t(1));
+    QCOMPARE(stats.held, uint64_t(2));
+}
+
+void IngestTest::summingTest()
+{
+    MergeEngine engine;
+
+    StructAircraft record = makeRecord(BASE_TIME, 10);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+    QCOMPARE(record.messages, uint32_t(10));
+
+    //второй пункт: первая запись задает начало отсчета, дальше
+    //учитываются приращения, в том числе устаревших записей
+    record = makeRecord(BASE_TIME - 200, 5);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 100));
+    record = makeRecord(BASE_TIME - 100, 8);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 200));
+    QCOMPARE(engine.stats().stale, uint64_t(2));
+
+    record = makeRecord(BASE_TIME + 300, 12);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 300));
+    QCOMPARE(record.messages, uint32_t(12 + 3));
+
+    //повтор счетчика ничего не добавляет
+    record = makeRecord(BASE_TIME + 400, 12);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 400));
+    QCOMPARE(record.messages, uint32_t(12 + 3));
+
+    //уменьшение счетчика - пункт перезапущен и считает заново
+    record = makeRecord(BASE_TIME + 500, 3);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 500));
+    QCOMPARE(record.messages, uint32_t(12 + 3 + 3));
+}
+
+void IngestTest::evictionTest()
+{
+    MergeEngine engine;
+
+    //четыре пункта занимают все ячейки; самолёт уже учитывается
+    //по первому пункту, остальные задают начало отсчета
+    StructAircraft record;
+    for(int source = 1; source <= 4; source++)
+    {
+        record = makeRecord(BASE_TIME + source, 100);
+        engine.merge(source, record, BASE_TIME + source * 10);
+    }
+
+    //пятый вытесняет дольше всех молчавший пункт 1, выбранный источник
+    //освобождается, и запись применяется сразу
+    record = makeRecord(BASE_TIME + 5, 100);
+    QVERIFY(engine.merge(5, record, BASE_TIME + 50));
+    QCOMPARE(record.messages, uint32_t(100));
+
+    //пункт 1 возвращается (вытесняя пункт 2): учитывается только
+    //приращение его счетчика, а не весь счетчик заново
+    record = makeRecord(BASE_TIME + 6, 103);
+    QVERIFY(!engine.merge(1, record, BASE_TIME + 60));
+
+    record = makeRecord(BASE_TIME + 7, 110);
+    QVERIFY(engine.merge(5, record, BASE_TIME + 70));
+    QCOMPARE(record.messages, uint32_t(100 + 3 + 10));
+
+    //пункт 2 тоже возвращается после вытеснения
+    record = makeRecord(BASE_TIME + 8, 101);
+    QVERIFY(!engine.merge(2, record, BASE_TIME + 80));
+
+    record = makeRecord(BASE_TIME + 9, 110);
+    QVERIFY(engine.merge(5, record, BASE_TIME + 90));
+    QCOMPARE(record.messages, uint32_t(100 + 3 + 10 + 1));
+}
+
+void IngestTest::reconnectTest()
+{
+    MergeEngine engine;
+
+    //подключение 1 пункта
+    StructAircraft record = makeRecord(BASE_TIME, 50);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+    record = makeRecord(BASE_TIME + 1000, 60);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 1000));
+    QCOMPARE(record.messages, uint32_t(60));
+
+    //обрыв и переподключение: тот же пункт с новым идентификатором
+    //продолжает свой счетчик, накопленные сообщения не добавляются
+    //повторно
+    record = makeRecord(BASE_TIME + 5000, 70);
+    QVERIFY(engine.merge(2, record, BASE_TIME + 5000));
+    QCOMPARE(record.messages, uint32_t(60));
+
+    record = makeRecord(BASE_TIME + 6000, 80);
+    QVERIFY(engine.merge(2, record, BASE_TIME + 6000));
+    QCOMPARE(record.messages, uint32_t(70));
+
+    //повторный обрыв
+    record = makeRecord(BASE_TIME + 9000, 95);
+    QVERIFY(engine.merge(3, record, BASE_TIME + 9000));
+    record = makeRecord(BASE_TIME + 10000, 100);
+    QVERIFY(engine.merge(3, record, BASE_TIME + 10000));
+    QCOMPARE(record.messages, uint32_t(75));
+    QCOMPARE(engine.stats().sourceSwitches, uint64_t(2));
+}
+
+void IngestTest::removeStaleTest()
+{
+    MergeEngine engine;
+
+    StructAircraft record = makeRecord(BASE_TIME, 100);
+    QVERIFY(engine.merge(1, record, BASE_TIME));
+    QCOMPARE(engine.stats().aircraft, 1);
+
+    engine.removeStale(BASE_TIME + 30000, 60000);
+    QCOMPARE(engine.stats().aircraft, 1);
+
+    engine.removeStale(BASE_TIME + 70000, 60000);
+    QCOMPARE(engine.stats().aircraft, 0);
+
+    //самолёт снова в зоне: счет начинается заново
+    record = makeRecord(BASE_TIME + 80000, 150);
+    QVERIFY(engine.merge(1, record, BASE_TIME + 80000));
+    QCOMPARE(record.messages, uint32_t(150));
+}
+
+void IngestTest::clockInvalidSampleTest()
+{
+    ClockOffset clock;
+
+    //ответ принят раньше отправки запроса
+    QVERIFY(!clock.addSample(BASE_TIME, BASE_TIME + 10, BASE_TIME + 12, BASE_TIME - 1));
+    //ответ отправлен раньше приема запроса
+    QVERIFY(!clock.addSample(BASE_TIME, BASE_TIME + 10, BASE_TIME + 9, BASE_TIME + 20));
+    //обработка на пункте дольше всего обмена - отрицательное время обмена
+    QVERIFY(!clock.addSample(BASE_TIME, BASE_TIME + 10, BASE_TIME + 40, BASE_TIME + 20));
+
+    QVERIFY(!clock.isValid());
+    QCOMPARE(clock.offset(), int64_t(0));
+    QCOMPARE(clock.rtt(), int64_t(-1));
+
+    //отброшенный замер не меняет принятую оценку
+    QVERIFY(exchange(clock, BASE_TIME, 250, 10, 10));
+    QVERIFY(!clock.addSample(BASE_TIME + 1000, BASE_TIME + 900, BASE_TIME + 800,
+                             BASE_TIME + 1100));
+    QVERIFY(clock.isValid());
+    QCOMPARE(clock.offset(), int64_t(250));
+    QCOMPARE(clock.rtt(), int64_t(20));
+
+    clock.reset();
+    QVERIFY(!clock.isValid());
+    QCOMPARE(clock.rtt(), int64_t(-1));
+}
+
+void IngestTest::clockAsymmetricSampleTest()
+{
+    ClockOffset clock;
+
+    //симметричный обмен дает точное смещение
+    QVERIFY(exchange(clock, BASE_TIME, -1200, 15, 15));
+    QCOMPARE(clock.offset(), int64_t(-1200));
+    QCOMPARE(clock.rtt(), int64_t(30));
+
+    //ответ задержан в очереди на 400 мс: замер смещен на -200 мс,
+    //но его время обмена больше, и он не выбирается, пока быстрый
+    //замер остается среди 8 последних
+    for(int i = 1; i < 7; i++)
+    {
+        QVERIFY(exchange(clock, BASE_TIME + i * 1000, -1200, 15, 415));
+        QCOMPARE(clock.offset(), int64_t(-1200));
+        QCOMPARE(clock.rtt(), int64_t(30));
+    }
+    QCOMPARE(clock.toServer(BASE_TIME - 1200), BASE_TIME);
+
+    //запрос задержан сильнее ответа
+    QVERIFY(exchange(clock, BASE_TIME + 7000, -1200, 300, 20));
+    QCOMPARE(clock.offset(), int64_t(-1200));
+}
+
+void IngestTest::clockConvergenceTest()
+{
+    ClockOffset clock;
+    int64_t t1 = BASE_TIME;
+
+    //задержки меняются от обмена к обмену, каждый восьмой обмен
+    //симметричный и самый быстрый
+    const int64_t delays[][2] = { { 40, 90 }, { 70, 35 }, { 25, 25 }, { 120, 30 },
+                                  { 30, 60 }, { 55, 55 }, { 90, 20 }, { 10, 10 } };
+
+    for(int i = 0; i < 16; i++, t1 += 1000)
+        QVERIFY(exchange(clock, t1, 250, delays[i % 8][0], delays[i % 8][1]));
+    QCOMPARE(clock.offset(), int64_t(250));
+    QCOMPARE(clock.rtt(), int64_t(20));
+
+    //часы пункта переведены на 80 мс: после вытеснения старых замеров
+    //оценка плавно сходится к новому смещению
+    int64_t previous = clock.offset();
+    for(int i = 0; i < 48; i++, t1 += 1000)
+    {
+        QVERIFY(exchange(clock, t1, 330, delays[i % 8][0], delays[i % 8][1]));
+        QVERIFY(clock.offset() >= previous);
+        QVERIFY(clock.offset() <= 330);
+        previous = clock.offset();
+    }
+    QCOMPARE(clock.offset(), int64_t(330));
+    QCOMPARE(clock.toServer(BASE_TIME + 330), BASE_TIME);
+}
+
+QTEST_APPLESS_MAIN(IngestTest)
@@ -0,0 +1,56 @@
+#ifndef INGESTTEST_H
+#define INGESTTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/ingest/MergeEngine.h"
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/ingest/ClockOffset.h"
+
+/*!
+ * \brief The IngestTest class
+ * Проверка MergeEngine: запись применяется, только если она новее
+ * примененной; выбранный источник сменяется при опережении, потере
+ * источника или более высоком темпе сообщений; счетчики сообщений
+ * пунктов суммируются по приращениям, в том числе после вытеснения
+ * ячейки источника, переподключения и перезапуска пункта.
+ * Проверка ClockOffset: противоречивые метки отбрасываются, замеры
+ * с несимметричной задержкой не искажают оценку, оценка сходится
+ * к известному смещению часов
+ */
+class IngestTest : public QObject
+{
+    Q_OBJECT
+    ///< адрес самолёта
+    static constexpr uint32_t ICAO = 0x4242a1;
+    ///< время начала, мс с начала эпохи
+    static constexpr int64_t BASE_TIME = 1577836800000;
+
+    static StructAircraft makeRecord(int64_t seen, uint32_t messages);
+    /*!
+     * \brief exchange обмен FRAME_PING/FRAME_PONG с заданными задержками
+     * \param t1 - отправка запроса, часы сервера
+     * \param offset - смещение часов пункта относительно сервера, мс
+     * \param up - задержка запроса, мс
+     * \param down - задержка ответа, мс
+     * \return результат ClockOffset::addSample
+     */
+    static bool exchange(ClockOffset& clock, int64_t t1, int64_t offset,
+                         int64_t up, int64_t down);
+
+private Q_SLOTS:
+    void staleTest();
+    void heldTest();
+    void switchAheadTest();
+    void switchLostTest();
+    void switchRateTest();
+    void summingTest();
+    void evictionTest();
+    void reconnectTest();
+    void removeStaleTest();
+    void clockInvalidSampleTest();
+    void clockAsymmetricSampleTest();
+    void clockConvergenceTest();
+};
+
+#endif // INGESTTEST_H
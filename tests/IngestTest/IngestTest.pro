@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Проверка объединения записей приемных пунктов на сервере:
+# гистерезис выбора источника, устаревшие записи,
+# суммирование счетчиков сообщений и оценка смещения часов
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = IngestTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    IngestTest.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/NetServer/ingest/MergeEngine.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/NetServer/ingest/ClockOffset.cpp
+
+HEADERS += \
+    IngestTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
@@ -0,0 +1,258 @@
+#include "MulticastLoopbackTest.h"
+
+#include <QNetworkInterface>
+#include <QSignalSpy>
+#include <string.h>
+
+#include "../MyLib/RTL_SDR_RadarLib/DataController/MulticastPublisher.h"
+#include "../MyLib/RTL_SDR_RadarLib/DataController/MulticastReceiver.h"
+
+namespace
+{
+QByteArray withSeq(QByteArray datagram, uint32_t seq)
+{
+    MulticastHeader header;
+    memcpy(&header, datagram.constData(), sizeof(header));
+    header.seq = seq;
+    memcpy(datagram.data(), &header, sizeof(header));
+    return datagram;
+}
+}
+
+QVector<StructAircraft> MulticastLoopbackTest::makeObjects(int count, int64_t seen)
+{
+    QVector<StructAircraft> objects(count);
+    for(int i = 0; i < count; i++)
+    {
+        StructAircraft& a = objects[i];
+        memset(&a, 0, sizeof(a));
+        a.icao = uint32_t(0x400000 + i);
+        snprintf(a.flight, sizeof(a.flight), "TST%04d", i);
+        a.altitude = uint32_t(1000 + i);
+        a.speed = uint32_t(400 + i);
+        a.course = uint32_t(i % 360);
+        a.lat = 55000000 + i;
+        a.lon = 37000000 + i;
+        a.seen = seen;
+        a.messages = uint32_t(i);
+    }
+    return objects;
+}
+
+QByteArray MulticastLoopbackTest::makeDump(const QVector<StructAircraft> &objects)
+{
+    uint32_t frameSize = sizeof(StructAircraft);
+    int32_t count = objects.size();
+
+    QByteArray dump;
+    dump.append(reinterpret_cast<const char*>(&frameSize), sizeof(frameSize));
+    dump.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    dump.append(reinterpret_cast<const char*>(objects.constData()),
+                count * int(sizeof(StructAircraft)));
+    return dump;
+}
+
+void MulticastLoopbackTest::packTest()
+{
+    const int count = MCAST_RECORDS_PER_DATAGRAM * 3 + 5;
+    QVector<StructAircraft> objects = makeObjects(count, 1000);
+
+    MulticastPacker packer;
+    QVector<QByteArray> datagrams = packer.pack(makeDump(objects), 1000);
+    QCOMPARE(datagrams.size(), 4);
+
+    QVector<StructAircraft> received;
+    for(int i = 0; i < datagrams.size(); i++)
+    {
+        QVERIFY(datagrams[i].size() <= MCAST_MAX_DATAGRAM);
+
+        MulticastHeader header;
+        QVector<StructAircraft> records;
+        QVERIFY(MulticastTracker::parse(datagrams[i], header, records));
+        QCOMPARE(header.seq, uint32_t(i));
+        QCOMPARE(header.snapshot, uint32_t(0));
+        QCOMPARE(int(header.part), i);
+        QCOMPARE(int(header.parts), 4);
+        QCOMPARE(header.time, int64_t(1000));
+        received += records;
+    }
+
+    QCOMPARE(received.size(), count);
+    QVERIFY(memcmp(received.constData(), objects.constData(),
+                   size_t(count) * sizeof(StructAircraft)) == 0);
+
+    //нумерация датаграмм продолжается в следующем снимке
+    datagrams = packer.pack(objects, 2000);
+    MulticastHeader header;
+    QVector<StructAircraft> records;
+    QVERIFY(MulticastTracker::parse(datagrams.first(), header, records));
+    QCOMPARE(header.seq, uint32_t(4));
+    QCOMPARE(header.snapshot, uint32_t(1));
+}
+
+void MulticastLoopbackTest::emptySnapshotTest()
+{
+    MulticastPacker packer;
+    QVector<QByteArray> datagrams = packer.pack(QVector<StructAircraft>(), 1000);
+    QCOMPARE(datagrams.size(), 1);
+
+    MulticastHeader header;
+    QVector<StructAircraft> records;
+    QVERIFY(MulticastTracker::parse(datagrams.first(), header, records));
+    QCOMPARE(int(header.count), 0);
+    QCOMPARE(int(header.parts), 1);
+    QVERIFY(records.isEmpty());
+
+    QVERIFY(packer.pack(QByteArray("bad"), 1000).isEmpty());
+}
+
+void MulticastLoopbackTest::invalidDatagramTest()
+{
+    MulticastPacker packer;
+    QByteArray datagram = packer.pack(makeObjects(3, 1000), 1000).first();
+
+    MulticastTracker tracker;
+    MulticastHeader header;
+    QVector<StructAircraft> records;
+
+    QVERIFY(!tracker.accept(datagram.left(10), header, records));
+    QVERIFY(!tracker.accept(datagram.left(datagram.size() - 1), header, records));
+    QVERIFY(!tracker.accept(datagram + QByteArray(1, '\0'), header, records));
+
+    QByteArray wrongMagic = datagram;
+    wrongMagic[0] = 'X';
+    QVERIFY(!tracker.accept(wrongMagic, header, records));
+
+    QCOMPARE(tracker.stats().invalid, uint64_t(4));
+    QCOMPARE(tracker.stats().received, uint64_t(0));
+
+    QVERIFY(tracker.accept(datagram, header, records));
+    QCOMPARE(records.size(), 3);
+}
+
+void MulticastLoopbackTest::lossDetectionTest()
+{
+    MulticastPacker packer;
+    QVector<QByteArray> datagrams;
+    for(int i = 0; i < 10; i++)
+        datagrams += packer.pack(makeObjects(1, i), i);
+
+    MulticastTracker tracker;
+    MulticastHeader header;
+    QVector<StructAircraft> records;
+
+    //0 1 2 _ _ 5 6 3 6 7 8 9: потеряны 3 и 4, 3 пришла поздно, 6 повторно
+    for(int i : { 0, 1, 2, 5, 6 })
+        QVERIFY(tracker.accept(datagrams[i], header, records));
+    QCOMPARE(tracker.stats().lost, uint64_t(2));
+
+    QVERIFY(!tracker.accept(datagrams[3], header, records));
+    QVERIFY(records.isEmpty());
+    QVERIFY(!tracker.accept(datagrams[6], header, records));
+
+    for(int i : { 7, 8, 9 })
+        QVERIFY(tracker.accept(datagrams[i], header, records));
+
+    QCOMPARE(tracker.stats().received, uint64_t(10));
+    QCOMPARE(tracker.stats().lost, uint64_t(2));
+    QCOMPARE(tracker.stats().late, uint64_t(2));
+    QCOMPARE(tracker.stats().resyncs, uint64_t(0));
+}
+
+void MulticastLoopbackTest::sequenceWrapTest()
+{
+    MulticastPacker packer;
+    QByteArray datagram = packer.pack(makeObjects(1, 1000), 1000).first();
+
+    MulticastTracker tracker;
+    MulticastHeader header;
+    QVector<StructAircraft> records;
+
+    QVERIFY(tracker.accept(withSeq(datagram, 0xfffffffe), header, records));
+    QVERIFY(tracker.accept(withSeq(datagram, 0xffffffff), header, records));
+    QVERIFY(tracker.accept(withSeq(datagram, 0), header, records));
+    QVERIFY(tracker.accept(withSeq(datagram, 2), header, records));
+    QCOMPARE(tracker.stats().lost, uint64_t(1));
+
+    //перезапуск передатчика - нумерация начинается заново без учета потерь
+    QVERIFY(tracker.accept(withSeq(datagram, 0x80000000), header, records));
+    QVERIFY(tracker.accept(withSeq(datagram, 0x80000001), header, records));
+    QCOMPARE(tracker.stats().resyncs, uint64_t(1));
+    QCOMPARE(tracker.stats().lost, uint64_t(1));
+
+    //перезапуск через несколько секунд работы: нумерация снова с нуля,
+    //разрыв меньше RESYNC_GAP, но назад дальше окна перестановки
+    MulticastTracker restarted;
+    for(uint32_t seq = 0; seq < 5000; seq++)
+        QVERIFY(restarted.accept(withSeq(datagram, seq), header, records));
+    QVERIFY(restarted.accept(withSeq(datagram, 0), header, records));
+    QVERIFY(restarted.accept(withSeq(datagram, 1), header, records));
+    QCOMPARE(restarted.stats().resyncs, uint64_t(1));
+    QCOMPARE(restarted.stats().late, uint64_t(0));
+    QCOMPARE(restarted.stats().lost, uint64_t(0));
+
+    //перестановка в пределах окна - запоздавшая датаграмма, не перезапуск
+    for(uint32_t seq = 2; seq < 100; seq++)
+        QVERIFY(restarted.accept(withSeq(datagram, seq), header, records));
+    QVERIFY(!restarted.accept(withSeq(datagram, 40), header, records));
+    QCOMPARE(restarted.stats().late, uint64_t(1));
+    QCOMPARE(restarted.stats().resyncs, uint64_t(1));
+}
+
+void MulticastLoopbackTest::loopbackTest()
+{
+    QNetworkInterface loopback;
+    for(const QNetworkInterface& iface : QNetworkInterface::allInterfaces())
+    {
+        if(iface.flags().testFlag(QNetworkInterface::IsLoopBack) &&
+                iface.flags().testFlag(QNetworkInterface::IsUp))
+        {
+            loopback = iface;
+            break;
+        }
+    }
+    if(!loopback.isValid())
+        QSKIP("no loopback interface");
+
+    MulticastReceiver first;
+    MulticastReceiver second;
+    if(!first.open(GROUP, PORT, loopback) || !second.open(GROUP, PORT, loopback))
+        QSKIP("multicast is not available on the loopback interface");
+
+    QSignalSpy firstSpy(&first, &MulticastReceiver::snapshotReceived);
+    QSignalSpy secondSpy(&second, &MulticastReceiver::snapshotReceived);
+
+    MulticastPublisher publisher;
+    QVERIFY(publisher.open(GROUP, PORT, 0, loopback));
+
+    const int count = MCAST_RECORDS_PER_DATAGRAM * 2 + 1;
+    QVector<StructAircraft> objects = makeObjects(count, 1000);
+    QCOMPARE(publisher.publish(makeDump(objects), 1000), 3);
+
+    //получатели одного потока не увеличивают работу передатчика
+    QTRY_COMPARE(firstSpy.count(), 1);
+    QTRY_COMPARE(secondSpy.count(), 1);
+    QCOMPARE(first.objects().size(), count);
+    QCOMPARE(second.objects().size(), count);
+
+    const StructAircraft& a = first.objects().value(objects[7].icao);
+    QVERIFY(memcmp(&a, &objects[7], sizeof(a)) == 0);
+
+    //самолёты, отсутствующие в полном снимке, удаляются
+    objects.resize(10);
+    for(StructAircraft& air : objects)
+        air.seen = 2000;
+    QCOMPARE(publisher.publish(makeDump(objects), 2000), 1);
+
+    QTRY_COMPARE(firstSpy.count(), 2);
+    QCOMPARE(first.objects().size(), 10);
+    QCOMPARE(first.objects().value(objects[0].icao).seen, int64_t(2000));
+
+    QCOMPARE(publisher.stats().datagrams, uint64_t(4));
+    QCOMPARE(publisher.stats().errors, uint64_t(0));
+    QCOMPARE(first.stats().received, uint64_t(4));
+    QCOMPARE(first.stats().lost, uint64_t(0));
+    QCOMPARE(first.stats().late, uint64_t(0));
+}
+
+QTEST_GUILESS_MAIN(MulticastLoopbackTest)
@@ -0,0 +1,32 @@
+#ifndef MULTICASTLOOPBACKTEST_H
+#define MULTICASTLOOPBACKTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "protocol/MulticastCodec.h"
+
+/*!
+ * \brief The MulticastLoopbackTest class
+ * Проверка протокола рассылки и передачи снимков через петлевой
+ * интерфейс. Датаграммы не покидают узел (TTL 0)
+ */
+class MulticastLoopbackTest : public QObject
+{
+    Q_OBJECT
+    static constexpr const char* GROUP = "239.255.77.99";
+    static constexpr uint16_t PORT = 30199;
+
+    static QVector<StructAircraft> makeObjects(int count, int64_t seen);
+    static QByteArray makeDump(const QVector<StructAircraft>& objects);
+
+private Q_SLOTS:
+    void packTest();
+    void emptySnapshotTest();
+    void invalidDatagramTest();
+    void lossDetectionTest();
+    void sequenceWrapTest();
+    void loopbackTest();
+};
+
+#endif // MULTICASTLOOPBACKTEST_H
@@ -0,0 +1,30 @@
+#-------------------------------------------------
+#
+# Проверка рассылки UDP multicast: разбиение снимков на датаграммы,
+# контроль потерь и прием через петлевой интерфейс
+#
+#-------------------------------------------------
+
+QT       += network testlib
+QT       -= gui
+
+TARGET = MulticastLoopbackTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    MulticastLoopbackTest.cpp \
+    ../../src/include/protocol/MulticastCodec.cpp \
+    ../../src/include/protocol/DeltaEncoder.cpp
+
+HEADERS += \
+    MulticastLoopbackTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
+
+LIBS += -lDataController
@@ -0,0 +1,519 @@
+#include "PipelineTest.h"
+
+#include <algorithm>
+#include <thread>
+
+bool PipelineTest::period(OverloadGovernor &governor, int64_t lag, uint64_t dropped, int64_t now)
+{
+    _blocks += PERIOD_BLOCKS;
+    _dropped += dropped;
+    return governor.update(lag, _blocks, _dropped, now);
+}
+
+void PipelineTest::init()
+{
+    _blocks = 0;
+    _dropped = 0;
+}
+
+void PipelineTest::fifo(BoundedQueue<int> &queue)
+{
+    //емкость округляется вверх до степени двойки
+    QCOMPARE(queue.capacity(), 8);
+
+    int item = 0;
+    QVERIFY(!queue.tryPop(item));
+    QCOMPARE(queue.size(), 0);
+
+    //каждый круг сдвигает начало на 3 ячейки: индексы переходят
+    //через границу буфера
+    int next = 0;
+    int expected = 0;
+    for(int round = 0; round < 5; round++)
+    {
+        while(queue.size() < queue.capacity())
+        {
+            item = next++;
+            QVERIFY(queue.tryPush(item));
+        }
+
+        //при заполненной очереди элемент остается у вызывающего
+        item = -1;
+        QVERIFY(!queue.tryPush(item));
+        QCOMPARE(item, -1);
+
+        for(int i = 0; i < 3; i++)
+        {
+            QVERIFY(queue.tryPop(item));
+            QCOMPARE(item, expected++);
+        }
+        QCOMPARE(queue.size(), 5);
+    }
+
+    while(queue.tryPop(item))
+        QCOMPARE(item, expected++);
+    QCOMPARE(expected, next);
+    QCOMPARE(queue.size(), 0);
+}
+
+void PipelineTest::spscQueueTest()
+{
+    SpscQueue<int> queue(5);
+    fifo(queue);
+
+    SpscQueue<int> minimal(0);
+    QCOMPARE(minimal.capacity(), 2);
+}
+
+void PipelineTest::spscThreadTest()
+{
+    SpscQueue<int> queue(16);
+
+    std::thread producer([&queue]()
+    {
+        for(int i = 0; i < THREAD_ITEMS; i++)
+        {
+            int item = i;
+            while(!queue.tryPush(item))
+                std::this_thread::yield();
+        }
+    });
+
+    //потребитель получает все элементы в порядке постановки
+    int expected = 0;
+    bool ordered = true;
+    while(expected < THREAD_ITEMS)
+    {
+        int item = -1;
+        if(!queue.tryPop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if(item != expected)
+            ordered = false;
+        expected++;
+    }
+    producer.join();
+
+    QVERIFY(ordered);
+    QCOMPARE(queue.size(), 0);
+}
+
+void PipelineTest::mpmcQueueTest()
+{
+    MpmcQueue<int> queue(7);
+    fifo(queue);
+
+    MpmcQueue<int> minimal(1);
+    QCOMPARE(minimal.capacity(), 2);
+}
+
+void PipelineTest::mpmcThreadTest()
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 3;
+    MpmcQueue<int> queue(8);
+
+    std::vector<std::atomic<int>> received(size_t(PRODUCERS * THREAD_ITEMS));
+    for(auto& value : received)
+        value.store(0);
+    std::atomic<int> total(0);
+    std::atomic<bool> ordered(true);
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < PRODUCERS; p++)
+    {
+        threads.emplace_back([&queue, p]()
+        {
+            for(int i = 0; i < THREAD_ITEMS; i++)
+            {
+                int item = p * THREAD_ITEMS + i;
+                while(!queue.tryPush(item))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for(int c = 0; c < CONSUMERS; c++)
+    {
+        threads.emplace_back([&]()
+        {
+            //элементы одного производителя одному потребителю
+            //приходят в порядке постановки
+            int last[PRODUCERS];
+            for(int& value : last)
+                value = -1;
+
+            while(total.load() < PRODUCERS * THREAD_ITEMS)
+            {
+                int item = -1;
+                if(!queue.tryPop(item))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                received[size_t(item)].fetch_add(1);
+                total.fetch_add(1);
+
+                const int producer = item / THREAD_ITEMS;
+                if(item <= last[producer])
+                    ordered = false;
+                last[producer] = item;
+            }
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+
+    //каждый элемент получен ровно один раз
+    int missed = 0;
+    for(auto& value : received)
+    {
+        if(value.load() != 1)
+            missed++;
+    }
+    QCOMPARE(missed, 0);
+    QCOMPARE(total.load(), PRODUCERS * THREAD_ITEMS);
+    QVERIFY(ordered.load());
+    QCOMPARE(queue.size(), 0);
+}
+
+void PipelineTest::stageDropTest()
+{
+    std::atomic<bool> gate(false);
+    std::atomic<int> handled(0);
+    std::vector<int> released;
+    std::mutex releasedMutex;
+
+    PipelineStage<int> stage("drop", StageConfig(1, 2, OVERFLOW_POLICY::DROP), 1,
+                             [&](int&)
+    {
+        while(!gate.load())
+            std::this_thread::yield();
+        handled.fetch_add(1);
+        return true;
+    });
+    stage.setRelease([&](int& item)
+    {
+        std::lock_guard<std::mutex> lock(releasedMutex);
+        released.push_back(item);
+    });
+    stage.start();
+
+    //первый элемент занимает поток обработки
+    int item = 0;
+    QVERIFY(stage.push(item));
+    while(stage.stats().queued != 0)
+        std::this_thread::yield();
+
+    //два элемента в очереди, остальные отбрасываются без ожидания
+    for(int i = 1; i <= 5; i++)
+    {
+        item = i;
+        QCOMPARE(stage.push(item), i <= 2);
+        QCOMPARE(item, i);
+    }
+    QCOMPARE(stage.dropped(), uint64_t(3));
+    QCOMPARE(stage.stats().waits, uint64_t(0));
+    QCOMPARE(stage.stats().queued, 2);
+
+    gate = true;
+    while(handled.load() < 3)
+        std::this_thread::yield();
+    stage.stop();
+
+    //последняя стадия освобождает обработанные элементы,
+    //отброшенные остаются у вызывающего
+    QCOMPARE(stage.processed(), uint64_t(3));
+    QCOMPARE(int(released.size()), 3);
+    QCOMPARE(released[0], 0);
+    QCOMPARE(released[1], 1);
+    QCOMPARE(released[2], 2);
+}
+
+void PipelineTest::stageBlockTest()
+{
+    constexpr int COUNT = 2000;
+    std::vector<int> handled;
+
+    //поток обработки медленнее производителя
+    PipelineStage<int> stage("block", StageConfig(1, 2, OVERFLOW_POLICY::BLOCK), 1,
+                             [&](int& item)
+    {
+        handled.push_back(item);
+        if(item % 100 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return true;
+    });
+    stage.start();
+
+    bool accepted = true;
+    for(int i = 0; i < COUNT; i++)
+    {
+        int item = i;
+        if(!stage.push(item))
+            accepted = false;
+    }
+    QVERIFY(accepted);
+
+    while(stage.processed() < uint64_t(COUNT))
+        std::this_thread::yield();
+    stage.stop();
+
+    //ничего не потеряно, порядок сохранен, производитель ожидал
+    QCOMPARE(stage.dropped(), uint64_t(0));
+    QVERIFY(stage.stats().waits > 0);
+    QCOMPARE(int(handled.size()), COUNT);
+    bool ordered = true;
+    for(int i = 0; i < COUNT; i++)
+    {
+        if(handled[size_t(i)] != i)
+            ordered = false;
+    }
+    QVERIFY(ordered);
+}
+
+void PipelineTest::stageStopTest()
+{
+    std::atomic<bool> gate(false);
+    std::vector<int> handled;
+    std::vector<int> released;
+    std::mutex releasedMutex;
+
+    PipelineStage<int> stage("stop", StageConfig(1, 2, OVERFLOW_POLICY::BLOCK), 1,
+                             [&](int& item)
+    {
+        while(!gate.load())
+            std::this_thread::yield();
+        handled.push_back(item);
+        return true;
+    });
+    stage.setRelease([&](int& item)
+    {
+        std::lock_guard<std::mutex> lock(releasedMutex);
+        released.push_back(item);
+    });
+    stage.start();
+
+    int item = 0;
+    QVERIFY(stage.push(item));
+    while(stage.stats().queued != 0)
+        std::this_thread::yield();
+    for(int i = 1; i <= 2; i++)
+    {
+        item = i;
+        QVERIFY(stage.push(item));
+    }
+
+    //производитель ожидает места в заполненной очереди
+    std::atomic<int> blocked(-1);
+    std::thread producer([&]()
+    {
+        int value = 3;
+        blocked = stage.push(value) ? 1 : 0;
+    });
+    while(stage.stats().waits == 0)
+        std::this_thread::yield();
+
+    //остановка будит производителя, поток обработки завершает
+    //текущий элемент, оставшиеся в очереди освобождаются без обработки
+    std::thread opener([&gate]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        gate = true;
+    });
+    stage.stop();
+    producer.join();
+    opener.join();
+
+    QCOMPARE(blocked.load(), 0);
+    QVERIFY(!stage.isRunning());
+    QCOMPARE(int(handled.size()), 1);
+    QCOMPARE(handled[0], 0);
+    QCOMPARE(stage.processed(), uint64_t(1));
+    QCOMPARE(stage.stats().queued, 0);
+
+    std::sort(released.begin(), released.end());
+    QCOMPARE(int(released.size()), 3);
+    QCOMPARE(released[0], 0);
+    QCOMPARE(released[1], 1);
+    QCOMPARE(released[2], 2);
+}
+
+void PipelineTest::degradeRecoverTest()
+{
+    OverloadGovernor governor;
+    governor.reset(OverloadConfig(), 0);
+
+    //задержка конвейера 10 мс - опорный уровень
+    QVERIFY(!period(governor, 10 * MSEC, 0, 1 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+
+    //отставание 500 мс: ступень за ступенью не чаще 2 с
+    QVERIFY(period(governor, 500 * MSEC, 0, 2 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+    QVERIFY(!period(governor, 500 * MSEC, 0, 3 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+    QVERIFY(period(governor, 500 * MSEC, 0, 4 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_PHASE_CORRECTION);
+    QVERIFY(!period(governor, 500 * MSEC, 0, 5 * SEC));
+    QVERIFY(period(governor, 500 * MSEC, 0, 6 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_DSP);
+
+    //ниже последней ступени упрощать нечего
+    QVERIFY(!period(governor, 500 * MSEC, 0, 8 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_DSP);
+
+    OverloadStats stats = governor.stats();
+    QCOMPARE(stats.degradations, uint64_t(3));
+    QCOMPARE(stats.overloadedPeriods, uint64_t(6));
+    QCOMPARE(stats.backlogUs, int64_t(490000));
+    QCOMPARE(stats.lagUs, int64_t(500000));
+
+    //запас с 9 с: ступень вверх каждые 10 с
+    int64_t now = 9 * SEC;
+    for(; now < 19 * SEC; now += SEC)
+        QVERIFY(!period(governor, 10 * MSEC, 0, now));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_DSP);
+
+    const DEGRADATION_LEVEL levels[] = { DEGRADATION_LEVEL::NO_PHASE_CORRECTION,
+                                         DEGRADATION_LEVEL::NO_TWO_BITS_FIX,
+                                         DEGRADATION_LEVEL::FULL };
+    for(DEGRADATION_LEVEL level : levels)
+    {
+        QVERIFY(period(governor, 10 * MSEC, 0, now));
+        QCOMPARE(governor.level(), level);
+        now += SEC;
+        for(int i = 1; i < 10; i++, now += SEC)
+            QVERIFY(!period(governor, 10 * MSEC, 0, now));
+    }
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+
+    stats = governor.stats();
+    QCOMPARE(stats.recoveries, uint64_t(3));
+    QCOMPARE(stats.degradations, uint64_t(3));
+    QCOMPARE(stats.backlogUs, int64_t(0));
+    QCOMPARE(stats.maxBacklogUs, int64_t(490000));
+}
+
+void PipelineTest::dropRatioTest()
+{
+    OverloadGovernor governor;
+    governor.reset(OverloadConfig(), 0);
+
+    //2 блока из 100 - на пороге, еще не перегрузка
+    QVERIFY(!period(governor, 10 * MSEC, 2, 1 * SEC));
+    QVERIFY(!period(governor, 10 * MSEC, 2, 2 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+    QCOMPARE(governor.stats().overloadedPeriods, uint64_t(0));
+
+    //5% потерь без отставания
+    QVERIFY(period(governor, 10 * MSEC, 5, 3 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+    QCOMPARE(governor.stats().dropRatio, 0.05);
+
+    //потери без отставания не дают запаса для восстановления
+    for(int64_t now = 4 * SEC; now <= 20 * SEC; now += SEC)
+        period(governor, 10 * MSEC, 1, now);
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+    QCOMPARE(governor.stats().recoveries, uint64_t(0));
+}
+
+void PipelineTest::skipTwoBitsFixTest()
+{
+    OverloadConfig config;
+    config.skipTwoBitsFix = true;
+
+    OverloadGovernor governor;
+    governor.reset(config, 0);
+
+    QVERIFY(!period(governor, 10 * MSEC, 0, 1 * SEC));
+
+    //первое же упрощение отключает коррекцию фазы
+    QVERIFY(period(governor, 500 * MSEC, 0, 2 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_PHASE_CORRECTION);
+    QVERIFY(period(governor, 500 * MSEC, 0, 4 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_DSP);
+
+    QVERIFY(!period(governor, 10 * MSEC, 0, 5 * SEC));
+    QVERIFY(period(governor, 10 * MSEC, 0, 15 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_PHASE_CORRECTION);
+
+    //восстановление тоже минует пропущенную ступень
+    QVERIFY(period(governor, 10 * MSEC, 0, 25 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+
+    const OverloadStats stats = governor.stats();
+    QCOMPARE(stats.degradations, uint64_t(2));
+    QCOMPARE(stats.recoveries, uint64_t(2));
+}
+
+void PipelineTest::interruptedRecoveryTest()
+{
+    OverloadGovernor governor;
+    governor.reset(OverloadConfig(), 0);
+
+    QVERIFY(!period(governor, 10 * MSEC, 0, 1 * SEC));
+    QVERIFY(period(governor, 500 * MSEC, 0, 2 * SEC));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+
+    //запас 9 с, затем период с отставанием 100 мс: ниже порога
+    //упрощения, но выше порога запаса - отсчет начинается заново
+    int64_t now = 3 * SEC;
+    for(; now < 12 * SEC; now += SEC)
+        QVERIFY(!period(governor, 10 * MSEC, 0, now));
+    QVERIFY(!period(governor, 110 * MSEC, 0, now));
+    now += SEC;
+
+    for(int i = 0; i < 10; i++, now += SEC)
+        QVERIFY(!period(governor, 10 * MSEC, 0, now));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::NO_TWO_BITS_FIX);
+
+    QVERIFY(period(governor, 10 * MSEC, 0, now));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+    QCOMPARE(governor.stats().overloadedPeriods, uint64_t(1));
+}
+
+void PipelineTest::baselineTest()
+{
+    OverloadGovernor governor;
+    governor.reset(OverloadConfig(), 0);
+
+    //постоянная задержка 400 мс - не перегрузка
+    for(int64_t now = SEC; now <= 10 * SEC; now += SEC)
+        QVERIFY(!period(governor, 400 * MSEC, 0, now));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+    QCOMPARE(governor.stats().backlogUs, int64_t(0));
+
+    //рост на 200 мс сверх опорного уровня: ниже порога упрощения
+    QVERIFY(!period(governor, 600 * MSEC, 0, 11 * SEC));
+    QCOMPARE(governor.stats().backlogUs, int64_t(200000));
+
+    //новая постоянная задержка (потеря отсчетов в приемнике) через окно
+    //поиска минимума становится опорным уровнем
+    int64_t now = 12 * SEC;
+    for(; now <= 70 * SEC; now += SEC)
+        QVERIFY(!period(governor, 600 * MSEC, 0, now));
+    QCOMPARE(governor.stats().backlogUs, int64_t(0));
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+}
+
+void PipelineTest::disabledTest()
+{
+    OverloadConfig config;
+    config.enabled = false;
+
+    OverloadGovernor governor;
+    governor.reset(config, 0);
+
+    for(int64_t now = SEC; now <= 10 * SEC; now += SEC)
+        QVERIFY(!period(governor, (now / SEC) * 500 * MSEC, 50, now));
+
+    QCOMPARE(governor.level(), DEGRADATION_LEVEL::FULL);
+    QCOMPARE(governor.stats().degradations, uint64_t(0));
+    QCOMPARE(governor.stats().lagUs, int64_t(5000000));
+}
+
+QTEST_APPLESS_MAIN(PipelineTest)
@@ -0,0 +1,67 @@
+#ifndef PIPELINETEST_H
+#define PIPELINETEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "pipeline/OverloadGovernor.h"
+#include "pipeline/PipelineStage.h"
+
+/*!
+ * \brief The PipelineTest class
+ * Проверка SpscQueue и MpmcQueue: емкость, порядок, заполнение и
+ * передача между потоками без потерь и повторов. Проверка
+ * PipelineStage: отбрасывание при DROP, ожидание производителя при
+ * BLOCK, освобождение оставшихся элементов при остановке.
+ * Проверка OverloadGovernor на синтетических отставании и потерях:
+ * упрощение по одной ступени не чаще degradeHoldUs, восстановление
+ * после recoverHoldUs с запасом, пропуск ступени NO_TWO_BITS_FIX вне
+ * агрессивного режима и постоянная задержка конвейера как опорный
+ * уровень. Время задается явно, один вызов update на период оценки
+ */
+class PipelineTest : public QObject
+{
+    Q_OBJECT
+    ///< нс в секунде и миллисекунде
+    static constexpr int64_t SEC = 1000000000;
+    static constexpr int64_t MSEC = 1000000;
+    ///< блоков за период оценки
+    static constexpr uint64_t PERIOD_BLOCKS = 100;
+    ///< элементов на поток в проверках между потоками
+    static constexpr int THREAD_ITEMS = 100000;
+
+    ///< прочитано и потеряно блоков с начала работы
+    uint64_t _blocks = 0;
+    uint64_t _dropped = 0;
+
+    /*!
+     * \brief period один период оценки
+     * \param lag - отставание часов дискретизации, нс
+     * \param dropped - потеряно блоков за период
+     * \param now - время окончания периода, нс
+     * \return результат OverloadGovernor::update
+     */
+    bool period(OverloadGovernor& governor, int64_t lag, uint64_t dropped, int64_t now);
+    /*!
+     * \brief fifo заполнение, порядок и переход через границу буфера
+     */
+    static void fifo(BoundedQueue<int>& queue);
+
+private Q_SLOTS:
+    void init();
+    void spscQueueTest();
+    void spscThreadTest();
+    void mpmcQueueTest();
+    void mpmcThreadTest();
+    void stageDropTest();
+    void stageBlockTest();
+    void stageStopTest();
+    void degradeRecoverTest();
+    void dropRatioTest();
+    void skipTwoBitsFixTest();
+    void interruptedRecoveryTest();
+    void baselineTest();
+    void disabledTest();
+};
+
+#endif // PIPELINETEST_H
@@ -0,0 +1,27 @@
+#-------------------------------------------------
+#
+# Проверка элементов конвейера обработки: очереди без блокировок,
+# стадия с переполнением DROP/BLOCK и остановкой, ступени
+# упрощения обработки при перегрузке
+#
+#-------------------------------------------------
+
+QT       += testlib
+QT       -= gui
+
+TARGET = PipelineTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    PipelineTest.cpp
+
+HEADERS += \
+    PipelineTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
@@ -1,6 +1,7 @@
 #include "PoolObjectsTest.h"
 
 #include "../MyLib/RTL_SDR_RadarLib/PoolObject/PoolObject.h"
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/table/PoolObjectTable.h"
 
 
 PoolObjectsTestTest::PoolObjectsTestTest()
@@ -153,6 +154,145 @@ void PoolObjectsTestTest::updateObjectTest()
 
 }
 
+void PoolObjectsTestTest::removeStaleObjectsTest()
+{
+    const int64_t ttl = 1000;
+    _pool->setObjectTTL(OBJECT_TYPE::air, ttl);
+    QCOMPARE(_pool->getObjectTTL(OBJECT_TYPE::air), ttl);
+
+    int64_t now = QDateTime::currentMSecsSinceEpoch();
+
+    QSharedPointer<IObject> staleObject = _pool->createNewObject(100,
+                                                                 QDateTime::fromMSecsSinceEpoch(now - 5 * ttl),
+                                                                 Position());
+    QSharedPointer<IObject> freshObject = _pool->createNewObject(101,
+                                                                 QDateTime::fromMSecsSinceEpoch(now),
+                                                                 Position());
+    QVERIFY(staleObject.isNull() != true);
+    QVERIFY(freshObject.isNull() != true);
+
+    //объект обновлялся - срок жизни продлевается
+    freshObject->setMSecStop(now + 3 * ttl);
+
+    QCOMPARE(_pool->removeStaleObjects(now + 2 * ttl), 1);
+    QCOMPARE(_pool->isExistsObject(100), false);
+    QCOMPARE(_pool->isExistsObject(101), true);
+
+    QCOMPARE(_pool->removeStaleObjects(now + 5 * ttl), 1);
+    QCOMPARE(_pool->isExistsObject(101), false);
+}
+
+void PoolObjectsTestTest::geoIndexTest()
+{
+    QDateTime now = QDateTime::currentDateTime();
+
+    _pool->createNewObject(200, now, Position(37.60, 55.75));
+    _pool->createNewObject(201, now, Position(37.70, 55.80));
+    _pool->createNewObject(202, now, Position(30.30, 59.95));
+    _pool->createNewObject(203, now, Position());
+
+    QCOMPARE(_pool->valuesInRect(Position(37.0, 55.0),
+                                 Position(38.0, 56.0)).size(), 2);
+    QCOMPARE(_pool->valuesInRadius(Position(37.60, 55.75), 1000.0).size(), 1);
+
+    QSharedPointer<IObject> nearest = _pool->nearestObject(Position(30.0, 60.0),
+                                                           100000.0);
+    QVERIFY(nearest.isNull() != true);
+    QCOMPARE(nearest->getId(), uint64_t(202));
+
+    //объект переместился - индекс обновляется
+    _pool->getObjectByID(202)->setGeoCoord(Position(37.61, 55.76));
+    _pool->updateGeoIndex(202);
+    QCOMPARE(_pool->valuesInRadius(Position(37.60, 55.75), 5000.0).size(), 2);
+    QCOMPARE(_pool->nearestObject(Position(30.0, 60.0), 100000.0).isNull(), true);
+
+    //удалённый объект не возвращается из индекса
+    _pool->deleteObject(200);
+    QCOMPARE(_pool->valuesInRect(Position(37.0, 55.0),
+                                 Position(38.0, 56.0)).size(), 2);
+    QCOMPARE(_pool->valuesInRadius(Position(37.60, 55.75), 1000.0).size(), 0);
+}
+
+void PoolObjectsTestTest::tableHandleTest()
+{
+    PoolObjectTable table(OBJECT_TYPE::air, 4);
+    table.setObjectTTL(OBJECT_TYPE::air, 1000);
+    QDateTime now = QDateTime::currentDateTime();
+
+    QSharedPointer<IObject> first = table.createNewObject(0x111111, now,
+                                                          Position(37.60, 55.75));
+    QVERIFY(first.isNull() != true);
+    QCOMPARE(table.columns().size(), 1);
+
+    table.deleteObject(0x111111);
+
+    //удалённый объект отвязан от пула и сохраняет свой id
+    QCOMPARE(first->getId(), uint64_t(0x111111));
+    QCOMPARE(first->getInUse(), false);
+    QCOMPARE(first->getObjectState(), OBJECT_STATE::DELETE_OBJECT);
+    QCOMPARE(table.isExistsObject(0x111111), false);
+
+    //слот используется повторно, объект - нет
+    QSharedPointer<IObject> second = table.createNewObject(0x222222, now,
+                                                           Position(30.30, 59.95));
+    QVERIFY(second.isNull() != true);
+    QVERIFY(second.data() != first.data());
+    QCOMPARE(table.columns().size(), 1);
+    QCOMPARE(first->getId(), uint64_t(0x111111));
+    QCOMPARE(second->getId(), uint64_t(0x222222));
+
+    //изменения отвязанного объекта не попадают в массивы пула
+    first->setGeoCoord(Position(37.61, 55.76));
+    first->setObjectState(OBJECT_STATE::UPDATE_OBJECT);
+    QCOMPARE(table.getObjectsCount(), 1);
+    QCOMPARE(table.columns().id[0], uint64_t(0x222222));
+    QCOMPARE(table.getObjectByID(0x111111).isNull(), true);
+    QVERIFY(table.getObjectByID(0x222222).data() == second.data());
+
+    //устаревший объект также отвязывается
+    QCOMPARE(table.removeStaleObjects(now.toMSecsSinceEpoch() + 5000), 1);
+    QCOMPARE(second->getId(), uint64_t(0x222222));
+    QCOMPARE(second->getInUse(), false);
+    QCOMPARE(table.getObjectsCount(), 0);
+}
+
+void PoolObjectsTestTest::releasedSlotTest()
+{
+    PoolObjectTable table(OBJECT_TYPE::air, 4);
+    QDateTime now = QDateTime::currentDateTime();
+
+    for(uint64_t id = 0x100001; id <= 0x100003; id++)
+        QVERIFY(table.createNewObject(id, now, Position(37.60, 55.75)).isNull() != true);
+    QCOMPARE(table.columns().size(), 3);
+    QCOMPARE(table.columns().released.size(), 0);
+
+    //объект помечен удалённым без участия пула - слот учитывается один раз
+    QSharedPointer<IObject> deleted = table.getObjectByID(0x100002);
+    deleted->setObjectState(OBJECT_STATE::DELETE_OBJECT);
+    deleted->setInUse(false);
+    QCOMPARE(table.columns().released.size(), 1);
+    QCOMPARE(table.getObjectsCount(), 2);
+
+    //слот используется повторно без добавления нового
+    QVERIFY(table.createNewObject(0x200001, now, Position()).isNull() != true);
+    QCOMPARE(table.columns().size(), 3);
+    QCOMPARE(table.columns().released.size(), 0);
+    QCOMPARE(table.columns().id[1], uint64_t(0x200001));
+    QCOMPARE(deleted->getId(), uint64_t(0x100002));
+    QCOMPARE(table.isExistsObject(0x100002), false);
+
+    //объект снова используется - слот не отдаётся новому объекту
+    QSharedPointer<IObject> restored = table.getObjectByID(0x100001);
+    restored->setObjectState(OBJECT_STATE::DELETE_OBJECT);
+    restored->setObjectState(OBJECT_STATE::UPDATE_OBJECT);
+    QCOMPARE(table.columns().released.size(), 1);
+
+    QVERIFY(table.createNewObject(0x300001, now, Position()).isNull() != true);
+    QCOMPARE(table.columns().size(), 4);
+    QCOMPARE(table.columns().released.size(), 0);
+    QVERIFY(table.getObjectByID(0x100001).data() == restored.data());
+    QCOMPARE(table.getObjectsCount(), 4);
+}
 
 QTEST_APPLESS_MAIN(PoolObjectsTestTest)
 
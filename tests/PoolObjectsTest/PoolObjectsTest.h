@@ -25,6 +25,10 @@ private Q_SLOTS:
     void deleteAllObjectsFromPoolTest();
     void deleteAddDeletObjectTest();
     void updateObjectTest();
+    void removeStaleObjectsTest();
+    void geoIndexTest();
+    void tableHandleTest();
+    void releasedSlotTest();
 };
 
 
@@ -0,0 +1,135 @@
+#include "PoolScanBenchmark.h"
+
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/PoolObject.h"
+#include "../MyLib/RTL_SDR_RadarLib/PoolObject/table/PoolObjectTable.h"
+
+PoolScanBenchmark::PoolScanBenchmark()
+{
+    _hashPool = new PoolObject(OBJECT_TYPE::air);
+    _tablePool = new PoolObjectTable(OBJECT_TYPE::air);
+}
+
+PoolScanBenchmark::~PoolScanBenchmark()
+{
+    delete _hashPool;
+    delete _tablePool;
+}
+
+void PoolScanBenchmark::initTestCase()
+{
+    QDateTime now = QDateTime::currentDateTime();
+
+    for(int i = 1; i <= OBJECTS_COUNT; ++i)
+    {
+        Position pos(30.0 + (i % 100) * 0.1, 50.0 + (i / 100) * 0.1);
+        float altitude = float(i % 12000);
+
+        for(IPoolObject* pool : QList<IPoolObject*>{ _hashPool, _tablePool })
+        {
+            QSharedPointer<IObject> object = pool->createNewObject(uint64_t(i), now, pos);
+            QVERIFY(object.isNull() != true);
+            object->setAltitude(altitude);
+        }
+    }
+
+    //каждый десятый объект удалён
+    for(int i = 10; i <= OBJECTS_COUNT; i += 10)
+    {
+        _hashPool->deleteObject(uint64_t(i));
+        _tablePool->deleteObject(uint64_t(i));
+    }
+}
+
+void PoolScanBenchmark::consistencyTest()
+{
+    QCOMPARE(_tablePool->getObjectsCount(), _hashPool->getObjectsCount());
+
+    double hashSum = 0.0;
+    for(auto &object : _hashPool->values())
+        hashSum += object->getAltitude();
+
+    double tableSum = 0.0;
+    const StateColumns& columns = _tablePool->columns();
+    for(int slot = 0; slot < columns.size(); ++slot)
+    {
+        if(columns.inUse[slot])
+            tableSum += columns.altitude[slot];
+    }
+    QCOMPARE(tableSum, hashSum);
+
+    //изменение через объект видно в массивах
+    _tablePool->getObjectByID(1)->setAltitude(12345.0f);
+    int slot = -1;
+    for(int i = 0; i < columns.size(); ++i)
+    {
+        if(columns.id[i] == 1)
+            slot = i;
+    }
+    QVERIFY(slot >= 0);
+    QCOMPARE(columns.altitude[slot], 12345.0f);
+    _tablePool->getObjectByID(1)->setAltitude(1.0f);
+}
+
+void PoolScanBenchmark::hashPoolScan()
+{
+    double sum = 0.0;
+    QBENCHMARK
+    {
+        sum = 0.0;
+        for(auto &object : _hashPool->values())
+            sum += object->getAltitude();
+    }
+    QVERIFY(sum > 0.0);
+}
+
+void PoolScanBenchmark::tablePoolObjectScan()
+{
+    double sum = 0.0;
+    QBENCHMARK
+    {
+        sum = 0.0;
+        for(auto &object : _tablePool->values())
+            sum += object->getAltitude();
+    }
+    QVERIFY(sum > 0.0);
+}
+
+void PoolScanBenchmark::tablePoolColumnScan()
+{
+    const StateColumns& columns = _tablePool->columns();
+    double sum = 0.0;
+    QBENCHMARK
+    {
+        sum = 0.0;
+        const uint8_t* inUse = columns.inUse.constData();
+        const float* altitude = columns.altitude.constData();
+        for(int slot = 0; slot < columns.size(); ++slot)
+        {
+            if(inUse[slot])
+                sum += altitude[slot];
+        }
+    }
+    QVERIFY(sum > 0.0);
+}
+
+void PoolScanBenchmark::hashPoolCount()
+{
+    int count = 0;
+    QBENCHMARK
+    {
+        count = _hashPool->getObjectsCount();
+    }
+    QVERIFY(count > 0);
+}
+
+void PoolScanBenchmark::tablePoolCount()
+{
+    int count = 0;
+    QBENCHMARK
+    {
+        count = _tablePool->getObjectsCount();
+    }
+    QVERIFY(count > 0);
+}
+
+QTEST_APPLESS_MAIN(PoolScanBenchmark)
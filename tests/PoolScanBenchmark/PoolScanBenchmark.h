@@ -0,0 +1,35 @@
+#ifndef POOLSCANBENCHMARK_H
+#define POOLSCANBENCHMARK_H
+
+#include <QtTest>
+#include <QObject>
+
+class PoolObject;
+class PoolObjectTable;
+
+/*!
+ * \brief The PoolScanBenchmark class
+ * Сравнение стоимости полного просмотра пула для двух реализаций
+ * IPoolObject. Пулы заполняются одинаковым набором самолётов
+ */
+class PoolScanBenchmark : public QObject
+{
+    Q_OBJECT
+    static constexpr int OBJECTS_COUNT = 3000;
+
+    PoolObject* _hashPool = nullptr;
+    PoolObjectTable* _tablePool = nullptr;
+public:
+    PoolScanBenchmark();
+    ~PoolScanBenchmark();
+private Q_SLOTS:
+    void initTestCase();
+    void consistencyTest();
+    void hashPoolScan();
+    void tablePoolObjectScan();
+    void tablePoolColumnScan();
+    void hashPoolCount();
+    void tablePoolCount();
+};
+
+#endif // POOLSCANBENCHMARK_H
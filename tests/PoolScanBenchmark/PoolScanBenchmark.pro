@@ -0,0 +1,27 @@
+#-------------------------------------------------
+#
+# Бенчмарк полного просмотра пула объектов:
+# QHash<uint64_t, QSharedPointer<IObject>> против массивов состояния
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+TARGET = PoolScanBenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    PoolScanBenchmark.cpp
+
+HEADERS += \
+    PoolScanBenchmark.h
+
+include( ../../common.pri )
+include( ../../app.pri )
+
+LIBS += -lPoolObject
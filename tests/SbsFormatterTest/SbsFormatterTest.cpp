@@ -0,0 +1,210 @@
+#include "SbsFormatterTest.h"
+
+#include <QDateTime>
+
+QList<QList<QByteArray>> SbsFormatterTest::messages(const QByteArray &out)
+{
+    QList<QList<QByteArray>> list;
+    for(QByteArray line : out.split('\n'))
+    {
+        if(line.isEmpty())
+            continue;
+        if(line.endsWith('\r'))
+            line.chop(1);
+        list.append(line.split(','));
+    }
+    return list;
+}
+
+void SbsFormatterTest::positionTest()
+{
+    Aircraft air(0x3c6586);
+    char flight[] = "DLH4AB  ";
+    air.setFlightInfo(flight);
+    air.setAltitude(10000.0f);
+    air.setLatitude(55.75);
+    air.setLongitude(37.6);
+    air.setSpeed(800.0f);
+    air.setCourse(90.4f);
+    air.setMSecStop(BASE_TIME);
+
+    SbsFormatter formatter;
+    QByteArray out;
+    QCOMPARE(formatter.format(&air, BASE_TIME + 500, out), 3);
+    QVERIFY(out.endsWith("\r\n"));
+
+    const QList<QList<QByteArray>> list = messages(out);
+    QCOMPARE(list.size(), 3);
+    for(const QList<QByteArray>& fields : list)
+    {
+        QCOMPARE(fields.size(), int(FIELD_COUNT));
+        QCOMPARE(fields.at(0), QByteArray("MSG"));
+        QCOMPARE(fields.at(4), QByteArray("3C6586"));
+    }
+
+    //время формирования - время приема, время записи - текущее, местное время
+    const QByteArray generated = QDateTime::fromMSecsSinceEpoch(BASE_TIME)
+            .toString("yyyy/MM/dd,HH:mm:ss.zzz").toLatin1();
+    const QByteArray logged = QDateTime::fromMSecsSinceEpoch(BASE_TIME + 500)
+            .toString("yyyy/MM/dd,HH:mm:ss.zzz").toLatin1();
+    const QList<QByteArray>& first = list.at(0);
+    QCOMPARE(QByteArray(first.at(6) + ',' + first.at(7)), generated);
+    QCOMPARE(QByteArray(first.at(8) + ',' + first.at(9)), logged);
+
+    //MSG,1 - позывной без завершающих пробелов
+    QCOMPARE(list.at(0).at(1), QByteArray("1"));
+    QCOMPARE(list.at(0).at(10), QByteArray("DLH4AB"));
+    QVERIFY(list.at(0).at(11).isEmpty());
+
+    //MSG,3 - высота 10000 м = 32808 футов и координаты
+    QCOMPARE(list.at(1).at(1), QByteArray("3"));
+    QVERIFY(list.at(1).at(10).isEmpty());
+    QCOMPARE(list.at(1).at(11), QByteArray("32808"));
+    QVERIFY(list.at(1).at(12).isEmpty());
+    QCOMPARE(list.at(1).at(14), QByteArray("55.75000"));
+    QCOMPARE(list.at(1).at(15), QByteArray("37.60000"));
+
+    //MSG,4 - 800 км/ч = 432 узла, курс в целых градусах
+    QCOMPARE(list.at(2).at(1), QByteArray("4"));
+    QVERIFY(list.at(2).at(11).isEmpty());
+    QCOMPARE(list.at(2).at(12), QByteArray("432"));
+    QCOMPARE(list.at(2).at(13), QByteArray("90"));
+    QVERIFY(list.at(2).at(14).isEmpty());
+}
+
+void SbsFormatterTest::changesTest()
+{
+    Aircraft air(0x3c6586);
+    char flight[] = "AFL123  ";
+    air.setFlightInfo(flight);
+    air.setAltitude(10000.0f);
+    air.setLatitude(55.75);
+    air.setLongitude(37.6);
+    air.setSpeed(800.0f);
+    air.setCourse(90.0f);
+    air.setMSecStop(BASE_TIME);
+
+    SbsFormatter formatter;
+    QByteArray out;
+    QCOMPARE(formatter.format(&air, BASE_TIME, out), 3);
+
+    //время приема не изменилось - сообщений нет
+    out.clear();
+    QCOMPARE(formatter.format(&air, BASE_TIME + 1000, out), 0);
+    QVERIFY(out.isEmpty());
+
+    //новое время приема без изменения данных
+    air.setMSecStop(BASE_TIME + 1000);
+    QCOMPARE(formatter.format(&air, BASE_TIME + 1000, out), 0);
+    QVERIFY(out.isEmpty());
+
+    //изменилась только высота: 10100 м = 33136 футов
+    air.setAltitude(10100.0f);
+    air.setMSecStop(BASE_TIME + 2000);
+    QCOMPARE(formatter.format(&air, BASE_TIME + 2000, out), 1);
+    QList<QList<QByteArray>> list = messages(out);
+    QCOMPARE(list.size(), 1);
+    QCOMPARE(list.at(0).at(1), QByteArray("3"));
+    QCOMPARE(list.at(0).at(11), QByteArray("33136"));
+
+    //изменился только курс
+    out.clear();
+    air.setCourse(91.0f);
+    air.setMSecStop(BASE_TIME + 3000);
+    QCOMPARE(formatter.format(&air, BASE_TIME + 3000, out), 1);
+    list = messages(out);
+    QCOMPARE(list.at(0).at(1), QByteArray("4"));
+    QCOMPARE(list.at(0).at(12), QByteArray("432"));
+    QCOMPARE(list.at(0).at(13), QByteArray("91"));
+
+    //изменился только позывной
+    out.clear();
+    char other[] = "AFL124  ";
+    air.setFlightInfo(other);
+    air.setMSecStop(BASE_TIME + 4000);
+    QCOMPARE(formatter.format(&air, BASE_TIME + 4000, out), 1);
+    list = messages(out);
+    QCOMPARE(list.at(0).at(1), QByteArray("1"));
+    QCOMPARE(list.at(0).at(10), QByteArray("AFL124"));
+
+    QCOMPARE(formatter.format(nullptr, BASE_TIME + 4000, out), 0);
+}
+
+void SbsFormatterTest::surveillanceTest()
+{
+    //без координат и скорости: только высота сообщением MSG,5
+    Aircraft air(0xabcd);
+    air.setAltitude(3000.0f);
+    air.setMSecStop(BASE_TIME);
+
+    SbsFormatter formatter;
+    QByteArray out;
+    QCOMPARE(formatter.format(&air, BASE_TIME, out), 1);
+
+    QList<QList<QByteArray>> list = messages(out);
+    QCOMPARE(list.size(), 1);
+    QCOMPARE(list.at(0).size(), int(FIELD_COUNT));
+    QCOMPARE(list.at(0).at(1), QByteArray("5"));
+    QCOMPARE(list.at(0).at(4), QByteArray("00ABCD"));
+    QCOMPARE(list.at(0).at(11), QByteArray("9842"));
+    QVERIFY(list.at(0).at(14).isEmpty());
+    QVERIFY(list.at(0).at(15).isEmpty());
+
+    //та же высота - повторно не передается
+    out.clear();
+    air.setMSecStop(BASE_TIME + 1000);
+    QCOMPARE(formatter.format(&air, BASE_TIME + 1000, out), 0);
+
+    //с появлением координат высота передается сообщением MSG,3
+    air.setLatitude(-33.5);
+    air.setLongitude(-70.25);
+    air.setMSecStop(BASE_TIME + 2000);
+    QCOMPARE(formatter.format(&air, BASE_TIME + 2000, out), 1);
+    list = messages(out);
+    QCOMPARE(list.at(0).at(1), QByteArray("3"));
+    QCOMPARE(list.at(0).at(11), QByteArray("9842"));
+    QCOMPARE(list.at(0).at(14), QByteArray("-33.50000"));
+    QCOMPARE(list.at(0).at(15), QByteArray("-70.25000"));
+}
+
+void SbsFormatterTest::cycleTest()
+{
+    Aircraft first(0x3c6586);
+    char flight[] = "DLH4AB  ";
+    first.setFlightInfo(flight);
+    first.setAltitude(10000.0f);
+    first.setLatitude(55.75);
+    first.setLongitude(37.6);
+    first.setSpeed(800.0f);
+    first.setCourse(90.0f);
+    first.setMSecStop(BASE_TIME);
+
+    Aircraft second(0x4242a1);
+    second.setAltitude(5000.0f);
+    second.setLatitude(59.9);
+    second.setLongitude(30.3);
+    second.setMSecStop(BASE_TIME);
+
+    SbsFormatter formatter;
+    QByteArray out;
+    QCOMPARE(formatter.format(&first, BASE_TIME, out), 3);
+    QCOMPARE(formatter.format(&second, BASE_TIME, out), 1);
+    formatter.finishCycle();
+
+    //второй самолёт не встретился в цикле и забывается
+    QCOMPARE(formatter.format(&first, BASE_TIME, out), 0);
+    formatter.finishCycle();
+
+    out.clear();
+    QCOMPARE(formatter.format(&first, BASE_TIME, out), 0);
+    QCOMPARE(formatter.format(&second, BASE_TIME, out), 1);
+    QCOMPARE(messages(out).at(0).at(4), QByteArray("4242A1"));
+    formatter.finishCycle();
+
+    //после сброса все самолёты передаются полностью
+    formatter.reset();
+    QCOMPARE(formatter.format(&first, BASE_TIME, out), 3);
+    QCOMPARE(formatter.format(&second, BASE_TIME, out), 1);
+}
+
+QTEST_APPLESS_MAIN(SbsFormatterTest)
@@ -0,0 +1,37 @@
+#ifndef SBSFORMATTERTEST_H
+#define SBSFORMATTERTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "../MyLib/RTL_SDR_RadarLib/NetServer/sbs/SbsFormatter.h"
+#include "objects/air/Aircraft.h"
+
+/*!
+ * \brief The SbsFormatterTest class
+ * Проверка SbsFormatter: поля сообщений MSG,1/3/4/5, высота в футах
+ * и скорость в узлах, без изменения времени приема сообщения
+ * не формируются, после изменения передаются только изменённые
+ * группы полей; забытый или сброшенный самолёт передается полностью
+ */
+class SbsFormatterTest : public QObject
+{
+    Q_OBJECT
+    ///< время начала, мс с начала эпохи
+    static constexpr int64_t BASE_TIME = 1577836800000;
+    ///< число полей сообщения SBS-1
+    static constexpr int FIELD_COUNT = 22;
+
+    /*!
+     * \brief messages разбиение буфера на сообщения и поля
+     */
+    static QList<QList<QByteArray>> messages(const QByteArray& out);
+
+private Q_SLOTS:
+    void positionTest();
+    void changesTest();
+    void surveillanceTest();
+    void cycleTest();
+};
+
+#endif // SBSFORMATTERTEST_H
@@ -0,0 +1,33 @@
+#-------------------------------------------------
+#
+# Проверка формирования сообщений SBS-1 (BaseStation):
+# типы сообщений, перевод высоты в футы и скорости в узлы,
+# передача только изменений самолёта
+#
+#-------------------------------------------------
+
+QT       += gui testlib
+
+TARGET = SbsFormatterTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    SbsFormatterTest.cpp \
+    ../../src/MyLib/RTL_SDR_RadarLib/NetServer/sbs/SbsFormatter.cpp \
+    ../../src/include/objects/base/BaseObject.cpp \
+    ../../src/include/objects/air/Aircraft.cpp \
+    ../../src/include/objects/air/TrackHistory.cpp \
+    ../../src/include/objects/air/TrackPredictor.cpp \
+    ../../src/include/coord/Position.cpp \
+    ../../src/include/coord/Conversions.cpp
+
+HEADERS += \
+    SbsFormatterTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )
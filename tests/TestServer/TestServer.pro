@@ -24,12 +24,23 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 LIBS += -lfftw3
 
+INCLUDEPATH += ../../src/include
+
 SOURCES += \
         main.cpp \
-        mainwindow.cpp
+        mainwindow.cpp \
+        ../../src/include/protocol/DeltaDecoder.cpp \
+        ../../src/include/protocol/DeltaEncoder.cpp \
+        ../../src/include/protocol/FrameCodec.cpp \
+        ../../src/include/protocol/Crc32.cpp
 
 HEADERS += \
-        ../../src/MyLib/RTL_SDR_RadarLib/Demodulator/StructAircraft.h \
+        ../../src/include/objects/air/StructAircraft.h \
+        ../../src/include/protocol/DeltaProtocol.h \
+        ../../src/include/protocol/DeltaDecoder.h \
+        ../../src/include/protocol/FrameProtocol.h \
+        ../../src/include/protocol/FrameCodec.h \
+        ../../src/include/protocol/Crc32.h \
         mainwindow.h
 
 FORMS += \
@@ -2,7 +2,7 @@
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include "../../src/MyLib/RTL_SDR_RadarLib/Demodulator/StructAircraft.h"
+#include "objects/air/StructAircraft.h"
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -26,6 +26,9 @@ void MainWindow::acceptConnection()
 {
     qDebug()<<"new connection avalible";
     tcpServerConnection = tcpServer.nextPendingConnection();
+    //новое подключение начинает поток кадров заново
+    _framed = false;
+    _frames.reset();
     QObject::connect(tcpServerConnection, SIGNAL(readyRead()),
             this, SLOT(updateServerProgress()));
     connect(tcpServerConnection, SIGNAL(error(QAbstractSocket::SocketError)),
@@ -39,9 +42,75 @@ void MainWindow::updateServerProgress()
 
     qDebug()<<"bytesReceived = " << bytesReceived << "data" << array.toHex();
 
-    StructAircraft a;
+    //разностный протокол начинается с сигнатуры,
+    //недоразобранное сообщение остаётся в буфере
+    uint32_t magic = 0;
+    if(array.size() >= int(sizeof(magic)))
+        memcpy(&magic, array.constData(), sizeof(magic));
 
-    memcpy((char*)&a,(char*)array.data(),sizeof (StructAircraft));
+    //кадры с синхронизацией разбираются по мере поступления
+    if(_framed || magic == FRAME_SYNC)
+    {
+        _framed = true;
+        _frames.feed(array, [this](const FrameHeader& header, const char* payload)
+        {
+            QVector<StructAircraft> records;
+            if(!FrameParser::records(header, payload, records))
+                return;
+            for(const StructAircraft& a : records)
+                printAircraft(a);
+        });
+        qDebug()<<"frames:"<<_frames.stats().frames
+               <<"crc errors:"<<_frames.stats().crcErrors
+               <<"garbage bytes:"<<_frames.stats().garbageBytes
+               <<"lost frames:"<<_frames.stats().lostFrames;
+        return;
+    }
+
+    if(!_buffer.isEmpty() || magic == DELTA_MAGIC)
+    {
+        _buffer.append(array);
+        processDeltaMessages();
+        return;
+    }
+
+    //полный список самолётов
+    const int offset = 2 * sizeof(int32_t);
+    for(int pos = offset; pos + int(sizeof(StructAircraft)) <= array.size();
+        pos += sizeof(StructAircraft))
+    {
+        StructAircraft a;
+        memcpy((char*)&a, array.constData() + pos, sizeof (StructAircraft));
+        printAircraft(a);
+    }
+}
+
+void MainWindow::processDeltaMessages()
+{
+    forever
+    {
+        int size = DeltaDecoder::messageSize(_buffer);
+        if(size < 0)
+        {
+            qDebug()<<"wrong delta message, drop buffer";
+            _buffer.clear();
+            return;
+        }
+        if(size == 0 || size > _buffer.size())
+            break;
+
+        if(!_decoder.apply(_buffer.left(size)))
+            qDebug()<<"delta message skipped, waiting for keyframe";
+        _buffer.remove(0, size);
+    }
+
+    qDebug()<<"aircrafts:"<<_decoder.objects().size();
+    for(const StructAircraft& a : _decoder.objects())
+        printAircraft(a);
+}
+
+void MainWindow::printAircraft(const StructAircraft &a)
+{
     QString str;
     str.append( QString("+++++++++++++++++++++++++++++++++++++\n"));
     str.append( QString("ICAO: %1\n").arg(a.icao,9,16));
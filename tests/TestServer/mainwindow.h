@@ -6,6 +6,9 @@
 #include <QTcpSocket>
 #include <math.h>
 
+#include "protocol/DeltaDecoder.h"
+#include "protocol/FrameCodec.h"
+
 namespace Ui {
 class MainWindow;
 }
@@ -35,6 +38,20 @@ private:
     int bytesToWrite;
     int bytesWritten;
     int bytesReceived = 0;
+    ///< принятые и не разобранные данные
+    QByteArray _buffer;
+    ///< состояние по разностным сообщениям
+    DeltaDecoder _decoder;
+    ///< разбор потока кадров
+    FrameParser _frames;
+    ///< подключение передает кадры
+    bool _framed = false;
+
+    void printAircraft(const StructAircraft& a);
+    /*!
+     * \brief processDeltaMessages разбор сообщений разностного протокола
+     */
+    void processDeltaMessages();
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,54 @@
+#include "TimeModelBenchmark.h"
+
+#include "time/Clock.h"
+
+TimeModelBenchmark::TimeModelBenchmark() :
+    _aircraft(0x4242)
+{
+}
+
+void TimeModelBenchmark::legacyDateTimeUpdate()
+{
+    //прежняя схема: QDateTime хранился вместе с мс
+    QDateTime tstop;
+    int64_t msStop = 0;
+
+    QBENCHMARK
+    {
+        tstop = QDateTime::currentDateTime();
+        msStop = tstop.toUTC().toMSecsSinceEpoch();
+    }
+    QVERIFY(msStop > 0);
+}
+
+void TimeModelBenchmark::dateTimeUpdate()
+{
+    QBENCHMARK
+    {
+        _aircraft.setDateTimeStop(QDateTime::currentDateTime());
+    }
+    QVERIFY(_aircraft.getMSecStop() > 0);
+}
+
+void TimeModelBenchmark::nsecUpdate()
+{
+    QBENCHMARK
+    {
+        _aircraft.setNSecStop(Clock::nowNSec());
+    }
+    QVERIFY(_aircraft.getNSecStop() > 0);
+}
+
+void TimeModelBenchmark::nsecPresentation()
+{
+    _aircraft.setNSecStop(Clock::nowNSec());
+
+    QString text;
+    QBENCHMARK
+    {
+        text = _aircraft.getDateTimeStop().toString("hh:mm:ss.zzz");
+    }
+    QVERIFY(!text.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TimeModelBenchmark)
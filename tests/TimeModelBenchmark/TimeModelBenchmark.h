@@ -0,0 +1,27 @@
+#ifndef TIMEMODELBENCHMARK_H
+#define TIMEMODELBENCHMARK_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "objects/air/Aircraft.h"
+
+/*!
+ * \brief The TimeModelBenchmark class
+ * Сравнение стоимости обновления времени объекта на одно сообщение:
+ * QDateTime с пересчётом в мс против целого числа нс с начала эпохи
+ */
+class TimeModelBenchmark : public QObject
+{
+    Q_OBJECT
+    Aircraft _aircraft;
+public:
+    TimeModelBenchmark();
+private Q_SLOTS:
+    void legacyDateTimeUpdate();
+    void dateTimeUpdate();
+    void nsecUpdate();
+    void nsecPresentation();
+};
+
+#endif // TIMEMODELBENCHMARK_H
@@ -0,0 +1,26 @@
+#-------------------------------------------------
+#
+# Бенчмарк обновления времени объекта при обработке сообщения
+#
+#-------------------------------------------------
+
+QT       += testlib
+
+TARGET = TimeModelBenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    TimeModelBenchmark.cpp
+
+HEADERS += \
+    TimeModelBenchmark.h
+
+include( ../../common.pri )
+include( ../../app.pri )
+
+LIBS += -lPoolObject
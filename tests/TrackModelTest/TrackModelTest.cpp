@@ -0,0 +1,236 @@
+#include "TrackModelTest.h"
+
+#include <limits>
+
+#include "objects/air/TrackHistory.h"
+#include "objects/air/TrackPredictor.h"
+
+void TrackModelTest::minIntervalTest()
+{
+    TrackHistory history;
+    const Position start(37.60, 55.75);
+    //смещение на север ~1.1 км - больше MIN_DISTANCE
+    const Position moved(37.60, 55.76);
+
+    QVERIFY(history.append(BASE_TIME, start, 1000.0f, 800.0f));
+    QCOMPARE(history.size(), 1);
+
+    //раньше MIN_INTERVAL точка отбрасывается даже при смещении
+    QCOMPARE(history.append(BASE_TIME + TrackHistory::MIN_INTERVAL - 1,
+                            moved, 1000.0f, 800.0f), false);
+    QCOMPARE(history.size(), 1);
+
+    QVERIFY(history.append(BASE_TIME + TrackHistory::MIN_INTERVAL,
+                           moved, 1000.0f, 800.0f));
+    QCOMPARE(history.size(), 2);
+    QCOMPARE(history.sample(1).time, BASE_TIME + TrackHistory::MIN_INTERVAL);
+}
+
+void TrackModelTest::maxIntervalTest()
+{
+    TrackHistory history;
+    const Position start(37.60, 55.75);
+    //смещение ~60 м - меньше MIN_DISTANCE
+    const Position near(37.60, 55.7505);
+
+    QVERIFY(history.append(BASE_TIME, start, 1000.0f, 0.0f));
+
+    //неподвижный объект до MAX_INTERVAL не записывается
+    QCOMPARE(history.append(BASE_TIME + TrackHistory::MIN_INTERVAL,
+                            near, 1000.0f, 0.0f), false);
+    QCOMPARE(history.append(BASE_TIME + TrackHistory::MAX_INTERVAL - 1,
+                            near, 1000.0f, 0.0f), false);
+    QCOMPARE(history.size(), 1);
+
+    QVERIFY(history.append(BASE_TIME + TrackHistory::MAX_INTERVAL,
+                           near, 1000.0f, 0.0f));
+    QCOMPARE(history.size(), 2);
+}
+
+void TrackModelTest::altitudeChangeTest()
+{
+    TrackHistory history;
+    const Position start(37.60, 55.75);
+
+    QVERIFY(history.append(BASE_TIME, start, 1000.0f, 0.0f));
+
+    //набор высоты без смещения записывается с интервалом MIN_INTERVAL
+    QCOMPARE(history.append(BASE_TIME + TrackHistory::MIN_INTERVAL, start,
+                            1000.0f + TrackHistory::MIN_ALTITUDE_DELTA - 1.0f,
+                            0.0f), false);
+    QVERIFY(history.append(BASE_TIME + 2 * TrackHistory::MIN_INTERVAL, start,
+                           1000.0f + TrackHistory::MIN_ALTITUDE_DELTA,
+                           0.0f));
+    QCOMPARE(history.size(), 2);
+    QCOMPARE(history.sample(1).altitude, 1000.0f + TrackHistory::MIN_ALTITUDE_DELTA);
+}
+
+void TrackModelTest::ringWrapTest()
+{
+    TrackHistory history;
+    const int extra = 10;
+    const int total = TrackHistory::CAPACITY + extra;
+
+    for(int i = 0; i < total; i++)
+        QVERIFY(history.append(BASE_TIME + i * TrackHistory::MAX_INTERVAL,
+                               Position(37.60, 55.75 + i * 0.01),
+                               float(i), 0.0f));
+
+    //самые старые точки перезаписаны, порядок сохраняется
+    QCOMPARE(history.size(), int(TrackHistory::CAPACITY));
+    QCOMPARE(history.sample(0).time, BASE_TIME + extra * TrackHistory::MAX_INTERVAL);
+    QCOMPARE(history.sample(0).altitude, float(extra));
+
+    for(int i = 1; i < history.size(); i++)
+        QCOMPARE(history.sample(i).time - history.sample(i - 1).time,
+                 int64_t(TrackHistory::MAX_INTERVAL));
+
+    const TrackSample last = history.sample(history.size() - 1);
+    QCOMPARE(last.time, BASE_TIME + (total - 1) * TrackHistory::MAX_INTERVAL);
+    QVERIFY(qAbs(last.position.latitude() - (55.75 + (total - 1) * 0.01)) < 1e-6);
+
+    //очистка не освобождает буфер, траектория начинается заново
+    history.clear();
+    QVERIFY(history.isEmpty());
+    QVERIFY(history.append(BASE_TIME, Position(37.60, 55.75), 0.0f, 0.0f));
+    QCOMPARE(history.sample(0).time, int64_t(BASE_TIME));
+}
+
+void TrackModelTest::altitudeClampTest()
+{
+    TrackHistory history;
+
+    QVERIFY(history.append(BASE_TIME, Position(37.60, 55.75), 40000.0f, -10.0f));
+    QVERIFY(history.append(BASE_TIME + TrackHistory::MAX_INTERVAL,
+                           Position(37.60, 55.75), -40000.0f, 1.0e7f));
+
+    //высота ограничивается диапазоном int16, скорость - uint16
+    //поля упакованной точки копируются: ссылка на них недопустима
+    QCOMPARE(int16_t(history.at(0).altitude), std::numeric_limits<int16_t>::max());
+    QCOMPARE(int16_t(history.at(1).altitude), std::numeric_limits<int16_t>::min());
+    QCOMPARE(uint16_t(history.at(0).speed), uint16_t(0));
+    QCOMPARE(uint16_t(history.at(1).speed), std::numeric_limits<uint16_t>::max());
+}
+
+void TrackModelTest::timeRestartTest()
+{
+    TrackHistory history;
+
+    QVERIFY(history.append(BASE_TIME, Position(37.60, 55.75), 0.0f, 0.0f));
+    QVERIFY(history.append(BASE_TIME + TrackHistory::MAX_INTERVAL,
+                           Position(37.60, 55.75), 0.0f, 0.0f));
+
+    //время назад - траектория начинается заново
+    QVERIFY(history.append(BASE_TIME - 1000, Position(37.60, 55.75), 0.0f, 0.0f));
+    QCOMPARE(history.size(), 1);
+    QCOMPARE(history.sample(0).time, BASE_TIME - 1000);
+}
+
+void TrackModelTest::predictionTest()
+{
+    TrackPredictor predictor;
+    const Position start(37.60, 55.75);
+
+    QCOMPARE(predictor.isValid(), false);
+    QVERIFY(predictor.updatePosition(BASE_TIME, start));
+    QVERIFY(predictor.isValid());
+
+    //360 км/ч на восток - 100 м/с
+    predictor.updateVelocity(BASE_TIME, 360.0f, 90.0f);
+
+    const Position predicted = predictor.predict(BASE_TIME + 10000);
+    QVERIFY(qAbs(start.flatDistanceEstimate(predicted) - 1000.0) < 1.0);
+    QVERIFY(predicted.longitude() > start.longitude());
+    QVERIFY(qAbs(predicted.latitude() - start.latitude()) < 1e-6);
+
+    //прогноз ограничен MAX_PREDICTION
+    const Position limited = predictor.predict(BASE_TIME + 10 * TrackPredictor::MAX_PREDICTION);
+    QVERIFY(qAbs(start.flatDistanceEstimate(limited)
+                 - 100.0 * TrackPredictor::MAX_PREDICTION / 1000.0) < 1.0);
+
+    //момент до последнего обновления - без экстраполяции
+    QVERIFY(predictor.predict(BASE_TIME - 1000) == predictor.getPosition());
+}
+
+void TrackModelTest::gateRejectionTest()
+{
+    TrackPredictor predictor;
+    const Position start(37.60, 55.75);
+    //~55 км к северу - вне строба через 1 с
+    const Position far(37.60, 56.25);
+    //~500 м к северу - в стробе
+    const Position near(37.60, 55.7545);
+
+    QVERIFY(predictor.updatePosition(BASE_TIME, start));
+
+    QCOMPARE(predictor.isPlausible(BASE_TIME + 1000, far), false);
+    QCOMPARE(predictor.updatePosition(BASE_TIME + 1000, far), false);
+    QVERIFY(predictor.getPosition() == start);
+
+    QVERIFY(predictor.isPlausible(BASE_TIME + 2000, near));
+    QVERIFY(predictor.updatePosition(BASE_TIME + 2000, near));
+
+    //положение сглаживается: между прогнозом и измерением
+    const double moved = start.flatDistanceEstimate(predictor.getPosition());
+    QVERIFY(moved > 0.0);
+    QVERIFY(moved < start.flatDistanceEstimate(near));
+
+    //строб растет со временем: через 200 с далекое измерение допустимо
+    QVERIFY(predictor.isPlausible(BASE_TIME + 200000, far));
+}
+
+void TrackModelTest::reinitializationTest()
+{
+    TrackPredictor predictor;
+    const Position start(37.60, 55.75);
+    const Position far(30.30, 59.95);
+
+    QVERIFY(predictor.updatePosition(BASE_TIME, start));
+
+    //принятое измерение сбрасывает счетчик отброшенных
+    QCOMPARE(predictor.updatePosition(BASE_TIME + 1000, far), false);
+    QCOMPARE(predictor.updatePosition(BASE_TIME + 2000, far), false);
+    QVERIFY(predictor.updatePosition(BASE_TIME + 3000, start));
+
+    for(int i = 1; i < TrackPredictor::MAX_REJECTED; i++)
+    {
+        QCOMPARE(predictor.updatePosition(BASE_TIME + 3000 + i * 1000, far), false);
+        QVERIFY(predictor.getPosition() != far);
+    }
+
+    //MAX_REJECTED подряд - траектория начинается с нового измерения
+    QVERIFY(predictor.updatePosition(BASE_TIME + 3000 + TrackPredictor::MAX_REJECTED * 1000,
+                                     far));
+    QVERIFY(predictor.getPosition() == far);
+
+    //после переинициализации измерения рядом с новым положением принимаются
+    QVERIFY(predictor.updatePosition(BASE_TIME + 10000, Position(30.30, 59.951)));
+}
+
+void TrackModelTest::antimeridianTest()
+{
+    TrackPredictor predictor;
+    const Position start(179.99, 0.0);
+
+    QVERIFY(predictor.updatePosition(BASE_TIME, start));
+    //900 км/ч на восток - 250 м/с
+    predictor.updateVelocity(BASE_TIME, 900.0f, 90.0f);
+
+    const Position predicted = predictor.predict(BASE_TIME + 10000);
+    QVERIFY(predicted.longitude() >= -180.0 && predicted.longitude() <= 180.0);
+    QVERIFY(predicted.longitude() < 0.0);
+    QVERIFY(qAbs(start.flatDistanceEstimate(predicted) - 2500.0) < 1.0);
+
+    //измерение по другую сторону антимеридиана попадает в строб
+    const Position crossed(-179.995, 0.0);
+    QVERIFY(predictor.isPlausible(BASE_TIME + 5000, crossed));
+    QVERIFY(predictor.updatePosition(BASE_TIME + 5000, crossed));
+    QVERIFY(predictor.getPosition().longitude() >= -180.0);
+    QVERIFY(predictor.getPosition().longitude() <= 180.0);
+
+    QCOMPARE(Position::normalizeLongitude(181.0), -179.0);
+    QCOMPARE(Position::normalizeLongitude(-540.5), 179.5);
+    QCOMPARE(Position::normalizeLongitude(37.6), 37.6);
+}
+
+QTEST_APPLESS_MAIN(TrackModelTest)
@@ -0,0 +1,33 @@
+#ifndef TRACKMODELTEST_H
+#define TRACKMODELTEST_H
+
+#include <QtTest>
+#include <QObject>
+
+/*!
+ * \brief The TrackModelTest class
+ * Проверка истории движения объекта: интервалы прореживания,
+ * перезапись кольцевого буфера и ограничение упакованных значений.
+ * Проверка фильтра положения: строб, переинициализация и прогноз,
+ * в том числе при пересечении антимеридиана
+ */
+class TrackModelTest : public QObject
+{
+    Q_OBJECT
+    ///< время начала траектории, мс с начала эпохи
+    static constexpr int64_t BASE_TIME = 1577836800000;
+
+private Q_SLOTS:
+    void minIntervalTest();
+    void maxIntervalTest();
+    void altitudeChangeTest();
+    void ringWrapTest();
+    void altitudeClampTest();
+    void timeRestartTest();
+    void predictionTest();
+    void gateRejectionTest();
+    void reinitializationTest();
+    void antimeridianTest();
+};
+
+#endif // TRACKMODELTEST_H
@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Проверка модели траектории: прореживание и кольцевой
+# буфер истории движения объекта, фильтр положения
+#
+#-------------------------------------------------
+
+QT       += gui testlib
+
+TARGET = TrackModelTest
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    TrackModelTest.cpp \
+    ../../src/include/coord/Position.cpp \
+    ../../src/include/coord/Conversions.cpp \
+    ../../src/include/objects/air/TrackHistory.cpp \
+    ../../src/include/objects/air/TrackPredictor.cpp
+
+HEADERS += \
+    TrackModelTest.h
+
+include( ../../common.pri )
+include( ../../app.pri )